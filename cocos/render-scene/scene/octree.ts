@@ -76,15 +76,29 @@ export class Octree {
         this._depth = val;
     }
 
+    /**
+     * @en The looseness of the octree child bounds
+     * @zh 八叉树子节点包围盒的松散系数
+     */
+    get looseness (): number {
+        return this._looseness;
+    }
+
+    set looseness (val: number) {
+        this._looseness = val;
+    }
+
     protected _enabled = false;
     protected _minPos = new Vec3(0, 0, 0);
     protected _maxPos = new Vec3(0, 0, 0);
     protected _depth = 0;
+    protected _looseness = 1;
 
     public initialize (octreeInfo: OctreeInfo) {
         this._enabled = octreeInfo.enabled;
         this._minPos = octreeInfo.minPos;
         this._maxPos = octreeInfo.maxPos;
         this._depth = octreeInfo.depth;
+        this._looseness = octreeInfo.looseness;
     }
 }
@@ -314,6 +314,7 @@ serializable(OctreeInfoProto, '_enabled');
 serializable(OctreeInfoProto, '_minPos');
 serializable(OctreeInfoProto, '_maxPos');
 serializable(OctreeInfoProto, '_depth');
+serializable(OctreeInfoProto, '_looseness');
 const enabledDescriptor = Object.getOwnPropertyDescriptor(OctreeInfoProto, 'enabled');
 tooltip('i18n:octree_culling.enabled')(OctreeInfoProto, 'enabled', enabledDescriptor);
 editable(OctreeInfoProto, 'enabled', enabledDescriptor);
@@ -331,6 +332,12 @@ type(CCInteger)(OctreeInfoProto, 'depth', depthDescriptor);
 slide(OctreeInfoProto, 'depth', depthDescriptor);
 range([4, 12, 1])(OctreeInfoProto, 'depth', depthDescriptor);
 editable(OctreeInfoProto, 'depth', depthDescriptor);
+const loosenessDescriptor = Object.getOwnPropertyDescriptor(OctreeInfoProto, 'looseness');
+tooltip('i18n:octree_culling.looseness')(OctreeInfoProto, 'looseness', loosenessDescriptor);
+type(CCFloat)(OctreeInfoProto, 'looseness', loosenessDescriptor);
+slide(OctreeInfoProto, 'looseness', loosenessDescriptor);
+range([1, 2, 0.1])(OctreeInfoProto, 'looseness', loosenessDescriptor);
+editable(OctreeInfoProto, 'looseness', loosenessDescriptor);
 ccclass('cc.OctreeInfo')(OctreeInfo);
 
 const ShadowsInfoProto = ShadowsInfo.prototype;
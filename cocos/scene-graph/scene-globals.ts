@@ -960,6 +960,7 @@ legacyCC.ShadowsInfo = ShadowsInfo;
 export const DEFAULT_WORLD_MIN_POS = new Vec3(-1024.0, -1024.0, -1024.0);
 export const DEFAULT_WORLD_MAX_POS = new Vec3(1024.0, 1024.0, 1024.0);
 export const DEFAULT_OCTREE_DEPTH = 8;
+export const DEFAULT_OCTREE_LOOSENESS = 1.0;
 
 /**
  * @en Scene management and culling configuration based on octree
@@ -1033,6 +1034,24 @@ export class OctreeInfo {
         return this._depth;
     }
 
+    /**
+     * @en The looseness of the octree child bounds, 1 means a regular octree.
+     * A larger value keeps moving objects in the same node longer.
+     * @zh 八叉树子节点包围盒的松散系数，1 表示普通八叉树，较大的值可减少移动物体的重新插入。
+     */
+    @editable
+    @range([1, 2, 0.1])
+    @slide
+    @type(CCFloat)
+    @tooltip('i18n:octree_culling.looseness')
+    set looseness (val: number) {
+        this._looseness = val;
+        if (this._resource) { this._resource.looseness = val; }
+    }
+    get looseness () {
+        return this._looseness;
+    }
+
     @serializable
     protected _enabled = false;
     @serializable
@@ -1041,6 +1060,8 @@ export class OctreeInfo {
     protected _maxPos = new Vec3(DEFAULT_WORLD_MAX_POS);
     @serializable
     protected _depth = DEFAULT_OCTREE_DEPTH;
+    @serializable
+    protected _looseness = DEFAULT_OCTREE_LOOSENESS;
 
     protected _resource: Octree | null = null;
 
@@ -1026,6 +1026,7 @@ module.exports = {
         minPos: 'The minimum position of the world bounding box.',
         maxPos: 'The maximum position of the world bounding box.',
         depth: 'The depth of octree.',
+        looseness: 'The looseness of octree child bounds, 1 means a regular octree.',
     },
     light_probe: {
         giScale: 'The value of GI multiplier.',
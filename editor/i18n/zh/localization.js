@@ -1007,6 +1007,7 @@ module.exports = {
         minPos: '世界包围盒最小顶点的坐标',
         maxPos: '世界包围盒最大顶点的坐标',
         depth: '八叉树深度',
+        looseness: '八叉树子节点包围盒的松散系数，1 表示普通八叉树',
     },
     light_probe: {
         giScale: 'GI乘数',
@@ -65,6 +65,13 @@
     #define USE_MEMORY_LEAK_DETECTOR 0
 #endif
 
+/** Average number of bytes allocated between two samples of the memory hook, 0 records every allocation.
+ *  Only takes effect when USE_MEMORY_LEAK_DETECTOR is enabled.
+ */
+#ifndef CC_MEMORY_SAMPLING_INTERVAL
+    #define CC_MEMORY_SAMPLING_INTERVAL 0
+#endif
+
 #ifndef CC_USE_PROFILER
     #define CC_USE_PROFILER 0
 #endif
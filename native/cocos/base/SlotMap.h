@@ -0,0 +1,157 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Stable handle of an element in a SlotMap.
+ * The generation tells a stale handle apart from a reused slot.
+ */
+struct SlotMapHandle {
+    static constexpr uint32_t INVALID_INDEX{0xFFFFFFFF};
+
+    uint32_t index{INVALID_INDEX};
+    uint32_t generation{0};
+
+    inline bool isValid() const noexcept { return index != INVALID_INDEX; }
+    inline void clear() noexcept { index = INVALID_INDEX; }
+
+    inline bool operator==(const SlotMapHandle &rhs) const noexcept { return index == rhs.index && generation == rhs.generation; }
+    inline bool operator!=(const SlotMapHandle &rhs) const noexcept { return !operator==(rhs); }
+};
+
+/**
+ * Generational slot map: O(1) insert, erase and lookup by handle,
+ * values are stored densely for iteration. Erasing swaps the last value
+ * into the hole, so the iteration order is not preserved.
+ */
+template <typename T>
+class SlotMap final {
+public:
+    using Handle = SlotMapHandle;
+
+    SlotMapHandle insert(T value);
+    bool erase(const SlotMapHandle &handle);
+    bool contains(const SlotMapHandle &handle) const noexcept;
+    void clear();
+
+    inline T *get(const SlotMapHandle &handle) noexcept { return contains(handle) ? &_values[_slots[handle.index].dense] : nullptr; }
+    inline const T *get(const SlotMapHandle &handle) const noexcept { return contains(handle) ? &_values[_slots[handle.index].dense] : nullptr; }
+
+    inline const ccstd::vector<T> &values() const noexcept { return _values; }
+    inline size_t size() const noexcept { return _values.size(); }
+    inline bool empty() const noexcept { return _values.empty(); }
+    void reserve(size_t capacity);
+
+private:
+    struct Slot {
+        uint32_t dense{0}; // index in _values, or the next free slot
+        uint32_t generation{0};
+    };
+
+    ccstd::vector<T> _values;
+    ccstd::vector<uint32_t> _denseToSlot;
+    ccstd::vector<Slot> _slots;
+    uint32_t _freeHead{SlotMapHandle::INVALID_INDEX};
+};
+
+template <typename T>
+SlotMapHandle SlotMap<T>::insert(T value) {
+    uint32_t slotIndex = _freeHead;
+    if (slotIndex == SlotMapHandle::INVALID_INDEX) {
+        slotIndex = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    } else {
+        _freeHead = _slots[slotIndex].dense;
+    }
+
+    Slot &slot = _slots[slotIndex];
+    slot.dense = static_cast<uint32_t>(_values.size());
+    _values.emplace_back(std::move(value));
+    _denseToSlot.emplace_back(slotIndex);
+    return {slotIndex, slot.generation};
+}
+
+template <typename T>
+bool SlotMap<T>::erase(const SlotMapHandle &handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+
+    Slot &slot = _slots[handle.index];
+    const uint32_t dense = slot.dense;
+    const auto last = static_cast<uint32_t>(_values.size() - 1);
+    if (dense != last) {
+        _values[dense] = std::move(_values[last]);
+        _denseToSlot[dense] = _denseToSlot[last];
+        _slots[_denseToSlot[dense]].dense = dense;
+    }
+    _values.pop_back();
+    _denseToSlot.pop_back();
+
+    ++slot.generation;
+    slot.dense = _freeHead;
+    _freeHead = handle.index;
+    return true;
+}
+
+template <typename T>
+bool SlotMap<T>::contains(const SlotMapHandle &handle) const noexcept {
+    if (handle.index >= _slots.size()) {
+        return false;
+    }
+    const Slot &slot = _slots[handle.index];
+    return slot.generation == handle.generation &&
+           slot.dense < _denseToSlot.size() && _denseToSlot[slot.dense] == handle.index;
+}
+
+template <typename T>
+void SlotMap<T>::clear() {
+    // release the slots in place so that the handles given out become stale
+    for (const uint32_t slotIndex : _denseToSlot) {
+        Slot &slot = _slots[slotIndex];
+        ++slot.generation;
+        slot.dense = _freeHead;
+        _freeHead = slotIndex;
+    }
+    _values.clear();
+    _denseToSlot.clear();
+}
+
+template <typename T>
+void SlotMap<T>::reserve(size_t capacity) {
+    _values.reserve(capacity);
+    _denseToSlot.reserve(capacity);
+    _slots.reserve(capacity);
+}
+
+} // namespace cc
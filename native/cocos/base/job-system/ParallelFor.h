@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "base/job-system/JobSystem.h"
+
+namespace cc {
+
+/**
+ * Runs func(begin, end) over [0, count) split into contiguous ranges of at least minPerJob items,
+ * at most one range per worker of jobSystem plus one which the calling thread runs itself.
+ * A minPerJob of 0 is treated as 1.
+ * Returns when all the ranges are done, func has to be safe to call concurrently on disjoint ranges.
+ */
+template <typename Func>
+void parallelFor(JobSystem *jobSystem, uint32_t count, uint32_t minPerJob, const Func &func) {
+    minPerJob = std::max(minPerJob, 1U);
+    const uint32_t jobCount = std::min(jobSystem->threadCount() + 1, (count + minPerJob - 1) / minPerJob);
+    if (jobCount < 2) {
+        func(0U, count);
+        return;
+    }
+
+    const uint32_t step = (count + jobCount - 1) / jobCount;
+    JobGraph graph(jobSystem);
+    graph.createForEachIndexJob(1U, jobCount, 1U, [&](uint32_t job) {
+        func(std::min(count, job * step), std::min(count, (job + 1) * step));
+    });
+    graph.run();
+    func(0U, std::min(count, step));
+    graph.waitForAll();
+}
+
+/**
+ * Same as above on the shared job system.
+ */
+template <typename Func>
+void parallelFor(uint32_t count, uint32_t minPerJob, const Func &func) {
+    parallelFor(JobSystem::getInstance(), count, minPerJob, func);
+}
+
+} // namespace cc
@@ -0,0 +1,167 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "NativeJobGraph.h"
+#include <thread>
+
+namespace cc {
+
+NativeJobGraph::~NativeJobGraph() noexcept {
+    waitForAll();
+    for (auto &node : _nodes) {
+        delete node.task;
+    }
+}
+
+uint32_t NativeJobGraph::addNode(NativeJobTaskItf *task) noexcept {
+    CC_ASSERT(!_pending);
+    Node &node = _nodes.emplace_back();
+    node.graph = this;
+    node.task = task;
+    return static_cast<uint32_t>(_nodes.size() - 1);
+}
+
+void NativeJobGraph::makeEdge(uint32_t j1, uint32_t j2) noexcept {
+    CC_ASSERT(j1 != j2 && !_pending);
+    _nodes[j1].successors.emplace_back(&_nodes[j2]);
+    ++_nodes[j2].predecessorCount;
+}
+
+void NativeJobGraph::run() noexcept {
+    waitForAll();
+    if (_nodes.empty()) {
+        return;
+    }
+
+    for (auto &node : _nodes) {
+        node.pendingPredecessors.store(node.predecessorCount, std::memory_order_relaxed);
+        node.cursor.store(0, std::memory_order_relaxed);
+        node.remainingIterations.store(node.iterationCount, std::memory_order_relaxed);
+    }
+
+    // Hold one reference so that the graph cannot be seen as done before all roots are injected.
+    _activeJobs.store(1, std::memory_order_relaxed);
+    _pending = true;
+    for (auto &node : _nodes) {
+        if (node.predecessorCount == 0) {
+            submit(&NativeJobGraph::nodeEntry, &node);
+        }
+    }
+    _activeJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void NativeJobGraph::waitForAll() noexcept {
+    if (!_pending) {
+        return;
+    }
+    while (_activeJobs.load(std::memory_order_acquire) != 0) {
+        // Help the workers instead of blocking, this also makes nested waits inside jobs safe.
+        if (!_system->tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+    _pending = false;
+}
+
+void NativeJobGraph::submit(NativeJob::Callback callback, Node *node) noexcept {
+    _activeJobs.fetch_add(1, std::memory_order_relaxed);
+    _system->submit({callback, node});
+}
+
+void NativeJobGraph::nodeEntry(void *data) noexcept {
+    auto *node = static_cast<Node *>(data);
+    auto *graph = node->graph;
+    graph->execute(node);
+    graph->_activeJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void NativeJobGraph::chunkEntry(void *data) noexcept {
+    auto *node = static_cast<Node *>(data);
+    auto *graph = node->graph;
+    graph->execute(graph->runChunks(node));
+    graph->_activeJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void NativeJobGraph::execute(Node *node) noexcept {
+    while (node) {
+        if (node->forEach) {
+            node = startForEach(node);
+        } else {
+            node->task->execute(0);
+            node = finish(node);
+        }
+    }
+}
+
+NativeJobGraph::Node *NativeJobGraph::startForEach(Node *node) noexcept {
+    if (node->iterationCount == 0) {
+        return finish(node);
+    }
+    const uint32_t helpers = std::min(_system->threadCount(), node->iterationCount - 1);
+    for (uint32_t i = 0; i < helpers; ++i) {
+        submit(&NativeJobGraph::chunkEntry, node);
+    }
+    return runChunks(node);
+}
+
+NativeJobGraph::Node *NativeJobGraph::runChunks(Node *node) noexcept {
+    const uint32_t participants = _system->threadCount() + 1;
+    uint32_t processed = 0;
+    uint32_t first = node->cursor.load(std::memory_order_relaxed);
+    while (first < node->iterationCount) {
+        // Guided chunking: big chunks while there is plenty of work, smaller ones to balance the tail.
+        const uint32_t chunk = std::max(1U, (node->iterationCount - first) / (participants * 2));
+        if (!node->cursor.compare_exchange_weak(first, first + chunk, std::memory_order_relaxed)) {
+            continue;
+        }
+        for (uint32_t i = first; i < first + chunk; ++i) {
+            node->task->execute(node->begin + i * node->step);
+        }
+        processed += chunk;
+        first = node->cursor.load(std::memory_order_relaxed);
+    }
+
+    // Only the thread completing the last iterations finishes the node.
+    if (processed > 0 && node->remainingIterations.fetch_sub(processed, std::memory_order_acq_rel) == processed) {
+        return finish(node);
+    }
+    return nullptr;
+}
+
+NativeJobGraph::Node *NativeJobGraph::finish(Node *node) noexcept {
+    Node *continuation = nullptr;
+    for (auto *successor : node->successors) {
+        if (successor->pendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (!continuation) {
+                continuation = successor;
+            } else {
+                submit(&NativeJobGraph::nodeEntry, successor);
+            }
+        }
+    }
+    return continuation;
+}
+
+} // namespace cc
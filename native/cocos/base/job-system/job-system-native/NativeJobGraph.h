@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include "NativeJobSystem.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class NativeJobTaskItf {
+public:
+    virtual ~NativeJobTaskItf() = default;
+    virtual void execute(uint32_t index) = 0;
+};
+
+template <class Fn>
+class NativeJobTaskImpl final : public NativeJobTaskItf {
+public:
+    explicit NativeJobTaskImpl(Fn &&t) noexcept : _task(std::forward<Fn>(t)) {}
+    inline void execute(uint32_t /*index*/) override { _task(); }
+
+private:
+    std::decay_t<Fn> _task;
+};
+
+template <class Fn>
+class NativeForEachTaskImpl final : public NativeJobTaskItf {
+public:
+    explicit NativeForEachTaskImpl(Fn &&t) noexcept : _task(std::forward<Fn>(t)) {}
+    inline void execute(uint32_t index) override { _task(index); }
+
+private:
+    std::decay_t<Fn> _task;
+};
+
+/**
+ * Jobs become ready when their dependency counter drops to zero. The thread finishing a job
+ * runs one of the newly ready successors directly as a continuation and injects the others.
+ * For-each jobs are split into chunks claimed by all workers, large ones first.
+ */
+class NativeJobGraph final {
+public:
+    explicit NativeJobGraph(NativeJobSystem *system) noexcept : _system(system) {}
+    NativeJobGraph(const NativeJobGraph &) = delete;
+    NativeJobGraph(NativeJobGraph &&) = delete;
+    NativeJobGraph &operator=(const NativeJobGraph &) = delete;
+    NativeJobGraph &operator=(NativeJobGraph &&) = delete;
+    ~NativeJobGraph() noexcept;
+
+    template <typename Function>
+    uint32_t createJob(Function &&func) noexcept;
+
+    template <typename Function>
+    uint32_t createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept;
+
+    void makeEdge(uint32_t j1, uint32_t j2) noexcept;
+
+    void run() noexcept;
+
+    void waitForAll() noexcept;
+
+private:
+    struct Node {
+        NativeJobGraph *graph{nullptr};
+        NativeJobTaskItf *task{nullptr};
+        ccstd::vector<Node *> successors;
+        uint32_t predecessorCount{0};
+        std::atomic<uint32_t> pendingPredecessors{0};
+
+        // for-each jobs only
+        bool forEach{false};
+        uint32_t begin{0};
+        uint32_t step{1};
+        uint32_t iterationCount{0};
+        std::atomic<uint32_t> cursor{0};
+        std::atomic<uint32_t> remainingIterations{0};
+    };
+
+    static void nodeEntry(void *data) noexcept;
+    static void chunkEntry(void *data) noexcept;
+
+    uint32_t addNode(NativeJobTaskItf *task) noexcept;
+    void submit(NativeJob::Callback callback, Node *node) noexcept;
+    void execute(Node *node) noexcept;
+    Node *startForEach(Node *node) noexcept;
+    Node *runChunks(Node *node) noexcept;
+    Node *finish(Node *node) noexcept;
+
+    NativeJobSystem *_system{nullptr};
+    ccstd::deque<Node> _nodes; // existing nodes cannot be invalidated
+
+    // jobs of this graph that are queued or running, the graph is done when it drops to zero
+    std::atomic<uint32_t> _activeJobs{0};
+    bool _pending{false};
+};
+
+template <typename Function>
+uint32_t NativeJobGraph::createJob(Function &&func) noexcept {
+    return addNode(ccnew NativeJobTaskImpl<Function>(std::forward<Function>(func)));
+}
+
+template <typename Function>
+uint32_t NativeJobGraph::createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept {
+    const uint32_t id = addNode(ccnew NativeForEachTaskImpl<Function>(std::forward<Function>(func)));
+    Node &node = _nodes[id];
+    node.forEach = true;
+    node.begin = begin;
+    node.step = std::max(1U, step);
+    node.iterationCount = begin < end ? (end - begin + node.step - 1) / node.step : 0;
+    return id;
+}
+
+} // namespace cc
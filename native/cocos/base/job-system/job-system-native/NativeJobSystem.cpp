@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "NativeJobSystem.h"
+#include <algorithm>
+#include "base/Log.h"
+
+namespace cc {
+
+NativeJobSystem *NativeJobSystem::instance = nullptr;
+
+uint32_t NativeJobSystem::defaultThreadCount() noexcept {
+    // Leave room for the game thread and the render thread.
+    const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 4U ? hardwareThreads - 2U : 2U;
+}
+
+NativeJobSystem::NativeJobSystem(uint32_t threadCount) noexcept {
+    threadCount = std::max(1U, threadCount);
+    _workers.reserve(threadCount);
+    for (uint32_t i = 0U; i < threadCount; ++i) {
+        _workers.emplace_back(&NativeJobSystem::workerLoop, this);
+    }
+    CC_LOG_INFO("Native Job system initialized: %u worker threads", threadCount);
+}
+
+NativeJobSystem::~NativeJobSystem() {
+    _running.store(false, std::memory_order_release);
+    _semaphore.signal(static_cast<int>(_workers.size()));
+    for (auto &worker : _workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    _workers.clear();
+}
+
+void NativeJobSystem::submit(const NativeJob &job) noexcept {
+    bool const succeed = _jobs.enqueue(job);
+    CC_ASSERT(succeed);
+    _semaphore.signal();
+}
+
+bool NativeJobSystem::tryRunOne() noexcept {
+    NativeJob job;
+    if (_jobs.try_dequeue(job)) {
+        job.callback(job.data);
+        return true;
+    }
+    return false;
+}
+
+void NativeJobSystem::workerLoop() noexcept {
+    while (true) {
+        // Each job posts one signal, but waiting threads help with the jobs as well, so the
+        // job a signal was posted for may be gone while others queued up: drain the queue
+        // after every wake-up instead of running a single job per signal.
+        _semaphore.wait();
+        if (!_running.load(std::memory_order_acquire)) {
+            break;
+        }
+        while (tryRunOne()) {
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+#include "concurrentqueue/concurrentqueue.h"
+#include "concurrentqueue/lightweightsemaphore.h"
+
+namespace cc {
+
+using NativeJobToken = void;
+
+struct NativeJob {
+    using Callback = void (*)(void *data);
+
+    Callback callback{nullptr};
+    void *data{nullptr};
+};
+
+/**
+ * Built-in job system with a fixed set of worker threads pulling jobs from a lock-free MPMC queue.
+ */
+class NativeJobSystem final {
+private:
+    static NativeJobSystem *instance;
+
+public:
+    static NativeJobSystem *getInstance() {
+        if (!instance) {
+            instance = ccnew NativeJobSystem;
+        }
+        return instance;
+    }
+
+    static void destroyInstance() {
+        CC_SAFE_DELETE(instance);
+    }
+
+    NativeJobSystem() noexcept : NativeJobSystem(defaultThreadCount()) {}
+    explicit NativeJobSystem(uint32_t threadCount) noexcept;
+    NativeJobSystem(const NativeJobSystem &) = delete;
+    NativeJobSystem(NativeJobSystem &&) = delete;
+    NativeJobSystem &operator=(const NativeJobSystem &) = delete;
+    NativeJobSystem &operator=(NativeJobSystem &&) = delete;
+    ~NativeJobSystem();
+
+    inline uint32_t threadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+    /**
+     * Inject a job, can be called from any thread including the workers.
+     */
+    void submit(const NativeJob &job) noexcept;
+
+    /**
+     * Execute one pending job on the calling thread, returns false if there is none.
+     * Used by threads waiting for a job graph so that they help instead of blocking.
+     */
+    bool tryRunOne() noexcept;
+
+private:
+    static uint32_t defaultThreadCount() noexcept;
+
+    void workerLoop() noexcept;
+
+    moodycamel::ConcurrentQueue<NativeJob> _jobs;
+    moodycamel::LightweightSemaphore _semaphore;
+    ccstd::vector<std::thread> _workers;
+    std::atomic<bool> _running{true};
+};
+
+} // namespace cc
@@ -33,6 +33,11 @@
         #include <pthread.h>
     #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS
         #include <execinfo.h>
+    #elif CC_PLATFORM == CC_PLATFORM_LINUX
+        #include <cxxabi.h>
+        #include <dlfcn.h>
+        #include <execinfo.h>
+        #include <cstring>
     #elif CC_PLATFORM == CC_PLATFORM_WINDOWS
         #include <DbgHelp.h>
         #include <Windows.h>
@@ -46,7 +51,7 @@ namespace cc {
 
 ccstd::string StackFrame::toString() {
     static ccstd::string unknown("unknown");
-    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX
     std::stringstream stream;
     stream << "\tmodule: " << (module.empty() ? unknown : module)
            << "\tfunction: " << (function.empty() ? unknown : function);
@@ -157,7 +162,7 @@ ccstd::vector<void *> CallStack::backtrace() {
 
     return callstack;
 
-    #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS
+    #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS || CC_PLATFORM == CC_PLATFORM_LINUX
     ccstd::vector<void *> callstack;
     callstack.reserve(MAX_STACK_FRAMES);
 
@@ -185,7 +190,7 @@ ccstd::vector<void *> CallStack::backtrace() {
 }
 
 ccstd::vector<StackFrame> CallStack::backtraceSymbols(const ccstd::vector<void *> &callstack) {
-    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX
     ccstd::vector<StackFrame> frames;
     size_t size = callstack.size();
     for (size_t i = 0; i < size; i++) {
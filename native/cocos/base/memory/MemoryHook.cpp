@@ -27,45 +27,143 @@
 #include "CallStack.h"
 #if USE_MEMORY_LEAK_DETECTOR
 
+    #include <algorithm>
+    #include <cmath>
+    #include <cstring>
     #include <sstream>
 
-    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX
         #define __GNU_SOURCE
         #include <dlfcn.h>
 
 static NewHookType g_new_hooker = nullptr;
 static DeleteHookType g_delete_hooker = nullptr;
 
+typedef void *(*CallocType)(size_t count, size_t size);
+typedef void *(*ReallocType)(void *ptr, size_t size);
+typedef void *(*MemalignType)(size_t alignment, size_t size);
+typedef int (*PosixMemalignType)(void **ptr, size_t alignment, size_t size);
+
+// dlsym may call calloc before the system one is resolved, serve these calls from a static buffer.
+static char g_bootstrap_buffer[1024];
+static size_t g_bootstrap_used = 0;
+
+static inline bool isBootstrapMemory(const void *ptr) {
+    return ptr >= g_bootstrap_buffer && ptr < g_bootstrap_buffer + sizeof(g_bootstrap_buffer);
+}
+
+template <typename T>
+static inline T resolveSystem(T *system, const char *name) {
+    if (CC_PREDICT_FALSE(*system == nullptr)) {
+        *system = (T)dlsym(RTLD_NEXT, name);
+    }
+    return *system;
+}
+
+static inline void onAllocate(void *ptr, size_t size) {
+    if (CC_PREDICT_TRUE(g_new_hooker != nullptr) && ptr != nullptr) {
+        g_new_hooker(ptr, size);
+    }
+}
+
+static inline void onFree(void *ptr) {
+    if (CC_PREDICT_TRUE(g_delete_hooker != nullptr) && ptr != nullptr) {
+        g_delete_hooker(ptr);
+    }
+}
+
 extern "C" {
 
 void *malloc(size_t size) __attribute__((weak));
 void free(void *ptr) __attribute__((weak));
+void *calloc(size_t count, size_t size) __attribute__((weak));
+void *realloc(void *ptr, size_t size) __attribute__((weak));
+void *memalign(size_t alignment, size_t size) __attribute__((weak));
+void *aligned_alloc(size_t alignment, size_t size) __attribute__((weak));
+int posix_memalign(void **ptr, size_t alignment, size_t size) __attribute__((weak));
 
 // Use strong symbol to overwrite the weak one.
 void *malloc(size_t size) {
     static MallocType system_malloc = nullptr;
-    if (CC_PREDICT_FALSE(system_malloc == nullptr)) {
-        system_malloc = (MallocType)dlsym(RTLD_NEXT, "malloc");
+    void *ptr = resolveSystem(&system_malloc, "malloc")(size);
+    onAllocate(ptr, size);
+    return ptr;
+}
+
+void free(void *ptr) {
+    static FreeType system_free = nullptr;
+    if (CC_PREDICT_FALSE(isBootstrapMemory(ptr))) {
+        return;
     }
 
-    void *ptr = system_malloc(size);
-    if (CC_PREDICT_TRUE(g_new_hooker != nullptr)) {
-        g_new_hooker(ptr, size);
+    resolveSystem(&system_free, "free")(ptr);
+    onFree(ptr);
+}
+
+void *calloc(size_t count, size_t size) {
+    static CallocType system_calloc = nullptr;
+    static bool resolving = false;
+    if (CC_PREDICT_FALSE(system_calloc == nullptr)) {
+        if (resolving) {
+            // zero initialized already, never released
+            const size_t bytes = (count * size + 15) & ~static_cast<size_t>(15);
+            if (g_bootstrap_used + bytes > sizeof(g_bootstrap_buffer)) {
+                return nullptr;
+            }
+            void *ptr = g_bootstrap_buffer + g_bootstrap_used;
+            g_bootstrap_used += bytes;
+            return ptr;
+        }
+        resolving = true;
+        resolveSystem(&system_calloc, "calloc");
+        resolving = false;
     }
 
+    void *ptr = system_calloc(count, size);
+    onAllocate(ptr, count * size);
     return ptr;
 }
 
-void free(void *ptr) {
-    static FreeType system_free = nullptr;
-    if (CC_PREDICT_FALSE(system_free == nullptr)) {
-        system_free = (FreeType)dlsym(RTLD_NEXT, "free");
+void *realloc(void *ptr, size_t size) {
+    static ReallocType system_realloc = nullptr;
+    if (CC_PREDICT_FALSE(isBootstrapMemory(ptr))) {
+        void *newPtr = malloc(size);
+        if (newPtr != nullptr) {
+            memcpy(newPtr, ptr, std::min(size, static_cast<size_t>(g_bootstrap_buffer + sizeof(g_bootstrap_buffer) - static_cast<char *>(ptr))));
+        }
+        return newPtr;
     }
 
-    system_free(ptr);
-    if (CC_PREDICT_TRUE(g_delete_hooker != nullptr)) {
-        g_delete_hooker(ptr);
+    void *newPtr = resolveSystem(&system_realloc, "realloc")(ptr, size);
+    // the old block is released when the call succeeds, or when it frees with a zero size
+    if (newPtr != nullptr || size == 0) {
+        onFree(ptr);
+    }
+    onAllocate(newPtr, size);
+    return newPtr;
+}
+
+void *memalign(size_t alignment, size_t size) {
+    static MemalignType system_memalign = nullptr;
+    void *ptr = resolveSystem(&system_memalign, "memalign")(alignment, size);
+    onAllocate(ptr, size);
+    return ptr;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    static MemalignType system_aligned_alloc = nullptr;
+    void *ptr = resolveSystem(&system_aligned_alloc, "aligned_alloc")(alignment, size);
+    onAllocate(ptr, size);
+    return ptr;
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+    static PosixMemalignType system_posix_memalign = nullptr;
+    const int ret = resolveSystem(&system_posix_memalign, "posix_memalign")(ptr, alignment, size);
+    if (ret == 0) {
+        onAllocate(*ptr, size);
     }
+    return ret;
 }
 }
 
@@ -130,6 +228,94 @@ int MallocHook_RemoveDeleteHook(MallocHook_DeleteHook hook);
 
 namespace cc {
 
+    #if (CC_COMPILER == CC_COMPILER_GNUC || CC_COMPILER == CC_COMPILER_CLANG)
+        // initial-exec avoids lazy TLS allocation, which would re-enter the hooks.
+        #define CC_HOOK_THREAD_LOCAL __attribute__((tls_model("initial-exec"))) thread_local
+    #else
+        #define CC_HOOK_THREAD_LOCAL thread_local
+    #endif
+
+namespace {
+
+CC_HOOK_THREAD_LOCAL uint32_t tCurrentTag = MemoryHook::DEFAULT_TAG;
+CC_HOOK_THREAD_LOCAL int64_t tBytesUntilSample = 0;
+CC_HOOK_THREAD_LOCAL uint64_t tRandomState = 0;
+// Set while the sampler itself allocates or frees, so that these calls are not sampled.
+CC_HOOK_THREAD_LOCAL bool tInSampler = false;
+
+std::mutex gTagMutex;
+const char *gTagNames[MemoryHook::MAX_TAG_COUNT] = {"untagged"};
+std::atomic<uint32_t> gTagCount{1};
+
+class SamplerGuard {
+public:
+    SamplerGuard() : _prev(tInSampler) { tInSampler = true; }
+    ~SamplerGuard() { tInSampler = _prev; }
+
+private:
+    bool _prev{false};
+};
+
+uint64_t nextRandom() {
+    // xorshift64*, seeded lazily per thread.
+    if (CC_PREDICT_FALSE(tRandomState == 0)) {
+        tRandomState = reinterpret_cast<uint64_t>(&tRandomState) ^ 0x9E3779B97F4A7C15ULL;
+    }
+    tRandomState ^= tRandomState >> 12;
+    tRandomState ^= tRandomState << 25;
+    tRandomState ^= tRandomState >> 27;
+    return tRandomState * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * Distance to the next sample follows an exponential distribution, so that sampling is a Poisson process
+ * over the allocated bytes and does not alias with periodic allocation patterns.
+ */
+int64_t nextSampleDistance(size_t interval) {
+    // 53 random bits in (0, 1]
+    const double u = static_cast<double>((nextRandom() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    const double distance = -std::log(u) * static_cast<double>(interval);
+    return std::max<int64_t>(1, static_cast<int64_t>(distance));
+}
+
+/**
+ * An allocation of `size` bytes is sampled with probability 1 - exp(-size / interval), so it stands for
+ * size / probability bytes.
+ */
+size_t sampleWeight(size_t size, size_t interval) {
+    if (size >= interval * 32) {
+        return size;
+    }
+    const double probability = 1.0 - std::exp(-static_cast<double>(size) / static_cast<double>(interval));
+    return probability > 0.0 ? static_cast<size_t>(static_cast<double>(size) / probability) : interval;
+}
+
+uint64_t hashCallstack(const ccstd::vector<void *> &callstack) {
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a
+    for (auto *frame : callstack) {
+        hash ^= reinterpret_cast<uint64_t>(frame);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline uint64_t entryKey(uint64_t callsite, uint32_t tag) {
+    return callsite ^ (static_cast<uint64_t>(tag) * 0x9E3779B97F4A7C15ULL);
+}
+
+inline uint32_t shardIndex(uint64_t address, uint32_t shardCount) {
+    // Ignore the low bits that are fixed by malloc alignment.
+    return static_cast<uint32_t>((address >> 4) ^ (address >> 12)) % shardCount;
+}
+
+void sortEntries(MemorySnapshot &snapshot) {
+    std::sort(snapshot.entries.begin(), snapshot.entries.end(), [](const MemorySnapshotEntry &lhs, const MemorySnapshotEntry &rhs) {
+        return lhs.liveBytes > rhs.liveBytes;
+    });
+}
+
+} // namespace
+
 static void newHook(const void *ptr, size_t size) {
     uint64_t address = reinterpret_cast<uint64_t>(ptr);
     GMemoryHook.addRecord(address, size);
@@ -141,15 +327,38 @@ static void deleteHook(const void *ptr) {
 }
 
 MemoryHook::MemoryHook() {
+    _samplingInterval = CC_MEMORY_SAMPLING_INTERVAL;
     registerAll();
 }
 
 MemoryHook::~MemoryHook() {
     unRegisterAll();
-    dumpMemoryLeak();
+    if (isSampling()) {
+        dumpSnapshot(takeSnapshot());
+    } else {
+        dumpMemoryLeak();
+    }
 }
 
 void MemoryHook::addRecord(uint64_t address, size_t size) {
+    const size_t interval = _samplingInterval.load(std::memory_order_relaxed);
+    if (interval > 0) {
+        if (tInSampler || address == 0) {
+            return;
+        }
+        // Fast path: no lock and no callstack for the allocations that are not sampled.
+        tBytesUntilSample -= static_cast<int64_t>(size);
+        if (CC_PREDICT_TRUE(tBytesUntilSample > 0)) {
+            return;
+        }
+        const bool firstSample = tRandomState == 0;
+        tBytesUntilSample = nextSampleDistance(interval);
+        if (!firstSample) {
+            addSample(address, size, interval);
+        }
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (_hooking) {
         return;
@@ -171,6 +380,11 @@ void MemoryHook::addRecord(uint64_t address, size_t size) {
 }
 
 void MemoryHook::removeRecord(uint64_t address) {
+    if (isSampling()) {
+        removeSample(address);
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (_hooking) {
         return;
@@ -190,6 +404,211 @@ void MemoryHook::removeRecord(uint64_t address) {
     _hooking = false;
 }
 
+void MemoryHook::addSample(uint64_t address, size_t size, size_t interval) {
+    SamplerGuard guard;
+
+    MemorySample sample;
+    sample.size = size;
+    sample.weight = sampleWeight(size, interval);
+    sample.tag = tCurrentTag;
+    sample.callstack = CallStack::backtrace();
+    sample.callsite = hashCallstack(sample.callstack);
+    const auto weight = static_cast<int64_t>(sample.weight);
+
+    auto &shard = _sampleShards[shardIndex(address, SAMPLE_SHARD_COUNT)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto iter = shard.samples.find(address);
+        if (iter != shard.samples.end()) {
+            // The free of the previous owner of this address was missed.
+            _sampledLiveBytes.fetch_sub(static_cast<int64_t>(iter->second.weight), std::memory_order_relaxed);
+            iter->second = std::move(sample);
+        } else {
+            shard.samples.emplace(address, std::move(sample));
+            _sampledCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    _sampledLiveBytes.fetch_add(weight, std::memory_order_relaxed);
+}
+
+void MemoryHook::removeSample(uint64_t address) {
+    if (tInSampler || _sampledCount.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    SamplerGuard guard;
+    auto &shard = _sampleShards[shardIndex(address, SAMPLE_SHARD_COUNT)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.samples.find(address);
+    if (iter != shard.samples.end()) {
+        _sampledLiveBytes.fetch_sub(static_cast<int64_t>(iter->second.weight), std::memory_order_relaxed);
+        _sampledCount.fetch_sub(1, std::memory_order_relaxed);
+        shard.samples.erase(iter);
+    }
+}
+
+void MemoryHook::setSamplingInterval(size_t interval) {
+    SamplerGuard guard;
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _hooking = true;
+
+    _samplingInterval = interval;
+    _records.clear();
+    _totalSize = 0;
+    for (auto &shard : _sampleShards) {
+        std::lock_guard<std::mutex> shardLock(shard.mutex);
+        shard.samples.clear();
+    }
+    _sampledCount = 0;
+    _sampledLiveBytes = 0;
+
+    _hooking = false;
+}
+
+uint32_t MemoryHook::registerTag(const char *name) {
+    SamplerGuard guard;
+    std::lock_guard<std::mutex> lock(gTagMutex);
+    const uint32_t count = gTagCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (strcmp(gTagNames[i], name) == 0) {
+            return i;
+        }
+    }
+    if (count >= MAX_TAG_COUNT) {
+        return DEFAULT_TAG;
+    }
+    gTagNames[count] = name;
+    gTagCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+const char *MemoryHook::getTagName(uint32_t tag) {
+    return tag < gTagCount.load(std::memory_order_acquire) ? gTagNames[tag] : gTagNames[DEFAULT_TAG];
+}
+
+uint32_t MemoryHook::setCurrentTag(uint32_t tag) {
+    const uint32_t prev = tCurrentTag;
+    tCurrentTag = tag;
+    return prev;
+}
+
+uint32_t MemoryHook::getCurrentTag() {
+    return tCurrentTag;
+}
+
+MemorySnapshot MemoryHook::takeSnapshot() {
+    SamplerGuard guard;
+
+    MemorySnapshot snapshot;
+    ccstd::unordered_map<uint64_t, size_t> indices;
+    for (auto &shard : _sampleShards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto &iter : shard.samples) {
+            const auto &sample = iter.second;
+            const auto key = entryKey(sample.callsite, sample.tag);
+            auto found = indices.find(key);
+            if (found == indices.end()) {
+                found = indices.emplace(key, snapshot.entries.size()).first;
+                MemorySnapshotEntry entry;
+                entry.callsite = sample.callsite;
+                entry.tag = sample.tag;
+                entry.callstack = sample.callstack;
+                snapshot.entries.emplace_back(std::move(entry));
+            }
+            auto &entry = snapshot.entries[found->second];
+            entry.liveBytes += static_cast<int64_t>(sample.weight);
+            ++entry.sampleCount;
+            snapshot.totalLiveBytes += static_cast<int64_t>(sample.weight);
+        }
+    }
+    sortEntries(snapshot);
+    return snapshot;
+}
+
+MemorySnapshot MemoryHook::diffSnapshots(const MemorySnapshot &before, const MemorySnapshot &after) {
+    SamplerGuard guard;
+
+    MemorySnapshot diff;
+    diff.totalLiveBytes = after.totalLiveBytes - before.totalLiveBytes;
+
+    ccstd::unordered_map<uint64_t, const MemorySnapshotEntry *> previous;
+    for (const auto &entry : before.entries) {
+        previous.emplace(entryKey(entry.callsite, entry.tag), &entry);
+    }
+
+    for (const auto &entry : after.entries) {
+        MemorySnapshotEntry delta = entry;
+        auto iter = previous.find(entryKey(entry.callsite, entry.tag));
+        if (iter != previous.end()) {
+            delta.liveBytes -= iter->second->liveBytes;
+            delta.sampleCount -= iter->second->sampleCount;
+            previous.erase(iter);
+        }
+        if (delta.liveBytes != 0 || delta.sampleCount != 0) {
+            diff.entries.emplace_back(std::move(delta));
+        }
+    }
+
+    // Callsites that were released completely.
+    for (const auto &iter : previous) {
+        MemorySnapshotEntry delta = *iter.second;
+        delta.liveBytes = -delta.liveBytes;
+        delta.sampleCount = -delta.sampleCount;
+        diff.entries.emplace_back(std::move(delta));
+    }
+
+    sortEntries(diff);
+    return diff;
+}
+
+void MemoryHook::dumpSnapshot(const MemorySnapshot &snapshot, uint32_t maxEntries) {
+    SamplerGuard guard;
+    #if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    CallStack::initSym();
+    #endif
+
+    std::stringstream startStream;
+    startStream << std::endl;
+    startStream << "---------------------------------------------------------------------------------------------------------" << std::endl;
+    startStream << "--------------------------------------memory snapshot start----------------------------------------------" << std::endl;
+    startStream << "---------------------------------------------------------------------------------------------------------" << std::endl;
+    startStream << "Sampling interval: " << getSamplingInterval() << " bytes, "
+                << "estimated live bytes: " << snapshot.totalLiveBytes << ", "
+                << "callsites: " << snapshot.entries.size() << std::endl;
+    log(startStream.str());
+
+    uint32_t i = 0;
+    for (const auto &entry : snapshot.entries) {
+        if (i >= maxEntries) {
+            break;
+        }
+
+        std::stringstream stream;
+        int k = 0;
+
+        stream << std::endl;
+        stream << "<" << ++i << ">:"
+               << "[" << getTagName(entry.tag) << "] " << entry.liveBytes << " bytes in " << entry.sampleCount << " samples" << std::endl;
+        stream << "\tcallstack:" << std::endl;
+
+        for (auto &frame : CallStack::backtraceSymbols(entry.callstack)) {
+            stream << "\t[" << ++k << "]:" << frame.toString() << std::endl;
+        }
+
+        log(stream.str());
+    }
+
+    std::stringstream endStream;
+    endStream << "---------------------------------------------------------------------------------------------------------" << std::endl;
+    endStream << "--------------------------------------memory snapshot end------------------------------------------------" << std::endl;
+    endStream << "---------------------------------------------------------------------------------------------------------" << std::endl;
+    log(endStream.str());
+
+    #if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    CallStack::cleanupSym();
+    #endif
+}
+
 static bool isIgnored(const StackFrame &frame) {
     #if CC_PLATFORM == CC_PLATFORM_WINDOWS
     static const ccstd::vector<ccstd::string> ignoreModules = {
@@ -296,7 +715,7 @@ void MemoryHook::dumpMemoryLeak() {
 void MemoryHook::log(const ccstd::string &msg) {
     #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
     __android_log_write(ANDROID_LOG_WARN, "Cocos", msg.c_str());
-    #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS
+    #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS || CC_PLATFORM == CC_PLATFORM_LINUX
     fputs(msg.c_str(), stdout);
     #elif (CC_PLATFORM == CC_PLATFORM_WINDOWS)
     OutputDebugStringA(msg.c_str());
@@ -304,7 +723,7 @@ void MemoryHook::log(const ccstd::string &msg) {
 }
 
 void MemoryHook::registerAll() {
-    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX
     g_new_hooker = newHook;
     g_delete_hooker = deleteHook;
     free(malloc(1)); // force to init system_malloc/system_free
@@ -320,7 +739,7 @@ void MemoryHook::registerAll() {
 }
 
 void MemoryHook::unRegisterAll() {
-    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX
     g_new_hooker = nullptr;
     g_delete_hooker = nullptr;
     #elif CC_PLATFORM == CC_PLATFORM_IOS || CC_PLATFORM == CC_PLATFORM_MACOS
@@ -28,6 +28,7 @@
 #include "../Config.h"
 #if USE_MEMORY_LEAK_DETECTOR
 
+    #include <atomic>
     #include <mutex>
     #include "../Macros.h"
     #include "base/std/container/string.h"
@@ -48,6 +49,34 @@ struct CC_DLL MemoryRecord {
     ccstd::vector<void *> callstack;
 };
 
+/**
+ * An allocation picked by the sampling profiler.
+ * weight is the estimated number of bytes this sample stands for.
+ */
+struct CC_DLL MemorySample {
+    size_t size{0};
+    size_t weight{0};
+    uint32_t tag{0};
+    uint64_t callsite{0};
+    ccstd::vector<void *> callstack;
+};
+
+/**
+ * Estimated live bytes of one (callsite, tag) pair.
+ */
+struct CC_DLL MemorySnapshotEntry {
+    uint64_t callsite{0};
+    uint32_t tag{0};
+    int64_t liveBytes{0};
+    int64_t sampleCount{0};
+    ccstd::vector<void *> callstack;
+};
+
+struct CC_DLL MemorySnapshot {
+    int64_t totalLiveBytes{0};
+    ccstd::vector<MemorySnapshotEntry> entries;
+};
+
 class CC_DLL MemoryHook {
 public:
     MemoryHook();
@@ -58,9 +87,44 @@ public:
      */
     using RecordMap = ccstd::unordered_map<uint64_t, MemoryRecord>;
 
+    static constexpr uint32_t MAX_TAG_COUNT{64};
+    static constexpr uint32_t DEFAULT_TAG{0};
+
     void addRecord(uint64_t address, size_t size);
     void removeRecord(uint64_t address);
-    inline size_t getTotalSize() const { return _totalSize; }
+    inline size_t getTotalSize() const { return isSampling() ? static_cast<size_t>(_sampledLiveBytes.load(std::memory_order_relaxed)) : _totalSize; }
+
+    /**
+     * Record one allocation per `interval` bytes on average instead of every allocation, 0 switches back
+     * to full recording. Records collected in the previous mode are dropped.
+     */
+    void setSamplingInterval(size_t interval);
+    inline size_t getSamplingInterval() const { return _samplingInterval.load(std::memory_order_relaxed); }
+    inline bool isSampling() const { return getSamplingInterval() > 0; }
+
+    /**
+     * Register a subsystem tag, returns the same id for the same name. Tag 0 is "untagged".
+     */
+    static uint32_t registerTag(const char *name);
+    static const char *getTagName(uint32_t tag);
+    /**
+     * Set the tag of allocations made by the calling thread, returns the previous one.
+     */
+    static uint32_t setCurrentTag(uint32_t tag);
+    static uint32_t getCurrentTag();
+
+    /**
+     * Aggregate the live samples by callsite and tag, entries are sorted by live bytes in descending order.
+     */
+    MemorySnapshot takeSnapshot();
+    /**
+     * Entries of `after` minus `before`, only the ones that changed, sorted by growth in descending order.
+     */
+    static MemorySnapshot diffSnapshots(const MemorySnapshot &before, const MemorySnapshot &after);
+    /**
+     * Symbolize and output the first `maxEntries` entries of a snapshot.
+     */
+    void dumpSnapshot(const MemorySnapshot &snapshot, uint32_t maxEntries = 32);
 
 private:
     /**
@@ -80,11 +144,40 @@ private:
      */
     void unRegisterAll();
 
+    void addSample(uint64_t address, size_t size, size_t interval);
+    void removeSample(uint64_t address);
+
 private:
+    static constexpr uint32_t SAMPLE_SHARD_COUNT{64};
+
+    struct SampleShard {
+        std::mutex mutex;
+        ccstd::unordered_map<uint64_t, MemorySample> samples;
+    };
+
     std::recursive_mutex _mutex;
     bool _hooking{false};
     RecordMap _records;
     size_t _totalSize{0U};
+
+    std::atomic<size_t> _samplingInterval{0};
+    std::atomic<int64_t> _sampledLiveBytes{0};
+    std::atomic<int64_t> _sampledCount{0};
+    SampleShard _sampleShards[SAMPLE_SHARD_COUNT];
+};
+
+/**
+ * Tag allocations made by the current thread in this scope, e.g.
+ * static const uint32_t tag = MemoryHook::registerTag("physics");
+ * MemoryTagScope scope(tag);
+ */
+class CC_DLL MemoryTagScope {
+public:
+    explicit MemoryTagScope(uint32_t tag) : _prevTag(MemoryHook::setCurrentTag(tag)) {}
+    ~MemoryTagScope() { MemoryHook::setCurrentTag(_prevTag); }
+
+private:
+    uint32_t _prevTag{MemoryHook::DEFAULT_TAG};
 };
 
 extern MemoryHook GMemoryHook;
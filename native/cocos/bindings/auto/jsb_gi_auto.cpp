@@ -3268,6 +3268,129 @@ bool js_register_cc_gi_LightProbeInfo(se::Object* obj) {
 }
 
 
+se::Class* __jsb_cc_gi_SH_class = nullptr;
+se::Object* __jsb_cc_gi_SH_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_gi_SH) 
+
+static bool js_cc_gi_SH_project_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    ccstd::vector< cc::Vec3 > *arg1 = 0 ;
+    ccstd::vector< cc::Vec3 > *arg2 = 0 ;
+    ccstd::vector< cc::Vec3 > temp1 ;
+    ccstd::vector< cc::Vec3 > temp2 ;
+    ccstd::vector< cc::Vec3 > result;
+    
+    if(argc != 2) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+    
+    ok &= sevalue_to_native(args[0], &temp1, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg1 = &temp1;
+    
+    
+    ok &= sevalue_to_native(args[1], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    result = cc::gi::SH::project((ccstd::vector< cc::Vec3 > const &)*arg1,(ccstd::vector< cc::Vec3 > const &)*arg2);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_gi_SH_project_static) 
+
+static bool js_cc_gi_SH_projectProbes_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    ccstd::vector< cc::Vec3 > *arg1 = 0 ;
+    ccstd::vector< cc::Vec3 > *arg2 = 0 ;
+    ccstd::vector< cc::Vec3 > temp1 ;
+    ccstd::vector< cc::Vec3 > temp2 ;
+    ccstd::vector< cc::Vec3 > result;
+    
+    if(argc != 2) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+    
+    ok &= sevalue_to_native(args[0], &temp1, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg1 = &temp1;
+    
+    
+    ok &= sevalue_to_native(args[1], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    result = cc::gi::SH::projectProbes((ccstd::vector< cc::Vec3 > const &)*arg1,(ccstd::vector< cc::Vec3 > const &)*arg2);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject() /*ctx*/);
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+    
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_gi_SH_projectProbes_static) 
+
+static bool js_new_cc_gi_SH(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::gi::SH *result;
+    result = (cc::gi::SH *)new cc::gi::SH();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_gi_SH, __jsb_cc_gi_SH_class, js_delete_cc_gi_SH)
+
+static bool js_delete_cc_gi_SH(se::State& s)
+{
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_gi_SH) 
+
+bool js_register_cc_gi_SH(se::Object* obj) {
+    auto* cls = se::Class::create("SH", obj, nullptr, _SE(js_new_cc_gi_SH)); 
+    
+    
+    
+    
+    cls->defineStaticFunction("project", _SE(js_cc_gi_SH_project_static)); 
+    cls->defineStaticFunction("projectProbes", _SE(js_cc_gi_SH_projectProbes_static)); 
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_gi_SH));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::gi::SH>(cls);
+    
+    __jsb_cc_gi_SH_proto = cls->getProto();
+    __jsb_cc_gi_SH_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+
 
 
 bool register_all_gi(se::Object* obj) {
@@ -3288,6 +3411,7 @@ bool register_all_gi(se::Object* obj) {
     js_register_cc_gi_LightProbesData(ns); 
     js_register_cc_gi_LightProbes(ns); 
     js_register_cc_gi_LightProbeInfo(ns); 
+    js_register_cc_gi_SH(ns); 
     
     /* Register global variables & global functions */
     
@@ -38,6 +38,7 @@
 #include "bindings/manual/jsb_conversions.h"
 #include "gi/light-probe/Delaunay.h"
 #include "gi/light-probe/LightProbe.h"
+#include "gi/light-probe/SH.h"
 
 
 
@@ -90,4 +91,9 @@ JSB_REGISTER_OBJECT_TYPE(cc::gi::LightProbeInfo);
 extern se::Object *__jsb_cc_gi_LightProbeInfo_proto; // NOLINT
 extern se::Class * __jsb_cc_gi_LightProbeInfo_class; // NOLINT
 
+
+JSB_REGISTER_OBJECT_TYPE(cc::gi::SH);
+extern se::Object *__jsb_cc_gi_SH_proto; // NOLINT
+extern se::Class * __jsb_cc_gi_SH_class; // NOLINT
+
 // clang-format on
@@ -142,6 +142,55 @@ static bool js_cc_physics_World_setAllowSleep(se::State& s)
 }
 SE_BIND_FUNC(js_cc_physics_World_setAllowSleep) 
 
+static bool js_cc_physics_World_setSimulationWorkerCount(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::physics::World *arg1 = (cc::physics::World *) NULL ;
+    uint32_t arg2 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::physics::World>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    (arg1)->setSimulationWorkerCount(arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_physics_World_setSimulationWorkerCount) 
+
+static bool js_cc_physics_World_setSplitSimulation(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::physics::World *arg1 = (cc::physics::World *) NULL ;
+    bool arg2 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::physics::World>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    (arg1)->setSplitSimulation(arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_physics_World_setSplitSimulation) 
+
 static bool js_cc_physics_World_step(se::State& s)
 {
     CC_UNUSED bool ok = true;
@@ -416,6 +465,54 @@ static bool js_cc_physics_World_raycastClosestResult(se::State& s)
 }
 SE_BIND_FUNC(js_cc_physics_World_raycastClosestResult) 
 
+static bool js_cc_physics_World_sceneQueryBatch(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::physics::World *arg1 = (cc::physics::World *) NULL ;
+    cc::Float32Array *arg2 = 0 ;
+    uint32_t arg3 ;
+    cc::Float32Array *arg4 = 0 ;
+    cc::Uint32Array *arg5 = 0 ;
+    cc::Float32Array temp2 ;
+    cc::Float32Array temp4 ;
+    cc::Uint32Array temp5 ;
+    uint32_t result;
+    
+    if(argc != 4) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 4);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::physics::World>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    
+    ok &= sevalue_to_native(args[1], &arg3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    ok &= sevalue_to_native(args[2], &temp4, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg4 = &temp4;
+    
+    
+    ok &= sevalue_to_native(args[3], &temp5, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg5 = &temp5;
+    
+    result = (arg1)->sceneQueryBatch((cc::Float32Array const &)*arg2,arg3,*arg4,*arg5);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject()); 
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_physics_World_sceneQueryBatch) 
+
 static bool js_cc_physics_World_createConvex(se::State& s)
 {
     CC_UNUSED bool ok = true;
@@ -582,6 +679,8 @@ bool js_register_cc_physics_World(se::Object* obj) {
     
     cls->defineFunction("setGravity", _SE(js_cc_physics_World_setGravity)); 
     cls->defineFunction("setAllowSleep", _SE(js_cc_physics_World_setAllowSleep)); 
+    cls->defineFunction("setSimulationWorkerCount", _SE(js_cc_physics_World_setSimulationWorkerCount)); 
+    cls->defineFunction("setSplitSimulation", _SE(js_cc_physics_World_setSplitSimulation)); 
     cls->defineFunction("step", _SE(js_cc_physics_World_step)); 
     cls->defineFunction("emitEvents", _SE(js_cc_physics_World_emitEvents)); 
     cls->defineFunction("syncSceneToPhysics", _SE(js_cc_physics_World_syncSceneToPhysics)); 
@@ -593,6 +692,7 @@ bool js_register_cc_physics_World(se::Object* obj) {
     cls->defineFunction("raycastClosest", _SE(js_cc_physics_World_raycastClosest)); 
     cls->defineFunction("raycastResult", _SE(js_cc_physics_World_raycastResult)); 
     cls->defineFunction("raycastClosestResult", _SE(js_cc_physics_World_raycastClosestResult)); 
+    cls->defineFunction("sceneQueryBatch", _SE(js_cc_physics_World_sceneQueryBatch)); 
     cls->defineFunction("createConvex", _SE(js_cc_physics_World_createConvex)); 
     cls->defineFunction("createTrimesh", _SE(js_cc_physics_World_createTrimesh)); 
     cls->defineFunction("createHeightField", _SE(js_cc_physics_World_createHeightField)); 
@@ -122,6 +122,22 @@ using namespace cc;
 #define cc_pipeline_PipelineSceneData_lightProbes_get(self_) self_->getLightProbes()
   
 
+#define cc_pipeline_PipelineSceneData_softwareOcclusionCulling_get(self_) self_->getSoftwareOcclusionCulling()
+  
+
+#define cc_pipeline_SoftwareOcclusionCulling_enabled_get(self_) self_->isEnabled()
+#define cc_pipeline_SoftwareOcclusionCulling_enabled_set(self_, val_) self_->setEnabled(val_)
+  
+
+#define cc_pipeline_SoftwareOcclusionCulling_width_get(self_) self_->getWidth()
+  
+
+#define cc_pipeline_SoftwareOcclusionCulling_height_get(self_) self_->getHeight()
+  
+
+#define cc_pipeline_SoftwareOcclusionCulling_occluderCount_get(self_) self_->getOccluderCount()
+  
+
 #define cc_pipeline_BloomStage_threshold_get(self_) self_->getThreshold()
 #define cc_pipeline_BloomStage_threshold_set(self_, val_) self_->setThreshold(val_)
   
@@ -11915,7 +11931,7 @@ static bool js_cc_pipeline_InstancedBuffer_uploadBuffers(se::State& s)
     
     ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
     SE_PRECONDITION2(ok, false, "Error processing arguments"); 
-    ((cc::pipeline::InstancedBuffer const *)arg1)->uploadBuffers(arg2);
+    (arg1)->uploadBuffers(arg2);
     
     
     return true;
@@ -12070,6 +12086,88 @@ static bool js_cc_pipeline_InstancedBuffer_dynamicOffsets(se::State& s)
 }
 SE_BIND_FUNC(js_cc_pipeline_InstancedBuffer_dynamicOffsets) 
 
+static bool js_cc_pipeline_InstancedBuffer_setPersistentModeEnabled_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    bool arg1 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    
+    ok &= sevalue_to_native(args[0], &arg1, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc::pipeline::InstancedBuffer::setPersistentModeEnabled(arg1);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_InstancedBuffer_setPersistentModeEnabled_static) 
+
+static bool js_cc_pipeline_InstancedBuffer_isPersistentModeEnabled_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    bool result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    result = (bool)cc::pipeline::InstancedBuffer::isPersistentModeEnabled();
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_InstancedBuffer_isPersistentModeEnabled_static) 
+
+static bool js_cc_pipeline_InstancedBuffer_setIndirectModeEnabled_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    bool arg1 ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    
+    ok &= sevalue_to_native(args[0], &arg1, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc::pipeline::InstancedBuffer::setIndirectModeEnabled(arg1);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_InstancedBuffer_setIndirectModeEnabled_static) 
+
+static bool js_cc_pipeline_InstancedBuffer_isIndirectModeEnabled_static(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    bool result;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    result = (bool)cc::pipeline::InstancedBuffer::isIndirectModeEnabled();
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_InstancedBuffer_isIndirectModeEnabled_static) 
+
 bool js_register_cc_pipeline_InstancedBuffer(se::Object* obj) {
     auto* cls = se::Class::create("InstancedBuffer", obj, nullptr, _SE(js_new_cc_pipeline_InstancedBuffer)); 
     
@@ -12087,6 +12185,11 @@ bool js_register_cc_pipeline_InstancedBuffer(se::Object* obj) {
     cls->defineStaticProperty("INITIAL_CAPACITY", nullptr, nullptr); 
     cls->defineStaticProperty("MAX_CAPACITY", nullptr, nullptr); 
     
+    cls->defineStaticFunction("setPersistentModeEnabled", _SE(js_cc_pipeline_InstancedBuffer_setPersistentModeEnabled_static)); 
+    cls->defineStaticFunction("isPersistentModeEnabled", _SE(js_cc_pipeline_InstancedBuffer_isPersistentModeEnabled_static)); 
+    cls->defineStaticFunction("setIndirectModeEnabled", _SE(js_cc_pipeline_InstancedBuffer_setIndirectModeEnabled_static)); 
+    cls->defineStaticFunction("isIndirectModeEnabled", _SE(js_cc_pipeline_InstancedBuffer_isIndirectModeEnabled_static)); 
+    
     
     
     cls->defineFinalizeFunction(_SE(js_delete_cc_pipeline_InstancedBuffer));
@@ -13130,6 +13233,247 @@ bool js_register_cc_pipeline_PostProcessStage(se::Object* obj) {
 }
 
 
+se::Class* __jsb_cc_pipeline_SoftwareOcclusionCulling_class = nullptr;
+se::Object* __jsb_cc_pipeline_SoftwareOcclusionCulling_proto = nullptr;
+SE_DECLARE_FINALIZE_FUNC(js_delete_cc_pipeline_SoftwareOcclusionCulling) 
+
+static bool js_new_cc_pipeline_SoftwareOcclusionCulling(se::State& s) // NOLINT(readability-identifier-naming)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    cc::pipeline::SoftwareOcclusionCulling *result;
+    result = (cc::pipeline::SoftwareOcclusionCulling *)new cc::pipeline::SoftwareOcclusionCulling();
+    
+    
+    auto *ptr = JSB_MAKE_PRIVATE_OBJECT_WITH_INSTANCE(result);
+    s.thisObject()->setPrivateObject(ptr);
+    return true;
+}
+SE_BIND_CTOR(js_new_cc_pipeline_SoftwareOcclusionCulling, __jsb_cc_pipeline_SoftwareOcclusionCulling_class, js_delete_cc_pipeline_SoftwareOcclusionCulling)
+
+static bool js_delete_cc_pipeline_SoftwareOcclusionCulling(se::State& s)
+{
+    return true;
+}
+SE_BIND_FINALIZE_FUNC(js_delete_cc_pipeline_SoftwareOcclusionCulling) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_setResolution(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    uint32_t arg2 ;
+    uint32_t arg3 ;
+    
+    if(argc != 2) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    
+    ok &= sevalue_to_native(args[1], &arg3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    (arg1)->setResolution(arg2,arg3);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_SoftwareOcclusionCulling_setResolution) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_addOccluder(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    cc::scene::Model *arg2 = (cc::scene::Model *) NULL ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    (arg1)->addOccluder(arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_SoftwareOcclusionCulling_addOccluder) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_removeOccluder(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    cc::scene::Model *arg2 = (cc::scene::Model *) NULL ;
+    
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    (arg1)->removeOccluder((cc::scene::Model const *)arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_SoftwareOcclusionCulling_removeOccluder) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_clearOccluders(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    (arg1)->clearOccluders();
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_pipeline_SoftwareOcclusionCulling_clearOccluders) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_enabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc_pipeline_SoftwareOcclusionCulling_enabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_pipeline_SoftwareOcclusionCulling_enabled_set) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_enabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    result = (bool)cc_pipeline_SoftwareOcclusionCulling_enabled_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_pipeline_SoftwareOcclusionCulling_enabled_get) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_width_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    uint32_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    result = (uint32_t)cc_pipeline_SoftwareOcclusionCulling_width_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_pipeline_SoftwareOcclusionCulling_width_get) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_height_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    uint32_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    result = (uint32_t)cc_pipeline_SoftwareOcclusionCulling_height_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_pipeline_SoftwareOcclusionCulling_height_get) 
+
+static bool js_cc_pipeline_SoftwareOcclusionCulling_occluderCount_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::pipeline::SoftwareOcclusionCulling *arg1 = (cc::pipeline::SoftwareOcclusionCulling *) NULL ;
+    size_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::SoftwareOcclusionCulling>(s);
+    if (nullptr == arg1) return true;
+    result = (size_t)cc_pipeline_SoftwareOcclusionCulling_occluderCount_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_pipeline_SoftwareOcclusionCulling_occluderCount_get) 
+
+bool js_register_cc_pipeline_SoftwareOcclusionCulling(se::Object* obj) {
+    auto* cls = se::Class::create("SoftwareOcclusionCulling", obj, nullptr, _SE(js_new_cc_pipeline_SoftwareOcclusionCulling)); 
+    
+    cls->defineProperty("enabled", _SE(js_cc_pipeline_SoftwareOcclusionCulling_enabled_get), _SE(js_cc_pipeline_SoftwareOcclusionCulling_enabled_set)); 
+    cls->defineProperty("width", _SE(js_cc_pipeline_SoftwareOcclusionCulling_width_get), nullptr); 
+    cls->defineProperty("height", _SE(js_cc_pipeline_SoftwareOcclusionCulling_height_get), nullptr); 
+    cls->defineProperty("occluderCount", _SE(js_cc_pipeline_SoftwareOcclusionCulling_occluderCount_get), nullptr); 
+    
+    cls->defineFunction("setResolution", _SE(js_cc_pipeline_SoftwareOcclusionCulling_setResolution)); 
+    cls->defineFunction("addOccluder", _SE(js_cc_pipeline_SoftwareOcclusionCulling_addOccluder)); 
+    cls->defineFunction("removeOccluder", _SE(js_cc_pipeline_SoftwareOcclusionCulling_removeOccluder)); 
+    cls->defineFunction("clearOccluders", _SE(js_cc_pipeline_SoftwareOcclusionCulling_clearOccluders)); 
+    
+    
+    
+    
+    cls->defineFinalizeFunction(_SE(js_delete_cc_pipeline_SoftwareOcclusionCulling));
+    
+    
+    cls->install();
+    JSBClassType::registerClass<cc::pipeline::SoftwareOcclusionCulling>(cls);
+    
+    __jsb_cc_pipeline_SoftwareOcclusionCulling_proto = cls->getProto();
+    __jsb_cc_pipeline_SoftwareOcclusionCulling_class = cls;
+    se::ScriptEngine::getInstance()->clearException();
+    return true;
+}
+
+
 se::Class* __jsb_cc_pipeline_PipelineSceneData_class = nullptr;
 se::Object* __jsb_cc_pipeline_PipelineSceneData_proto = nullptr;
 SE_DECLARE_FINALIZE_FUNC(js_delete_cc_pipeline_PipelineSceneData) 
@@ -13758,6 +14102,25 @@ static bool js_cc_pipeline_PipelineSceneData_lightProbes_get(se::State& s)
 }
 SE_BIND_PROP_GET(js_cc_pipeline_PipelineSceneData_lightProbes_get) 
 
+static bool js_cc_pipeline_PipelineSceneData_softwareOcclusionCulling_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::pipeline::PipelineSceneData *arg1 = (cc::pipeline::PipelineSceneData *) NULL ;
+    cc::pipeline::SoftwareOcclusionCulling *result = 0 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::pipeline::PipelineSceneData>(s);
+    if (nullptr == arg1) return true;
+    result = (cc::pipeline::SoftwareOcclusionCulling *)cc_pipeline_PipelineSceneData_softwareOcclusionCulling_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval()); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_pipeline_PipelineSceneData_softwareOcclusionCulling_get) 
+
 bool js_register_cc_pipeline_PipelineSceneData(se::Object* obj) {
     auto* cls = se::Class::create("PipelineSceneData", obj, nullptr, _SE(js_new_cc_pipeline_PipelineSceneData)); 
     
@@ -13768,6 +14131,7 @@ bool js_register_cc_pipeline_PipelineSceneData(se::Object* obj) {
     cls->defineProperty("skybox", _SE(js_cc_pipeline_PipelineSceneData_skybox_get), nullptr); 
     cls->defineProperty("shadows", _SE(js_cc_pipeline_PipelineSceneData_shadows_get), nullptr); 
     cls->defineProperty("lightProbes", _SE(js_cc_pipeline_PipelineSceneData_lightProbes_get), nullptr); 
+    cls->defineProperty("softwareOcclusionCulling", _SE(js_cc_pipeline_PipelineSceneData_softwareOcclusionCulling_get), nullptr); 
     
     cls->defineFunction("activate", _SE(js_cc_pipeline_PipelineSceneData_activate)); 
     cls->defineFunction("destroy", _SE(js_cc_pipeline_PipelineSceneData_destroy)); 
@@ -20917,6 +21281,7 @@ bool register_all_pipeline(se::Object* obj) {
     js_register_cc_pipeline_LightingStage(ns); 
     js_register_cc_pipeline_BloomStage(ns); 
     js_register_cc_pipeline_PostProcessStage(ns); 
+    js_register_cc_pipeline_SoftwareOcclusionCulling(ns); 
     js_register_cc_pipeline_PipelineSceneData(ns); 
     js_register_cc_pipeline_BatchedItem(ns); 
     js_register_cc_pipeline_BatchedBuffer(ns); 
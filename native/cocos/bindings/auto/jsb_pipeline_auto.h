@@ -50,6 +50,7 @@
 #include "renderer/pipeline/deferred/LightingStage.h"
 #include "renderer/pipeline/deferred/BloomStage.h"
 #include "renderer/pipeline/deferred/PostProcessStage.h"
+#include "renderer/pipeline/SoftwareOcclusionCulling.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/BatchedBuffer.h"
 #include "renderer/pipeline/GeometryRenderer.h"
@@ -573,6 +574,11 @@ extern se::Object *__jsb_cc_pipeline_PostProcessStage_proto; // NOLINT
 extern se::Class * __jsb_cc_pipeline_PostProcessStage_class; // NOLINT
 
 
+JSB_REGISTER_OBJECT_TYPE(cc::pipeline::SoftwareOcclusionCulling);
+extern se::Object *__jsb_cc_pipeline_SoftwareOcclusionCulling_proto; // NOLINT
+extern se::Class * __jsb_cc_pipeline_SoftwareOcclusionCulling_class; // NOLINT
+
+
 JSB_REGISTER_OBJECT_TYPE(cc::pipeline::PipelineSceneData);
 extern se::Object *__jsb_cc_pipeline_PipelineSceneData_proto; // NOLINT
 extern se::Class * __jsb_cc_pipeline_PipelineSceneData_class; // NOLINT
@@ -124,6 +124,10 @@ using namespace cc;
 #define cc_Root_cameraList_get(self_) self_->getCameraList()
   
 
+#define cc_Root_localUBOPoolEnabled_get(self_) self_->isLocalUBOPoolEnabled()
+#define cc_Root_localUBOPoolEnabled_set(self_, val_) self_->setLocalUBOPoolEnabled(val_)
+  
+
 #define cc_scene_RenderWindow_width_get(self_) self_->getWidth()
   
 
@@ -1052,6 +1056,10 @@ using namespace cc;
 #define cc_scene_OctreeInfo_depth_set(self_, val_) self_->setDepth(val_)
   
 
+#define cc_scene_OctreeInfo_looseness_get(self_) self_->getLooseness()
+#define cc_scene_OctreeInfo_looseness_set(self_, val_) self_->setLooseness(val_)
+  
+
 #define cc_Scene_autoReleaseAssets_get(self_) self_->isAutoReleaseAssets()
 #define cc_Scene_autoReleaseAssets_set(self_, val_) self_->setAutoReleaseAssets(val_)
   
@@ -1080,6 +1088,14 @@ using namespace cc;
 #define cc_scene_ReflectionProbe_size_set(self_, val_) self_->setBoudingSize(val_)
   
 
+#define cc_ProgramLib_asyncCompileEnabled_get(self_) self_->isAsyncCompileEnabled()
+#define cc_ProgramLib_asyncCompileEnabled_set(self_, val_) self_->setAsyncCompileEnabled(val_)
+  
+
+#define cc_ProgramLib_asyncCompileLimit_get(self_) self_->getAsyncCompileLimit()
+#define cc_ProgramLib_asyncCompileLimit_set(self_, val_) self_->setAsyncCompileLimit(val_)
+  
+
 
 static bool js_cc_hasFlag__SWIG_1(se::State& s)
 {
@@ -6045,6 +6061,43 @@ static bool js_cc_Root_cameraList_get(se::State& s)
 }
 SE_BIND_PROP_GET(js_cc_Root_cameraList_get) 
 
+static bool js_cc_Root_localUBOPoolEnabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::Root *arg1 = (cc::Root *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::Root>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc_Root_localUBOPoolEnabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_Root_localUBOPoolEnabled_set) 
+
+static bool js_cc_Root_localUBOPoolEnabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::Root *arg1 = (cc::Root *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::Root>(s);
+    if (nullptr == arg1) return true;
+    result = (bool)cc_Root_localUBOPoolEnabled_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_Root_localUBOPoolEnabled_get) 
+
 bool js_register_cc_Root(se::Object* obj) {
     auto* cls = se::Class::create("Root", obj, nullptr, _SE(js_new_cc_Root)); 
     
@@ -6065,6 +6118,7 @@ bool js_register_cc_Root(se::Object* obj) {
     cls->defineProperty("pipeline", _SE(js_cc_Root_pipeline_get), nullptr); 
     cls->defineProperty("customPipeline", _SE(js_cc_Root_customPipeline_get), nullptr); 
     cls->defineProperty("cameraList", _SE(js_cc_Root_cameraList_get), nullptr); 
+    cls->defineProperty("localUBOPoolEnabled", _SE(js_cc_Root_localUBOPoolEnabled_get), _SE(js_cc_Root_localUBOPoolEnabled_set)); 
     
     cls->defineFunction("_initialize", _SE(js_cc_Root__initialize)); 
     cls->defineFunction("destroy", _SE(js_cc_Root_destroy)); 
@@ -19315,24 +19369,90 @@ static bool js_cc_scene_RenderScene_removeModel(se::State& s)
 }
 SE_BIND_FUNC(js_cc_scene_RenderScene_removeModel) 
 
-static bool js_cc_scene_RenderScene_removeModels(se::State& s)
+static bool js_cc_scene_RenderScene_removeModels__SWIG_0(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    cc::scene::RenderScene *arg1 = (cc::scene::RenderScene *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::RenderScene>(s);
+    if (nullptr == arg1) return true;
+    (arg1)->removeModels();
+    
+    
+    return true;
+}
+
+static bool js_cc_scene_RenderScene_addModels(se::State& s)
 {
     CC_UNUSED bool ok = true;
     const auto& args = s.args();
     size_t argc = args.size();
     cc::scene::RenderScene *arg1 = (cc::scene::RenderScene *) NULL ;
+    ccstd::vector< cc::scene::Model * > *arg2 = 0 ;
+    ccstd::vector< cc::scene::Model * > temp2 ;
     
-    if(argc != 0) {
-        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+    if(argc != 1) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
         return false;
     }
     arg1 = SE_THIS_OBJECT<cc::scene::RenderScene>(s);
     if (nullptr == arg1) return true;
-    (arg1)->removeModels();
+    
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    (arg1)->addModels((ccstd::vector< cc::scene::Model * > const &)*arg2);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_scene_RenderScene_addModels) 
+
+static bool js_cc_scene_RenderScene_removeModels__SWIG_1(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    cc::scene::RenderScene *arg1 = (cc::scene::RenderScene *) NULL ;
+    ccstd::vector< cc::scene::Model * > *arg2 = 0 ;
+    ccstd::vector< cc::scene::Model * > temp2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::RenderScene>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    (arg1)->removeModels((ccstd::vector< cc::scene::Model * > const &)*arg2);
     
     
     return true;
 }
+
+static bool js_cc_scene_RenderScene_removeModels(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    
+    
+    if (argc == 0) {
+        ok = js_cc_scene_RenderScene_removeModels__SWIG_0(s);
+        if (ok) {
+            return true; 
+        }
+    } 
+    if (argc == 1) {
+        ok = js_cc_scene_RenderScene_removeModels__SWIG_1(s);
+        if (ok) {
+            return true; 
+        }
+    } 
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
 SE_BIND_FUNC(js_cc_scene_RenderScene_removeModels) 
 
 static bool js_cc_scene_RenderScene_onGlobalPipelineStateChanged(se::State& s)
@@ -19620,6 +19740,7 @@ bool js_register_cc_scene_RenderScene(se::Object* obj) {
     cls->defineFunction("removeSpotLights", _SE(js_cc_scene_RenderScene_removeSpotLights)); 
     cls->defineFunction("addModel", _SE(js_cc_scene_RenderScene_addModel)); 
     cls->defineFunction("removeModel", _SE(js_cc_scene_RenderScene_removeModel)); 
+    cls->defineFunction("addModels", _SE(js_cc_scene_RenderScene_addModels)); 
     cls->defineFunction("removeModels", _SE(js_cc_scene_RenderScene_removeModels)); 
     cls->defineFunction("onGlobalPipelineStateChanged", _SE(js_cc_scene_RenderScene_onGlobalPipelineStateChanged)); 
     cls->defineFunction("getMainLight", _SE(js_cc_scene_RenderScene_getMainLight)); 
@@ -26270,9 +26391,136 @@ static bool js_cc_ProgramLib_getGFXShader(se::State& s)
 }
 SE_BIND_FUNC(js_cc_ProgramLib_getGFXShader) 
 
+static bool js_cc_ProgramLib_compileQueuedShaders(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    
+    if(argc != 0) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 0);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    (arg1)->compileQueuedShaders();
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_compileQueuedShaders) 
+
+static bool js_cc_ProgramLib_setFallbackShader(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    ccstd::string *arg2 = 0 ;
+    cc::gfx::Shader *arg3 = (cc::gfx::Shader *) NULL ;
+    ccstd::string temp2 ;
+    
+    if(argc != 2) {
+        SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+        return false;
+    }
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &temp2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    arg2 = &temp2;
+    
+    
+    ok &= sevalue_to_native(args[1], &arg3, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    (arg1)->setFallbackShader((ccstd::string const &)*arg2,arg3);
+    
+    
+    return true;
+}
+SE_BIND_FUNC(js_cc_ProgramLib_setFallbackShader) 
+
+static bool js_cc_ProgramLib_asyncCompileEnabled_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    bool arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2);
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc_ProgramLib_asyncCompileEnabled_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_ProgramLib_asyncCompileEnabled_set) 
+
+static bool js_cc_ProgramLib_asyncCompileEnabled_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    bool result;
+    
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    result = (bool)cc_ProgramLib_asyncCompileEnabled_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_ProgramLib_asyncCompileEnabled_get) 
+
+static bool js_cc_ProgramLib_asyncCompileLimit_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    uint32_t arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments"); 
+    cc_ProgramLib_asyncCompileLimit_set(arg1,arg2);
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_ProgramLib_asyncCompileLimit_set) 
+
+static bool js_cc_ProgramLib_asyncCompileLimit_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::ProgramLib *arg1 = (cc::ProgramLib *) NULL ;
+    uint32_t result;
+    
+    arg1 = SE_THIS_OBJECT<cc::ProgramLib>(s);
+    if (nullptr == arg1) return true;
+    result = (uint32_t)cc_ProgramLib_asyncCompileLimit_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject());
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_ProgramLib_asyncCompileLimit_get) 
+
 bool js_register_cc_ProgramLib(se::Object* obj) {
     auto* cls = se::Class::create("ProgramLib", obj, nullptr, _SE(js_new_cc_ProgramLib)); 
     
+    cls->defineProperty("asyncCompileEnabled", _SE(js_cc_ProgramLib_asyncCompileEnabled_get), _SE(js_cc_ProgramLib_asyncCompileEnabled_set)); 
+    cls->defineProperty("asyncCompileLimit", _SE(js_cc_ProgramLib_asyncCompileLimit_get), _SE(js_cc_ProgramLib_asyncCompileLimit_set)); 
     
     cls->defineFunction("register", _SE(js_cc_ProgramLib_cpp_keyword_register)); 
     cls->defineFunction("define", _SE(js_cc_ProgramLib_define)); 
@@ -26283,6 +26531,8 @@ bool js_register_cc_ProgramLib(se::Object* obj) {
     cls->defineFunction("getKey", _SE(js_cc_ProgramLib_getKey)); 
     cls->defineFunction("destroyShaderByDefines", _SE(js_cc_ProgramLib_destroyShaderByDefines)); 
     cls->defineFunction("getGFXShader", _SE(js_cc_ProgramLib_getGFXShader)); 
+    cls->defineFunction("compileQueuedShaders", _SE(js_cc_ProgramLib_compileQueuedShaders)); 
+    cls->defineFunction("setFallbackShader", _SE(js_cc_ProgramLib_setFallbackShader)); 
     
     
     cls->defineStaticFunction("getInstance", _SE(js_cc_ProgramLib_getInstance_static)); 
@@ -26492,6 +26742,40 @@ static bool js_cc_scene_OctreeInfo__depth_get(se::State& s)
 }
 SE_BIND_PROP_GET(js_cc_scene_OctreeInfo__depth_get) 
 
+static bool js_cc_scene_OctreeInfo__looseness_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::scene::OctreeInfo *arg1 = (cc::scene::OctreeInfo *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::OctreeInfo>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg1->_looseness, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_scene_OctreeInfo__looseness_set) 
+
+static bool js_cc_scene_OctreeInfo__looseness_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::scene::OctreeInfo *arg1 = (cc::scene::OctreeInfo *) NULL ;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::OctreeInfo>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= nativevalue_to_se(arg1->_looseness, s.rval(), s.thisObject()); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_scene_OctreeInfo__looseness_get) 
+
 static bool js_cc_scene_OctreeInfo_enabled_set(se::State& s)
 {
     CC_UNUSED bool ok = true;
@@ -26651,6 +26935,44 @@ static bool js_cc_scene_OctreeInfo_depth_get(se::State& s)
 }
 SE_BIND_PROP_GET(js_cc_scene_OctreeInfo_depth_get) 
 
+static bool js_cc_scene_OctreeInfo_looseness_set(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    const auto& args = s.args();
+    size_t argc = args.size();
+    cc::scene::OctreeInfo *arg1 = (cc::scene::OctreeInfo *) NULL ;
+    float arg2 ;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::OctreeInfo>(s);
+    if (nullptr == arg1) return true;
+    
+    ok &= sevalue_to_native(args[0], &arg2, s.thisObject());
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    
+    cc_scene_OctreeInfo_looseness_set(arg1,SWIG_STD_MOVE(arg2));
+    
+    
+    return true;
+}
+SE_BIND_PROP_SET(js_cc_scene_OctreeInfo_looseness_set) 
+
+static bool js_cc_scene_OctreeInfo_looseness_get(se::State& s)
+{
+    CC_UNUSED bool ok = true;
+    cc::scene::OctreeInfo *arg1 = (cc::scene::OctreeInfo *) NULL ;
+    float result;
+    
+    arg1 = SE_THIS_OBJECT<cc::scene::OctreeInfo>(s);
+    if (nullptr == arg1) return true;
+    result = cc_scene_OctreeInfo_looseness_get(arg1);
+    
+    ok &= nativevalue_to_se(result, s.rval(), s.thisObject()); 
+    
+    
+    return true;
+}
+SE_BIND_PROP_GET(js_cc_scene_OctreeInfo_looseness_get) 
+
 bool js_register_cc_scene_OctreeInfo(se::Object* obj) {
     auto* cls = se::Class::create("OctreeInfo", obj, nullptr, _SE(js_new_cc_scene_OctreeInfo)); 
     
@@ -26658,10 +26980,12 @@ bool js_register_cc_scene_OctreeInfo(se::Object* obj) {
     cls->defineProperty("_minPos", _SE(js_cc_scene_OctreeInfo__minPos_get), _SE(js_cc_scene_OctreeInfo__minPos_set)); 
     cls->defineProperty("_maxPos", _SE(js_cc_scene_OctreeInfo__maxPos_get), _SE(js_cc_scene_OctreeInfo__maxPos_set)); 
     cls->defineProperty("_depth", _SE(js_cc_scene_OctreeInfo__depth_get), _SE(js_cc_scene_OctreeInfo__depth_set)); 
+    cls->defineProperty("_looseness", _SE(js_cc_scene_OctreeInfo__looseness_get), _SE(js_cc_scene_OctreeInfo__looseness_set)); 
     cls->defineProperty("enabled", _SE(js_cc_scene_OctreeInfo_enabled_get), _SE(js_cc_scene_OctreeInfo_enabled_set)); 
     cls->defineProperty("minPos", _SE(js_cc_scene_OctreeInfo_minPos_get), _SE(js_cc_scene_OctreeInfo_minPos_set)); 
     cls->defineProperty("maxPos", _SE(js_cc_scene_OctreeInfo_maxPos_get), _SE(js_cc_scene_OctreeInfo_maxPos_set)); 
     cls->defineProperty("depth", _SE(js_cc_scene_OctreeInfo_depth_get), _SE(js_cc_scene_OctreeInfo_depth_set)); 
+    cls->defineProperty("looseness", _SE(js_cc_scene_OctreeInfo_looseness_get), _SE(js_cc_scene_OctreeInfo_looseness_set)); 
     
     cls->defineFunction("activate", _SE(js_cc_scene_OctreeInfo_activate)); 
     
@@ -32,17 +32,20 @@
 #include "platform/interfaces/modules/ISystemWindowManager.h"
 #include "platform/java/modules/XRInterface.h"
 #include "profiler/Profiler.h"
+#include "renderer/core/ProgramLib.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/gfx-base/GFXSwapchain.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
 #include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/StaticMeshPool.h"
 #include "renderer/pipeline/custom/NativePipelineTypes.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "renderer/pipeline/deferred/DeferredPipeline.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
+#include "scene/LocalUBOPool.h"
 #include "scene/SpotLight.h"
 #include "engine/EngineEvents.h"
 
@@ -151,6 +154,8 @@ void Root::destroy() {
     _pipelineRuntime.reset();
 
     CC_SAFE_DESTROY_NULL(_pipeline);
+    scene::LocalUBOPool::getInstance()->destroy();
+    pipeline::StaticMeshPool::getInstance()->destroy();
 
     CC_SAFE_DELETE(_batcher);
 
@@ -163,6 +168,14 @@ void Root::destroy() {
     //    this.dataPoolManager.clear();
 }
 
+void Root::setLocalUBOPoolEnabled(bool enabled) {
+    scene::LocalUBOPool::getInstance()->setEnabled(enabled);
+}
+
+bool Root::isLocalUBOPoolEnabled() const {
+    return scene::LocalUBOPool::getInstance()->isEnabled();
+}
+
 void Root::resize(uint32_t width, uint32_t height, uint32_t windowId) {
     for (const auto &window : _renderWindows) {
         auto *swapchain = window->getSwapchain();
@@ -386,6 +399,9 @@ void Root::frameMoveProcess(bool isNeedUpdateScene, int32_t totalFrames) {
             _batcher->uploadBuffers();
         }
 
+        // swap in the shader variants compiled since the last frame before the scenes are updated
+        ProgramLib::getInstance()->compileQueuedShaders();
+
         if (isNeedUpdateScene) {
             for (const auto &scene : _scenes) {
                 scene->update(stamp);
@@ -412,6 +428,8 @@ void Root::frameMoveEnd() {
         }
     #endif
         emit<BeforeRender>();
+        scene::LocalUBOPool::getInstance()->update();
+        pipeline::StaticMeshPool::getInstance()->flush();
         _pipelineRuntime->render(_cameraList);
 #endif
         _device->present();
@@ -293,6 +293,13 @@ public:
 
     inline bool isUsingDeferredPipeline() const { return _useDeferredPipeline; }
 
+    /**
+     * @zh
+     * 模型是否共享每帧统一上传的局部 UBO 池，仅对之后初始化的模型生效
+     */
+    void setLocalUBOPoolEnabled(bool enabled);
+    bool isLocalUBOPoolEnabled() const;
+
     scene::RenderWindow *createRenderWindowFromSystemWindow(uint32_t windowId);
     scene::RenderWindow *createRenderWindowFromSystemWindow(cc::ISystemWindow *window);
 
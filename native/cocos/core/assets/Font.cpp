@@ -30,6 +30,7 @@
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/hash/hash.h"
 #include "gfx-base/GFXTexture.h"
 #include "math/Math.h"
@@ -106,9 +107,22 @@ void Font::load(const ccstd::string &path) {
     CC_PROFILE_MEMORY_INC(Font, _data.size());
 }
 
+float Font::getFaceScale(uint32_t fontSize) const {
+    auto iter = _faces.find(fontSize);
+    if (iter == _faces.end() || !iter->second) {
+        return 1.0F;
+    }
+
+    return static_cast<float>(fontSize) / static_cast<float>(iter->second->getFontSize());
+}
+
 void Font::releaseFaces() {
+    // several font sizes may share one face, e.g. the freetype SDF face
+    ccstd::unordered_set<FontFace *> faces;
     for (auto &iter : _faces) {
-        delete iter.second;
+        if (faces.insert(iter.second).second) {
+            delete iter.second;
+        }
     }
 
     _faces.clear();
@@ -39,6 +39,13 @@ class Font;
 constexpr uint32_t DEFAULT_FREETYPE_TEXTURE_SIZE = 512U;
 constexpr uint32_t MIN_FONT_SIZE = 1U;
 constexpr uint32_t MAX_FONT_SIZE = 128U;
+// 0 leaves the atlas of a face unbounded, SDF faces default to SDF_MAX_TEXTURES
+constexpr uint32_t DEFAULT_FREETYPE_MAX_TEXTURES = 0U;
+// signed distance field glyphs are rasterized once at SDF_FONT_SIZE and scaled to any font size,
+// SDF_SPREAD is the distance range in pixels encoded around the outline, the outline itself is at 0.5.
+constexpr uint32_t SDF_FONT_SIZE = 32U;
+constexpr uint32_t SDF_SPREAD = 4U;
+constexpr uint32_t SDF_MAX_TEXTURES = 4U;
 
 enum class FontType {
     INVALID,
@@ -87,6 +94,11 @@ struct FontFaceInfo {
     uint32_t textureWidth{DEFAULT_FREETYPE_TEXTURE_SIZE};
     uint32_t textureHeight{DEFAULT_FREETYPE_TEXTURE_SIZE};
     ccstd::vector<uint32_t> preLoadedCharacters;
+    // only used in freetype, rasterize signed distance fields shared by all font sizes.
+    bool sdf{false};
+    // only used in freetype, least recently used glyphs are evicted once the atlas holds this many textures,
+    // 0 means unbounded for regular faces and SDF_MAX_TEXTURES for SDF faces.
+    uint32_t maxTextures{DEFAULT_FREETYPE_MAX_TEXTURES};
     //~
 };
 
@@ -112,6 +124,7 @@ public:
     inline gfx::Texture *getTexture(uint32_t page) const { return _textures[page]; }
     inline uint32_t getTextureWidth() const { return _textureWidth; }
     inline uint32_t getTextureHeight() const { return _textureHeight; }
+    inline bool isSDF() const { return _sdf; }
 
 protected:
     virtual void doInit(const FontFaceInfo &info) = 0;
@@ -124,6 +137,7 @@ protected:
     ccstd::vector<gfx::Texture *> _textures;
     uint32_t _textureWidth{0U};
     uint32_t _textureHeight{0U};
+    bool _sdf{false};
 };
 
 /**
@@ -144,6 +158,8 @@ public:
     inline const ccstd::string &getPath() const { return _path; }
     inline const ccstd::vector<uint8_t> &getData() const { return _data; }
     inline FontFace *getFace(uint32_t fontSize) { return _faces[fontSize]; }
+    // glyph metrics are in the font size of the face, an SDF face registered under fontSize scales them by this factor.
+    float getFaceScale(uint32_t fontSize) const;
     void releaseFaces();
 
 protected:
@@ -29,8 +29,14 @@
 #include "FreeTypeFont.h"
 #include <freetype/ft2build.h>
 #include FT_FREETYPE_H
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <mutex>
+#include "GlyphAtlas.h"
 #include "base/Log.h"
+#include "base/job-system/ParallelFor.h"
+#include "core/Root.h"
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -78,60 +84,94 @@ struct FTFace {
     FT_Face face{nullptr};
 };
 
-/**
- * GlyphAllocator: allocate space for glyph from top to down, from left to right.
- */
-class GlyphAllocator {
-public:
-    GlyphAllocator(uint32_t maxWidth, uint32_t maxHeight)
-    : _maxWidth(maxWidth), _maxHeight(maxHeight) {}
-
-    inline void reset() {
-        _nextX = 0U;
-        _nextY = 0U;
-        _maxLineHeight = 0U;
-    }
+namespace {
 
-    bool allocate(uint32_t width, uint32_t height, uint32_t &x, uint32_t &y) {
-        // try current line
-        if (_nextX + width <= _maxWidth && _nextY + height <= _maxHeight) {
-            x = _nextX;
-            y = _nextY;
+// SDF glyphs are rasterized at SDF_RASTER_SCALE times SDF_FONT_SIZE, then the distances are downsampled
+constexpr uint32_t SDF_RASTER_SCALE = 4U;
 
-            _nextX += width;
-            _maxLineHeight = std::max(_maxLineHeight, height);
+constexpr uint32_t MIN_GLYPHS_PER_JOB = 32U;
+constexpr uint32_t MIN_SDF_GLYPHS_PER_JOB = 8U;
 
-            return true;
-        }
+// FT_Library is shared by the faces of all threads, FreeType requires creating and destroying faces serially
+std::mutex faceMutex;
 
-        // try next line
-        uint32_t nextY = _nextY + _maxLineHeight;
-        if (width <= _maxWidth && nextY + height <= _maxHeight) {
-            x = 0U;
-            y = nextY;
+inline float elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
-            _nextX = width;
-            _nextY = nextY;
-            _maxLineHeight = height;
+FT_Face openFace(FT_Library lib, const ccstd::vector<uint8_t> &fontData, uint32_t pixelSize) {
+    std::lock_guard<std::mutex> lock(faceMutex);
+    FT_Face face{nullptr};
+    FT_Error error = FT_New_Memory_Face(lib, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &face);
+    if (error) {
+        CC_LOG_ERROR("FT_New_Memory_Face failed, error code: %d.", error);
+        return nullptr;
+    }
 
-            return true;
-        }
+    error = FT_Set_Pixel_Sizes(face, 0, pixelSize);
+    if (error) {
+        CC_LOG_ERROR("FT_Set_Pixel_Sizes failed, error code: %d.", error);
+        FT_Done_Face(face);
+        return nullptr;
+    }
+
+    return face;
+}
+
+void closeFace(FT_Face face) {
+    std::lock_guard<std::mutex> lock(faceMutex);
+    FT_Done_Face(face);
+}
+
+void copyBitmap(const FT_Bitmap &bitmap, GlyphBitmap &out) {
+    const uint32_t width = bitmap.width;
+    const uint32_t height = bitmap.rows;
+    out.buffer.assign((width + 1) * (height + 1), 0U);
+    for (uint32_t y = 0U; y < height; ++y) {
+        const uint8_t *src = bitmap.buffer + static_cast<ptrdiff_t>(y) * bitmap.pitch;
+        std::copy(src, src + width, out.buffer.data() + y * (width + 1));
+    }
+}
 
+bool rasterizeGlyph(FT_Face face, uint32_t code, uint32_t scale, bool sdf, GlyphBitmap &out) {
+    FT_Error error = FT_Load_Char(face, code, FT_LOAD_RENDER);
+    if (error) {
+        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, code);
         return false;
     }
 
-private:
-    // texture resolution
-    const uint32_t _maxWidth{0U};
-    const uint32_t _maxHeight{0U};
+    const FT_GlyphSlot slot = face->glyph;
+    const auto &bitmap = slot->bitmap;
+    // advance.x's unit is 1/64 pixels
+    const auto unit = static_cast<FT_Pos>(64 * scale);
+    out.glyph.advance = static_cast<int32_t>((slot->advance.x + unit / 2) / unit);
+
+    if (bitmap.width == 0U || bitmap.rows == 0U) {
+        out.glyph.width = 0U;
+        out.glyph.height = 0U;
+        out.glyph.bearingX = static_cast<int16_t>(slot->bitmap_left / static_cast<int32_t>(scale));
+        out.glyph.bearingY = static_cast<int16_t>(slot->bitmap_top / static_cast<int32_t>(scale));
+        return true;
+    }
 
-    // next space
-    uint32_t _nextX{0U};
-    uint32_t _nextY{0U};
+    if (sdf) {
+        generateSDF(bitmap.buffer, bitmap.width, bitmap.rows, bitmap.pitch, slot->bitmap_left, slot->bitmap_top, static_cast<int32_t>(scale), out);
+    } else {
+        out.glyph.width = static_cast<uint16_t>(bitmap.width);
+        out.glyph.height = static_cast<uint16_t>(bitmap.rows);
+        out.glyph.bearingX = static_cast<int16_t>(slot->bitmap_left);
+        out.glyph.bearingY = static_cast<int16_t>(slot->bitmap_top);
+        copyBitmap(bitmap, out);
+    }
 
-    // max height of current line
-    uint32_t _maxLineHeight{0U};
-};
+    return true;
+}
+
+uint32_t clampFontSize(uint32_t fontSize) {
+    return fontSize < MIN_FONT_SIZE ? MIN_FONT_SIZE : (fontSize > MAX_FONT_SIZE ? MAX_FONT_SIZE : fontSize);
+}
+
+} // namespace
 
 /**
  * FreeTypeFontFace
@@ -144,6 +184,8 @@ FreeTypeFontFace::FreeTypeFontFace(Font *font)
     }
 }
 
+FreeTypeFontFace::~FreeTypeFontFace() = default;
+
 void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
     const auto &fontData = _font->getData();
     if (fontData.empty()) {
@@ -151,10 +193,19 @@ void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
         return;
     }
 
-    _fontSize = info.fontSize < MIN_FONT_SIZE ? MIN_FONT_SIZE : (info.fontSize > MAX_FONT_SIZE ? MAX_FONT_SIZE : info.fontSize);
+    _sdf = info.sdf;
+    if (_sdf) {
+        _fontSize = SDF_FONT_SIZE;
+        _rasterScale = SDF_RASTER_SCALE;
+    } else {
+        _fontSize = clampFontSize(info.fontSize);
+        _rasterScale = 1U;
+    }
     _textureWidth = info.textureWidth;
     _textureHeight = info.textureHeight;
-    _allocator = std::make_unique<GlyphAllocator>(_textureWidth, _textureHeight);
+    // regular faces keep growing unless the user caps them, SDF faces share one atlas between all sizes
+    _maxTextures = info.maxTextures ? info.maxTextures : (_sdf ? SDF_MAX_TEXTURES : 0U);
+    _atlas = std::make_unique<GlyphAtlas>(_textureWidth, _textureHeight);
 
     FT_Face face{nullptr};
     FT_Error error = FT_New_Memory_Face(library->lib, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &face);
@@ -163,23 +214,22 @@ void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
         return;
     }
 
-    error = FT_Set_Pixel_Sizes(face, 0, _fontSize);
+    error = FT_Set_Pixel_Sizes(face, 0, _fontSize * _rasterScale);
     if (error) {
         CC_LOG_ERROR("FT_Set_Pixel_Sizes failed, error code: %d.", error);
         return;
     }
 
     _face = std::make_unique<FTFace>(face);
-    _lineHeight = static_cast<uint32_t>(face->size->metrics.height >> 6);
+    _lineHeight = static_cast<uint32_t>(face->size->metrics.height >> 6) / _rasterScale;
 
-    for (const auto &code : info.preLoadedCharacters) {
-        loadGlyph(code);
-    }
+    prerasterize(info.preLoadedCharacters);
 }
 
 const FontGlyph *FreeTypeFontFace::getGlyph(uint32_t code) {
     auto iter = _glyphs.find(code);
     if (iter != _glyphs.end()) {
+        _atlas->touch(code, nextUseStamp());
         return &iter->second;
     }
 
@@ -207,58 +257,148 @@ float FreeTypeFontFace::getKerning(uint32_t prevCode, uint32_t nextCode) {
         return 0.0F;
     }
 
-    auto result = static_cast<float>(kerning.x >> 6);
+    auto result = static_cast<float>(kerning.x >> 6) / static_cast<float>(_rasterScale);
     _kernings[{prevCode, nextCode}] = result;
 
     return result;
 }
 
-const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
-    FT_Face face = _face->face;
-    FT_Error error = FT_Load_Char(face, code, FT_LOAD_RENDER);
-    if (error) {
-        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, code);
-        return nullptr;
+void FreeTypeFontFace::prerasterize(const ccstd::vector<uint32_t> &codes) {
+    if (!_face) {
+        return;
     }
 
-    FontGlyph glyph;
-    glyph.width = face->glyph->bitmap.width;
-    glyph.height = face->glyph->bitmap.rows;
-    glyph.bearingX = face->glyph->bitmap_left;
-    glyph.bearingY = face->glyph->bitmap_top;
-    glyph.advance = static_cast<int32_t>(face->glyph->advance.x >> 6); // advance.x's unit is 1/64 pixels
+    ccstd::vector<uint32_t> pending;
+    pending.reserve(codes.size());
+    for (auto code : codes) {
+        if (_glyphs.find(code) == _glyphs.end()) {
+            pending.push_back(code);
+        }
+    }
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+    if (pending.empty()) {
+        return;
+    }
 
-    uint32_t x = 0U;
-    uint32_t y = 0U;
+    const auto count = static_cast<uint32_t>(pending.size());
+    const auto &fontData = _font->getData();
+    const uint32_t pixelSize = _fontSize * _rasterScale;
+    ccstd::vector<GlyphBitmap> bitmaps(count);
 
-    if (_textures.empty()) {
-        createTexture(_textureWidth, _textureHeight);
+    const auto start = std::chrono::steady_clock::now();
+    parallelFor(count, _sdf ? MIN_SDF_GLYPHS_PER_JOB : MIN_GLYPHS_PER_JOB, [&](uint32_t begin, uint32_t end) {
+        if (begin >= end) {
+            return;
+        }
+
+        // FT_Face is not thread safe: the range starting at 0 runs on the calling thread with the face of this object,
+        // the worker threads open their own faces.
+        FT_Face face = begin == 0U ? _face->face : openFace(library->lib, fontData, pixelSize);
+        if (!face) {
+            return;
+        }
+
+        for (uint32_t i = begin; i < end; ++i) {
+            bitmaps[i].valid = rasterizeGlyph(face, pending[i], _rasterScale, _sdf, bitmaps[i]);
+        }
+
+        if (begin != 0U) {
+            closeFace(face);
+        }
+    });
+    _stats.rasterizeTime += elapsedMs(start);
+
+    // texture uploads stay on the calling thread
+    for (uint32_t i = 0U; i < count; ++i) {
+        if (bitmaps[i].valid) {
+            addGlyph(pending[i], bitmaps[i]);
+        }
+    }
+}
+
+FontAtlasStats FreeTypeFontFace::getAtlasStats() const {
+    FontAtlasStats stats = _stats;
+    stats.textures = static_cast<uint32_t>(_textures.size());
+    stats.glyphs = static_cast<uint32_t>(_glyphs.size());
+    stats.occupancy = _atlas ? _atlas->getOccupancy() : 0.0F;
+    return stats;
+}
+
+const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
+    GlyphBitmap bitmap;
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = rasterizeGlyph(_face->face, code, _rasterScale, _sdf, bitmap);
+    _stats.rasterizeTime += elapsedMs(start);
+    if (!loaded) {
+        return nullptr;
     }
 
+    return addGlyph(code, bitmap);
+}
+
+const FontGlyph *FreeTypeFontFace::addGlyph(uint32_t code, const GlyphBitmap &bitmap) {
+    ++_stats.rasterizedGlyphs;
+    FontGlyph glyph = bitmap.glyph;
+
     if (glyph.width > 0U && glyph.height > 0U) {
-        // try current texture
-        if (!_allocator->allocate(glyph.width + 1, glyph.height + 1, x, y)) {
+        const uint32_t width = glyph.width + 1;
+        const uint32_t height = glyph.height + 1;
+        const uint64_t stamp = nextUseStamp();
+        uint32_t page = 0U;
+        uint32_t x = 0U;
+        uint32_t y = 0U;
+
+        bool allocated = _atlas->allocate(code, width, height, stamp, page, x, y);
+
+        // try new empty texture
+        if (!allocated && (!_maxTextures || _atlas->getPageCount() < _maxTextures)) {
             createTexture(_textureWidth, _textureHeight);
+            _atlas->addPage();
+            allocated = _atlas->allocate(code, width, height, stamp, page, x, y);
+        }
 
-            // try new empty texture
-            _allocator->reset();
-            if (!_allocator->allocate(glyph.width + 1, glyph.height + 1, x, y)) {
-                CC_LOG_WARNING("Glyph allocate failed, character: %u.", code);
-                return nullptr;
+        // reuse the space of the least recently used glyphs, they are rasterized again when requested
+        if (!allocated && _maxTextures) {
+            ccstd::vector<uint32_t> evicted;
+            if (_atlas->evict(height, _frameStamp, evicted)) {
+                for (auto evictedCode : evicted) {
+                    _glyphs.erase(evictedCode);
+                }
+                _stats.evictedGlyphs += static_cast<uint32_t>(evicted.size());
+                allocated = _atlas->allocate(code, width, height, stamp, page, x, y);
             }
         }
 
-        auto page = static_cast<uint32_t>(_textures.size() - 1);
-        updateTexture(page, x, y, glyph.width, glyph.height, face->glyph->bitmap.buffer);
+        if (!allocated) {
+            CC_LOG_WARNING("Glyph allocate failed, character: %u.", code);
+            return nullptr;
+        }
+
+        // upload with the padding, the space may be reused from evicted glyphs
+        updateTexture(page, x, y, width, height, bitmap.buffer.data());
 
-        glyph.x = x;
-        glyph.y = y;
+        glyph.x = static_cast<int16_t>(x);
+        glyph.y = static_cast<int16_t>(y);
         glyph.page = page;
     }
 
-    _glyphs[code] = glyph;
+    auto &result = _glyphs[code];
+    result = glyph;
 
-    return &_glyphs[code];
+    return &result;
+}
+
+uint64_t FreeTypeFontFace::nextUseStamp() {
+    // without a root every use starts a new frame, so only the glyph being added is protected
+    const auto *root = Root::getInstance();
+    const float frameTime = root ? root->getCumulativeTime() : -1.0F;
+    ++_useStamp;
+    if (!root || frameTime != _frameTime) {
+        _frameTime = frameTime;
+        _frameStamp = _useStamp;
+    }
+    return _useStamp;
 }
 
 void FreeTypeFontFace::createTexture(uint32_t width, uint32_t height) {
@@ -305,10 +445,36 @@ FreeTypeFont::FreeTypeFont(const ccstd::string &path)
 }
 
 FontFace *FreeTypeFont::createFace(const FontFaceInfo &info) {
+    const uint32_t fontSize = info.sdf ? info.fontSize : clampFontSize(info.fontSize);
+    auto iter = _faces.find(fontSize);
+    if (iter != _faces.end() && iter->second) {
+        auto *face = static_cast<FreeTypeFontFace *>(iter->second);
+        if (face->isSDF() == info.sdf) {
+            face->prerasterize(info.preLoadedCharacters);
+            return face;
+        }
+
+        // replaced by a face of the other kind, the SDF face may still be registered under other sizes
+        iter->second = nullptr;
+        const bool shared = std::any_of(_faces.begin(), _faces.end(), [face](const auto &pair) { return pair.second == face; });
+        if (!shared) {
+            delete face;
+        }
+    }
+
+    if (info.sdf) {
+        // one SDF face serves all font sizes, it is registered under each requested size
+        auto sdfIter = std::find_if(_faces.begin(), _faces.end(), [](const auto &pair) { return pair.second && pair.second->isSDF(); });
+        if (sdfIter != _faces.end()) {
+            auto *face = static_cast<FreeTypeFontFace *>(sdfIter->second);
+            face->prerasterize(info.preLoadedCharacters);
+            _faces[fontSize] = face;
+            return face;
+        }
+    }
+
     auto *face = ccnew FreeTypeFontFace(this);
     face->doInit(info);
-
-    uint32_t fontSize = face->getFontSize();
     _faces[fontSize] = face;
 
     return face;
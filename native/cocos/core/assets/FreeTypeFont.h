@@ -35,7 +35,17 @@ namespace cc {
 
 struct FTLibrary;
 struct FTFace;
-class GlyphAllocator;
+struct GlyphBitmap;
+class GlyphAtlas;
+
+struct FontAtlasStats {
+    uint32_t textures{0U};
+    uint32_t glyphs{0U};
+    uint32_t rasterizedGlyphs{0U};
+    uint32_t evictedGlyphs{0U};
+    float occupancy{0.0F};     // allocated area / total area of the textures
+    float rasterizeTime{0.0F}; // accumulated, in milliseconds
+};
 
 /**
  * FreeTypeFontFace
@@ -43,7 +53,7 @@ class GlyphAllocator;
 class FreeTypeFontFace : public FontFace {
 public:
     explicit FreeTypeFontFace(Font *font);
-    ~FreeTypeFontFace() override = default;
+    ~FreeTypeFontFace() override;
     FreeTypeFontFace(const FreeTypeFontFace &) = delete;
     FreeTypeFontFace(FreeTypeFontFace &&) = delete;
     FreeTypeFontFace &operator=(const FreeTypeFontFace &) = delete;
@@ -51,16 +61,28 @@ public:
 
     const FontGlyph *getGlyph(uint32_t code) override;
     float getKerning(uint32_t prevCode, uint32_t nextCode) override;
+    // Rasterizes the glyphs not loaded yet on the job system worker threads, then packs them on the calling thread.
+    void prerasterize(const ccstd::vector<uint32_t> &codes);
+    FontAtlasStats getAtlasStats() const;
     static void destroyFreeType();
 
 private:
     void doInit(const FontFaceInfo &info) override;
     const FontGlyph *loadGlyph(uint32_t code);
+    const FontGlyph *addGlyph(uint32_t code, const GlyphBitmap &bitmap);
     void createTexture(uint32_t width, uint32_t height);
     void updateTexture(uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *buffer);
+    uint64_t nextUseStamp();
 
-    std::unique_ptr<GlyphAllocator> _allocator{nullptr};
+    std::unique_ptr<GlyphAtlas> _atlas{nullptr};
     std::unique_ptr<FTFace> _face;
+    uint32_t _rasterScale{1U}; // SDF glyphs are rasterized at a higher resolution then downsampled
+    uint32_t _maxTextures{DEFAULT_FREETYPE_MAX_TEXTURES}; // 0: unbounded, never evicts
+    // glyphs used since _frameStamp are never evicted, their quads may not be drawn yet
+    uint64_t _useStamp{0U};
+    uint64_t _frameStamp{0U};
+    float _frameTime{-1.0F};
+    FontAtlasStats _stats;
     static FTLibrary *library;
 
     friend class FreeTypeFont;
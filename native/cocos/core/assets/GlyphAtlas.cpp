@@ -0,0 +1,226 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace cc {
+
+namespace {
+
+constexpr uint8_t SDF_INSIDE_THRESHOLD = 128U;
+constexpr float SDF_DISTANCE_INF = 1e20F;
+
+inline int32_t positiveMod(int32_t value, int32_t divisor) {
+    return ((value % divisor) + divisor) % divisor;
+}
+
+// Felzenszwalb & Huttenlocher squared euclidean distance transform of one row or column
+void distanceTransform1D(const float *f, float *d, int32_t *v, float *z, int32_t n) {
+    int32_t k = 0;
+    v[0] = 0;
+    z[0] = -SDF_DISTANCE_INF;
+    z[1] = SDF_DISTANCE_INF;
+
+    for (int32_t q = 1; q < n; ++q) {
+        float s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * (q - v[k]));
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * (q - v[k]));
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = SDF_DISTANCE_INF;
+    }
+
+    k = 0;
+    for (int32_t q = 0; q < n; ++q) {
+        while (z[k + 1] < static_cast<float>(q)) {
+            ++k;
+        }
+        d[q] = static_cast<float>((q - v[k]) * (q - v[k])) + f[v[k]];
+    }
+}
+
+void distanceTransform2D(float *grid, int32_t width, int32_t height) {
+    const int32_t length = std::max(width, height);
+    ccstd::vector<float> f(length);
+    ccstd::vector<float> d(length);
+    ccstd::vector<int32_t> v(length);
+    ccstd::vector<float> z(length + 1);
+
+    for (int32_t x = 0; x < width; ++x) {
+        for (int32_t y = 0; y < height; ++y) {
+            f[y] = grid[y * width + x];
+        }
+        distanceTransform1D(f.data(), d.data(), v.data(), z.data(), height);
+        for (int32_t y = 0; y < height; ++y) {
+            grid[y * width + x] = d[y];
+        }
+    }
+
+    for (int32_t y = 0; y < height; ++y) {
+        float *row = grid + y * width;
+        std::copy(row, row + width, f.begin());
+        distanceTransform1D(f.data(), row, v.data(), z.data(), width);
+    }
+}
+
+} // namespace
+
+bool GlyphAtlas::allocate(uint32_t code, uint32_t width, uint32_t height, uint64_t stamp, uint32_t &page, uint32_t &x, uint32_t &y) {
+    if (width > _width || height > _height) {
+        return false;
+    }
+
+    // best fit among the shelves with room left
+    Location best{INVALID_INDEX, INVALID_INDEX};
+    uint32_t bestWaste = UINT32_MAX;
+    for (uint32_t p = 0U; p < _pages.size(); ++p) {
+        const auto &shelves = _pages[p].shelves;
+        for (uint32_t s = 0U; s < shelves.size(); ++s) {
+            const auto &shelf = shelves[s];
+            if (shelf.height >= height && shelf.nextX + width <= _width && shelf.height - height < bestWaste) {
+                best = {p, s};
+                bestWaste = shelf.height - height;
+            }
+        }
+    }
+
+    // open a new shelf rather than wasting more than half of the glyph height
+    if (best.page == INVALID_INDEX || bestWaste > height / 2U) {
+        for (uint32_t p = 0U; p < _pages.size(); ++p) {
+            auto &target = _pages[p];
+            if (target.nextY + height <= _height) {
+                target.shelves.push_back({target.nextY, height});
+                target.nextY += height;
+                best = {p, static_cast<uint32_t>(target.shelves.size() - 1)};
+                break;
+            }
+        }
+    }
+
+    if (best.page == INVALID_INDEX) {
+        return false;
+    }
+
+    auto &shelf = _pages[best.page].shelves[best.shelf];
+    page = best.page;
+    x = shelf.nextX;
+    y = shelf.y;
+
+    shelf.nextX += width;
+    shelf.area += width * height;
+    shelf.lastUse = stamp;
+    shelf.codes.push_back(code);
+    _usedArea += width * height;
+    _locations[code] = best;
+
+    return true;
+}
+
+bool GlyphAtlas::evict(uint32_t height, uint64_t protectedStamp, ccstd::vector<uint32_t> &codes) {
+    Shelf *victim{nullptr};
+    for (auto &target : _pages) {
+        for (auto &shelf : target.shelves) {
+            if (shelf.height >= height && !shelf.codes.empty() && shelf.lastUse < protectedStamp &&
+                (!victim || shelf.lastUse < victim->lastUse)) {
+                victim = &shelf;
+            }
+        }
+    }
+
+    if (!victim) {
+        return false;
+    }
+
+    for (auto code : victim->codes) {
+        _locations.erase(code);
+    }
+    codes = std::move(victim->codes);
+    victim->codes.clear();
+    _usedArea -= victim->area;
+    victim->area = 0U;
+    victim->nextX = 0U;
+
+    return true;
+}
+
+void generateSDF(const uint8_t *bitmap, uint32_t width, uint32_t rows, int32_t pitch, int32_t left, int32_t top, int32_t scale, GlyphBitmap &out) {
+    const auto spread = static_cast<int32_t>(SDF_SPREAD) * scale;
+    const auto bitmapWidth = static_cast<int32_t>(width);
+    const auto bitmapHeight = static_cast<int32_t>(rows);
+    const int32_t padLeft = spread + positiveMod(left - spread, scale);
+    const int32_t padTop = spread + positiveMod(-(top + spread), scale);
+    const int32_t fieldWidth = (padLeft + bitmapWidth + spread + scale - 1) / scale * scale;
+    const int32_t fieldHeight = (padTop + bitmapHeight + spread + scale - 1) / scale * scale;
+
+    // outside: squared distance to the nearest inside texel, inside: to the nearest outside texel
+    ccstd::vector<float> outside(fieldWidth * fieldHeight, SDF_DISTANCE_INF);
+    ccstd::vector<float> inside(fieldWidth * fieldHeight, 0.0F);
+    for (int32_t y = 0; y < bitmapHeight; ++y) {
+        const uint8_t *src = bitmap + static_cast<ptrdiff_t>(y) * pitch;
+        for (int32_t x = 0; x < bitmapWidth; ++x) {
+            if (src[x] >= SDF_INSIDE_THRESHOLD) {
+                const int32_t index = (y + padTop) * fieldWidth + x + padLeft;
+                outside[index] = 0.0F;
+                inside[index] = SDF_DISTANCE_INF;
+            }
+        }
+    }
+    distanceTransform2D(outside.data(), fieldWidth, fieldHeight);
+    distanceTransform2D(inside.data(), fieldWidth, fieldHeight);
+
+    // signed distance at the texel centers, positive inside, the outline is half a texel away from the texel centers
+    auto distance = [&](int32_t x, int32_t y) {
+        const int32_t index = y * fieldWidth + x;
+        return inside[index] > 0.0F ? std::sqrt(inside[index]) - 0.5F : 0.5F - std::sqrt(outside[index]);
+    };
+
+    const int32_t outWidth = fieldWidth / scale;
+    const int32_t outHeight = fieldHeight / scale;
+    const int32_t center = scale / 2;
+    const float invRange = 1.0F / static_cast<float>(2 * spread);
+    out.buffer.assign((outWidth + 1) * (outHeight + 1), 0U);
+    for (int32_t y = 0; y < outHeight; ++y) {
+        for (int32_t x = 0; x < outWidth; ++x) {
+            const int32_t sx = x * scale + center;
+            const int32_t sy = y * scale + center;
+            const float d = 0.25F * (distance(sx - 1, sy - 1) + distance(sx, sy - 1) + distance(sx - 1, sy) + distance(sx, sy));
+            const float value = std::min(std::max(0.5F + d * invRange, 0.0F), 1.0F);
+            out.buffer[y * (outWidth + 1) + x] = static_cast<uint8_t>(value * 255.0F + 0.5F);
+        }
+    }
+
+    out.glyph.width = static_cast<uint16_t>(outWidth);
+    out.glyph.height = static_cast<uint16_t>(outHeight);
+    out.glyph.bearingX = static_cast<int16_t>((left - padLeft) / scale);
+    out.glyph.bearingY = static_cast<int16_t>((top + padTop) / scale);
+}
+
+} // namespace cc
@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "Font.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * GlyphBitmap: rasterized glyph waiting to be packed, the buffer is (width + 1) * (height + 1) with zero padding on the right and bottom.
+ */
+struct GlyphBitmap {
+    FontGlyph glyph;
+    ccstd::vector<uint8_t> buffer;
+    bool valid{false};
+};
+
+/**
+ * GlyphAtlas: allocate space for glyph on shelves, a shelf is a row of glyphs with similar height.
+ * When the textures are full, the least recently used shelf is evicted and reused.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas(uint32_t width, uint32_t height)
+    : _width(width), _height(height) {}
+
+    inline void addPage() { _pages.emplace_back(); }
+    inline uint32_t getPageCount() const { return static_cast<uint32_t>(_pages.size()); }
+
+    inline float getOccupancy() const {
+        const auto totalArea = static_cast<float>(_pages.size()) * static_cast<float>(_width) * static_cast<float>(_height);
+        return totalArea > 0.0F ? static_cast<float>(_usedArea) / totalArea : 0.0F;
+    }
+
+    bool allocate(uint32_t code, uint32_t width, uint32_t height, uint64_t stamp, uint32_t &page, uint32_t &x, uint32_t &y);
+
+    inline void touch(uint32_t code, uint64_t stamp) {
+        auto iter = _locations.find(code);
+        if (iter != _locations.end()) {
+            _pages[iter->second.page].shelves[iter->second.shelf].lastUse = stamp;
+        }
+    }
+
+    // Evicts the least recently used shelf that fits the height and was not used since protectedStamp.
+    bool evict(uint32_t height, uint64_t protectedStamp, ccstd::vector<uint32_t> &codes);
+
+private:
+    static constexpr uint32_t INVALID_INDEX{UINT32_MAX};
+
+    struct Shelf {
+        uint32_t y{0U};
+        uint32_t height{0U};
+        uint32_t nextX{0U};
+        uint32_t area{0U};
+        uint64_t lastUse{0U};
+        ccstd::vector<uint32_t> codes;
+    };
+
+    struct Page {
+        ccstd::vector<Shelf> shelves;
+        uint32_t nextY{0U};
+    };
+
+    struct Location {
+        uint32_t page{0U};
+        uint32_t shelf{0U};
+    };
+
+    // texture resolution
+    const uint32_t _width{0U};
+    const uint32_t _height{0U};
+
+    ccstd::vector<Page> _pages;
+    ccstd::unordered_map<uint32_t, Location> _locations;
+    uint64_t _usedArea{0U};
+};
+
+/**
+ * Builds the distance field of an 8-bit coverage bitmap rasterized at scale times the SDF font size.
+ * pitch is the byte offset between rows, left and top are the bearings of the bitmap at the raster size.
+ * out receives the downsampled field with SDF_SPREAD texels of padding and its glyph metrics at SDF_FONT_SIZE.
+ */
+void generateSDF(const uint8_t *bitmap, uint32_t width, uint32_t rows, int32_t pitch, int32_t left, int32_t top, int32_t scale, GlyphBitmap &out);
+
+} // namespace cc
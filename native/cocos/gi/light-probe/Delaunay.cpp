@@ -26,6 +26,9 @@
 
 #include "Delaunay.h"
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
 #include "base/Log.h"
 #include "core/platform/Debug.h"
 #include "math/Mat3.h"
@@ -33,13 +36,125 @@
 namespace cc {
 namespace gi {
 
+namespace {
+
+// vertices of the triangle opposite to vertex i, same winding as Delaunay::computeAdjacency
+constexpr int32_t FACE_VERTICES[4][3] = {{1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2}};
+
+constexpr uint32_t HILBERT_BITS{10};
+constexpr int32_t MIN_ROUND_SIZE{64};
+
+inline uint64_t edgeKey(int32_t v0, int32_t v1) {
+    if (v0 > v1) {
+        std::swap(v0, v1);
+    }
+    return (static_cast<uint64_t>(v0) << 32) | static_cast<uint32_t>(v1);
+}
+
+// triangle vertices are sorted and less than 2^21
+inline uint64_t triangleKey(const Triangle &triangle) {
+    return (static_cast<uint64_t>(triangle.vertex0) << 42) | (static_cast<uint64_t>(triangle.vertex1) << 21) | static_cast<uint64_t>(triangle.vertex2);
+}
+
+// predicates are evaluated in double precision, the float circumsphere of a sliver tetrahedron
+// is too inaccurate to keep the cavity of an inserted probe connected
+double orient(const Vec3 &a, const Vec3 &b, const Vec3 &c, const Vec3 &d) {
+    const double adx = a.x - d.x;
+    const double ady = a.y - d.y;
+    const double adz = a.z - d.z;
+    const double bdx = b.x - d.x;
+    const double bdy = b.y - d.y;
+    const double bdz = b.z - d.z;
+    const double cdx = c.x - d.x;
+    const double cdy = c.y - d.y;
+    const double cdz = c.z - d.z;
+
+    return adx * (bdy * cdz - bdz * cdy) + bdx * (cdy * adz - cdz * ady) + cdx * (ady * bdz - adz * bdy);
+}
+
+bool isInCircumSphere(const ccstd::vector<Vertex> &probes, const Tetrahedron &tetrahedron, const Vec3 &point) {
+    const auto &a = probes[tetrahedron.vertex0].position;
+    const auto &b = probes[tetrahedron.vertex1].position;
+    const auto &c = probes[tetrahedron.vertex2].position;
+    const auto &d = probes[tetrahedron.vertex3].position;
+
+    const double aex = a.x - point.x;
+    const double aey = a.y - point.y;
+    const double aez = a.z - point.z;
+    const double bex = b.x - point.x;
+    const double bey = b.y - point.y;
+    const double bez = b.z - point.z;
+    const double cex = c.x - point.x;
+    const double cey = c.y - point.y;
+    const double cez = c.z - point.z;
+    const double dex = d.x - point.x;
+    const double dey = d.y - point.y;
+    const double dez = d.z - point.z;
+
+    const double ab = aex * bey - bex * aey;
+    const double bc = bex * cey - cex * bey;
+    const double cd = cex * dey - dex * cey;
+    const double da = dex * aey - aex * dey;
+    const double ac = aex * cey - cex * aey;
+    const double bd = bex * dey - dex * bey;
+
+    const double abc = aez * bc - bez * ac + cez * ab;
+    const double bcd = bez * cd - cez * bd + dez * bc;
+    const double cda = cez * da + dez * ac + aez * cd;
+    const double dab = dez * ab + aez * bd + bez * da;
+
+    const double alift = aex * aex + aey * aey + aez * aez;
+    const double blift = bex * bex + bey * bey + bez * bez;
+    const double clift = cex * cex + cey * cey + cez * cez;
+    const double dlift = dex * dex + dey * dey + dez * dez;
+
+    const double det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+    return det * orient(a, b, c, d) > 0.0;
+}
+
+// index along a 3D Hilbert curve, see J. Skilling, Programming the Hilbert curve
+uint32_t hilbertIndex(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t axes[3] = {x, y, z};
+    for (uint32_t q = 1U << (HILBERT_BITS - 1); q > 1; q >>= 1) {
+        const uint32_t p = q - 1;
+        for (auto &axis : axes) {
+            if (axis & q) {
+                axes[0] ^= p;
+            } else {
+                const uint32_t t = (axes[0] ^ axis) & p;
+                axes[0] ^= t;
+                axis ^= t;
+            }
+        }
+    }
+
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+    uint32_t t = 0;
+    for (uint32_t q = 1U << (HILBERT_BITS - 1); q > 1; q >>= 1) {
+        if (axes[2] & q) {
+            t ^= q - 1;
+        }
+    }
+
+    uint32_t index = 0;
+    for (int32_t bit = HILBERT_BITS - 1; bit >= 0; bit--) {
+        for (auto axis : axes) {
+            index = (index << 1) | (((axis ^ t) >> bit) & 1);
+        }
+    }
+
+    return index;
+}
+
+} // namespace
+
 void CircumSphere::init(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) {
     // calculate circumsphere of 4 points in R^3 space.
     Mat3 mat(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z,
              p2.x - p0.x, p2.y - p0.y, p2.z - p0.z,
              p3.x - p0.x, p3.y - p0.y, p3.z - p0.z);
     mat.inverse();
-    mat.transpose();
 
     Vec3 n(((p1.x + p0.x) * (p1.x - p0.x) + (p1.y + p0.y) * (p1.y - p0.y) + (p1.z + p0.z) * (p1.z - p0.z)) * 0.5F,
            ((p2.x + p0.x) * (p2.x - p0.x) + (p2.y + p0.y) * (p2.y - p0.y) + (p2.z + p0.z) * (p2.z - p0.z)) * 0.5F,
@@ -77,30 +192,38 @@ void Delaunay::reset() {
     _tetrahedrons.clear();
     _triangles.clear();
     _edges.clear();
+    _freeTetrahedrons.clear();
+    _lastTetrahedron = 0;
 }
 
 void Delaunay::tetrahedralize() {
     // get probe count first
-    const auto probeCount = _probes.size();
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    const auto order = sortProbes(probeCount);
 
     // init a super tetrahedron containing all probes
     const auto center = initTetrahedron();
 
-    for (auto i = 0; i < probeCount; i++) {
-        addProbe(i);
+    for (const auto vertexIndex : order) {
+        addProbe(vertexIndex);
     }
 
-    // remove all tetrahedrons which contain the super tetrahedron's vertices
+    // remove all cavity tetrahedrons and all tetrahedrons which contain the super tetrahedron's vertices
     _tetrahedrons.erase(std::remove_if(_tetrahedrons.begin(), _tetrahedrons.end(),
                                        [probeCount](Tetrahedron &tetrahedron) {
-                                           auto vertexIndex = static_cast<int32_t>(probeCount);
-                                           return (tetrahedron.contain(vertexIndex) ||
-                                                   tetrahedron.contain(vertexIndex + 1) ||
-                                                   tetrahedron.contain(vertexIndex + 2) ||
-                                                   tetrahedron.contain(vertexIndex + 3));
+                                           return (tetrahedron.invalid ||
+                                                   tetrahedron.contain(probeCount) ||
+                                                   tetrahedron.contain(probeCount + 1) ||
+                                                   tetrahedron.contain(probeCount + 2) ||
+                                                   tetrahedron.contain(probeCount + 3));
                                        }),
                         _tetrahedrons.end());
 
+    // adjacency of the insertion is stale after removal, it is rebuilt by computeAdjacency
+    for (auto &tetrahedron : _tetrahedrons) {
+        tetrahedron.neighbours.fill(-1);
+    }
+
     // remove all additional points in the super tetrahedron
     _probes.erase(_probes.begin() + probeCount, _probes.end());
 
@@ -108,7 +231,7 @@ void Delaunay::tetrahedralize() {
 }
 
 Vec3 Delaunay::initTetrahedron() {
-    constexpr float minFloat = std::numeric_limits<float>::min();
+    constexpr float minFloat = std::numeric_limits<float>::lowest();
     constexpr float maxFloat = std::numeric_limits<float>::max();
 
     Vec3 minPos = {maxFloat, maxFloat, maxFloat};
@@ -162,55 +285,191 @@ void Delaunay::addEdge(uint32_t index, int32_t tet, int32_t i, int32_t v0, int32
     }
 }
 
-void Delaunay::addProbe(int32_t vertexIndex) {
-    const auto &probe = _probes[vertexIndex];
-    const auto position = probe.position;
+ccstd::vector<int32_t> Delaunay::sortProbes(int32_t probeCount) const {
+    // biased randomized insertion order: shuffled rounds of doubling size, each one sorted along a
+    // Hilbert curve so consecutive probes are close and the point location walk stays short
+    ccstd::vector<int32_t> order(probeCount);
+    std::iota(order.begin(), order.end(), 0);
 
-    auto triangleIndex = 0;
+    // fixed seed keeps the bake result stable between runs
+    std::mt19937 random(static_cast<uint32_t>(probeCount));
+    std::shuffle(order.begin(), order.end(), random);
+
+    Vec3 minPos{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    Vec3 maxPos{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for (auto i = 0; i < probeCount; i++) {
+        const auto &position = _probes[i].position;
+        Vec3::min(minPos, position, &minPos);
+        Vec3::max(maxPos, position, &maxPos);
+    }
+
+    const Vec3 extent = maxPos - minPos;
+    const float scale = static_cast<float>((1U << HILBERT_BITS) - 1) / std::max({extent.x, extent.y, extent.z, static_cast<float>(mathutils::EPSILON)});
+    ccstd::vector<uint32_t> keys(probeCount);
+    for (auto i = 0; i < probeCount; i++) {
+        const auto local = (_probes[i].position - minPos) * scale;
+        keys[i] = hilbertIndex(static_cast<uint32_t>(local.x), static_cast<uint32_t>(local.y), static_cast<uint32_t>(local.z));
+    }
+
+    auto end = probeCount;
+    while (end > 0) {
+        const auto begin = end > MIN_ROUND_SIZE ? end / 2 : 0;
+        std::sort(order.begin() + begin, order.begin() + end, [&keys](int32_t a, int32_t b) {
+            return keys[a] < keys[b];
+        });
+        end = begin;
+    }
+
+    return order;
+}
+
+int32_t Delaunay::locate(const Vec3 &position, int32_t start) const {
+    // visibility walk through adjacent tetrahedrons, the first tested face rotates every step to avoid cycling
+    auto current = start;
+    const auto maxSteps = static_cast<uint32_t>(_tetrahedrons.size());
+    for (uint32_t step = 0; step < maxSteps; step++) {
+        const auto &tetrahedron = _tetrahedrons[current];
+        const int32_t vertices[4] = {tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3};
+
+        auto next = current;
+        for (uint32_t k = 0; k < 4; k++) {
+            const auto i = (k + step) & 3;
+            const auto &p0 = _probes[vertices[FACE_VERTICES[i][0]]].position;
+            const auto &p1 = _probes[vertices[FACE_VERTICES[i][1]]].position;
+            const auto &p2 = _probes[vertices[FACE_VERTICES[i][2]]].position;
+
+            if (orient(p0, p1, p2, _probes[vertices[i]].position) * orient(p0, p1, p2, position) < 0.0) {
+                next = tetrahedron.neighbours[i];
+                break;
+            }
+        }
+
+        if (next == current) {
+            return current;
+        }
+
+        if (next < 0) {
+            return -1;
+        }
+
+        current = next;
+    }
+
+    return -1;
+}
+
+int32_t Delaunay::findConflict(const Vec3 &position) const {
     for (auto i = 0; i < static_cast<int32_t>(_tetrahedrons.size()); i++) {
-        auto &tetrahedron = _tetrahedrons[i];
-        if (tetrahedron.isInCircumSphere(position)) {
-            tetrahedron.invalid = true;
-
-            addTriangle(triangleIndex, i, 0, tetrahedron.vertex1, tetrahedron.vertex3, tetrahedron.vertex2, tetrahedron.vertex0);
-            addTriangle(triangleIndex + 1, i, 1, tetrahedron.vertex0, tetrahedron.vertex2, tetrahedron.vertex3, tetrahedron.vertex1);
-            addTriangle(triangleIndex + 2, i, 2, tetrahedron.vertex0, tetrahedron.vertex3, tetrahedron.vertex1, tetrahedron.vertex2);
-            addTriangle(triangleIndex + 3, i, 3, tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3);
-            triangleIndex += 4;
+        const auto &tetrahedron = _tetrahedrons[i];
+        if (!tetrahedron.invalid && isInCircumSphere(_probes, tetrahedron, position)) {
+            return i;
         }
     }
 
-    for (auto i = 0; i < triangleIndex; i++) {
-        if (_triangles[i].invalid) {
-            continue;
+    return -1;
+}
+
+void Delaunay::addProbe(int32_t vertexIndex) {
+    const auto position = _probes[vertexIndex].position;
+
+    // the containing tetrahedron always conflicts, fall back to a full scan for degenerate cases
+    auto seed = locate(position, _lastTetrahedron);
+    if (seed < 0 || !isInCircumSphere(_probes, _tetrahedrons[seed], position)) {
+        seed = findConflict(position);
+        if (seed < 0) {
+            return;
         }
+    }
 
-        for (auto k = i + 1; k < triangleIndex; k++) {
-            if (_triangles[i].isSame(_triangles[k])) {
-                _triangles[i].invalid = true;
-                _triangles[k].invalid = true;
-                break;
+    // grow the cavity from the seed through neighbours whose circumsphere contains the probe
+    _cavity.clear();
+    _cavityFaces.clear();
+    _tetrahedrons[seed].invalid = true;
+    _cavity.push_back(seed);
+
+    for (auto c = 0; c < static_cast<int32_t>(_cavity.size()); c++) {
+        const auto tet = _cavity[c];
+        const auto &tetrahedron = _tetrahedrons[tet];
+        const int32_t vertices[4] = {tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3};
+
+        for (auto i = 0; i < 4; i++) {
+            const auto neighbour = tetrahedron.neighbours[i];
+            if (neighbour >= 0) {
+                auto &other = _tetrahedrons[neighbour];
+                if (other.invalid) {
+                    continue;
+                }
+
+                // also take the neighbour if the probe can not see the face from inside the cavity,
+                // so every new tetrahedron keeps a positive volume when points are nearly cospherical
+                const auto &p0 = _probes[vertices[FACE_VERTICES[i][0]]].position;
+                const auto &p1 = _probes[vertices[FACE_VERTICES[i][1]]].position;
+                const auto &p2 = _probes[vertices[FACE_VERTICES[i][2]]].position;
+                if (isInCircumSphere(_probes, other, position) ||
+                    orient(p0, p1, p2, _probes[vertices[i]].position) * orient(p0, p1, p2, position) <= 0.0) {
+                    other.invalid = true;
+                    _cavity.push_back(neighbour);
+                    continue;
+                }
             }
+
+            CavityFace face;
+            face.vertex0 = vertices[FACE_VERTICES[i][0]];
+            face.vertex1 = vertices[FACE_VERTICES[i][1]];
+            face.vertex2 = vertices[FACE_VERTICES[i][2]];
+            face.neighbour = neighbour;
+            if (neighbour >= 0) {
+                const auto &neighbours = _tetrahedrons[neighbour].neighbours;
+                face.neighbourFace = static_cast<int32_t>(std::find(neighbours.begin(), neighbours.end(), tet) - neighbours.begin());
+            }
+            _cavityFaces.push_back(face);
         }
     }
 
-    // remove containing tetrahedron
-    _tetrahedrons.erase(std::remove_if(_tetrahedrons.begin(), _tetrahedrons.end(),
-                                       [](Tetrahedron &tetrahedron) { return tetrahedron.invalid; }),
-                        _tetrahedrons.end());
+    // connect every boundary face to the new probe, reusing the cavity slots first
+    _freeTetrahedrons.insert(_freeTetrahedrons.end(), _cavity.begin(), _cavity.end());
+    _faceMap.clear();
 
-    for (auto i = 0; i < triangleIndex; i++) {
-        const auto &triangle = _triangles[i];
-        if (!triangle.invalid) {
-            _tetrahedrons.emplace_back(this, triangle.vertex0, triangle.vertex1, triangle.vertex2, vertexIndex);
+    for (const auto &face : _cavityFaces) {
+        int32_t tet = 0;
+        if (_freeTetrahedrons.empty()) {
+            tet = static_cast<int32_t>(_tetrahedrons.size());
+            _tetrahedrons.emplace_back(this, face.vertex0, face.vertex1, face.vertex2, vertexIndex);
+        } else {
+            tet = _freeTetrahedrons.back();
+            _freeTetrahedrons.pop_back();
+            _tetrahedrons[tet] = Tetrahedron(this, face.vertex0, face.vertex1, face.vertex2, vertexIndex);
+        }
+
+        auto &tetrahedron = _tetrahedrons[tet];
+        tetrahedron.neighbours[3] = face.neighbour;
+        if (face.neighbour >= 0) {
+            _tetrahedrons[face.neighbour].neighbours[face.neighbourFace] = tet;
+        }
+
+        // the other three faces contain the new probe, match them with their siblings by the opposite edge
+        const int32_t vertices[3] = {face.vertex0, face.vertex1, face.vertex2};
+        for (auto i = 0; i < 3; i++) {
+            const auto key = edgeKey(vertices[(i + 1) % 3], vertices[(i + 2) % 3]);
+            const auto iter = _faceMap.find(key);
+            if (iter == _faceMap.end()) {
+                _faceMap.emplace(key, (tet << 2) | i);
+            } else {
+                const auto sibling = iter->second >> 2;
+                tetrahedron.neighbours[i] = sibling;
+                _tetrahedrons[sibling].neighbours[iter->second & 3] = tet;
+                _faceMap.erase(iter);
+            }
         }
+
+        _lastTetrahedron = tet;
     }
 }
 
 void Delaunay::reorder(const Vec3 &center) {
     // The tetrahedron in the middle is placed at the front of the vector
     std::sort(_tetrahedrons.begin(), _tetrahedrons.end(), [center](Tetrahedron &a, Tetrahedron &b) {
-        return a.sphere.center.distanceSquared(center) <= b.sphere.center.distanceSquared(center);
+        return a.sphere.center.distanceSquared(center) < b.sphere.center.distanceSquared(center);
     });
 }
 
@@ -230,22 +489,28 @@ void Delaunay::computeAdjacency() {
         triangleIndex += 4;
     }
 
+    // pair up shared triangles through a hash map instead of comparing all of them
+    CC_ASSERT(_probes.size() < (1U << 21));
+    _faceMap.clear();
+    _faceMap.reserve(triangleIndex);
     for (auto i = 0; i < triangleIndex; i++) {
-        if (!_triangles[i].isOuterFace) {
+        const auto key = triangleKey(_triangles[i]);
+        const auto iter = _faceMap.find(key);
+        if (iter == _faceMap.end()) {
+            _faceMap.emplace(key, i);
             continue;
         }
 
-        for (auto k = i + 1; k < triangleIndex; k++) {
-            if (_triangles[i].isSame(_triangles[k])) {
-                // update adjacency between tetrahedrons
-                _tetrahedrons[_triangles[i].tetrahedron].neighbours[_triangles[i].index] = _triangles[k].tetrahedron;
-                _tetrahedrons[_triangles[k].tetrahedron].neighbours[_triangles[k].index] = _triangles[i].tetrahedron;
-                _triangles[i].isOuterFace = false;
-                _triangles[k].isOuterFace = false;
-                break;
-            }
-        }
+        // update adjacency between tetrahedrons
+        auto &triangle = _triangles[iter->second];
+        _tetrahedrons[triangle.tetrahedron].neighbours[triangle.index] = _triangles[i].tetrahedron;
+        _tetrahedrons[_triangles[i].tetrahedron].neighbours[_triangles[i].index] = triangle.tetrahedron;
+        triangle.isOuterFace = false;
+        _triangles[i].isOuterFace = false;
+        _faceMap.erase(iter);
+    }
 
+    for (auto i = 0; i < triangleIndex; i++) {
         if (_triangles[i].isOuterFace) {
             auto &probe0 = _probes[_triangles[i].vertex0];
             auto &probe1 = _probes[_triangles[i].vertex1];
@@ -291,14 +556,20 @@ void Delaunay::computeAdjacency() {
         edgeIndex += 3;
     }
 
+    _faceMap.clear();
     for (auto i = 0; i < edgeIndex; i++) {
-        for (auto k = i + 1; k < edgeIndex; k++) {
-            if (_edges[i].isSame(_edges[k])) {
-                // update adjacency between outer cells
-                _tetrahedrons[_edges[i].tetrahedron].neighbours[_edges[i].index] = _edges[k].tetrahedron;
-                _tetrahedrons[_edges[k].tetrahedron].neighbours[_edges[k].index] = _edges[i].tetrahedron;
-            }
+        const auto key = edgeKey(_edges[i].vertex0, _edges[i].vertex1);
+        const auto iter = _faceMap.find(key);
+        if (iter == _faceMap.end()) {
+            _faceMap.emplace(key, i);
+            continue;
         }
+
+        // update adjacency between outer cells
+        const auto &edge = _edges[iter->second];
+        _tetrahedrons[edge.tetrahedron].neighbours[edge.index] = _edges[i].tetrahedron;
+        _tetrahedrons[_edges[i].tetrahedron].neighbours[_edges[i].index] = edge.tetrahedron;
+        _faceMap.erase(iter);
     }
 
     // normalize all convex hull probes' normal
@@ -330,7 +601,6 @@ void Delaunay::computeTetrahedronMatrix(Tetrahedron &tetrahedron) {
         p0.y - p3.y, p1.y - p3.y, p2.y - p3.y,
         p0.z - p3.z, p1.z - p3.z, p2.z - p3.z);
     tetrahedron.matrix.inverse();
-    tetrahedron.matrix.transpose();
 }
 
 void Delaunay::computeOuterCellMatrix(Tetrahedron &tetrahedron) {
@@ -386,8 +656,8 @@ void Delaunay::computeOuterCellMatrix(Tetrahedron &tetrahedron) {
         tetrahedron.vertex3 = -2;
     }
 
-    // transpose the matrix
-    tetrahedron.matrix.set(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
+    // Mat3::set takes rows, each row holds the x, y and z factors of one coefficient
+    tetrahedron.matrix.set(m[0], m[3], m[6], m[1], m[4], m[7], m[2], m[5], m[8]);
 
     // last column of mat3x4
     tetrahedron.offset.set(m[9], m[10], m[11]);
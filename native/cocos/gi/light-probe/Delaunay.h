@@ -27,6 +27,7 @@
 #pragma once
 #include "base/Macros.h"
 #include "base/std/container/array.h"
+#include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
 #include "core/geometry/AABB.h"
 #include "math/Utils.h"
@@ -226,11 +227,23 @@ public:
     ccstd::vector<Tetrahedron> build(const ccstd::vector<Vertex> &probes);
 
 private:
+    // boundary face of the cavity carved by an inserted probe
+    struct CavityFace {
+        int32_t vertex0{-1};
+        int32_t vertex1{-1};
+        int32_t vertex2{-1};
+        int32_t neighbour{-1};     // tetrahedron outside of the cavity sharing this face, -1 if none
+        int32_t neighbourFace{-1}; // index of this face in the neighbour's four triangles
+    };
+
     void reset();
     void tetrahedralize(); // Bowyer-Watson algorithm
     Vec3 initTetrahedron();
     void addTriangle(uint32_t index, int32_t tet, int32_t i, int32_t v0, int32_t v1, int32_t v2, int32_t v3);
     void addEdge(uint32_t index, int32_t tet, int32_t i, int32_t v0, int32_t v1);
+    ccstd::vector<int32_t> sortProbes(int32_t probeCount) const;
+    int32_t locate(const Vec3 &position, int32_t start) const;
+    int32_t findConflict(const Vec3 &position) const;
     void addProbe(int32_t vertexIndex);
     void reorder(const Vec3 &center);
     void computeAdjacency();
@@ -244,6 +257,13 @@ private:
     ccstd::vector<Triangle> _triangles;
     ccstd::vector<Edge> _edges;
 
+    // scratch buffers reused by every probe insertion
+    ccstd::vector<int32_t> _cavity;
+    ccstd::vector<CavityFace> _cavityFaces;
+    ccstd::vector<int32_t> _freeTetrahedrons;
+    ccstd::unordered_map<uint64_t, int32_t> _faceMap;
+    int32_t _lastTetrahedron{0};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Delaunay);
 };
 
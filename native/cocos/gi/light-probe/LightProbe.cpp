@@ -25,6 +25,9 @@
 ****************************************************************************/
 
 #include "LightProbe.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "PolynomialSolver.h"
 #include "core/Root.h"
 #include "core/scene-graph/Scene.h"
@@ -35,7 +38,15 @@
 namespace cc {
 namespace gi {
 
+namespace {
+// a moving object rarely crosses more tetrahedrons than this in a frame, a longer walk means a teleport
+constexpr int32_t MAX_WARM_START_STEPS{16};
+constexpr float TETRAHEDRONS_PER_CELL{8.0F};
+constexpr uint32_t MAX_CELL_COUNT_PER_AXIS{64U};
+} // namespace
+
 void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
+    _cellGridDirty = true;
     _probes.clear();
 
     auto pointCount = points.size();
@@ -48,6 +59,7 @@ void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
 void LightProbesData::updateTetrahedrons() {
     Delaunay delaunay;
     _tetrahedrons = delaunay.build(_probes);
+    _cellGridDirty = true;
 }
 
 bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const {
@@ -79,18 +91,80 @@ bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec
 }
 
 int32_t LightProbesData::getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const {
-    const auto tetrahedronCount = _tetrahedrons.size();
+    const auto tetrahedronCount = static_cast<int32_t>(_tetrahedrons.size());
     if (tetIndex < 0 || tetIndex >= tetrahedronCount) {
         tetIndex = 0;
     }
 
+    bool found = false;
+    return walkTetrahedrons(position, tetIndex, tetrahedronCount, weights, found);
+}
+
+bool LightProbesData::interpolateSHCoefficients(const ccstd::vector<Vec3> &positions, ccstd::vector<int32_t> &tetIndices, ccstd::vector<Vec3> &coefficients) {
+    if (!hasCoefficients()) {
+        return false;
+    }
+
+    if (_cellGridDirty) {
+        buildCellGrid();
+    }
+
+    const auto count = static_cast<uint32_t>(positions.size());
+    const auto tetrahedronCount = static_cast<int32_t>(_tetrahedrons.size());
+    tetIndices.resize(count, -1);
+    _weights.resize(count);
+
+    // locate all positions first
+    for (uint32_t i = 0; i < count; i++) {
+        const auto &position = positions[i];
+        auto tetIndex = tetIndices[i];
+        bool found = false;
+        if (tetIndex >= 0 && tetIndex < tetrahedronCount) {
+            tetIndex = walkTetrahedrons(position, tetIndex, MAX_WARM_START_STEPS, _weights[i], found);
+        }
+
+        if (!found) {
+            tetIndex = walkTetrahedrons(position, getCellTetrahedron(position), tetrahedronCount, _weights[i], found);
+        }
+
+        tetIndices[i] = tetIndex;
+    }
+
+    // then blend the coefficients, a probe's coefficients are contiguous Vec3 so they are blended as plain floats
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 must be tightly packed");
+    const auto basisCount = SH::getBasisCount();
+    const auto floatCount = basisCount * 3;
+    coefficients.resize(count * basisCount);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const auto &tetrahedron = _tetrahedrons[tetIndices[i]];
+        const auto &weights = _weights[i];
+        const auto *c0 = &_probes[tetrahedron.vertex0].coefficients[0].x;
+        const auto *c1 = &_probes[tetrahedron.vertex1].coefficients[0].x;
+        const auto *c2 = &_probes[tetrahedron.vertex2].coefficients[0].x;
+        // the weight of the missing vertex of an outer cell is 0
+        const auto *c3 = tetrahedron.vertex3 >= 0 ? &_probes[tetrahedron.vertex3].coefficients[0].x : c0;
+        const float w3 = tetrahedron.vertex3 >= 0 ? weights.w : 0.0F;
+        auto *result = &coefficients[i * basisCount].x;
+
+        for (uint32_t k = 0; k < floatCount; k++) {
+            result[k] = c0[k] * weights.x + c1[k] * weights.y + c2[k] * weights.z + c3[k] * w3;
+        }
+    }
+
+    return true;
+}
+
+int32_t LightProbesData::walkTetrahedrons(const Vec3 &position, int32_t tetIndex, int32_t maxSteps, Vec4 &weights, bool &found) const {
     int32_t lastIndex = -1;
     int32_t nextIndex = -1;
 
-    for (auto i = 0; i < tetrahedronCount; i++) {
+    found = false;
+    for (auto i = 0; i < maxSteps; i++) {
         const auto &tetrahedron = _tetrahedrons[tetIndex];
         getBarycentricCoord(position, tetrahedron, weights);
         if (weights.x >= 0.0F && weights.y >= 0.0F && weights.z >= 0.0F && weights.w >= 0.0F) {
+            found = true;
             break;
         }
 
@@ -106,6 +180,7 @@ int32_t LightProbesData::getInterpolationWeights(const Vec3 &position, int32_t t
 
         // return directly due to numerical precision error
         if (lastIndex == nextIndex) {
+            found = true;
             break;
         }
 
@@ -116,6 +191,68 @@ int32_t LightProbesData::getInterpolationWeights(const Vec3 &position, int32_t t
     return tetIndex;
 }
 
+void LightProbesData::buildCellGrid() {
+    _cellGridDirty = false;
+    _cellGrid.clear();
+    if (empty()) {
+        return;
+    }
+
+    Vec3 minPos{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    Vec3 maxPos{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for (const auto &probe : _probes) {
+        Vec3::min(minPos, probe.position, &minPos);
+        Vec3::max(maxPos, probe.position, &maxPos);
+    }
+
+    // cubic cells holding about TETRAHEDRONS_PER_CELL tetrahedrons each
+    constexpr auto minExtent = static_cast<float>(mathutils::EPSILON);
+    const Vec3 extent{std::max(maxPos.x - minPos.x, minExtent), std::max(maxPos.y - minPos.y, minExtent), std::max(maxPos.z - minPos.z, minExtent)};
+    const float cellCount = std::max(static_cast<float>(_tetrahedrons.size()) / TETRAHEDRONS_PER_CELL, 1.0F);
+    const float cellSize = std::cbrt(extent.x * extent.y * extent.z / cellCount);
+    const auto getCellCount = [cellSize](float length) {
+        return std::min(std::max(static_cast<uint32_t>(std::ceil(length / cellSize)), 1U), MAX_CELL_COUNT_PER_AXIS);
+    };
+    _cellCountX = getCellCount(extent.x);
+    _cellCountY = getCellCount(extent.y);
+    _cellCountZ = getCellCount(extent.z);
+    _cellGridMin = minPos;
+    _cellGridInvSize.set(static_cast<float>(_cellCountX) / extent.x, static_cast<float>(_cellCountY) / extent.y, static_cast<float>(_cellCountZ) / extent.z);
+    _cellGrid.resize(_cellCountX * _cellCountY * _cellCountZ);
+
+    // neighbouring cells are close, so each walk starts from the previous cell's tetrahedron
+    Vec4 weights;
+    int32_t tetIndex = 0;
+    uint32_t cellIndex = 0;
+    for (uint32_t z = 0; z < _cellCountZ; z++) {
+        for (uint32_t y = 0; y < _cellCountY; y++) {
+            for (uint32_t x = 0; x < _cellCountX; x++) {
+                const Vec3 center{minPos.x + (static_cast<float>(x) + 0.5F) * extent.x / static_cast<float>(_cellCountX),
+                                  minPos.y + (static_cast<float>(y) + 0.5F) * extent.y / static_cast<float>(_cellCountY),
+                                  minPos.z + (static_cast<float>(z) + 0.5F) * extent.z / static_cast<float>(_cellCountZ)};
+                tetIndex = getInterpolationWeights(center, tetIndex, weights);
+                _cellGrid[cellIndex++] = tetIndex;
+            }
+        }
+    }
+}
+
+int32_t LightProbesData::getCellTetrahedron(const Vec3 &position) const {
+    if (_cellGrid.empty()) {
+        return 0;
+    }
+
+    const auto getCell = [](float offset, float invSize, uint32_t count) {
+        const float cell = std::min(std::max(offset * invSize, 0.0F), static_cast<float>(count - 1));
+        return static_cast<uint32_t>(cell);
+    };
+    const auto x = getCell(position.x - _cellGridMin.x, _cellGridInvSize.x, _cellCountX);
+    const auto y = getCell(position.y - _cellGridMin.y, _cellGridInvSize.y, _cellCountY);
+    const auto z = getCell(position.z - _cellGridMin.z, _cellGridInvSize.z, _cellCountZ);
+
+    return _cellGrid[(z * _cellCountY + y) * _cellCountX + x];
+}
+
 Vec3 LightProbesData::getTriangleBarycentricCoord(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &position) {
     Vec3 normal;
     Vec3::cross(p1 - p0, p2 - p0, &normal);
@@ -48,14 +48,21 @@ public:
     LightProbesData() = default;
 
     inline ccstd::vector<Vertex> &getProbes() { return _probes; }
-    inline void setProbes(const ccstd::vector<Vertex> &probes) { _probes = probes; }
+    inline void setProbes(const ccstd::vector<Vertex> &probes) {
+        _probes = probes;
+        _cellGridDirty = true;
+    }
     inline ccstd::vector<Tetrahedron> &getTetrahedrons() { return _tetrahedrons; }
-    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) { _tetrahedrons = tetrahedrons; }
+    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) {
+        _tetrahedrons = tetrahedrons;
+        _cellGridDirty = true;
+    }
 
     inline bool empty() const { return _probes.empty() || _tetrahedrons.empty(); }
     inline void reset() {
         _probes.clear();
         _tetrahedrons.clear();
+        _cellGridDirty = true;
     }
     void updateProbes(ccstd::vector<Vec3> &points);
     void updateTetrahedrons();
@@ -63,8 +70,19 @@ public:
     bool getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const;
     int32_t getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const;
 
+    /**
+     * Interpolates the SH coefficients of many positions at once.
+     * tetIndices holds the last tetrahedron of each position as the start of the walk and receives the new one,
+     * a position too far from it is located through a uniform cell grid instead.
+     * coefficients receives SH::getBasisCount() values per position.
+     */
+    bool interpolateSHCoefficients(const ccstd::vector<Vec3> &positions, ccstd::vector<int32_t> &tetIndices, ccstd::vector<Vec3> &coefficients);
+
 private:
     inline bool hasCoefficients() const { return !empty() && !_probes[0].coefficients.empty(); }
+    int32_t walkTetrahedrons(const Vec3 &position, int32_t tetIndex, int32_t maxSteps, Vec4 &weights, bool &found) const;
+    void buildCellGrid();
+    int32_t getCellTetrahedron(const Vec3 &position) const;
     static Vec3 getTriangleBarycentricCoord(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &position);
     void getBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getTetrahedronBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
@@ -73,6 +91,17 @@ private:
 public:
     ccstd::vector<Vertex> _probes;
     ccstd::vector<Tetrahedron> _tetrahedrons;
+
+private:
+    // tetrahedron near the centre of each cell, the start of the walk for positions without a close last tetrahedron
+    ccstd::vector<int32_t> _cellGrid;
+    ccstd::vector<Vec4> _weights; // scratch of interpolateSHCoefficients
+    Vec3 _cellGridMin;
+    Vec3 _cellGridInvSize;
+    uint32_t _cellCountX{0};
+    uint32_t _cellCountY{0};
+    uint32_t _cellCountZ{0};
+    bool _cellGridDirty{true};
 };
 
 class LightProbes final {
@@ -25,11 +25,115 @@
 ****************************************************************************/
 
 #include "SH.h"
+#include <algorithm>
 #include "base/Macros.h"
+#include "base/job-system/ParallelFor.h"
+#include "math/Float4.h"
 
 namespace cc {
 namespace gi {
 
+namespace {
+
+// Samples are summed in blocks of a fixed size and the block sums are added in block order,
+// so the result does not depend on how many threads the blocks are spread over.
+constexpr uint32_t SAMPLE_BLOCK_SIZE{256};
+constexpr uint32_t MIN_BLOCKS_PER_JOB{4};
+constexpr uint32_t MIN_PROBES_PER_JOB{4};
+
+// 4-wide helpers of math/Float4.h, one sample direction per lane
+using namespace math; // NOLINT(google-build-using-namespace)
+
+// same as SH::basisFunctions, for 4 directions at once
+inline void evaluateBasis4(Float4 x, Float4 y, Float4 z, Float4 *basis) {
+    basis[0] = splat4(0.282095F);
+    basis[1] = mul4(splat4(0.488603F), y);
+    basis[2] = mul4(splat4(0.488603F), z);
+    basis[3] = mul4(splat4(0.488603F), x);
+    basis[4] = mul4(splat4(1.09255F), mul4(y, x));
+    basis[5] = mul4(splat4(1.09255F), mul4(y, z));
+    basis[6] = mul4(splat4(0.946175F), sub4(mul4(z, z), splat4(1.0F / 3.0F)));
+    basis[7] = mul4(splat4(1.09255F), mul4(z, x));
+    basis[8] = mul4(splat4(0.546274F), sub4(mul4(x, x), mul4(y, y)));
+}
+
+// sums of values[i] * basis(samples[i]) over one block, SH_BASIS_COUNT results
+void projectBlock(const Vec3 *samples, const Vec3 *values, uint32_t count, Vec3 *sums) {
+    Float4 basis[SH_BASIS_COUNT];
+    Float4 sumR[SH_BASIS_COUNT];
+    Float4 sumG[SH_BASIS_COUNT];
+    Float4 sumB[SH_BASIS_COUNT];
+    for (uint32_t j = 0; j < SH_BASIS_COUNT; j++) {
+        sumR[j] = sumG[j] = sumB[j] = splat4(0.0F);
+    }
+
+    for (uint32_t i = 0; i < count; i += 4) {
+        // the lanes past the end of the block have zero values and add nothing
+        float x[4]{};
+        float y[4]{};
+        float z[4]{};
+        float r[4]{};
+        float g[4]{};
+        float b[4]{};
+        const uint32_t laneCount = std::min(4U, count - i);
+        for (uint32_t k = 0; k < laneCount; k++) {
+            x[k] = samples[i + k].x;
+            y[k] = samples[i + k].y;
+            z[k] = samples[i + k].z;
+            r[k] = values[i + k].x;
+            g[k] = values[i + k].y;
+            b[k] = values[i + k].z;
+        }
+
+        evaluateBasis4(load4(x), load4(y), load4(z), basis);
+        const auto red = load4(r);
+        const auto green = load4(g);
+        const auto blue = load4(b);
+        for (uint32_t j = 0; j < SH_BASIS_COUNT; j++) {
+            sumR[j] = madd4(basis[j], red, sumR[j]);
+            sumG[j] = madd4(basis[j], green, sumG[j]);
+            sumB[j] = madd4(basis[j], blue, sumB[j]);
+        }
+    }
+
+    float lanes[4];
+    for (uint32_t j = 0; j < SH_BASIS_COUNT; j++) {
+        store4(lanes, sumR[j]);
+        sums[j].x = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        store4(lanes, sumG[j]);
+        sums[j].y = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        store4(lanes, sumB[j]);
+        sums[j].z = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+}
+
+inline uint32_t getBlockCount(uint32_t sampleCount) {
+    return (sampleCount + SAMPLE_BLOCK_SIZE - 1) / SAMPLE_BLOCK_SIZE;
+}
+
+void projectBlocks(const Vec3 *samples, const Vec3 *values, uint32_t sampleCount, uint32_t begin, uint32_t end, Vec3 *blockSums) {
+    for (uint32_t block = begin; block < end; block++) {
+        const uint32_t offset = block * SAMPLE_BLOCK_SIZE;
+        projectBlock(samples + offset, values + offset, std::min(SAMPLE_BLOCK_SIZE, sampleCount - offset), blockSums + block * SH_BASIS_COUNT);
+    }
+}
+
+// adds the block sums in block order and applies the Monte Carlo weight
+void reduceBlocks(const Vec3 *blockSums, uint32_t sampleCount, Vec3 *coefficients) {
+    const auto scale = 1.0F / (LightProbeSampler::uniformSpherePdf() * static_cast<float>(sampleCount));
+    const uint32_t blockCount = getBlockCount(sampleCount);
+    for (uint32_t j = 0; j < SH_BASIS_COUNT; j++) {
+        Vec3 coefficient{0.0F, 0.0F, 0.0F};
+        for (uint32_t block = 0; block < blockCount; block++) {
+            coefficient += blockSums[block * SH_BASIS_COUNT + j];
+        }
+
+        coefficients[j] = coefficient * scale;
+    }
+}
+
+} // namespace
+
 Vec3 LightProbeSampler::uniformSampleSphere(float u1, float u2) {
     float z = 1.0F - 2.0F * u1;
     float r = std::sqrt(std::max(0.0F, 1.0F - z * z));
@@ -206,27 +310,41 @@ Vec3 SH::evaluate(const Vec3& sample, const ccstd::vector<Vec3>& coefficients) {
     return result;
 }
 
-ccstd::vector<Vec3> SH::project(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values) {
+ccstd::vector<Vec3> SH::project(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, JobSystem* jobSystem) {
     CC_ASSERT(!samples.empty() && samples.size() == values.size());
 
     // integral using Monte Carlo method
-    const auto basisCount = getBasisCount();
-    const auto sampleCount = samples.size();
-    const auto scale = 1.0F / (LightProbeSampler::uniformSpherePdf() * static_cast<float>(sampleCount));
+    const auto sampleCount = static_cast<uint32_t>(samples.size());
+    ccstd::vector<Vec3> blockSums(getBlockCount(sampleCount) * SH_BASIS_COUNT);
+    parallelFor(jobSystem ? jobSystem : JobSystem::getInstance(), getBlockCount(sampleCount), MIN_BLOCKS_PER_JOB, [&](uint32_t begin, uint32_t end) {
+        projectBlocks(samples.data(), values.data(), sampleCount, begin, end, blockSums.data());
+    });
 
-    ccstd::vector<Vec3> coefficients;
-    coefficients.reserve(basisCount);
+    ccstd::vector<Vec3> coefficients(getBasisCount());
+    reduceBlocks(blockSums.data(), sampleCount, coefficients.data());
 
-    for (auto i = 0; i < basisCount; i++) {
-        Vec3 coefficient{0.0F, 0.0F, 0.0F};
+    return coefficients;
+}
+
+void SH::projectProbes(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, ccstd::vector<Vec3>& coefficients, JobSystem* jobSystem) {
+    CC_ASSERT(!samples.empty() && values.size() % samples.size() == 0);
 
-        for (auto k = 0; k < sampleCount; k++) {
-            coefficient += values[k] * evaluateBasis(i, samples[k]);
+    const auto sampleCount = static_cast<uint32_t>(samples.size());
+    const auto probeCount = static_cast<uint32_t>(values.size() / samples.size());
+    coefficients.resize(probeCount * getBasisCount());
+
+    parallelFor(jobSystem ? jobSystem : JobSystem::getInstance(), probeCount, MIN_PROBES_PER_JOB, [&](uint32_t begin, uint32_t end) {
+        ccstd::vector<Vec3> blockSums(getBlockCount(sampleCount) * SH_BASIS_COUNT);
+        for (uint32_t probe = begin; probe < end; probe++) {
+            projectBlocks(samples.data(), values.data() + probe * sampleCount, sampleCount, 0U, getBlockCount(sampleCount), blockSums.data());
+            reduceBlocks(blockSums.data(), sampleCount, coefficients.data() + probe * SH_BASIS_COUNT);
         }
+    });
+}
 
-        coefficient *= scale;
-        coefficients.push_back(coefficient);
-    }
+ccstd::vector<Vec3> SH::projectProbes(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, JobSystem* jobSystem) {
+    ccstd::vector<Vec3> coefficients;
+    projectProbes(samples, values, coefficients, jobSystem);
 
     return coefficients;
 }
@@ -28,6 +28,7 @@
 
 #include <cmath>
 #include <functional>
+#include "base/job-system/JobSystem.h"
 #include "base/std/container/vector.h"
 #include "core/TypedArray.h"
 #include "math/Math.h"
@@ -79,9 +80,16 @@ public:
     static Vec3 evaluate(const Vec3& sample, const ccstd::vector<Vec3>& coefficients);
 
     /**
-     * project a function to sh coefficients
+     * project a function to sh coefficients, split over the workers of jobSystem or of the shared one when null
      */
-    static ccstd::vector<Vec3> project(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values);
+    static ccstd::vector<Vec3> project(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, JobSystem* jobSystem = nullptr);
+
+    /**
+     * project the functions of many probes sharing the same samples, values holds samples.size() values per probe
+     * and coefficients receives getBasisCount() coefficients per probe, same results as calling project per probe
+     */
+    static void projectProbes(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, ccstd::vector<Vec3>& coefficients, JobSystem* jobSystem = nullptr);
+    static ccstd::vector<Vec3> projectProbes(const ccstd::vector<Vec3>& samples, const ccstd::vector<Vec3>& values, JobSystem* jobSystem = nullptr);
 
     /**
      * calculate irradiance's sh coefficients from radiance's sh coefficients directly
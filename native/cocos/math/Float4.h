@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2020-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+
+#if defined(__SSE__)
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+#endif
+
+namespace cc {
+namespace math {
+
+// 4-wide float helpers on SSE, NEON or plain arrays.
+// madd4 always rounds the product before the sum, so all the paths give the same results.
+#if defined(__SSE__)
+using Float4 = __m128;
+using Mask4 = __m128;
+
+inline Float4 splat4(float v) { return _mm_set1_ps(v); }
+inline Float4 set4(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+inline Float4 load4(const float *p) { return _mm_loadu_ps(p); }
+inline void store4(float *p, Float4 v) { _mm_storeu_ps(p, v); }
+inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+inline Float4 madd4(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline Float4 min4(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+inline Mask4 greaterEqual4(Float4 a, Float4 b) { return _mm_cmpge_ps(a, b); }
+inline Mask4 and4(Mask4 a, Mask4 b) { return _mm_and_ps(a, b); }
+inline bool any4(Mask4 m) { return _mm_movemask_ps(m) != 0; }
+inline Float4 select4(Mask4 m, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+using Float4 = float32x4_t;
+using Mask4 = uint32x4_t;
+
+inline Float4 splat4(float v) { return vdupq_n_f32(v); }
+inline Float4 set4(float a, float b, float c, float d) {
+    const float v[4] = {a, b, c, d};
+    return vld1q_f32(v);
+}
+inline Float4 load4(const float *p) { return vld1q_f32(p); }
+inline void store4(float *p, Float4 v) { vst1q_f32(p, v); }
+inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+// not vmlaq_f32, which may be fused on AArch64
+inline Float4 madd4(Float4 a, Float4 b, Float4 c) { return vaddq_f32(vmulq_f32(a, b), c); }
+inline Float4 min4(Float4 a, Float4 b) { return vminq_f32(a, b); }
+inline Mask4 greaterEqual4(Float4 a, Float4 b) { return vcgeq_f32(a, b); }
+inline Mask4 and4(Mask4 a, Mask4 b) { return vandq_u32(a, b); }
+inline bool any4(Mask4 m) {
+    const auto half = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+    return (vget_lane_u32(half, 0) | vget_lane_u32(half, 1)) != 0;
+}
+inline Float4 select4(Mask4 m, Float4 a, Float4 b) { return vbslq_f32(m, a, b); }
+#else
+struct Float4 {
+    float v[4];
+};
+struct Mask4 {
+    bool v[4];
+};
+
+inline Float4 splat4(float v) { return {{v, v, v, v}}; }
+inline Float4 set4(float a, float b, float c, float d) { return {{a, b, c, d}}; }
+inline Float4 load4(const float *p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store4(float *p, Float4 v) { std::copy(v.v, v.v + 4, p); }
+inline Float4 add4(Float4 a, Float4 b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+inline Float4 sub4(Float4 a, Float4 b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+inline Float4 mul4(Float4 a, Float4 b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+inline Float4 madd4(Float4 a, Float4 b, Float4 c) { return add4(mul4(a, b), c); }
+inline Float4 min4(Float4 a, Float4 b) {
+    return {{std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3])}};
+}
+inline Mask4 greaterEqual4(Float4 a, Float4 b) { return {{a.v[0] >= b.v[0], a.v[1] >= b.v[1], a.v[2] >= b.v[2], a.v[3] >= b.v[3]}}; }
+inline Mask4 and4(Mask4 a, Mask4 b) { return {{a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3]}}; }
+inline bool any4(Mask4 m) { return m.v[0] || m.v[1] || m.v[2] || m.v[3]; }
+inline Float4 select4(Mask4 m, Float4 a, Float4 b) {
+    return {{m.v[0] ? a.v[0] : b.v[0], m.v[1] ? a.v[1] : b.v[1], m.v[2] ? a.v[2] : b.v[2], m.v[3] ? a.v[3] : b.v[3]}};
+}
+#endif
+
+} // namespace math
+} // namespace cc
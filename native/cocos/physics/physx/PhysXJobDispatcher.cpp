@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "physics/physx/PhysXJobDispatcher.h"
+#include <algorithm>
+#include "base/memory/Memory.h"
+
+namespace cc {
+namespace physics {
+
+PhysXJobDispatcher::PhysXJobDispatcher(uint32_t workerCount)
+: _mWorkerCount(workerCount) {}
+
+PhysXJobDispatcher::~PhysXJobDispatcher() {
+    wait();
+}
+
+void PhysXJobDispatcher::submitTask(physx::PxBaseTask &task) {
+    if (!_mWorkerCount) {
+        task.run();
+        task.release();
+        return;
+    }
+    // counted before the enqueue, a worker seeing the count keeps polling until the task shows up
+    _mPendingTasks.fetch_add(1);
+    _mTasks.enqueue(&task);
+    kickWorker();
+}
+
+void PhysXJobDispatcher::simulate(physx::PxScene &scene, float dt) {
+    CC_ASSERT(!_mSimulating);
+
+    _mMaxWorkers = std::min(_mWorkerCount, JobSystem::getInstance()->threadCount());
+    _mCompletion.reset();
+    _mCompletion.setContinuation(*scene.getTaskManager(), nullptr);
+    scene.simulate(dt, &_mCompletion);
+    _mCompletion.removeReference();
+    _mSimulating = true;
+}
+
+void PhysXJobDispatcher::wait() {
+    if (!_mSimulating) return;
+
+    // the tasks queued after this are picked up by the workers
+    while (runOne()) {
+    }
+    _mCompletion.wait();
+
+    // nothing is submitted after the completion task, but the last workers may still be returning
+    ccstd::vector<JobGraph *> graphs;
+    {
+        std::lock_guard<std::mutex> lock(_mGraphMutex);
+        graphs.swap(_mGraphs);
+    }
+    for (auto *graph : graphs) {
+        graph->waitForAll();
+        CC_SAFE_DELETE(graph);
+    }
+    _mSimulating = false;
+}
+
+bool PhysXJobDispatcher::runOne() {
+    physx::PxBaseTask *task = nullptr;
+    if (!_mTasks.try_dequeue(task)) {
+        return false;
+    }
+    _mPendingTasks.fetch_sub(1);
+    task->run();
+    task->release();
+    return true;
+}
+
+bool PhysXJobDispatcher::acquireWorker() {
+    uint32_t active = _mActiveWorkers.load();
+    while (active < _mMaxWorkers) {
+        if (_mActiveWorkers.compare_exchange_weak(active, active + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PhysXJobDispatcher::kickWorker() {
+    if (!acquireWorker()) {
+        return;
+    }
+    auto *graph = ccnew JobGraph(JobSystem::getInstance());
+    graph->createJob([this]() {
+        work();
+    });
+    {
+        std::lock_guard<std::mutex> lock(_mGraphMutex);
+        _mGraphs.emplace_back(graph);
+    }
+    graph->run();
+}
+
+void PhysXJobDispatcher::work() {
+    do {
+        while (runOne()) {
+        }
+        _mActiveWorkers.fetch_sub(1);
+        // a task submitted while every worker was still active did not start a new one
+    } while (_mPendingTasks.load() && acquireWorker());
+}
+
+} // namespace physics
+} // namespace cc
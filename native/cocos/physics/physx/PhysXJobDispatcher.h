@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/vector.h"
+#include "concurrentqueue/concurrentqueue.h"
+#include "physics/physx/PhysXInc.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * Runs PhysX simulation tasks on the engine job system instead of dedicated PhysX threads.
+ * Tasks are queued and drained by job system workers, which return once the queue is empty,
+ * submitTask starts a new worker when fewer than the worker count are draining.
+ * The thread waiting for the step helps draining and then sleeps until the step completes.
+ * With a worker count of 0 every task runs inline where it is submitted, like PxDefaultCpuDispatcher(0).
+ */
+class PhysXJobDispatcher final : public physx::PxCpuDispatcher {
+public:
+    explicit PhysXJobDispatcher(uint32_t workerCount);
+    ~PhysXJobDispatcher() override;
+
+    void submitTask(physx::PxBaseTask &task) override;
+    uint32_t getWorkerCount() const override { return _mWorkerCount; }
+
+    // Only takes effect for the next step.
+    inline void setWorkerCount(uint32_t count) { _mWorkerCount = count; }
+
+    /**
+     * Kicks off a simulation step, returns once the solve has been handed to the workers.
+     * `wait` must be called before `fetchResults` of the scene.
+     */
+    void simulate(physx::PxScene &scene, float dt);
+    void wait();
+    inline bool isSimulating() const { return _mSimulating; }
+
+private:
+    class CompletionTask final : public physx::PxLightCpuTask {
+    public:
+        void run() override {
+            std::lock_guard<std::mutex> lock(_mMutex);
+            _mDone = true;
+            _mCondition.notify_all();
+        }
+        const char *getName() const override { return "PhysXJobDispatcher.completion"; }
+
+        inline void reset() { _mDone = false; }
+        inline void wait() {
+            std::unique_lock<std::mutex> lock(_mMutex);
+            _mCondition.wait(lock, [this]() { return _mDone; });
+        }
+
+    private:
+        std::mutex _mMutex;
+        std::condition_variable _mCondition;
+        bool _mDone{false};
+    };
+
+    bool runOne();
+    bool acquireWorker();
+    void kickWorker();
+    void work();
+
+    moodycamel::ConcurrentQueue<physx::PxBaseTask *> _mTasks;
+    CompletionTask _mCompletion;
+    // queued tasks not dequeued yet, workers recheck it after leaving so that no task is stranded
+    std::atomic<uint32_t> _mPendingTasks{0};
+    std::atomic<uint32_t> _mActiveWorkers{0};
+    // workers allowed during the current step
+    uint32_t _mMaxWorkers{0};
+    std::mutex _mGraphMutex;
+    ccstd::vector<JobGraph *> _mGraphs;
+    uint32_t _mWorkerCount{0};
+    bool _mSimulating{false};
+};
+
+} // namespace physics
+} // namespace cc
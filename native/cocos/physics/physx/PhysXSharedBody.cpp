@@ -64,6 +64,12 @@ PhysXSharedBody::PhysXSharedBody(
                                   _mWrappedBody(body) {
     _mImpl.ptr = 0;
     _mNode = node;
+    // Fires for the node itself and whenever an ancestor moves, i.e. whenever the world transform gets dirty.
+    _mTransformEventID = _mNode->on<Node::AncestorTransformChanged>([this](Node *emitter, TransformBit dirtyBit) {
+        if (!isInWorld() || emitter == _mWrappedWorld->getSyncingNode()) return;
+        if (!_mDirtyBits) _mWrappedWorld->addDirtyBody(this);
+        _mDirtyBits |= static_cast<uint32_t>(dirtyBit);
+    });
 };
 
 PhysXSharedBody *PhysXSharedBody::getSharedBody(const Node *node, PhysXWorld *const world, PhysXRigidBody *const body) {
@@ -86,6 +92,8 @@ PhysXSharedBody *PhysXSharedBody::getSharedBody(const Node *node, PhysXWorld *co
 }
 
 PhysXSharedBody::~PhysXSharedBody() {
+    _mNode->off(_mTransformEventID);
+    if (_mDirtyBits) _mWrappedWorld->removeDirtyBody(this);
     sharedBodesMap.erase(_mNode);
     if (_mStaticActor != nullptr) PX_RELEASE(_mStaticActor);
     if (_mDynamicActor != nullptr) PX_RELEASE(_mDynamicActor);
@@ -188,6 +196,7 @@ void PhysXSharedBody::initDynamicActor() {
         if (!transform.q.isUnit()) transform.q = PxQuat{PxIdentity};
         PxPhysics &phy = PxGetPhysics();
         _mDynamicActor = phy.createRigidDynamic(transform);
+        _mDynamicActor->userData = this;
         _mDynamicActor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, isKinematic());
     }
 }
@@ -207,7 +216,8 @@ void PhysXSharedBody::syncScale() {
 }
 
 void PhysXSharedBody::syncSceneToPhysics() {
-    uint32_t getChangedFlags = getNode()->getChangedFlags();
+    const uint32_t getChangedFlags = _mDirtyBits;
+    _mDirtyBits = 0;
     if (getChangedFlags) {
         if (getChangedFlags & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
         auto wp = getImpl().rigidActor->getGlobalPose();
@@ -247,13 +257,22 @@ void PhysXSharedBody::syncSceneWithCheck() {
     }
 }
 
-void PhysXSharedBody::syncPhysicsToScene() {
-    if (isStaticOrKinematic()) return;
-    if (_mDynamicActor->isSleeping()) return;
-    const PxTransform &wp = getImpl().rigidActor->getGlobalPose();
-    getNode()->setWorldPosition(wp.p.x, wp.p.y, wp.p.z);
-    getNode()->setWorldRotation(wp.q.x, wp.q.y, wp.q.z, wp.q.w);
+void PhysXSharedBody::syncPhysicsToScene(const Mat4 *parentInvMatrix, const Quaternion &parentInvRotation) {
+    const PxTransform &wp = _mDynamicActor->getGlobalPose();
+    Vec3 position{wp.p.x, wp.p.y, wp.p.z};
+    Quaternion rotation{wp.q.x, wp.q.y, wp.q.z, wp.q.w};
+    if (parentInvMatrix) {
+        position.transformMat4(*parentInvMatrix);
+        Quaternion localRotation{parentInvRotation};
+        localRotation.multiply(rotation);
+        rotation = localRotation;
+    }
+    // one local write instead of setWorldPosition + setWorldRotation, which invert the parent each
+    getNode()->setRTS(&rotation, &position, nullptr);
     getNode()->setChangedFlags(getNode()->getChangedFlags() | static_cast<uint32_t>(TransformBit::POSITION) | static_cast<uint32_t>(TransformBit::ROTATION));
+    // Node::invalidateChildren does not emit again while the node is both dirty and changed, resolving the
+    // world transform now lets a script move in the same frame, e.g. from a collision callback, reach PhysX.
+    getNode()->updateWorldTransform();
 }
 
 void PhysXSharedBody::addShape(const PhysXShape &shape) {
@@ -67,7 +67,11 @@ public:
     void syncScale();
     void syncSceneToPhysics();
     void syncSceneWithCheck();
-    void syncPhysicsToScene();
+    // `parentInvMatrix` and `parentInvRotation` are the inverse world transform of the node's parent,
+    // passed in so that bodies sharing a parent only invert it once, null for root nodes.
+    void syncPhysicsToScene(const Mat4 *parentInvMatrix, const Quaternion &parentInvRotation);
+    inline uint32_t getDirtyBits() const { return _mDirtyBits; }
+    inline void clearDirtyBits() { _mDirtyBits = 0; }
     void addShape(const PhysXShape &shape);
     void removeShape(const PhysXShape &shape);
     void addJoint(const PhysXJoint &joint, physx::PxJointActorIndex::Enum index);
@@ -94,6 +98,9 @@ private:
     physx::PxRigidStatic *_mStaticActor;
     physx::PxRigidDynamic *_mDynamicActor;
     PhysXWorld *_mWrappedWorld;
+    // TransformBit accumulated since the last scene-to-physics sync
+    uint32_t _mDirtyBits{0};
+    Node::AncestorTransformChanged::EventID _mTransformEventID;
     PhysXRigidBody *_mWrappedBody;
     ccstd::vector<PhysXShape *> _mWrappedShapes;
     ccstd::vector<PhysXJoint *> _mWrappedJoints0;
@@ -24,6 +24,9 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXWorld.h"
+#include <algorithm>
+#include <cstring>
+#include "base/job-system/ParallelFor.h"
 #include "base/memory/Memory.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
@@ -70,7 +73,7 @@ PhysXWorld::PhysXWorld() {
 #endif
     _mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *_mFoundation, scale, true, pvd);
     PxInitExtensions(*_mPhysics, pvd);
-    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    _mDispatcher = ccnew PhysXJobDispatcher(JobSystem::getInstance()->threadCount());
 
     _mEventMgr = ccnew PhysXEventManager();
 
@@ -80,6 +83,7 @@ PhysXWorld::PhysXWorld() {
     sceneDesc.kineKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_ACTIVE_ACTORS;
     sceneDesc.filterShader = simpleFilterShader;
     sceneDesc.simulationEventCallback = &_mEventMgr->getEventCallback();
     _mScene = _mPhysics->createScene(sceneDesc);
@@ -90,13 +94,17 @@ PhysXWorld::PhysXWorld() {
 }
 
 PhysXWorld::~PhysXWorld() {
+    if (_mDispatcher->isSimulating()) {
+        _mDispatcher->wait();
+        _mScene->fetchResults(true);
+    }
     auto &materialMap = getPxMaterialMap();
     // clear material cache
     materialMap.clear();
     delete _mEventMgr;
     PhysXJoint::releaseTempRigidActor();
     PX_RELEASE(_mScene);
-    PX_RELEASE(_mDispatcher);
+    delete _mDispatcher;
     PX_RELEASE(_mPhysics);
 #ifdef CC_DEBUG
     physx::PxPvdTransport *transport = _mPvd->getTransport();
@@ -110,11 +118,32 @@ PhysXWorld::~PhysXWorld() {
 }
 
 void PhysXWorld::step(float fixedTimeStep) {
-    _mScene->simulate(fixedTimeStep);
+    if (_mSplitSimulation) {
+        fetchResults();
+        _mDispatcher->simulate(*_mScene, fixedTimeStep);
+        return;
+    }
+    _mDispatcher->simulate(*_mScene, fixedTimeStep);
+    fetchResults();
+}
+
+void PhysXWorld::fetchResults() {
+    if (!_mDispatcher->isSimulating()) return;
+    _mDispatcher->wait();
     _mScene->fetchResults(true);
     syncPhysicsToScene();
 }
 
+void PhysXWorld::setSimulationWorkerCount(uint32_t count) {
+    fetchResults();
+    _mDispatcher->setWorkerCount(count);
+}
+
+void PhysXWorld::setSplitSimulation(bool val) {
+    if (!val) fetchResults();
+    _mSplitSimulation = val;
+}
+
 void PhysXWorld::setGravity(float x, float y, float z) {
     _mScene->setGravity(physx::PxVec3(x, y, z));
 }
@@ -217,9 +246,22 @@ void PhysXWorld::emitEvents() {
 }
 
 void PhysXWorld::syncSceneToPhysics() {
-    for (auto const &sb : _mSharedBodies) {
+    for (auto const &sb : _mDirtyBodies) {
         sb->syncSceneToPhysics();
     }
+    _mDirtyBodies.clear();
+}
+
+void PhysXWorld::addDirtyBody(PhysXSharedBody *sb) {
+    _mDirtyBodies.push_back(sb);
+}
+
+void PhysXWorld::removeDirtyBody(PhysXSharedBody *sb) {
+    auto iter = std::find(_mDirtyBodies.begin(), _mDirtyBodies.end(), sb);
+    if (iter != _mDirtyBodies.end()) {
+        _mDirtyBodies.erase(iter);
+    }
+    sb->clearDirtyBits();
 }
 
 uint32_t PhysXWorld::getMaskByIndex(uint32_t i) {
@@ -228,9 +270,40 @@ uint32_t PhysXWorld::getMaskByIndex(uint32_t i) {
 }
 
 void PhysXWorld::syncPhysicsToScene() {
-    for (auto const &sb : _mSharedBodies) {
-        sb->syncPhysicsToScene();
+    // Only actors that moved in the last step are reported, sleeping bodies cost nothing.
+    physx::PxU32 activeCount = 0;
+    physx::PxActor **activeActors = _mScene->getActiveActors(activeCount);
+
+    _mActiveBodies.clear();
+    for (physx::PxU32 i = 0; i < activeCount; ++i) {
+        auto *sb = static_cast<PhysXSharedBody *>(activeActors[i]->userData);
+        if (!sb || !sb->isDynamic()) continue;
+        Node *parent = sb->getNode()->getParent();
+        uint32_t depth = 0;
+        for (Node *node = parent; node; node = node->getParent()) ++depth;
+        _mActiveBodies.push_back({depth, parent, sb});
+    }
+
+    // Ancestors first so nested bodies see their parent's new pose, siblings grouped to share the parent inverse.
+    std::sort(_mActiveBodies.begin(), _mActiveBodies.end(), [](const ActiveBody &lhs, const ActiveBody &rhs) {
+        return lhs.depth != rhs.depth ? lhs.depth < rhs.depth : lhs.parent < rhs.parent;
+    });
+
+    Node *lastParent = nullptr;
+    Mat4 parentInvMatrix;
+    Quaternion parentInvRotation;
+    for (const auto &active : _mActiveBodies) {
+        if (active.parent && active.parent != lastParent) {
+            lastParent = active.parent;
+            parentInvMatrix = lastParent->getWorldMatrix();
+            parentInvMatrix.inverse();
+            parentInvRotation = lastParent->getWorldRotation().getConjugated();
+        }
+        // descendants of the written node are still marked dirty, e.g. kinematic children of a dynamic body
+        _mSyncingNode = active.body->getNode();
+        active.body->syncPhysicsToScene(active.parent ? &parentInvMatrix : nullptr, parentInvRotation);
     }
+    _mSyncingNode = nullptr;
 }
 
 void PhysXWorld::syncSceneWithCheck() {
@@ -259,6 +332,7 @@ void PhysXWorld::removeActor(const PhysXSharedBody &sb) {
     if (iter != end) {
         _mScene->removeActor(*(const_cast<PhysXSharedBody &>(sb).getImpl().rigidActor), true);
         _mSharedBodies.erase(iter);
+        if (sb.getDirtyBits()) removeDirtyBody(&const_cast<PhysXSharedBody &>(sb));
     }
 }
 
@@ -331,6 +405,133 @@ RaycastResult &PhysXWorld::raycastClosestResult() {
     return hit;
 }
 
+namespace {
+
+constexpr uint32_t MIN_QUERIES_PER_JOB{64};
+
+inline uint32_t readUint32(const float *data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline physx::PxVec3 readVec3(const float *data) {
+    return physx::PxVec3{data[0], data[1], data[2]};
+}
+
+bool writeHit(float *hit, const physx::PxShape *shape, float distance, const physx::PxVec3 &point, const physx::PxVec3 &normal) {
+    const auto &shapeMap = getPxShapeMap();
+    const auto shapeIter = shapeMap.find(reinterpret_cast<uintptr_t>(shape));
+    if (shapeIter == shapeMap.end()) return false;
+    memcpy(hit + SceneQueryLayout::HIT_SHAPE, &shapeIter->second, sizeof(uint32_t));
+    hit[SceneQueryLayout::HIT_DISTANCE] = distance;
+    memcpy(hit + SceneQueryLayout::HIT_POINT, &point.x, sizeof(float) * 3);
+    memcpy(hit + SceneQueryLayout::HIT_NORMAL, &normal.x, sizeof(float) * 3);
+    return true;
+}
+
+// Scratch hit buffers of one job, reused by all the queries it runs.
+struct SceneQueryScratch {
+    ccstd::vector<physx::PxRaycastHit> raycastHits;
+    ccstd::vector<physx::PxOverlapHit> overlapHits;
+};
+
+uint32_t runSceneQuery(const physx::PxScene &scene, const float *query, uint32_t maxHits, float *hits, SceneQueryScratch &scratch) {
+    const auto type = static_cast<ESceneQueryType>(readUint32(query + SceneQueryLayout::TYPE));
+    const bool queryTrigger = readUint32(query + SceneQueryLayout::FLAGS) & SceneQueryLayout::FLAG_QUERY_TRIGGER;
+    const physx::PxVec3 origin = readVec3(query + SceneQueryLayout::ORIGIN);
+    physx::PxVec3 unitDir = readVec3(query + SceneQueryLayout::DIRECTION);
+    unitDir.normalize();
+    const float distance = query[SceneQueryLayout::DISTANCE];
+    const physx::PxHitFlags flags = physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL;
+
+    physx::PxSceneQueryFilterData filterData;
+    filterData.data.word0 = readUint32(query + SceneQueryLayout::MASK);
+    filterData.data.word3 = QUERY_FILTER | (queryTrigger ? 0 : QUERY_CHECK_TRIGGER);
+    filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+
+    uint32_t hitCount = 0;
+    switch (type) {
+        case ESceneQueryType::RAYCAST: {
+            scratch.raycastHits.resize(maxHits);
+            bool blocking = false;
+            const auto touches = physx::PxSceneQueryExt::raycastMultiple(
+                scene, origin, unitDir, distance, flags, scratch.raycastHits.data(), maxHits, blocking,
+                filterData, &getQueryFilterShader());
+            // -1 means the buffer overflowed, it is full then
+            const auto count = touches < 0 ? maxHits : static_cast<uint32_t>(touches);
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto &hit = scratch.raycastHits[i];
+                if (writeHit(hits + hitCount * SceneQueryLayout::HIT_STRIDE, hit.shape, hit.distance, hit.position, hit.normal)) ++hitCount;
+            }
+            break;
+        }
+        case ESceneQueryType::RAYCAST_CLOSEST: {
+            filterData.data.word3 |= QUERY_SINGLE_HIT;
+            physx::PxRaycastHit hit;
+            if (physx::PxSceneQueryExt::raycastSingle(scene, origin, unitDir, distance, flags, hit, filterData, &getQueryFilterShader()) &&
+                writeHit(hits, hit.shape, hit.distance, hit.position, hit.normal)) {
+                hitCount = 1;
+            }
+            break;
+        }
+        case ESceneQueryType::SWEEP_SPHERE_CLOSEST: {
+            filterData.data.word3 |= QUERY_SINGLE_HIT;
+            const physx::PxSphereGeometry sphere{query[SceneQueryLayout::RADIUS]};
+            physx::PxSweepHit hit;
+            if (physx::PxSceneQueryExt::sweepSingle(scene, sphere, physx::PxTransform{origin}, unitDir, distance, flags, hit, filterData, &getQueryFilterShader()) &&
+                writeHit(hits, hit.shape, hit.distance, hit.position, hit.normal)) {
+                hitCount = 1;
+            }
+            break;
+        }
+        case ESceneQueryType::OVERLAP_SPHERE: {
+            scratch.overlapHits.resize(maxHits);
+            const physx::PxSphereGeometry sphere{query[SceneQueryLayout::RADIUS]};
+            const auto overlaps = physx::PxSceneQueryExt::overlapMultiple(
+                scene, sphere, physx::PxTransform{origin}, scratch.overlapHits.data(), maxHits, filterData, &getQueryFilterShader());
+            const auto count = overlaps < 0 ? maxHits : static_cast<uint32_t>(overlaps);
+            for (uint32_t i = 0; i < count; ++i) {
+                // overlaps carry no contact information, report the query origin
+                if (writeHit(hits + hitCount * SceneQueryLayout::HIT_STRIDE, scratch.overlapHits[i].shape, 0.0F, origin, physx::PxVec3{physx::PxZero})) ++hitCount;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return hitCount;
+}
+
+} // namespace
+
+uint32_t PhysXWorld::sceneQueryBatch(const float *queries, uint32_t queryCount, uint32_t maxHitsPerQuery,
+                                     float *hits, uint32_t *hitCounts) {
+    if (!queryCount || !maxHitsPerQuery) return 0;
+
+    // initialize the shared lookups on this thread, the jobs only read them
+    getPxShapeMap();
+    getQueryFilterShader();
+
+    const physx::PxScene &scene = *_mScene;
+    const uint32_t hitStride = maxHitsPerQuery * SceneQueryLayout::HIT_STRIDE;
+    auto runRange = [&](uint32_t begin, uint32_t end) {
+        SceneQueryScratch scratch;
+        for (uint32_t i = begin; i < end; ++i) {
+            hitCounts[i] = runSceneQuery(scene, queries + i * SceneQueryLayout::QUERY_STRIDE, maxHitsPerQuery, hits + i * hitStride, scratch);
+        }
+    };
+
+    // PhysX scene queries are safe to run concurrently as long as nobody writes to the scene
+    parallelFor(queryCount, MIN_QUERIES_PER_JOB, runRange);
+
+    uint32_t totalHits = 0;
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        totalHits += hitCounts[i];
+    }
+    return totalHits;
+}
+
 uint32_t PhysXWorld::addPXObject(uintptr_t PXObjectPtr) {
     uint32_t pxObjectID = _msPXObjectID;
     _msPXObjectID++;
@@ -32,6 +32,7 @@
 #include "physics/physx/PhysXEventManager.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
+#include "physics/physx/PhysXJobDispatcher.h"
 #include "physics/physx/PhysXRigidBody.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/spec/IWorld.h"
@@ -56,6 +57,8 @@ public:
     bool raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &raycastResult() override;
     RaycastResult &raycastClosestResult() override;
+    uint32_t sceneQueryBatch(const float *queries, uint32_t queryCount, uint32_t maxHitsPerQuery,
+                             float *hits, uint32_t *hitCounts) override;
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
     uint32_t createHeightField(HeightFieldDesc &desc) override;
@@ -78,11 +81,28 @@ public:
     }
 
     inline physx::PxScene &getScene() const { return *_mScene; }
+
+    // Number of job system workers solving a step, 0 runs the whole step on the calling thread.
+    void setSimulationWorkerCount(uint32_t count) override;
+    inline uint32_t getSimulationWorkerCount() const { return _mDispatcher->getWorkerCount(); }
+
+    // When enabled, step() only kicks off the solve and returns, its results are fetched
+    // at the start of the next step so rendering overlaps the simulation, at one step of latency.
+    void setSplitSimulation(bool val) override;
+    inline bool isSplitSimulation() const { return _mSplitSimulation; }
+    void fetchResults();
+
     uint32_t getMaskByIndex(uint32_t i);
     void syncPhysicsToScene();
     void addActor(const PhysXSharedBody &sb);
     void removeActor(const PhysXSharedBody &sb);
 
+    // Bodies whose node transform changed since the last syncSceneToPhysics.
+    void addDirtyBody(PhysXSharedBody *sb);
+    void removeDirtyBody(PhysXSharedBody *sb);
+    // Node being written by syncPhysicsToScene, its own transform event must not be echoed back to PhysX.
+    inline const Node *getSyncingNode() const { return _mSyncingNode; }
+
     //Mapping PhysX Object ID and Pointer
     uint32_t addPXObject(uintptr_t PXObjectPtr);
     void removePXObject(uint32_t pxObjectID);
@@ -103,11 +123,20 @@ private:
 #ifdef CC_DEBUG
     physx::PxPvd *_mPvd;
 #endif
-    physx::PxDefaultCpuDispatcher *_mDispatcher;
+    PhysXJobDispatcher *_mDispatcher;
     physx::PxScene *_mScene;
     PhysXEventManager *_mEventMgr;
+    bool _mSplitSimulation{false};
     uint32_t _mCollisionMatrix[31];
     ccstd::vector<PhysXSharedBody *> _mSharedBodies;
+    ccstd::vector<PhysXSharedBody *> _mDirtyBodies;
+    struct ActiveBody {
+        uint32_t depth;
+        Node *parent;
+        PhysXSharedBody *body;
+    };
+    ccstd::vector<ActiveBody> _mActiveBodies;
+    const Node *_mSyncingNode{nullptr};
 
     static uint32_t _msWrapperObjectID;
     static uint32_t _msPXObjectID;
@@ -24,7 +24,9 @@
 ****************************************************************************/
 
 #include "physics/sdk/World.h"
+#include <algorithm>
 #include <memory>
+#include "base/Log.h"
 #include "physics/PhysicsSelector.h"
 
 namespace cc {
@@ -50,6 +52,14 @@ void World::setAllowSleep(bool v) {
     _impl->setAllowSleep(v);
 }
 
+void World::setSimulationWorkerCount(uint32_t count) {
+    _impl->setSimulationWorkerCount(count);
+}
+
+void World::setSplitSimulation(bool v) {
+    _impl->setSplitSimulation(v);
+}
+
 void World::setGravity(float x, float y, float z) {
     _impl->setGravity(x, y, z);
 }
@@ -111,5 +121,24 @@ RaycastResult &World::raycastClosestResult() {
     return _impl->raycastClosestResult();
 }
 
+uint32_t World::sceneQueryBatch(const float *queries, uint32_t queryCount, uint32_t maxHitsPerQuery,
+                                float *hits, uint32_t *hitCounts) {
+    return _impl->sceneQueryBatch(queries, queryCount, maxHitsPerQuery, hits, hitCounts);
+}
+
+uint32_t World::sceneQueryBatch(const Float32Array &queries, uint32_t maxHitsPerQuery, Float32Array &hits, Uint32Array &hitCounts) {
+    const uint32_t queryCount = std::min(queries.length() / SceneQueryLayout::QUERY_STRIDE, hitCounts.length());
+    if (!queryCount) return 0;
+    if (!maxHitsPerQuery || hits.length() < queryCount * maxHitsPerQuery * SceneQueryLayout::HIT_STRIDE) {
+        CC_LOG_ERROR("sceneQueryBatch: hit buffers are too small for %u queries", queryCount);
+        return 0;
+    }
+    // the typed arrays share memory with the script side, no copy is made
+    const auto *queryData = reinterpret_cast<const float *>(queries.buffer()->getData() + queries.byteOffset());
+    auto *hitData = reinterpret_cast<float *>(hits.buffer()->getData() + hits.byteOffset());
+    auto *hitCountData = reinterpret_cast<uint32_t *>(hitCounts.buffer()->getData() + hitCounts.byteOffset());
+    return _impl->sceneQueryBatch(queryData, queryCount, maxHitsPerQuery, hitData, hitCountData);
+}
+
 } // namespace physics
 } // namespace cc
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include "base/Macros.h"
+#include "core/TypedArray.h"
 #include "physics/spec/IWorld.h"
 
 namespace cc {
@@ -37,6 +38,8 @@ public:
     ~World() override;
     void setGravity(float x, float y, float z) override;
     void setAllowSleep(bool v) override;
+    void setSimulationWorkerCount(uint32_t count) override;
+    void setSplitSimulation(bool v) override;
     void step(float fixedTimeStep) override;
     void emitEvents() override;
     void syncSceneToPhysics() override;
@@ -48,6 +51,9 @@ public:
     bool raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &raycastResult() override;
     RaycastResult &raycastClosestResult() override;
+    uint32_t sceneQueryBatch(const float *queries, uint32_t queryCount, uint32_t maxHitsPerQuery,
+                             float *hits, uint32_t *hitCounts) override;
+    uint32_t sceneQueryBatch(const Float32Array &queries, uint32_t maxHitsPerQuery, Float32Array &hits, Uint32Array &hitCounts);
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
     uint32_t createHeightField(HeightFieldDesc &desc) override;
@@ -106,12 +106,46 @@ struct RaycastResult {
     RaycastResult() = default;
 };
 
+enum class ESceneQueryType : uint32_t {
+    RAYCAST = 0,
+    RAYCAST_CLOSEST = 1,
+    SWEEP_SPHERE_CLOSEST = 2,
+    OVERLAP_SPHERE = 3,
+};
+
+/**
+ * Packed layout of a scene query batch, offsets are in 32-bit words.
+ * TYPE, MASK, FLAGS and HIT_SHAPE are integers, scripts write and read them through
+ * a Uint32Array view sharing the buffer of the Float32Array.
+ * Query i writes its hits to [i * maxHitsPerQuery, (i + 1) * maxHitsPerQuery) of the hit buffer.
+ */
+struct SceneQueryLayout {
+    static constexpr uint32_t TYPE = 0;
+    static constexpr uint32_t MASK = 1;
+    static constexpr uint32_t FLAGS = 2;
+    static constexpr uint32_t DISTANCE = 3;
+    static constexpr uint32_t ORIGIN = 4;
+    static constexpr uint32_t DIRECTION = 7;
+    static constexpr uint32_t RADIUS = 10;
+    static constexpr uint32_t QUERY_STRIDE = 12;
+
+    static constexpr uint32_t HIT_SHAPE = 0; //wrapper object ID
+    static constexpr uint32_t HIT_DISTANCE = 1;
+    static constexpr uint32_t HIT_POINT = 2;
+    static constexpr uint32_t HIT_NORMAL = 5;
+    static constexpr uint32_t HIT_STRIDE = 8;
+
+    static constexpr uint32_t FLAG_QUERY_TRIGGER = 1 << 0;
+};
+
 class IPhysicsWorld {
 public:
     virtual ~IPhysicsWorld() = default;
     ;
     virtual void setGravity(float x, float y, float z) = 0;
     virtual void setAllowSleep(bool v) = 0;
+    virtual void setSimulationWorkerCount(uint32_t count) = 0;
+    virtual void setSplitSimulation(bool v) = 0;
     virtual void step(float s) = 0;
     virtual void emitEvents() = 0;
     virtual void syncSceneToPhysics() = 0;
@@ -124,6 +158,9 @@ public:
     virtual bool raycastClosest(RaycastOptions &opt) = 0;
     virtual ccstd::vector<RaycastResult> &raycastResult() = 0;
     virtual RaycastResult &raycastClosestResult() = 0;
+    // Runs `queryCount` queries laid out as SceneQueryLayout, returns the total number of hits.
+    virtual uint32_t sceneQueryBatch(const float *queries, uint32_t queryCount, uint32_t maxHitsPerQuery,
+                                     float *hits, uint32_t *hitCounts) = 0;
     virtual uint32_t createConvex(ConvexDesc &desc) = 0;
     virtual uint32_t createTrimesh(TrimeshDesc &desc) = 0;
     virtual uint32_t createHeightField(HeightFieldDesc &desc) = 0;
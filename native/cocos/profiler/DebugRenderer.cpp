@@ -89,8 +89,8 @@ struct DebugVertex {
 };
 
 struct DebugBatch {
-    DebugBatch(gfx::Device *device, bool bd, bool it, gfx::Texture *tex)
-    : bold(bd), italic(it), texture(tex) {
+    DebugBatch(gfx::Device *device, bool bd, bool it, bool df, gfx::Texture *tex)
+    : bold(bd), italic(it), sdf(df), texture(tex) {
         gfx::DescriptorSetLayoutInfo info;
         info.bindings.push_back({0, gfx::DescriptorType::SAMPLER_TEXTURE, 1, gfx::ShaderStageFlagBit::FRAGMENT});
 
@@ -123,6 +123,7 @@ struct DebugBatch {
     std::vector<DebugVertex> vertices;
     bool bold{false};
     bool italic{false};
+    bool sdf{false};
     gfx::Texture *texture{nullptr};
     gfx::DescriptorSet *descriptorSet{nullptr};
     gfx::DescriptorSetLayout *descriptorSetLayout{nullptr};
@@ -169,14 +170,14 @@ public:
         CC_PROFILE_MEMORY_DEC(DebugVertexBuffer, static_cast<uint32_t>(_maxVertices * sizeof(DebugVertex)));
     }
 
-    DebugBatch &getOrCreateBatch(gfx::Device *device, bool bold, bool italic, gfx::Texture *texture) {
+    DebugBatch &getOrCreateBatch(gfx::Device *device, bool bold, bool italic, bool sdf, gfx::Texture *texture) {
         for (auto *batch : _batches) {
             if (batch->match(bold, italic, texture)) {
                 return *batch;
             }
         }
 
-        auto *batch = ccnew DebugBatch(device, bold, italic, texture);
+        auto *batch = ccnew DebugBatch(device, bold, italic, sdf, texture);
         _batches.push_back(batch);
 
         return *batch;
@@ -237,8 +238,11 @@ void DebugRenderer::activate(gfx::Device *device, const DebugRendererInfo &info)
 
     for (auto i = 0U; i < _fonts.size(); i++) {
         _fonts[i].font = ccnew FreeTypeFont(getFontPath(i));
-        _fonts[i].face = _fonts[i].font->createFace(FontFaceInfo(fontSize));
+        FontFaceInfo faceInfo(fontSize);
+        faceInfo.sdf = info.sdf;
+        _fonts[i].face = _fonts[i].font->createFace(faceInfo);
         _fonts[i].invTextureSize = {1.0F / _fonts[i].face->getTextureWidth(), 1.0F / _fonts[i].face->getTextureHeight()};
+        _fonts[i].faceScale = _fonts[i].font->getFaceScale(fontSize);
     }
 }
 
@@ -251,10 +255,8 @@ void DebugRenderer::render(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdB
     _buffer->update();
 
     const auto &pass = sceneData->getDebugRendererPass();
-    const auto &shader = sceneData->getDebugRendererShader();
+    gfx::Shader *boundShader{nullptr};
 
-    auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(pass, shader, _buffer->_inputAssembler, renderPass);
-    cmdBuff->bindPipelineState(pso);
     cmdBuff->bindInputAssembler(_buffer->_inputAssembler);
 
     uint32_t offset = 0U;
@@ -264,6 +266,13 @@ void DebugRenderer::render(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdB
             break;
         }
 
+        auto *shader = batch->sdf ? sceneData->getDebugRendererSDFShader() : sceneData->getDebugRendererShader();
+        if (shader != boundShader) {
+            auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(pass, shader, _buffer->_inputAssembler, renderPass);
+            cmdBuff->bindPipelineState(pso);
+            boundShader = shader;
+        }
+
         gfx::DrawInfo drawInfo;
         drawInfo.firstVertex = offset;
         drawInfo.vertexCount = count;
@@ -307,7 +316,7 @@ void DebugRenderer::addText(const ccstd::string &text, const Vec2 &screenPos, co
 
     auto offsetX = screenPos.x;
     auto offsetY = screenPos.y;
-    const auto scale = info.scale;
+    const auto scale = info.scale * fontInfo.faceScale;
     const auto lineHeight = face->getLineHeight() * scale;
     const auto &invTextureSize = fontInfo.invTextureSize;
 
@@ -328,7 +337,7 @@ void DebugRenderer::addText(const ccstd::string &text, const Vec2 &screenPos, co
         }
 
         if (glyph->width > 0U && glyph->height > 0U) {
-            auto &batch = _buffer->getOrCreateBatch(_device, info.bold, info.italic, face->getTexture(glyph->page));
+            auto &batch = _buffer->getOrCreateBatch(_device, info.bold, info.italic, face->isSDF(), face->getTexture(glyph->page));
 
             Vec4 rect{offsetX + static_cast<float>(glyph->bearingX) * scale,
                       offsetY - static_cast<float>(glyph->bearingY) * scale,
@@ -366,7 +375,7 @@ uint32_t DebugRenderer::getLineHeight(bool bold, bool italic) {
     auto &fontInfo = _fonts[index];
 
     if (fontInfo.face) {
-        return fontInfo.face->getLineHeight();
+        return static_cast<uint32_t>(static_cast<float>(fontInfo.face->getLineHeight()) * fontInfo.faceScale);
     }
 
     return 0U;
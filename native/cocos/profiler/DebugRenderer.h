@@ -52,6 +52,8 @@ struct DebugRendererInfo {
 
     uint32_t fontSize{0U};
     uint32_t maxCharacters{0U};
+    // signed distance field glyphs stay sharp at any text scale
+    bool sdf{false};
 };
 
 struct DebugTextInfo {
@@ -70,6 +72,7 @@ struct DebugFontInfo {
     Font *font{nullptr};
     FontFace *face{nullptr};
     Vec2 invTextureSize{0.0F, 0.0F};
+    float faceScale{1.0F}; // SDF glyph metrics are in SDF_FONT_SIZE units
 };
 
 constexpr uint32_t DEBUG_FONT_COUNT = 4U;
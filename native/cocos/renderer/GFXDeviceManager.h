@@ -28,6 +28,7 @@
 #include "engine/EngineEvents.h"
 
 #include "gfx-agent/DeviceAgent.h"
+#include "gfx-capture/DeviceCapture.h"
 #include "gfx-validator/DeviceValidator.h"
 
 // #undef CC_USE_NVN
@@ -154,6 +155,10 @@ private:
         }
 
 #if !defined(CC_SERVER_MODE)
+    #if CC_USE_GFX_CAPTURE
+        device = ccnew gfx::DeviceCapture(device);
+    #endif
+
         if (CC_DEBUG > 0 && !FORCE_DISABLE_VALIDATION || FORCE_ENABLE_VALIDATION) {
             device = ccnew gfx::DeviceValidator(device);
         }
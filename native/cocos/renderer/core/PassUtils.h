@@ -25,9 +25,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include "base/Ptr.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "base/std/hash/hash.h"
 #include "base/std/variant.h"
 
 #include "math/Color.h"
@@ -73,6 +75,41 @@ using MacroValue = ccstd::variant<int32_t, bool, ccstd::string>;
  */
 using MacroRecord = Record<ccstd::string, MacroValue>;
 
+/**
+ * @en Fixed-width key of a shader variant, the define values of one program packed with the bit layout built by ProgramLib
+ * @zh 定长的 shader 变体 key，按 ProgramLib 生成的位布局打包单个 shader 的宏值
+ */
+struct ShaderVariantKey {
+    static constexpr uint32_t WORD_COUNT{4};
+    static constexpr int32_t MAX_BIT_COUNT{static_cast<int32_t>(WORD_COUNT) * 64};
+
+    uint64_t words[WORD_COUNT]{};
+
+    // replaces the bitCount bits at offset, a field may span two words
+    inline void set(int32_t offset, int32_t bitCount, uint32_t value) {
+        CC_ASSERT(offset >= 0 && bitCount > 0 && bitCount <= 32 && offset + bitCount <= MAX_BIT_COUNT);
+        const auto word = static_cast<uint32_t>(offset) / 64;
+        const auto shift = static_cast<uint32_t>(offset) % 64;
+        const uint64_t mask = (uint64_t{1} << bitCount) - 1;
+        const uint64_t bits = value & mask;
+        words[word] = (words[word] & ~(mask << shift)) | (bits << shift);
+        if (shift + bitCount > 64) {
+            words[word + 1] = (words[word + 1] & ~(mask >> (64 - shift))) | (bits >> (64 - shift));
+        }
+    }
+
+    inline bool operator==(const ShaderVariantKey &rhs) const {
+        return std::equal(words, words + WORD_COUNT, rhs.words);
+    }
+    inline bool operator!=(const ShaderVariantKey &rhs) const { return !(*this == rhs); }
+};
+
+struct ShaderVariantKeyHash {
+    inline ccstd::hash_t operator()(const ShaderVariantKey &key) const {
+        return ccstd::hash_range(key.words, key.words + ShaderVariantKey::WORD_COUNT);
+    }
+};
+
 using MaterialProperty = ccstd::variant<ccstd::monostate /*0*/, float /*1*/, int32_t /*2*/, Vec2 /*3*/, Vec3 /*4*/, Vec4 /*5*/, Color, /*6*/ Mat3 /*7*/, Mat4 /*8*/, Quaternion /*9*/, IntrusivePtr<TextureBase> /*10*/, IntrusivePtr<gfx::Texture> /*11*/>;
 
 using MaterialPropertyList = ccstd::vector<MaterialProperty>;
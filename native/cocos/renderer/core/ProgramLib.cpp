@@ -25,10 +25,12 @@
 
 #include "renderer/core/ProgramLib.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <numeric>
 #include <ostream>
 #include "base/Log.h"
+#include "core/Root.h"
 #include "core/assets/EffectAsset.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -223,6 +225,23 @@ ccstd::vector<gfx::Attribute> getActiveAttributes(const IProgramInfo &tmpl, cons
     return out;
 }
 
+// packs the macros known by the template, the other macros do not select a variant of it
+ShaderVariantKey computeVariantKey(const IProgramInfo &tmpl, const MacroRecord &defines) {
+    ShaderVariantKey key;
+    for (const auto &define : defines) {
+        auto itIndex = tmpl.defineIndices.find(define.first);
+        if (itIndex == tmpl.defineIndices.end()) {
+            continue;
+        }
+        const auto &tmplDef = tmpl.defines[itIndex->second];
+        if (!tmplDef.map) {
+            continue;
+        }
+        key.set(tmplDef.offset, tmplDef.bitCount, static_cast<uint32_t>(tmplDef.map(define.second)));
+    }
+    return key;
+}
+
 } // namespace
 
 const char *getDeviceShaderVersion(const gfx::Device *device) {
@@ -275,6 +294,8 @@ ProgramLib::ProgramLib() {
 
 ProgramLib::~ProgramLib() {
     ProgramLib::instance = nullptr;
+    _pendingVariants.clear();
+    _compileQueue.clear();
 #if CC_DEBUG
     for (const auto &cache : _cache) {
         if (cache.second->getRefCount() > 1) {
@@ -310,6 +331,10 @@ void ProgramLib::registerEffect(EffectAsset *effect) {
 }
 
 IProgramInfo *ProgramLib::define(IShaderInfo &shader) {
+    return _variantLock.lockWrite([&]() { return defineTemplate(shader); });
+}
+
+IProgramInfo *ProgramLib::defineTemplate(IShaderInfo &shader) {
     auto itCurrTmpl = _templates.find(shader.name);
     if (itCurrTmpl != _templates.end() && itCurrTmpl->second.hash == shader.hash) {
         return &itCurrTmpl->second;
@@ -317,6 +342,8 @@ IProgramInfo *ProgramLib::define(IShaderInfo &shader) {
 
     IProgramInfo &tmpl = _templates[shader.name];
     tmpl.copyFrom(shader);
+    tmpl.defineIndices.clear();
+    _variants[shader.name].shaders.clear();
 
     // calculate option mask offset
     int32_t offset = 0;
@@ -363,11 +390,11 @@ IProgramInfo *ProgramLib::define(IShaderInfo &shader) {
             };
         }
         def.offset = offset;
+        def.bitCount = cnt;
+        tmpl.defineIndices[def.name] = static_cast<uint32_t>(&def - tmpl.defines.data());
         offset += cnt;
     }
-    if (offset > 31) {
-        tmpl.uber = true;
-    }
+    tmpl.uber = offset > ShaderVariantKey::MAX_BIT_COUNT;
     // generate constant macros
     {
         tmpl.constantMacros.clear();
@@ -605,23 +632,84 @@ ccstd::string ProgramLib::getKey(const ccstd::string &name, const MacroRecord &d
         ccstd::string ret{key.str() + std::to_string(tmpl.hash)};
         return ret;
     }
-    uint32_t key = 0;
+    const auto key = computeVariantKey(tmpl, defines);
+    uint32_t wordCount = ShaderVariantKey::WORD_COUNT;
+    while (wordCount > 1 && key.words[wordCount - 1] == 0) {
+        --wordCount;
+    }
     std::stringstream ss;
-    for (auto &tmplDef : tmplDefs) {
-        auto itDef = defines.find(tmplDef.name);
-        if (itDef == defines.end() || !tmplDef.map) {
-            continue;
-        }
-        const auto &value = itDef->second;
-        auto mapped = tmplDef.map(value);
-        auto offset = tmplDef.offset;
-        key |= (mapped << offset);
+    ss << std::hex << key.words[0];
+    for (uint32_t i = 1; i < wordCount; ++i) {
+        ss << "," << key.words[i];
     }
-    ss << std::hex << key << "|" << std::to_string(tmpl.hash);
+    ss << "|" << std::to_string(tmpl.hash);
     ccstd::string ret{ss.str()};
     return ret;
 }
 
+bool ProgramLib::getVariantKey(const ccstd::string &name, const MacroRecord &defines, ShaderVariantKey &key) {
+    return _variantLock.lockRead([&]() {
+        auto itTpl = _templates.find(name);
+        if (itTpl == _templates.end() || itTpl->second.uber) {
+            return false;
+        }
+        key = computeVariantKey(itTpl->second, defines);
+        return true;
+    });
+}
+
+bool ProgramLib::patchVariantKey(const ccstd::string &name, ShaderVariantKey &key, const ccstd::string &define, const MacroValue &value) {
+    return _variantLock.lockRead([&]() {
+        auto itTpl = _templates.find(name);
+        if (itTpl == _templates.end() || itTpl->second.uber) {
+            return false;
+        }
+        const auto &tmpl = itTpl->second;
+        auto itIndex = tmpl.defineIndices.find(define);
+        if (itIndex != tmpl.defineIndices.end()) {
+            const auto &tmplDef = tmpl.defines[itIndex->second];
+            if (tmplDef.map) {
+                key.set(tmplDef.offset, tmplDef.bitCount, static_cast<uint32_t>(tmplDef.map(value)));
+            }
+        }
+        return true;
+    });
+}
+
+gfx::Shader *ProgramLib::findShaderVariant(const ccstd::string &name, const ShaderVariantKey &key) {
+    return _variantLock.lockRead([&]() -> gfx::Shader * {
+        auto itVariants = _variants.find(name);
+        if (itVariants == _variants.end()) {
+            return nullptr;
+        }
+        auto &variants = itVariants->second;
+        auto itShader = variants.shaders.find(key);
+        if (itShader == variants.shaders.end()) {
+            return nullptr;
+        }
+        variants.hits.fetch_add(1, std::memory_order_relaxed);
+        return itShader->second;
+    });
+}
+
+IShaderVariantStats ProgramLib::getVariantStats(const ccstd::string &name) {
+    return _variantLock.lockRead([&]() {
+        IShaderVariantStats stats;
+        auto itVariants = _variants.find(name);
+        if (itVariants != _variants.end()) {
+            stats.hits = itVariants->second.hits.load(std::memory_order_relaxed);
+            stats.misses = itVariants->second.misses.load(std::memory_order_relaxed);
+        }
+        return stats;
+    });
+}
+
+void ProgramLib::addShaderVariant(const ccstd::string &name, const ShaderVariantKey &key, gfx::Shader *shader) {
+    _variantLock.lockWrite([&]() {
+        _variants[name].shaders[key] = shader;
+    });
+}
+
 void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
     if (defines.empty()) return;
     ccstd::vector<ccstd::string> defineValues;
@@ -641,11 +729,23 @@ void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
             matchedKeys.emplace_back(i.first);
         }
     }
-    for (const auto &key : matchedKeys) {
-        CC_LOG_DEBUG("destroyed shader %s", key.c_str());
-        _cache[key]->destroy();
-        _cache.erase(key);
-    }
+    if (matchedKeys.empty()) {
+        return;
+    }
+    _variantLock.lockWrite([&]() {
+        for (const auto &key : matchedKeys) {
+            CC_LOG_DEBUG("destroyed shader %s", key.c_str());
+            auto *shader = _cache[key].get();
+            for (auto &variants : _variants) {
+                auto &shaders = variants.second.shaders;
+                for (auto it = shaders.begin(); it != shaders.end();) {
+                    it = it->second == shader ? shaders.erase(it) : std::next(it);
+                }
+            }
+            shader->destroy();
+            _cache.erase(key);
+        }
+    });
 }
 
 gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
@@ -654,6 +754,26 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
         defines[it.first] = it.second;
     }
 
+    auto itTpl = _templates.find(name);
+    CC_ASSERT(itTpl != _templates.end());
+
+    const auto &tmpl = itTpl->second;
+    auto itVariants = _variants.find(name);
+    CC_ASSERT(itVariants != _variants.end());
+    auto &variants = itVariants->second;
+
+    // the main thread is the only writer, so it reads the variant caches without the lock
+    const bool useVariantKey = !keyOut && !tmpl.uber;
+    ShaderVariantKey variantKey;
+    if (useVariantKey) {
+        variantKey = computeVariantKey(tmpl, defines);
+        auto itVariant = variants.shaders.find(variantKey);
+        if (itVariant != variants.shaders.end()) {
+            variants.hits.fetch_add(1, std::memory_order_relaxed);
+            return itVariant->second;
+        }
+    }
+
     ccstd::string key;
     if (!keyOut) {
         key = getKey(name, defines);
@@ -663,13 +783,13 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
     auto itRes = _cache.find(key);
     if (itRes != _cache.end()) {
         //        CC_LOG_DEBUG("Found ProgramLib::_cache[%s]=%p, defines: %d", key.c_str(), itRes->second, defines.size());
+        variants.hits.fetch_add(1, std::memory_order_relaxed);
+        if (useVariantKey) {
+            addShaderVariant(name, variantKey, itRes->second);
+        }
         return itRes->second;
     }
-
-    auto itTpl = _templates.find(name);
-    CC_ASSERT(itTpl != _templates.end());
-
-    const auto &tmpl = itTpl->second;
+    variants.misses.fetch_add(1, std::memory_order_relaxed);
     const auto itTplInfo = _templateInfos.find(tmpl.hash);
     CC_ASSERT(itTplInfo != _templateInfos.end());
     auto &tmplInfo = itTplInfo->second;
@@ -706,8 +826,107 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
 
     auto *shader = device->createShader(tmplInfo.shaderInfo);
     _cache[key] = shader;
+    if (useVariantKey) {
+        addShaderVariant(name, variantKey, shader);
+    }
     //    CC_LOG_DEBUG("ProgramLib::_cache[%s]=%p, defines: %d", key.c_str(), shader, defines.size());
     return shader;
 }
 
+gfx::Shader *ProgramLib::getGFXShaderAsync(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
+                                           render::PipelineRuntime *pipeline, const ShaderCompileCallback &callback) {
+    if (!_asyncCompileEnabled) {
+        return getGFXShader(device, name, defines, pipeline);
+    }
+
+    for (const auto &it : pipeline->getMacros()) {
+        defines[it.first] = it.second;
+    }
+
+    ShaderVariantKey variantKey;
+    if (getVariantKey(name, defines, variantKey)) {
+        auto *shader = findShaderVariant(name, variantKey);
+        if (shader) {
+            return shader;
+        }
+    }
+
+    auto key = getKey(name, defines);
+    auto itRes = _cache.find(key);
+    if (itRes != _cache.end()) {
+        return itRes->second;
+    }
+
+    auto result = _pendingVariants.emplace(key, PendingVariant{});
+    auto &pending = result.first->second;
+    if (result.second) {
+        pending.name = name;
+        pending.defines = defines;
+        _compileQueue.emplace_back(key);
+        ++_compileStats.queued;
+    }
+    if (callback) {
+        pending.callbacks.emplace_back(callback);
+    }
+
+    // another variant of the program may draw something completely different, e.g. a skinned mesh in bind pose,
+    // so only a fallback registered for the program is used, otherwise the draw is skipped
+    auto itFallback = _fallbackShaders.find(name);
+    if (itFallback == _fallbackShaders.end()) {
+        ++_compileStats.drawsSkipped;
+        return nullptr;
+    }
+    ++_compileStats.stallsAvoided;
+    return itFallback->second.get();
+}
+
+void ProgramLib::compileQueuedShaders() {
+    if (_compileQueue.empty()) {
+        return;
+    }
+
+    auto *root = Root::getInstance();
+    if (root) {
+        compileQueuedShaders(root->getDevice(), root->getPipeline());
+    }
+}
+
+void ProgramLib::compileQueuedShaders(gfx::Device *device, render::PipelineRuntime *pipeline) {
+    if (_compileQueue.empty() || !device || !pipeline) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t count = 0;
+    while (!_compileQueue.empty() && count < _asyncCompileLimit) {
+        auto itPending = _pendingVariants.find(_compileQueue.front());
+        _compileQueue.pop_front();
+        if (itPending == _pendingVariants.end()) {
+            continue;
+        }
+        auto pending = std::move(itPending->second);
+        _pendingVariants.erase(itPending);
+
+        auto *shader = getGFXShader(device, pending.name, pending.defines, pipeline);
+        ++count;
+        ++_compileStats.compiled;
+        if (!shader) {
+            // the callers are still notified so they stop waiting for the variant
+            CC_LOG_ERROR("compile queued shader %s failed", pending.name.c_str());
+        }
+        for (const auto &callback : pending.callbacks) {
+            callback(shader);
+        }
+    }
+    _compileStats.compileTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ProgramLib::setFallbackShader(const ccstd::string &name, gfx::Shader *shader) {
+    if (shader) {
+        _fallbackShaders[name] = shader;
+    } else {
+        _fallbackShaders.erase(name);
+    }
+}
+
 } // namespace cc
@@ -24,14 +24,18 @@
 ****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <functional>
 #include <numeric>
 #include <sstream>
 #include "base/RefVector.h"
+#include "base/std/container/deque.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "base/std/optional.h"
+#include "base/threading/ReadWriteLock.h"
 #include "core/Types.h"
 #include "core/assets/EffectAsset.h"
 #include "renderer/gfx-base/GFXDef-common.h"
@@ -48,6 +52,7 @@ class PipelineRuntime;
 struct IDefineRecord : public IDefineInfo {
     std::function<int32_t(const MacroValue &)> map{nullptr};
     int32_t offset{0};
+    int32_t bitCount{0};
 };
 struct IMacroInfo {
     ccstd::string name;
@@ -69,12 +74,36 @@ struct ITemplateInfo {
 struct IProgramInfo : public IShaderInfo {
     ccstd::string effectName;
     ccstd::vector<IDefineRecord> defines;
+    Record<ccstd::string, uint32_t> defineIndices; // define name to index in defines
     ccstd::string constantMacros;
-    bool uber{false}; // macro number exceeds default limits, will fallback to string hash
+    bool uber{false}; // macro bits exceed ShaderVariantKey::MAX_BIT_COUNT, will fallback to string hash
 
     void copyFrom(const IShaderInfo &o);
 };
 
+/**
+ * @en Hit and miss counts of the shader variant cache of one program, a miss is a variant being compiled
+ * @zh 单个 shader 变体缓存的命中与未命中次数，未命中即编译了新的变体
+ */
+struct IShaderVariantStats {
+    uint32_t hits{0};
+    uint32_t misses{0};
+};
+
+/**
+ * @en Counters of the asynchronous shader compilation
+ * @zh 异步 shader 编译的统计
+ */
+struct IShaderCompileStats {
+    uint32_t queued{0};        // variants queued instead of being compiled on request
+    uint32_t compiled{0};      // queued variants compiled by compileQueuedShaders, failures included
+    uint32_t stallsAvoided{0}; // requests answered with a fallback shader
+    uint32_t drawsSkipped{0};  // requests answered with nothing, the draw is skipped
+    float compileTime{0.F};    // milliseconds spent in compileQueuedShaders
+};
+
+using ShaderCompileCallback = std::function<void(gfx::Shader *)>;
+
 const char *getDeviceShaderVersion(const gfx::Device *device);
 
 /**
@@ -138,6 +167,40 @@ public:
      */
     ccstd::string getKey(const ccstd::string &name, const MacroRecord &defines);
 
+    /**
+     * @en Gets the fixed-width variant key of a macro combination, returns false for uber programs. Thread safe.
+     * @zh 获取预处理宏组合的定长变体 key，uber shader 返回 false，可在任意线程调用。
+     * @param name Target shader name
+     * @param defines The combination of preprocess macros, pipeline macros included
+     * @param key The variant key
+     */
+    bool getVariantKey(const ccstd::string &name, const MacroRecord &defines, ShaderVariantKey &key);
+
+    /**
+     * @en Updates one macro of a variant key, so keys can be derived from define changes. Thread safe.
+     * @zh 更新变体 key 中的单个宏，用于根据宏的变化增量生成 key，可在任意线程调用。
+     * @param name Target shader name
+     * @param key The variant key to update
+     * @param define The macro name
+     * @param value The macro value
+     */
+    bool patchVariantKey(const ccstd::string &name, ShaderVariantKey &key, const ccstd::string &define, const MacroValue &value);
+
+    /**
+     * @en Gets an already compiled shader variant, returns nullptr if the variant has not been compiled. Thread safe.
+     * @zh 获取已编译的 shader 变体，尚未编译时返回 nullptr，可在任意线程调用。
+     * @param name Target shader name
+     * @param key The variant key
+     */
+    gfx::Shader *findShaderVariant(const ccstd::string &name, const ShaderVariantKey &key);
+
+    /**
+     * @en Gets the hit and miss counts of the variant cache of a shader
+     * @zh 获取 shader 变体缓存的命中统计
+     * @param name Target shader name
+     */
+    IShaderVariantStats getVariantStats(const ccstd::string &name);
+
     /**
      * @en Destroy all shader instance match the preprocess macros
      * @zh 销毁所有完全满足指定预处理宏特征的 shader 实例。
@@ -157,13 +220,83 @@ public:
     gfx::Shader *getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
                               render::PipelineRuntime *pipeline, ccstd::string *key = nullptr);
 
+    /**
+     * @en Gets the shader resource instance, or queues its compilation when asynchronous compilation is enabled.
+     * A queued variant is answered with the fallback registered by setFallbackShader, or nullptr to skip the draw,
+     * and the callback receives the real one once compiled, or nullptr if the compilation failed.
+     * @zh 获取指定 shader 的渲染资源实例，开启异步编译时未编译的变体会进入编译队列，
+     * 期间返回 setFallbackShader 注册的备用 shader，没有注册时返回 nullptr 以跳过绘制，
+     * 编译完成后通过回调返回真正的 shader，编译失败时回调参数为 nullptr。
+     * @param name Shader name
+     * @param defines Preprocess macros
+     * @param pipeline The [[RenderPipeline]] which owns the render command
+     * @param callback Called with the compiled shader, only if the variant was queued
+     */
+    gfx::Shader *getGFXShaderAsync(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
+                                   render::PipelineRuntime *pipeline, const ShaderCompileCallback &callback);
+
+    /**
+     * @en Compiles the queued shader variants with the current device and pipeline of Root,
+     * at most the async compile limit per call, called once per frame
+     * @zh 使用 Root 当前的设备和管线编译队列中的 shader 变体，每次最多编译 async compile limit 个，每帧调用一次
+     */
+    void compileQueuedShaders();
+
+    /**
+     * @en Compiles the queued shader variants with the given device and pipeline, at most the async compile limit per call
+     * @zh 使用指定的设备和管线编译队列中的 shader 变体，每次最多编译 async compile limit 个
+     */
+    void compileQueuedShaders(gfx::Device *device, render::PipelineRuntime *pipeline);
+
+    /**
+     * @en Registers the shader used in place of the variants of a shader that are still compiling
+     * @zh 注册 shader 变体编译期间使用的备用 shader
+     * @param name Shader name
+     * @param shader The fallback shader, nullptr to unregister
+     */
+    void setFallbackShader(const ccstd::string &name, gfx::Shader *shader);
+
+    inline void setAsyncCompileEnabled(bool enabled) { _asyncCompileEnabled = enabled; }
+    inline bool isAsyncCompileEnabled() const { return _asyncCompileEnabled; }
+    inline void setAsyncCompileLimit(uint32_t limit) { _asyncCompileLimit = std::max(limit, 1U); }
+    inline uint32_t getAsyncCompileLimit() const { return _asyncCompileLimit; }
+    inline const IShaderCompileStats &getCompileStats() const { return _compileStats; }
+
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(ProgramLib);
 
+    struct ProgramVariants {
+        ccstd::unordered_map<ShaderVariantKey, IntrusivePtr<gfx::Shader>, ShaderVariantKeyHash> shaders;
+        std::atomic<uint32_t> hits{0};
+        std::atomic<uint32_t> misses{0};
+    };
+
+    // the device and pipeline are resolved from Root when compiling, they may be switched while the variant waits
+    struct PendingVariant {
+        ccstd::string name;
+        MacroRecord defines;
+        ccstd::vector<ShaderCompileCallback> callbacks;
+    };
+
+    IProgramInfo *defineTemplate(IShaderInfo &shader);
+    void addShaderVariant(const ccstd::string &name, const ShaderVariantKey &key, gfx::Shader *shader);
+
     static ProgramLib *instance;
     Record<ccstd::string, IProgramInfo> _templates; // per shader
     Record<ccstd::string, IntrusivePtr<gfx::Shader>> _cache;
     Record<uint64_t, ITemplateInfo> _templateInfos;
+    // Variant caches per shader, only written on the main thread under the write lock,
+    // other threads read _templates and _variants under the read lock.
+    Record<ccstd::string, ProgramVariants> _variants;
+    ReadWriteLock _variantLock;
+
+    // asynchronous compilation, the queue holds the keys of _pendingVariants in request order
+    Record<ccstd::string, PendingVariant> _pendingVariants;
+    ccstd::deque<ccstd::string> _compileQueue;
+    Record<ccstd::string, IntrusivePtr<gfx::Shader>> _fallbackShaders;
+    IShaderCompileStats _compileStats;
+    uint32_t _asyncCompileLimit{1};
+    bool _asyncCompileEnabled{false};
 };
 
 } // namespace cc
@@ -25,6 +25,7 @@
 
 #include "CommandBufferAgent.h"
 #include <cstring>
+#include <iterator>
 #include "BufferAgent.h"
 #include "DescriptorSetAgent.h"
 #include "DeviceAgent.h"
@@ -135,9 +136,26 @@ void CommandBufferAgent::doDestroy() {
         {
             actor->destroy();
         });
+
+    _releasedBundleResources.clear();
+}
+
+void CommandBufferAgent::releaseBundleResources() {
+    if (DeviceAgent::getInstance()->_multithreaded) {
+        _releasedBundleResources.insert(_releasedBundleResources.end(),
+                                        std::make_move_iterator(_bundleResources.begin()),
+                                        std::make_move_iterator(_bundleResources.end()));
+    }
+    _bundleResources.clear();
 }
 
 void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    // the actor drops its bundle as well
+    if (_isBundle) {
+        _isBundle = false;
+        releaseBundleResources();
+    }
+
     ENQUEUE_MESSAGE_4(
         _messageQueue,
         CommandBufferBegin,
@@ -151,6 +169,9 @@ void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebu
 }
 
 void CommandBufferAgent::end() {
+    _isBundle = _recordingBundle;
+    _recordingBundle = false;
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEnd,
         actor, getActor(),
@@ -159,6 +180,70 @@ void CommandBufferAgent::end() {
         });
 }
 
+bool CommandBufferAgent::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    // The actor tells whether it keeps the commands on the device thread only,
+    // the feature tells it beforehand.
+    if (!DeviceAgent::getInstance()->hasFeature(Feature::COMMAND_BUNDLE)) {
+        CommandBuffer::beginBundle(renderPass, subpass, frameBuffer);
+        return false;
+    }
+
+    if (_isBundle) {
+        _isBundle = false;
+        releaseBundleResources();
+    }
+    _recordingBundle = true;
+    retainBundleResource(renderPass);
+    retainBundleResource(frameBuffer);
+
+    ENQUEUE_MESSAGE_4(
+        _messageQueue,
+        CommandBufferBeginBundle,
+        actor, getActor(),
+        renderPass, renderPass ? static_cast<RenderPassAgent *>(renderPass)->getActor() : nullptr,
+        subpass, subpass,
+        frameBuffer, frameBuffer ? static_cast<FramebufferAgent *>(frameBuffer)->getActor() : nullptr,
+        {
+            actor->beginBundle(renderPass, subpass, frameBuffer);
+        });
+    return true;
+}
+
+void CommandBufferAgent::releaseBundle() {
+    _isBundle = false;
+
+    ENQUEUE_MESSAGE_1(
+        _messageQueue, CommandBufferReleaseBundle,
+        actor, getActor(),
+        {
+            actor->releaseBundle();
+        });
+
+    releaseBundleResources();
+}
+
+bool CommandBufferAgent::updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (!_isBundle) return false;
+
+    uint32_t *actorDynamicOffsets = nullptr;
+    if (dynamicOffsetCount) {
+        actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
+        memcpy(actorDynamicOffsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    }
+
+    ENQUEUE_MESSAGE_4(
+        _messageQueue, CommandBufferUpdateBundleDynamicOffsets,
+        actor, getActor(),
+        set, set,
+        dynamicOffsetCount, dynamicOffsetCount,
+        dynamicOffsets, actorDynamicOffsets,
+        {
+            actor->updateBundleDynamicOffsets(set, dynamicOffsetCount, dynamicOffsets);
+        });
+    // every backend with the feature patches the offsets in place
+    return true;
+}
+
 void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
     auto attachmentCount = utils::toUint(renderPass->getColorAttachments().size());
     Color *actorColors = nullptr;
@@ -219,6 +304,8 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
+    retainBundleResource(pso);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindPipelineState,
         actor, getActor(),
@@ -229,6 +316,8 @@ void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    retainBundleResource(descriptorSet);
+
     uint32_t *actorDynamicOffsets = nullptr;
     if (dynamicOffsetCount) {
         actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
@@ -248,6 +337,8 @@ void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
+    retainBundleResource(ia);
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindInputAssembler,
         actor, getActor(),
@@ -362,6 +453,20 @@ void CommandBufferAgent::draw(const DrawInfo &info) {
         });
 }
 
+void CommandBufferAgent::drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) {
+    retainBundleResource(indirectBuffer);
+
+    ENQUEUE_MESSAGE_4(
+        _messageQueue, CommandBufferDrawIndirect,
+        actor, getActor(),
+        indirectBuffer, static_cast<BufferAgent *>(indirectBuffer)->getActor(),
+        firstDraw, firstDraw,
+        drawCount, drawCount,
+        {
+            actor->drawIndirect(indirectBuffer, firstDraw, drawCount);
+        });
+}
+
 void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     auto *bufferAgent = static_cast<BufferAgent *>(buff);
 
@@ -384,6 +489,29 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t s
         });
 }
 
+void CommandBufferAgent::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    auto *bufferAgent = static_cast<BufferAgent *>(buff);
+
+    uint8_t *actorBuffer{nullptr};
+    bool needFreeing{false};
+
+    BufferAgent::getActorBuffer(bufferAgent, _messageQueue, size, &actorBuffer, &needFreeing);
+    memcpy(actorBuffer, data, size);
+
+    ENQUEUE_MESSAGE_6(
+        _messageQueue, CommandBufferUpdateBufferRange,
+        actor, getActor(),
+        buff, bufferAgent->getActor(),
+        data, actorBuffer,
+        offset, offset,
+        size, size,
+        needFreeing, needFreeing,
+        {
+            actor->updateBufferRange(buff, data, offset, size);
+            if (needFreeing) free(data);
+        });
+}
+
 void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
@@ -407,6 +535,8 @@ void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::dispatch(const DispatchInfo &info) {
+    retainBundleResource(info.indirectBuffer);
+
     DispatchInfo actorInfo = info;
     if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferAgent *>(info.indirectBuffer)->getActor();
 
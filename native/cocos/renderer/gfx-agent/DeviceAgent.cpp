@@ -403,6 +403,11 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
         {
             CommandBufferAgent::flushCommands(count, cmdBuffs, multiThreaded);
         });
+
+    // the actors have released their bundles by the time the agents enqueue their deletion
+    for (uint32_t i = 0; i < count; ++i) {
+        static_cast<CommandBufferAgent *const>(cmdBuffs[i])->_releasedBundleResources.clear();
+    }
 }
 
 void DeviceAgent::getQueryPoolResults(QueryPool *queryPool) {
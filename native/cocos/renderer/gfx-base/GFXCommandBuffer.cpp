@@ -45,9 +45,22 @@ void CommandBuffer::initialize(const CommandBufferInfo &info) {
 void CommandBuffer::destroy() {
     doDestroy();
 
+    _recordingBundle = false;
+    _isBundle = false;
+    _bundleResources.clear();
+
     _type = CommandBufferType::PRIMARY;
     _queue = nullptr;
 }
 
+bool CommandBuffer::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    begin(renderPass, subpass, frameBuffer);
+    return false;
+}
+
+void CommandBuffer::drawIndirect(Buffer * /*indirectBuffer*/, uint32_t /*firstDraw*/, uint32_t /*drawCount*/) {
+    CC_ASSERT(false); // Command 'drawIndirect' needs Feature::DRAW_INDIRECT_FIRST_INSTANCE.
+}
+
 } // namespace gfx
 } // namespace cc
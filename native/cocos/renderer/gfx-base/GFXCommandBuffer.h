@@ -28,6 +28,7 @@
 #include "GFXBuffer.h"
 #include "GFXInputAssembler.h"
 #include "GFXObject.h"
+#include "base/Ptr.h"
 #include "base/RefCounted.h"
 #include "base/Utils.h"
 #include "base/std/container/vector.h"
@@ -61,6 +62,9 @@ public:
     virtual void nextSubpass() = 0;
     virtual void draw(const DrawInfo &info) = 0;
     virtual void updateBuffer(Buffer *buff, const void *data, uint32_t size) = 0;
+    // Writes `size` bytes of `data` into `buff` starting at byte `offset`, both have to be multiples of 4.
+    // The rest of the buffer is left untouched.
+    virtual void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) = 0;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) = 0;
     virtual void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) = 0;
     virtual void execute(CommandBuffer *const *cmdBuffs, uint32_t count) = 0;
@@ -69,6 +73,23 @@ public:
     virtual void endQuery(QueryPool *queryPool, uint32_t id) = 0;
     virtual void resetQueryPool(QueryPool *queryPool) = 0;
     virtual void completeQueryPool(QueryPool *queryPool) {}
+    // Issues `drawCount` draws stored in an INDIRECT buffer, starting from draw `firstDraw`,
+    // with the input assembler bound last. Only backends with Feature::DRAW_INDIRECT_FIRST_INSTANCE
+    // implement it, check the feature before using it.
+    virtual void drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount);
+
+    // Command bundles: a secondary command buffer recorded after beginBundle() keeps its commands
+    // and the resources they reference after end(). Executing it again in later frames replays the
+    // commands without recording them, until releaseBundle() or the next begin.
+    // Bundles hold state, draw and dispatch commands, no transfers, barriers or render passes.
+    // Returns false if the backend can not keep the commands (see Feature::COMMAND_BUNDLE),
+    // the buffer is then recorded as after begin() and has to be recorded again every frame.
+    virtual bool beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer);
+    virtual void releaseBundle() {}
+    // Patches the dynamic offsets of descriptor set `set` in the replays of the bundle,
+    // returns false if the bundle has to be recorded again to change them.
+    virtual bool updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) { return false; }
+    virtual bool isBundle() const { return _isBundle; }
 
     // barrier: excutionBarrier
     // bufferBarriers: array of BufferBarrier*, descriptions of access of buffers
@@ -108,17 +129,30 @@ public:
     virtual uint32_t getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint32_t getNumInstances() const { return _numInstances; }
     virtual uint32_t getNumTris() const { return _numTriangles; }
+    // draw calls of the executed secondary command buffers, replayed from bundles or recorded in this frame
+    virtual uint32_t getNumReplayedDrawCalls() const { return _numReplayedDrawCalls; }
+    virtual uint32_t getNumRecordedDrawCalls() const { return _numRecordedDrawCalls; }
 
 protected:
     virtual void doInit(const CommandBufferInfo &info) = 0;
     virtual void doDestroy() = 0;
 
+    inline void retainBundleResource(RefCounted *resource) {
+        if (_recordingBundle && resource) _bundleResources.emplace_back(resource);
+    }
+
     Queue *_queue = nullptr;
     CommandBufferType _type = CommandBufferType::PRIMARY;
 
     uint32_t _numDrawCalls = 0;
     uint32_t _numInstances = 0;
     uint32_t _numTriangles = 0;
+    uint32_t _numReplayedDrawCalls = 0;
+    uint32_t _numRecordedDrawCalls = 0;
+
+    bool _recordingBundle = false;
+    bool _isBundle = false;
+    ccstd::vector<IntrusivePtr<RefCounted>> _bundleResources;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -186,6 +186,12 @@ enum class Feature : uint32_t {
     // the max number of attachment limit(4) situation for many devices, and shader
     // sources inside this kind of subpass must match this behavior.
     INPUT_ATTACHMENT_BENEFIT,
+    // CommandBuffer::drawIndirect is available and honors the first instance
+    // of each draw, so per-draw instance data can be fetched from instanced attributes.
+    // Backends without multi-draw support issue one indirect call per draw.
+    DRAW_INDIRECT_FIRST_INSTANCE,
+    // Secondary command buffers can be recorded as bundles, see CommandBuffer::beginBundle.
+    COMMAND_BUNDLE,
     COUNT,
 };
 CC_ENUM_CONVERSION_OPERATOR(Feature);
@@ -128,6 +128,7 @@ protected:
 
     friend class DeviceAgent;
     friend class DeviceValidator;
+    friend class DeviceCapture;
     friend class DeviceManager;
 
     Device();
@@ -25,11 +25,16 @@
 
 #include "SPIRVUtils.h"
 
+#include <algorithm>
+#include <cstring>
+#include "base/Data.h"
 #include "base/Log.h"
 #include "base/Utils.h"
 #include "glslang/Public/ShaderLang.h"
+#include "glslang/build_info.h"
 #include "glslang/SPIRV/GlslangToSpv.h"
 #include "glslang/StandAlone/ResourceLimits.h"
+#include "platform/FileUtils.h"
 #include "spirv/spirv.h"
 
 namespace cc {
@@ -51,8 +56,6 @@ EShLanguage getShaderStage(ShaderStageFlagBit type) {
     }
 }
 
-#include <glslang/build_info.h>
-
 glslang::EShTargetClientVersion getClientVersion(int vulkanMinorVersion) {
     switch (vulkanMinorVersion) {
         case 0: return glslang::EShTargetVulkan_1_0;
@@ -100,24 +103,195 @@ struct Id {
     uint32_t storageClass{0};
     uint32_t *pLocation{nullptr};
 };
+
+// bump when the entry layout or the compile options change
+constexpr uint32_t CACHE_VERSION{1};
+constexpr uint32_t CACHE_ENTRY_MAGIC{0x56505343}; // 'CSPV'
+constexpr uint32_t CACHE_INDEX_MAGIC{0x49505343}; // 'CSPI'
+constexpr char CACHE_INDEX_NAME[]{"index.bin"};
+constexpr char CACHE_ENTRY_SUFFIX[]{".spv"};
+// a crash loses at most this many index updates, the files they wrote are adopted on the next load
+constexpr uint32_t CACHE_INDEX_SAVE_INTERVAL{16};
+#if CC_DEBUG > 0
+constexpr uint32_t STRIP_DEBUG_INFO{0};
+#else
+constexpr uint32_t STRIP_DEBUG_INFO{1};
+#endif
+
+// FNV-1a, 64 bits keep collisions out of reach for any realistic number of variants
+constexpr uint64_t FNV_OFFSET_BASIS{14695981039346656037ULL};
+constexpr uint64_t FNV_PRIME{1099511628211ULL};
+
+uint64_t hashBytes(uint64_t hash, const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t hashValue(uint64_t hash, T value) {
+    return hashBytes(hash, &value, sizeof(value));
+}
+
+ccstd::string getCacheEntryName(uint64_t key) {
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(key), CACHE_ENTRY_SUFFIX); // NOLINT(google-runtime-int)
+    return name;
+}
+
+bool parseCacheEntryName(const ccstd::string &path, uint64_t *key) {
+    const auto slash = path.find_last_of('/');
+    const auto name = slash == ccstd::string::npos ? path : path.substr(slash + 1);
+    constexpr size_t suffixLength = sizeof(CACHE_ENTRY_SUFFIX) - 1;
+    if (name.size() != 16 + suffixLength || name.compare(16, suffixLength, CACHE_ENTRY_SUFFIX) != 0) {
+        return false;
+    }
+    char *end = nullptr;
+    *key = strtoull(name.c_str(), &end, 16);
+    return end == name.c_str() + 16;
+}
+
+class CacheWriter {
+public:
+    template <typename T>
+    void write(T value) {
+        write(&value, sizeof(value));
+    }
+    void write(const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        _buffer.insert(_buffer.end(), bytes, bytes + size);
+    }
+    uint32_t size() const { return utils::toUint(_buffer.size()); }
+    bool save(const ccstd::string &path) const {
+        Data data;
+        data.copy(_buffer.data(), utils::toUint(_buffer.size()));
+        return FileUtils::getInstance()->writeDataToFile(data, path);
+    }
+
+private:
+    ccstd::vector<uint8_t> _buffer;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(const Data &data) : _data(data.getBytes()), _size(data.getSize()) {}
+
+    template <typename T>
+    bool read(T &value) {
+        return read(&value, sizeof(value));
+    }
+    bool read(void *data, size_t size) {
+        if (_offset + size > _size) return false;
+        memcpy(data, _data + _offset, size);
+        _offset += size;
+        return true;
+    }
+
+private:
+    const uint8_t *_data{nullptr};
+    size_t _size{0};
+    size_t _offset{0};
+};
 } // namespace
 
 SPIRVUtils SPIRVUtils::instance;
 
 void SPIRVUtils::initialize(int vulkanMinorVersion) {
     glslang::InitializeProcess();
+    setTargetVersions(vulkanMinorVersion);
+}
 
+void SPIRVUtils::setTargetVersions(int vulkanMinorVersion) {
     _clientInputSemanticsVersion = 100 + vulkanMinorVersion * 10;
     _clientVersion = getClientVersion(vulkanMinorVersion);
     _targetVersion = getTargetVersion(vulkanMinorVersion);
 }
 
 void SPIRVUtils::destroy() {
+    setCacheDirectory("");
+    _prewarmedCacheDirectory.clear();
+
     glslang::FinalizeProcess();
     _output.clear();
 }
 
+void SPIRVUtils::setCacheDirectory(const ccstd::string &path, uint32_t maxSize) {
+    if (_cacheIndexDirty) {
+        saveCacheIndex();
+    }
+    _cacheEntries.clear();
+    _cacheSize = 0;
+    _cacheMaxSize = maxSize;
+    _cacheDirectory = path;
+    if (_cacheDirectory.empty()) {
+        return;
+    }
+
+    if (_cacheDirectory.back() != '/') {
+        _cacheDirectory += '/';
+    }
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isDirectoryExist(_cacheDirectory) && !fileUtils->createDirectory(_cacheDirectory)) {
+        CC_LOG_WARNING("SPIR-V cache disabled, failed to create %s", _cacheDirectory.c_str());
+        _cacheDirectory.clear();
+        return;
+    }
+    loadCacheIndex();
+}
+
+void SPIRVUtils::setPrewarmedCacheDirectory(const ccstd::string &path) {
+    _prewarmedCacheDirectory = path;
+    if (!_prewarmedCacheDirectory.empty() && _prewarmedCacheDirectory.back() != '/') {
+        _prewarmedCacheDirectory += '/';
+    }
+}
+
 void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &source) {
+    const auto sourceSize = utils::toUint(source.size());
+    uint64_t cacheKey = 0;
+    if (!_cacheDirectory.empty() || !_prewarmedCacheDirectory.empty()) {
+        cacheKey = getCacheKey(type, source);
+        if (!_cacheDirectory.empty() && _cacheEntries.count(cacheKey) && loadCacheEntry(_cacheDirectory, cacheKey, sourceSize)) {
+            _cacheEntries[cacheKey].lastUse = ++_cacheClock;
+            _cacheIndexDirty = true;
+            return;
+        }
+        if (!_prewarmedCacheDirectory.empty() && loadCacheEntry(_prewarmedCacheDirectory, cacheKey, sourceSize)) {
+            return;
+        }
+    }
+
+    if (compileSource(type, source) && !_cacheDirectory.empty()) {
+        storeCacheEntry(cacheKey, sourceSize);
+    }
+}
+
+bool SPIRVUtils::precompile(int vulkanMinorVersion, ShaderStageFlagBit type, const ccstd::string &source, const ccstd::string &directory) {
+    const auto clientInputSemanticsVersion = _clientInputSemanticsVersion;
+    const auto clientVersion = _clientVersion;
+    const auto targetVersion = _targetVersion;
+    setTargetVersions(vulkanMinorVersion);
+
+    bool succeeded = compileSource(type, source);
+    if (succeeded) {
+        auto path = directory;
+        if (!path.empty() && path.back() != '/') {
+            path += '/';
+        }
+        auto *fileUtils = FileUtils::getInstance();
+        succeeded = (fileUtils->isDirectoryExist(path) || fileUtils->createDirectory(path)) &&
+                    writeCacheEntry(path, getCacheKey(type, source), utils::toUint(source.size())) > 0;
+    }
+
+    _clientInputSemanticsVersion = clientInputSemanticsVersion;
+    _clientVersion = clientVersion;
+    _targetVersion = targetVersion;
+    return succeeded;
+}
+
+bool SPIRVUtils::compileSource(ShaderStageFlagBit type, const ccstd::string &source) {
     EShLanguage stage = getShaderStage(type);
     const char *string = source.c_str();
 
@@ -130,8 +304,10 @@ void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &sourc
 
     auto messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
 
+    bool succeeded = true;
     if (!_shader->parse(&glslang::DefaultTBuiltInResource, _clientInputSemanticsVersion, false, messages)) {
         CC_LOG_ERROR("GLSL Parsing Failed:\n%s\n%s", _shader->getInfoLog(), _shader->getInfoDebugLog());
+        succeeded = false;
     }
 
     _program = std::make_unique<glslang::TProgram>();
@@ -139,6 +315,7 @@ void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &sourc
 
     if (!_program->link(messages)) {
         CC_LOG_ERROR("GLSL Linking Failed:\n%s\n%s", _program->getInfoLog(), _program->getInfoDebugLog());
+        succeeded = false;
     }
 
     _output.clear();
@@ -152,11 +329,188 @@ void SPIRVUtils::compileGLSL(ShaderStageFlagBit type, const ccstd::string &sourc
     spvOptions.stripDebugInfo = true;
 #endif
     glslang::GlslangToSpv(*_program->getIntermediate(stage), _output, &logger, &spvOptions);
+
+    _activeInputLocations.clear();
+    if (type == ShaderStageFlagBit::VERTEX) {
+        _program->buildReflection();
+        int activeCount = _program->getNumPipeInputs();
+        for (int i = 0; i < activeCount; ++i) {
+            _activeInputLocations.push_back(_program->getPipeInput(i).getType()->getQualifier().layoutLocation);
+        }
+    }
+    return succeeded;
+}
+
+uint64_t SPIRVUtils::getCacheKey(ShaderStageFlagBit type, const ccstd::string &source) const {
+    uint64_t key = FNV_OFFSET_BASIS;
+    key = hashValue(key, CACHE_VERSION);
+    key = hashValue(key, static_cast<uint32_t>(GLSLANG_VERSION_MAJOR));
+    key = hashValue(key, static_cast<uint32_t>(GLSLANG_VERSION_MINOR));
+    key = hashValue(key, static_cast<uint32_t>(GLSLANG_VERSION_PATCH));
+    key = hashValue(key, STRIP_DEBUG_INFO);
+    key = hashValue(key, static_cast<uint32_t>(_clientInputSemanticsVersion));
+    key = hashValue(key, static_cast<uint32_t>(_clientVersion));
+    key = hashValue(key, static_cast<uint32_t>(_targetVersion));
+    key = hashValue(key, static_cast<uint32_t>(type));
+    return hashBytes(key, source.data(), source.size());
+}
+
+bool SPIRVUtils::loadCacheEntry(const ccstd::string &directory, uint64_t key, uint32_t sourceSize) {
+    auto *fileUtils = FileUtils::getInstance();
+    const auto path = directory + getCacheEntryName(key);
+    if (!fileUtils->isFileExist(path)) {
+        return false;
+    }
+
+    const Data data = fileUtils->getDataFromFile(path);
+    CacheReader reader(data);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t entryKey = 0;
+    uint32_t entrySourceSize = 0;
+    uint32_t codeCount = 0;
+    uint32_t inputCount = 0;
+    bool valid = reader.read(magic) && reader.read(version) && reader.read(entryKey) && reader.read(entrySourceSize) &&
+                 reader.read(codeCount) && reader.read(inputCount);
+    valid = valid && magic == CACHE_ENTRY_MAGIC && version == CACHE_VERSION && entryKey == key && entrySourceSize == sourceSize && codeCount > 0;
+    if (valid) {
+        _output.resize(codeCount);
+        _activeInputLocations.resize(inputCount);
+        valid = reader.read(_output.data(), codeCount * sizeof(uint32_t)) &&
+                reader.read(_activeInputLocations.data(), inputCount * sizeof(uint32_t)) &&
+                _output[0] == SpvMagicNumber;
+    }
+    if (!valid) {
+        CC_LOG_WARNING("Invalid SPIR-V cache entry %s", path.c_str());
+        return false;
+    }
+
+    _shader.reset();
+    _program.reset();
+    return true;
+}
+
+uint32_t SPIRVUtils::writeCacheEntry(const ccstd::string &directory, uint64_t key, uint32_t sourceSize) const {
+    CacheWriter writer;
+    writer.write(CACHE_ENTRY_MAGIC);
+    writer.write(CACHE_VERSION);
+    writer.write(key);
+    writer.write(sourceSize);
+    writer.write(utils::toUint(_output.size()));
+    writer.write(utils::toUint(_activeInputLocations.size()));
+    writer.write(_output.data(), _output.size() * sizeof(uint32_t));
+    writer.write(_activeInputLocations.data(), _activeInputLocations.size() * sizeof(uint32_t));
+    return writer.save(directory + getCacheEntryName(key)) ? writer.size() : 0;
+}
+
+void SPIRVUtils::storeCacheEntry(uint64_t key, uint32_t sourceSize) {
+    const auto size = writeCacheEntry(_cacheDirectory, key, sourceSize);
+    if (!size) {
+        return;
+    }
+
+    auto &entry = _cacheEntries[key];
+    _cacheSize -= entry.size;
+    entry.size = size;
+    entry.lastUse = ++_cacheClock;
+    _cacheSize += entry.size;
+    if (_cacheSize > _cacheMaxSize) {
+        evictCacheEntries();
+    }
+    // saved in batches, setCacheDirectory and destroy save the rest
+    _cacheIndexDirty = true;
+    if (++_cacheUnsavedStores >= CACHE_INDEX_SAVE_INTERVAL) {
+        saveCacheIndex();
+    }
+}
+
+void SPIRVUtils::loadCacheIndex() {
+    auto *fileUtils = FileUtils::getInstance();
+    const auto path = _cacheDirectory + CACHE_INDEX_NAME;
+    if (fileUtils->isFileExist(path)) {
+        const Data data = fileUtils->getDataFromFile(path);
+        CacheReader reader(data);
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t count = 0;
+        if (reader.read(magic) && reader.read(version) && reader.read(count) && magic == CACHE_INDEX_MAGIC && version == CACHE_VERSION) {
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t key = 0;
+                CacheEntry entry;
+                if (!reader.read(key) || !reader.read(entry.size) || !reader.read(entry.lastUse)) {
+                    break;
+                }
+                _cacheEntries[key] = entry;
+                _cacheSize += entry.size;
+                _cacheClock = std::max(_cacheClock, entry.lastUse);
+            }
+        }
+    }
+    adoptUnindexedEntries();
+    if (_cacheSize > _cacheMaxSize) {
+        evictCacheEntries();
+    }
+    if (_cacheIndexDirty) {
+        saveCacheIndex();
+    }
+}
+
+void SPIRVUtils::adoptUnindexedEntries() {
+    // files stored after the last index save of a crashed run, they are the first to be evicted
+    auto *fileUtils = FileUtils::getInstance();
+    for (const auto &path : fileUtils->listFiles(_cacheDirectory)) {
+        uint64_t key = 0;
+        if (!parseCacheEntryName(path, &key) || _cacheEntries.count(key)) {
+            continue;
+        }
+        CacheEntry entry;
+        entry.size = static_cast<uint32_t>(std::max(fileUtils->getFileSize(path), 0L));
+        _cacheEntries[key] = entry;
+        _cacheSize += entry.size;
+        _cacheIndexDirty = true;
+    }
+}
+
+void SPIRVUtils::saveCacheIndex() {
+    CacheWriter writer;
+    writer.write(CACHE_INDEX_MAGIC);
+    writer.write(CACHE_VERSION);
+    writer.write(utils::toUint(_cacheEntries.size()));
+    for (const auto &entry : _cacheEntries) {
+        writer.write(entry.first);
+        writer.write(entry.second.size);
+        writer.write(entry.second.lastUse);
+    }
+    writer.save(_cacheDirectory + CACHE_INDEX_NAME);
+    _cacheIndexDirty = false;
+    _cacheUnsavedStores = 0;
+}
+
+void SPIRVUtils::evictCacheEntries() {
+    // least recently used first, down to 3/4 of the budget so that eviction does not run on every store
+    ccstd::vector<std::pair<uint64_t, uint64_t>> entries;
+    entries.reserve(_cacheEntries.size());
+    for (const auto &entry : _cacheEntries) {
+        entries.emplace_back(entry.second.lastUse, entry.first);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    auto *fileUtils = FileUtils::getInstance();
+    const uint64_t targetSize = _cacheMaxSize / 4 * 3;
+    for (const auto &entry : entries) {
+        if (_cacheSize <= targetSize) {
+            break;
+        }
+        auto it = _cacheEntries.find(entry.second);
+        _cacheSize -= it->second.size;
+        _cacheEntries.erase(it);
+        fileUtils->removeFile(_cacheDirectory + getCacheEntryName(entry.second));
+        _cacheIndexDirty = true;
+    }
 }
 
 void SPIRVUtils::compressInputLocations(gfx::AttributeList &attributes) {
     static ccstd::vector<Id> ids;
-    static ccstd::vector<uint32_t> activeLocations;
     static ccstd::vector<uint32_t> newLocations;
 
     uint32_t *code = _output.data();
@@ -203,12 +557,8 @@ void SPIRVUtils::compressInputLocations(gfx::AttributeList &attributes) {
         insn += wordCount;
     }
 
-    _program->buildReflection();
-    activeLocations.clear();
-    int activeCount = _program->getNumPipeInputs();
-    for (int i = 0; i < activeCount; ++i) {
-        activeLocations.push_back(_program->getPipeInput(i).getType()->getQualifier().layoutLocation);
-    }
+    const auto &activeLocations = _activeInputLocations;
+    auto activeCount = utils::toUint(activeLocations.size());
 
     uint32_t location = 0;
     uint32_t unusedLocation = activeCount;
@@ -26,6 +26,8 @@
 #pragma once
 
 #include <memory>
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
 #include "gfx-base/GFXDef.h"
 #include "glslang/Public/ShaderLang.h"
 
@@ -34,11 +36,33 @@ namespace gfx {
 
 class SPIRVUtils {
 public:
+    static constexpr uint32_t DEFAULT_CACHE_SIZE{32U * 1024U * 1024U};
+
     static SPIRVUtils *getInstance() { return &instance; }
 
     void initialize(int vulkanMinorVersion);
     void destroy();
 
+    /**
+     * Enables the on-disk SPIR-V cache in a writable directory, an empty path disables it.
+     * Entries are addressed by the hash of the source, the stage, the target versions and the glslang version,
+     * the least recently used ones are evicted once the cache grows over maxSize bytes.
+     */
+    void setCacheDirectory(const ccstd::string &path, uint32_t maxSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * Read-only cache written ahead of time by a build step, looked up when the writable cache misses.
+     */
+    void setPrewarmedCacheDirectory(const ccstd::string &path);
+
+    /**
+     * Offline entry point for build tools, compiles the source for the given Vulkan minor version
+     * and writes its entry into directory, which can then ship as the prewarmed cache.
+     * The keys include the target version, so a cache serving several versions is written once per version.
+     * initialize() must have been called, returns false if the source fails to compile.
+     */
+    bool precompile(int vulkanMinorVersion, ShaderStageFlagBit type, const ccstd::string &source, const ccstd::string &directory);
+
     void compileGLSL(ShaderStageFlagBit type, const ccstd::string &source);
     void compressInputLocations(gfx::AttributeList &attributes);
 
@@ -53,6 +77,22 @@ public:
     }
 
 private:
+    struct CacheEntry {
+        uint32_t size{0};
+        uint64_t lastUse{0};
+    };
+
+    void setTargetVersions(int vulkanMinorVersion);
+    bool compileSource(ShaderStageFlagBit type, const ccstd::string &source);
+    uint64_t getCacheKey(ShaderStageFlagBit type, const ccstd::string &source) const;
+    bool loadCacheEntry(const ccstd::string &directory, uint64_t key, uint32_t sourceSize);
+    uint32_t writeCacheEntry(const ccstd::string &directory, uint64_t key, uint32_t sourceSize) const;
+    void storeCacheEntry(uint64_t key, uint32_t sourceSize);
+    void loadCacheIndex();
+    void adoptUnindexedEntries();
+    void saveCacheIndex();
+    void evictCacheEntries();
+
     int _clientInputSemanticsVersion{0};
     glslang::EShTargetClientVersion _clientVersion{glslang::EShTargetClientVersion::EShTargetVulkan_1_0};
     glslang::EShTargetLanguageVersion _targetVersion{glslang::EShTargetLanguageVersion::EShTargetSpv_1_0};
@@ -60,6 +100,17 @@ private:
     std::unique_ptr<glslang::TShader> _shader{nullptr};
     std::unique_ptr<glslang::TProgram> _program{nullptr};
     ccstd::vector<uint32_t> _output;
+    ccstd::vector<uint32_t> _activeInputLocations; // reflected at compile time, so cached entries need no program
+
+    ccstd::string _cacheDirectory;
+    ccstd::string _prewarmedCacheDirectory;
+    ccstd::unordered_map<uint64_t, CacheEntry> _cacheEntries;
+    uint64_t _cacheSize{0};
+    uint64_t _cacheMaxSize{DEFAULT_CACHE_SIZE};
+    uint64_t _cacheClock{0};
+    // entries stored since the index was last saved
+    uint32_t _cacheUnsavedStores{0};
+    bool _cacheIndexDirty{false};
 
     static SPIRVUtils instance;
 };
@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "BufferCapture.h"
+#include "DeviceCapture.h"
+
+namespace cc {
+namespace gfx {
+
+BufferCapture::BufferCapture(Buffer *actor)
+: Agent<Buffer>(actor) {
+    _typedID = actor->getTypedID();
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+BufferCapture::~BufferCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    CC_SAFE_DELETE(_actor);
+}
+
+void BufferCapture::doInit(const BufferInfo &info) {
+    _actor->initialize(info);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_BUFFER, _captureID, info);
+}
+
+void BufferCapture::doInit(const BufferViewInfo &info) {
+    BufferViewInfo actorInfo = info;
+    actorInfo.buffer = static_cast<BufferCapture *>(info.buffer)->getActor();
+
+    _actor->initialize(actorInfo);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_BUFFER_VIEW, _captureID, info);
+}
+
+void BufferCapture::doResize(uint32_t size, uint32_t /*count*/) {
+    _actor->resize(size);
+
+    BufferInfo info{_usage, _memUsage, size, _stride, _flags};
+    auto *device = DeviceCapture::getInstance();
+    device->replaceResource(_captureID, CaptureOp::CREATE_BUFFER, _captureID, info);
+    device->record(CaptureOp::RESIZE_BUFFER, _captureID, size);
+}
+
+void BufferCapture::doDestroy() {
+    _actor->destroy();
+
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void BufferCapture::update(const void *buffer, uint32_t size) {
+    _actor->update(buffer, size);
+
+    auto *device = DeviceCapture::getInstance();
+    if (device->isCapturing()) device->record(CaptureOp::UPDATE_BUFFER, _captureID, CaptureBytes{buffer, size});
+}
+
+void BufferCapture::flush(const uint8_t *buffer) {
+    Buffer::flushBuffer(_actor, buffer);
+
+    auto *device = DeviceCapture::getInstance();
+    if (device->isCapturing()) device->record(CaptureOp::UPDATE_BUFFER, _captureID, CaptureBytes{buffer, _size});
+}
+
+uint8_t *BufferCapture::getStagingAddress() const {
+    return Buffer::getBufferStagingAddress(_actor);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,580 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CaptureReplayer.h"
+#include <algorithm>
+#include "base/Log.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXFramebuffer.h"
+#include "gfx-base/GFXInputAssembler.h"
+#include "gfx-base/GFXPipelineLayout.h"
+#include "gfx-base/GFXPipelineState.h"
+#include "gfx-base/GFXQueryPool.h"
+#include "gfx-base/GFXQueue.h"
+#include "gfx-base/GFXRenderPass.h"
+#include "gfx-base/GFXShader.h"
+#include "gfx-base/GFXSwapchain.h"
+#include "gfx-base/GFXTexture.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+template <typename T>
+void destroyAndDelete(GFXObject *object) {
+    auto *typed = static_cast<T *>(object);
+    CC_SAFE_DESTROY_AND_DELETE(typed);
+}
+
+void destroyObject(GFXObject *object) {
+    switch (object->getObjectType()) {
+        case ObjectType::SWAPCHAIN: destroyAndDelete<Swapchain>(object); break;
+        case ObjectType::BUFFER: destroyAndDelete<Buffer>(object); break;
+        case ObjectType::TEXTURE: destroyAndDelete<Texture>(object); break;
+        case ObjectType::RENDER_PASS: destroyAndDelete<RenderPass>(object); break;
+        case ObjectType::FRAMEBUFFER: destroyAndDelete<Framebuffer>(object); break;
+        case ObjectType::SHADER: destroyAndDelete<Shader>(object); break;
+        case ObjectType::DESCRIPTOR_SET_LAYOUT: destroyAndDelete<DescriptorSetLayout>(object); break;
+        case ObjectType::PIPELINE_LAYOUT: destroyAndDelete<PipelineLayout>(object); break;
+        case ObjectType::PIPELINE_STATE: destroyAndDelete<PipelineState>(object); break;
+        case ObjectType::DESCRIPTOR_SET: destroyAndDelete<DescriptorSet>(object); break;
+        case ObjectType::INPUT_ASSEMBLER: destroyAndDelete<InputAssembler>(object); break;
+        case ObjectType::COMMAND_BUFFER: destroyAndDelete<CommandBuffer>(object); break;
+        case ObjectType::QUEUE: destroyAndDelete<Queue>(object); break;
+        case ObjectType::QUERY_POOL: destroyAndDelete<QueryPool>(object); break;
+        default: CC_ASSERT(false); break;
+    }
+}
+
+// Backends without a surface, e.g. the empty device, only need a non-null handle.
+uint8_t placeholderWindow{0U};
+
+} // namespace
+
+CaptureReplayer::CaptureReplayer(Device *device)
+: _device(device) {
+    _context.device = device;
+}
+
+CaptureReplayer::~CaptureReplayer() {
+    reset();
+}
+
+bool CaptureReplayer::load(const ccstd::string &path) {
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) {
+        CC_LOG_ERROR("Failed to read GFX capture %s", path.c_str());
+        return false;
+    }
+    return load(ccstd::vector<uint8_t>(data.getBytes(), data.getBytes() + data.getSize()));
+}
+
+bool CaptureReplayer::load(ccstd::vector<uint8_t> data) {
+    reset();
+
+    CaptureReader reader(data.data(), static_cast<uint32_t>(data.size()), nullptr);
+    const auto magic = reader.read<uint32_t>();
+    const auto version = reader.read<uint32_t>();
+    if (reader.isFailed() || magic != CAPTURE_MAGIC || version != CAPTURE_VERSION) {
+        CC_LOG_ERROR("Invalid GFX capture header.");
+        return false;
+    }
+
+    _data = std::move(data);
+    return true;
+}
+
+void CaptureReplayer::reset() {
+    // capture IDs are issued in creation order, release dependents first
+    ccstd::vector<uint32_t> ids;
+    ids.reserve(_owned.size());
+    for (const auto &owned : _owned) {
+        if (owned.second) ids.push_back(owned.first);
+    }
+    std::sort(ids.begin(), ids.end(), std::greater<>());
+    for (uint32_t id : ids) destroyObject(_context.objects[id]);
+
+    _context.objects.clear();
+    _owned.clear();
+    _stats = {};
+}
+
+bool CaptureReplayer::replay() {
+    if (_data.empty()) return false;
+
+    constexpr uint32_t HEADER_SIZE = sizeof(CAPTURE_MAGIC) + sizeof(CAPTURE_VERSION);
+    CaptureReader reader(_data.data() + HEADER_SIZE, static_cast<uint32_t>(_data.size()) - HEADER_SIZE, &_context);
+    CaptureReader payload(nullptr, 0U, &_context);
+    CaptureOp op{CaptureOp::DEVICE_OBJECTS};
+
+    while (reader.nextRecord(op, payload)) {
+        ++_stats.records;
+        if (!replayRecord(op, payload) || payload.isFailed()) {
+            CC_LOG_ERROR("Malformed GFX capture record %u, op %u.", _stats.records, toNumber(op));
+            return false;
+        }
+    }
+
+    if (reader.isFailed()) {
+        CC_LOG_ERROR("Truncated GFX capture after %u records.", _stats.records);
+        return false;
+    }
+    return true;
+}
+
+void CaptureReplayer::addObject(uint32_t id, GFXObject *object, bool owned) {
+    removeObject(id);
+    if (!object) return;
+    _context.objects[id] = object;
+    _owned[id] = owned;
+}
+
+void CaptureReplayer::removeObject(uint32_t id) {
+    auto iter = _context.objects.find(id);
+    if (iter == _context.objects.end()) return;
+
+    GFXObject *object = iter->second;
+    _context.objects.erase(iter);
+
+    const bool owned = _owned[id];
+    _owned.erase(id);
+    if (!owned) return;
+
+    if (object->getObjectType() == ObjectType::SWAPCHAIN) {
+        auto *swapchain = static_cast<Swapchain *>(object);
+        for (auto it = _context.objects.begin(); it != _context.objects.end();) {
+            if (it->second == swapchain->getColorTexture() || it->second == swapchain->getDepthStencilTexture()) {
+                _owned.erase(it->first);
+                it = _context.objects.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    destroyObject(object);
+}
+
+bool CaptureReplayer::replayRecord(CaptureOp op, CaptureReader &payload) {
+    uint32_t id{0U};
+
+    switch (op) {
+        case CaptureOp::DEVICE_OBJECTS: {
+            uint32_t queueID{0U};
+            uint32_t queryPoolID{0U};
+            uint32_t cmdBuffID{0U};
+            payload(queueID, queryPoolID, cmdBuffID);
+            addObject(queueID, _device->getQueue(), false);
+            addObject(queryPoolID, _device->getQueryPool(), false);
+            addObject(cmdBuffID, _device->getCommandBuffer(), false);
+            break;
+        }
+        case CaptureOp::CREATE_QUEUE: {
+            QueueInfo info;
+            payload(id, info);
+            addObject(id, _device->createQueue(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_QUERY_POOL: {
+            QueryPoolInfo info;
+            payload(id, info);
+            addObject(id, _device->createQueryPool(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_COMMAND_BUFFER: {
+            CommandBufferInfo info;
+            payload(id, info);
+            addObject(id, _device->createCommandBuffer(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_SWAPCHAIN: {
+            SwapchainInfo info;
+            uint32_t colorTextureID{0U};
+            uint32_t depthStencilTextureID{0U};
+            payload(id, info, colorTextureID, depthStencilTextureID);
+            info.windowHandle = _windowHandle ? _windowHandle : &placeholderWindow;
+            Swapchain *swapchain = _device->createSwapchain(info);
+            addObject(id, swapchain, true);
+            addObject(colorTextureID, swapchain->getColorTexture(), false);
+            addObject(depthStencilTextureID, swapchain->getDepthStencilTexture(), false);
+            break;
+        }
+        case CaptureOp::CREATE_BUFFER: {
+            BufferInfo info;
+            payload(id, info);
+            addObject(id, _device->createBuffer(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_BUFFER_VIEW: {
+            BufferViewInfo info;
+            payload(id, info);
+            if (!info.buffer) return false;
+            addObject(id, _device->createBuffer(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_TEXTURE: {
+            TextureInfo info;
+            payload(id, info);
+            addObject(id, _device->createTexture(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_TEXTURE_VIEW: {
+            TextureViewInfo info;
+            payload(id, info);
+            if (!info.texture) return false;
+            addObject(id, _device->createTexture(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_SHADER: {
+            ShaderInfo info;
+            payload(id, info);
+            addObject(id, _device->createShader(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_INPUT_ASSEMBLER: {
+            InputAssemblerInfo info;
+            payload(id, info);
+            addObject(id, _device->createInputAssembler(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_RENDER_PASS: {
+            RenderPassInfo info;
+            payload(id, info);
+            addObject(id, _device->createRenderPass(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_FRAMEBUFFER: {
+            FramebufferInfo info;
+            payload(id, info);
+            if (!info.renderPass) return false;
+            addObject(id, _device->createFramebuffer(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_DESCRIPTOR_SET_LAYOUT: {
+            DescriptorSetLayoutInfo info;
+            payload(id, info);
+            addObject(id, _device->createDescriptorSetLayout(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_PIPELINE_LAYOUT: {
+            PipelineLayoutInfo info;
+            payload(id, info);
+            addObject(id, _device->createPipelineLayout(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_DESCRIPTOR_SET: {
+            DescriptorSetInfo info;
+            payload(id, info);
+            if (!info.layout) return false;
+            addObject(id, _device->createDescriptorSet(info), true);
+            break;
+        }
+        case CaptureOp::CREATE_PIPELINE_STATE: {
+            PipelineStateInfo info;
+            payload(id, info);
+            if (!info.shader || !info.renderPass) return false;
+            addObject(id, _device->createPipelineState(info), true);
+            break;
+        }
+        case CaptureOp::DESTROY: {
+            payload(id);
+            removeObject(id);
+            break;
+        }
+        case CaptureOp::RESIZE_BUFFER: {
+            uint32_t size{0U};
+            payload(id, size);
+            auto *buffer = _context.get<Buffer>(id);
+            if (!buffer) return false;
+            buffer->resize(size);
+            break;
+        }
+        case CaptureOp::RESIZE_TEXTURE: {
+            uint32_t width{0U};
+            uint32_t height{0U};
+            payload(id, width, height);
+            auto *texture = _context.get<Texture>(id);
+            if (!texture) return false;
+            texture->resize(width, height);
+            break;
+        }
+        case CaptureOp::RESIZE_SWAPCHAIN: {
+            uint32_t width{0U};
+            uint32_t height{0U};
+            SurfaceTransform transform{SurfaceTransform::IDENTITY};
+            payload(id, width, height, transform);
+            auto *swapchain = _context.get<Swapchain>(id);
+            if (!swapchain) return false;
+            swapchain->resize(width, height, transform);
+            break;
+        }
+        case CaptureOp::UPDATE_BUFFER: {
+            CaptureBytes bytes;
+            payload(id, bytes);
+            auto *buffer = _context.get<Buffer>(id);
+            if (!buffer) return false;
+            buffer->update(bytes.data, bytes.size);
+            break;
+        }
+        case CaptureOp::UPDATE_DESCRIPTOR_SET: {
+            CaptureDescriptorList descriptors;
+            payload(id, descriptors);
+            auto *descriptorSet = _context.get<DescriptorSet>(id);
+            if (!descriptorSet) return false;
+            for (const auto &descriptor : descriptors) {
+                if (descriptor.buffer) descriptorSet->bindBuffer(descriptor.binding, descriptor.buffer, descriptor.index);
+                if (descriptor.texture) descriptorSet->bindTexture(descriptor.binding, descriptor.texture, descriptor.index);
+                if (descriptor.sampler) descriptorSet->bindSampler(descriptor.binding, descriptor.sampler, descriptor.index);
+            }
+            descriptorSet->update();
+            break;
+        }
+        case CaptureOp::COPY_BUFFERS_TO_TEXTURE: {
+            Texture *texture{nullptr};
+            ccstd::vector<BufferTextureCopy> regions;
+            ccstd::vector<CaptureBytes> buffers;
+            payload(texture, regions, buffers);
+            if (!texture) return false;
+            BufferDataList data;
+            for (const auto &buffer : buffers) data.push_back(static_cast<const uint8_t *>(buffer.data));
+            _device->copyBuffersToTexture(data, texture, regions);
+            break;
+        }
+        case CaptureOp::COMMAND_BUFFER: {
+            CaptureBytes commands;
+            payload(id, commands);
+            auto *cmdBuff = _context.get<CommandBuffer>(id);
+            if (!cmdBuff || !replayCommands(cmdBuff, commands)) return false;
+            break;
+        }
+        case CaptureOp::FLUSH_COMMANDS: {
+            CommandBufferList cmdBuffs;
+            payload(cmdBuffs);
+            _device->flushCommands(cmdBuffs);
+            break;
+        }
+        case CaptureOp::SUBMIT: {
+            CommandBufferList cmdBuffs;
+            payload(id, cmdBuffs);
+            auto *queue = _context.get<Queue>(id);
+            if (!queue) return false;
+            queue->submit(cmdBuffs);
+            break;
+        }
+        case CaptureOp::ACQUIRE: {
+            ccstd::vector<Swapchain *> swapchains;
+            payload(swapchains);
+            _device->acquire(swapchains);
+            break;
+        }
+        case CaptureOp::PRESENT: {
+            _device->present();
+            ++_stats.frames;
+            break;
+        }
+        default: return false;
+    }
+    return true;
+}
+
+bool CaptureReplayer::replayCommands(CommandBuffer *cmdBuff, const CaptureBytes &commands) {
+    CaptureReader reader(static_cast<const uint8_t *>(commands.data), commands.size, &_context);
+    CaptureReader payload(nullptr, 0U, &_context);
+    CaptureOp op{CaptureOp::CMD_BEGIN};
+
+    while (reader.nextRecord(op, payload)) {
+        if (op < CaptureOp::CMD_BEGIN) return false;
+        replayCommand(cmdBuff, op, payload);
+        if (payload.isFailed()) return false;
+    }
+    return !reader.isFailed();
+}
+
+void CaptureReplayer::replayCommand(CommandBuffer *cmdBuff, CaptureOp op, CaptureReader &payload) {
+    switch (op) {
+        case CaptureOp::CMD_BEGIN: {
+            RenderPass *renderPass{nullptr};
+            uint32_t subpass{0U};
+            Framebuffer *framebuffer{nullptr};
+            payload(renderPass, subpass, framebuffer);
+            cmdBuff->begin(renderPass, subpass, framebuffer);
+            break;
+        }
+        case CaptureOp::CMD_END: cmdBuff->end(); break;
+        case CaptureOp::CMD_BEGIN_RENDER_PASS: {
+            RenderPass *renderPass{nullptr};
+            Framebuffer *framebuffer{nullptr};
+            Rect renderArea;
+            ColorList colors;
+            float depth{1.F};
+            uint32_t stencil{0U};
+            CommandBufferList secondaryCBs;
+            payload(renderPass, framebuffer, renderArea, colors, depth, stencil, secondaryCBs);
+            cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, colors.data(), depth, stencil, secondaryCBs.data(), static_cast<uint32_t>(secondaryCBs.size()));
+            break;
+        }
+        case CaptureOp::CMD_END_RENDER_PASS: cmdBuff->endRenderPass(); break;
+        case CaptureOp::CMD_NEXT_SUBPASS: cmdBuff->nextSubpass(); break;
+        case CaptureOp::CMD_EXECUTE: {
+            CommandBufferList cmdBuffs;
+            payload(cmdBuffs);
+            cmdBuff->execute(cmdBuffs.data(), static_cast<uint32_t>(cmdBuffs.size()));
+            break;
+        }
+        case CaptureOp::CMD_BIND_PIPELINE_STATE: cmdBuff->bindPipelineState(payload.read<PipelineState *>()); break;
+        case CaptureOp::CMD_BIND_DESCRIPTOR_SET: {
+            uint32_t set{0U};
+            DescriptorSet *descriptorSet{nullptr};
+            ccstd::vector<uint32_t> dynamicOffsets;
+            payload(set, descriptorSet, dynamicOffsets);
+            cmdBuff->bindDescriptorSet(set, descriptorSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+            break;
+        }
+        case CaptureOp::CMD_BIND_INPUT_ASSEMBLER: cmdBuff->bindInputAssembler(payload.read<InputAssembler *>()); break;
+        case CaptureOp::CMD_SET_VIEWPORT: cmdBuff->setViewport(payload.read<Viewport>()); break;
+        case CaptureOp::CMD_SET_SCISSOR: cmdBuff->setScissor(payload.read<Rect>()); break;
+        case CaptureOp::CMD_SET_LINE_WIDTH: cmdBuff->setLineWidth(payload.read<float>()); break;
+        case CaptureOp::CMD_SET_DEPTH_BIAS: {
+            float constant{0.F};
+            float clamp{0.F};
+            float slope{0.F};
+            payload(constant, clamp, slope);
+            cmdBuff->setDepthBias(constant, clamp, slope);
+            break;
+        }
+        case CaptureOp::CMD_SET_BLEND_CONSTANTS: cmdBuff->setBlendConstants(payload.read<Color>()); break;
+        case CaptureOp::CMD_SET_DEPTH_BOUND: {
+            float minBounds{0.F};
+            float maxBounds{1.F};
+            payload(minBounds, maxBounds);
+            cmdBuff->setDepthBound(minBounds, maxBounds);
+            break;
+        }
+        case CaptureOp::CMD_SET_STENCIL_WRITE_MASK: {
+            StencilFace face{StencilFace::ALL};
+            uint32_t mask{0U};
+            payload(face, mask);
+            cmdBuff->setStencilWriteMask(face, mask);
+            break;
+        }
+        case CaptureOp::CMD_SET_STENCIL_COMPARE_MASK: {
+            StencilFace face{StencilFace::ALL};
+            uint32_t ref{0U};
+            uint32_t mask{0U};
+            payload(face, ref, mask);
+            cmdBuff->setStencilCompareMask(face, ref, mask);
+            break;
+        }
+        case CaptureOp::CMD_DRAW: {
+            cmdBuff->draw(payload.read<DrawInfo>());
+            ++_stats.drawCalls;
+            break;
+        }
+        case CaptureOp::CMD_DRAW_INDIRECT: {
+            Buffer *indirectBuffer{nullptr};
+            uint32_t firstDraw{0U};
+            uint32_t drawCount{0U};
+            payload(indirectBuffer, firstDraw, drawCount);
+            cmdBuff->drawIndirect(indirectBuffer, firstDraw, drawCount);
+            _stats.drawCalls += drawCount;
+            break;
+        }
+        case CaptureOp::CMD_UPDATE_BUFFER: {
+            Buffer *buffer{nullptr};
+            CaptureBytes bytes;
+            payload(buffer, bytes);
+            cmdBuff->updateBuffer(buffer, bytes.data, bytes.size);
+            break;
+        }
+        case CaptureOp::CMD_UPDATE_BUFFER_RANGE: {
+            Buffer *buffer{nullptr};
+            uint32_t offset{0U};
+            CaptureBytes bytes;
+            payload(buffer, offset, bytes);
+            cmdBuff->updateBufferRange(buffer, bytes.data, offset, bytes.size);
+            break;
+        }
+        case CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE: {
+            Texture *texture{nullptr};
+            ccstd::vector<BufferTextureCopy> regions;
+            ccstd::vector<CaptureBytes> buffers;
+            payload(texture, regions, buffers);
+            BufferDataList data;
+            for (const auto &buffer : buffers) data.push_back(static_cast<const uint8_t *>(buffer.data));
+            cmdBuff->copyBuffersToTexture(data.data(), texture, regions.data(), static_cast<uint32_t>(regions.size()));
+            break;
+        }
+        case CaptureOp::CMD_BLIT_TEXTURE: {
+            Texture *srcTexture{nullptr};
+            Texture *dstTexture{nullptr};
+            ccstd::vector<TextureBlit> regions;
+            Filter filter{Filter::LINEAR};
+            payload(srcTexture, dstTexture, regions, filter);
+            cmdBuff->blitTexture(srcTexture, dstTexture, regions.data(), static_cast<uint32_t>(regions.size()), filter);
+            break;
+        }
+        case CaptureOp::CMD_DISPATCH: cmdBuff->dispatch(payload.read<DispatchInfo>()); break;
+        case CaptureOp::CMD_PIPELINE_BARRIER: {
+            GeneralBarrier *barrier{nullptr};
+            ccstd::vector<BufferBarrier *> bufferBarriers;
+            ccstd::vector<Buffer *> buffers;
+            ccstd::vector<TextureBarrier *> textureBarriers;
+            ccstd::vector<Texture *> textures;
+            payload(barrier, bufferBarriers, buffers, textureBarriers, textures);
+            if (bufferBarriers.size() != buffers.size() || textureBarriers.size() != textures.size()) {
+                CC_LOG_ERROR("Mismatched pipeline barrier lists in GFX capture.");
+                break;
+            }
+            cmdBuff->pipelineBarrier(barrier, bufferBarriers.data(), buffers.data(), static_cast<uint32_t>(buffers.size()),
+                                     textureBarriers.data(), textures.data(), static_cast<uint32_t>(textures.size()));
+            break;
+        }
+        case CaptureOp::CMD_BEGIN_QUERY: {
+            QueryPool *queryPool{nullptr};
+            uint32_t id{0U};
+            payload(queryPool, id);
+            cmdBuff->beginQuery(queryPool, id);
+            break;
+        }
+        case CaptureOp::CMD_END_QUERY: {
+            QueryPool *queryPool{nullptr};
+            uint32_t id{0U};
+            payload(queryPool, id);
+            cmdBuff->endQuery(queryPool, id);
+            break;
+        }
+        case CaptureOp::CMD_RESET_QUERY_POOL: cmdBuff->resetQueryPool(payload.read<QueryPool *>()); break;
+        case CaptureOp::CMD_COMPLETE_QUERY_POOL: cmdBuff->completeQueryPool(payload.read<QueryPool *>()); break;
+        default: CC_LOG_ERROR("Unknown GFX capture command %u.", toNumber(op)); break;
+    }
+}
+
+} // namespace gfx
+} // namespace cc
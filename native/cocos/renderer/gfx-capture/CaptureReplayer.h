@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "CaptureUtils.h"
+#include "base/Macros.h"
+
+namespace cc {
+namespace gfx {
+
+// Replays a trace produced by DeviceCapture on any device, typically an offline run
+// under a different backend or driver to reproduce or profile the captured frames.
+// Swapchains need a native window handle on real backends, see `setWindowHandle`.
+class CC_DLL CaptureReplayer final {
+public:
+    struct Stats {
+        uint32_t frames{0U};
+        uint32_t records{0U};
+        uint32_t drawCalls{0U};
+    };
+
+    explicit CaptureReplayer(Device *device);
+    ~CaptureReplayer();
+
+    bool load(const ccstd::string &path);
+    bool load(ccstd::vector<uint8_t> data);
+
+    // Replays the whole trace, objects created by the trace stay alive until `reset`.
+    bool replay();
+    void reset();
+
+    inline void setWindowHandle(void *windowHandle) { _windowHandle = windowHandle; }
+    inline const Stats &getStats() const { return _stats; }
+
+private:
+    bool replayRecord(CaptureOp op, CaptureReader &payload);
+    bool replayCommands(CommandBuffer *cmdBuff, const CaptureBytes &commands);
+    void replayCommand(CommandBuffer *cmdBuff, CaptureOp op, CaptureReader &payload);
+
+    void addObject(uint32_t id, GFXObject *object, bool owned);
+    void removeObject(uint32_t id);
+
+    Device *_device{nullptr};
+    void *_windowHandle{nullptr};
+
+    ccstd::vector<uint8_t> _data;
+    CaptureContext _context;
+    ccstd::unordered_map<uint32_t, bool> _owned;
+    Stats _stats;
+};
+
+} // namespace gfx
+} // namespace cc
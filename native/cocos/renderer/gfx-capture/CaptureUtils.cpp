@@ -0,0 +1,206 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CaptureUtils.h"
+#include "BufferCapture.h"
+#include "CommandBufferCapture.h"
+#include "DescriptorSetCapture.h"
+#include "DescriptorSetLayoutCapture.h"
+#include "FramebufferCapture.h"
+#include "InputAssemblerCapture.h"
+#include "PipelineLayoutCapture.h"
+#include "PipelineStateCapture.h"
+#include "QueryPoolCapture.h"
+#include "QueueCapture.h"
+#include "RenderPassCapture.h"
+#include "ShaderCapture.h"
+#include "SwapchainCapture.h"
+#include "TextureCapture.h"
+#include "base/Utils.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+template <typename Capture, typename T>
+uint32_t captureIDOf(const T *object) {
+    return object ? static_cast<const Capture *>(object)->getCaptureID() : 0U;
+}
+
+template <typename T>
+void writeInfo(CaptureWriter &writer, const T *object) {
+    writer.write(object != nullptr);
+    if (object) writer.write(object->getInfo());
+}
+
+template <typename Info, typename T, typename Getter>
+void readInfo(CaptureReader &reader, CaptureContext *context, T *&object, Getter getter) {
+    object = nullptr;
+    if (reader.read<bool>()) {
+        auto info = reader.read<Info>();
+        if (context && context->device) object = (context->device->*getter)(info);
+    }
+}
+} // namespace
+
+uint32_t getCaptureID(const Queue *queue) { return captureIDOf<QueueCapture>(queue); }
+uint32_t getCaptureID(const QueryPool *queryPool) { return captureIDOf<QueryPoolCapture>(queryPool); }
+uint32_t getCaptureID(const CommandBuffer *cmdBuff) { return captureIDOf<CommandBufferCapture>(cmdBuff); }
+uint32_t getCaptureID(const Swapchain *swapchain) { return captureIDOf<SwapchainCapture>(swapchain); }
+uint32_t getCaptureID(const Buffer *buffer) { return captureIDOf<BufferCapture>(buffer); }
+uint32_t getCaptureID(const Texture *texture) { return captureIDOf<TextureCapture>(texture); }
+uint32_t getCaptureID(const Shader *shader) { return captureIDOf<ShaderCapture>(shader); }
+uint32_t getCaptureID(const InputAssembler *inputAssembler) { return captureIDOf<InputAssemblerCapture>(inputAssembler); }
+uint32_t getCaptureID(const RenderPass *renderPass) { return captureIDOf<RenderPassCapture>(renderPass); }
+uint32_t getCaptureID(const Framebuffer *framebuffer) { return captureIDOf<FramebufferCapture>(framebuffer); }
+uint32_t getCaptureID(const DescriptorSetLayout *descriptorSetLayout) { return captureIDOf<DescriptorSetLayoutCapture>(descriptorSetLayout); }
+uint32_t getCaptureID(const PipelineLayout *pipelineLayout) { return captureIDOf<PipelineLayoutCapture>(pipelineLayout); }
+uint32_t getCaptureID(const DescriptorSet *descriptorSet) { return captureIDOf<DescriptorSetCapture>(descriptorSet); }
+uint32_t getCaptureID(const PipelineState *pipelineState) { return captureIDOf<PipelineStateCapture>(pipelineState); }
+
+ccstd::vector<CaptureBytes> getCopyBufferBytes(const Texture *texture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count) {
+    const Format format = texture->getFormat();
+    const TextureType type = texture->getInfo().type;
+    const auto blockSize = formatAlignment(format);
+
+    ccstd::vector<CaptureBytes> result;
+    for (uint32_t i = 0U; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        const uint32_t width = region.buffStride > 0 ? region.buffStride : utils::alignTo(region.texExtent.width, blockSize.first);
+        const uint32_t height = region.buffTexHeight > 0 ? region.buffTexHeight : utils::alignTo(region.texExtent.height, blockSize.second);
+        const uint32_t depth = type == TextureType::TEX3D ? region.texExtent.depth : 1U;
+        const uint32_t size = region.buffOffset + formatSize(format, width, height, depth);
+
+        // one buffer per layer, 2D and 3D regions take a single buffer
+        const uint32_t bufferCount = type == TextureType::TEX2D || type == TextureType::TEX3D ? 1U : region.texSubres.layerCount;
+        for (uint32_t j = 0U; j < bufferCount; ++j) {
+            result.push_back({*buffers++, size});
+        }
+    }
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void CaptureWriter::beginRecord(CaptureOp op) {
+    _recordBegin = _data.size();
+    write(op);
+    write(0U);
+}
+
+void CaptureWriter::endRecord() {
+    auto size = static_cast<uint32_t>(_data.size() - _recordBegin - CAPTURE_RECORD_HEADER_SIZE);
+    memcpy(_data.data() + _recordBegin + sizeof(CaptureOp), &size, sizeof(size));
+}
+
+void CaptureWriter::append(const CaptureWriter &other) {
+    _data.insert(_data.end(), other._data.begin(), other._data.end());
+}
+
+void CaptureWriter::clear() {
+    _data.clear();
+    _recordBegin = 0U;
+}
+
+void CaptureWriter::write(const ccstd::string &value) {
+    write(static_cast<uint32_t>(value.size()));
+    writeRaw(value.data(), value.size());
+}
+
+void CaptureWriter::write(const CaptureBytes &bytes) {
+    write(bytes.size);
+    writeRaw(bytes.data, bytes.size);
+}
+
+void CaptureWriter::write(const Sampler *sampler) { writeInfo(*this, sampler); }
+void CaptureWriter::write(const GeneralBarrier *barrier) { writeInfo(*this, barrier); }
+void CaptureWriter::write(const TextureBarrier *barrier) { writeInfo(*this, barrier); }
+void CaptureWriter::write(const BufferBarrier *barrier) { writeInfo(*this, barrier); }
+
+void CaptureWriter::writeRaw(const void *data, size_t size) {
+    if (!size) return;
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    _data.insert(_data.end(), bytes, bytes + size);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+CaptureReader::CaptureReader(const uint8_t *data, uint32_t size, CaptureContext *context)
+: _data(data), _size(size), _context(context) {}
+
+bool CaptureReader::nextRecord(CaptureOp &op, CaptureReader &payload) {
+    if (isEnd() || _failed) return false;
+
+    uint32_t size = 0U;
+    (*this)(op, size);
+    if (_failed || _size - _offset < size) {
+        _failed = true;
+        return false;
+    }
+
+    payload = CaptureReader(_data + _offset, size, _context);
+    _offset += size;
+    return true;
+}
+
+void CaptureReader::read(ccstd::string &value) {
+    const auto size = read<uint32_t>();
+    if (_failed || _size - _offset < size) {
+        _failed = true;
+        return;
+    }
+    value.assign(reinterpret_cast<const char *>(_data + _offset), size);
+    _offset += size;
+}
+
+void CaptureReader::read(CaptureBytes &bytes) {
+    bytes.size = read<uint32_t>();
+    if (_failed || _size - _offset < bytes.size) {
+        _failed = true;
+        bytes = {};
+        return;
+    }
+    bytes.data = _data + _offset;
+    _offset += bytes.size;
+}
+
+void CaptureReader::read(Sampler *&sampler) { readInfo<SamplerInfo>(*this, _context, sampler, &Device::getSampler); }
+void CaptureReader::read(GeneralBarrier *&barrier) { readInfo<GeneralBarrierInfo>(*this, _context, barrier, &Device::getGeneralBarrier); }
+void CaptureReader::read(TextureBarrier *&barrier) { readInfo<TextureBarrierInfo>(*this, _context, barrier, &Device::getTextureBarrier); }
+void CaptureReader::read(BufferBarrier *&barrier) { readInfo<BufferBarrierInfo>(*this, _context, barrier, &Device::getBufferBarrier); }
+
+void CaptureReader::readRaw(void *data, size_t size) {
+    if (_failed || _size - _offset < size) {
+        _failed = true;
+        memset(data, 0, size);
+        return;
+    }
+    memcpy(data, _data + _offset, size);
+    _offset += static_cast<uint32_t>(size);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,491 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXDef.h"
+
+namespace cc {
+namespace gfx {
+
+// A capture trace is a header followed by a flat list of records: [CaptureOp:u16][payload size:u32][payload].
+// Resources alive when the capture window opens are written first as if they were created right then,
+// then every device, queue and command buffer call of the captured frames follows in issue order.
+// Commands of one command buffer are grouped in a single COMMAND_BUFFER record holding a nested record list.
+constexpr uint32_t CAPTURE_MAGIC{0x54474343U}; // "CCGT"
+constexpr uint32_t CAPTURE_VERSION{1U};
+constexpr uint32_t CAPTURE_RECORD_HEADER_SIZE{sizeof(uint16_t) + sizeof(uint32_t)};
+
+enum class CaptureOp : uint16_t {
+    DEVICE_OBJECTS,
+    CREATE_QUEUE,
+    CREATE_QUERY_POOL,
+    CREATE_COMMAND_BUFFER,
+    CREATE_SWAPCHAIN,
+    CREATE_BUFFER,
+    CREATE_BUFFER_VIEW,
+    CREATE_TEXTURE,
+    CREATE_TEXTURE_VIEW,
+    CREATE_SHADER,
+    CREATE_INPUT_ASSEMBLER,
+    CREATE_RENDER_PASS,
+    CREATE_FRAMEBUFFER,
+    CREATE_DESCRIPTOR_SET_LAYOUT,
+    CREATE_PIPELINE_LAYOUT,
+    CREATE_DESCRIPTOR_SET,
+    CREATE_PIPELINE_STATE,
+    DESTROY,
+    RESIZE_BUFFER,
+    RESIZE_TEXTURE,
+    RESIZE_SWAPCHAIN,
+    UPDATE_BUFFER,
+    UPDATE_DESCRIPTOR_SET,
+    COPY_BUFFERS_TO_TEXTURE,
+    COMMAND_BUFFER,
+    FLUSH_COMMANDS,
+    SUBMIT,
+    ACQUIRE,
+    PRESENT,
+
+    CMD_BEGIN = 0x100,
+    CMD_END,
+    CMD_BEGIN_RENDER_PASS,
+    CMD_END_RENDER_PASS,
+    CMD_NEXT_SUBPASS,
+    CMD_EXECUTE,
+    CMD_BIND_PIPELINE_STATE,
+    CMD_BIND_DESCRIPTOR_SET,
+    CMD_BIND_INPUT_ASSEMBLER,
+    CMD_SET_VIEWPORT,
+    CMD_SET_SCISSOR,
+    CMD_SET_LINE_WIDTH,
+    CMD_SET_DEPTH_BIAS,
+    CMD_SET_BLEND_CONSTANTS,
+    CMD_SET_DEPTH_BOUND,
+    CMD_SET_STENCIL_WRITE_MASK,
+    CMD_SET_STENCIL_COMPARE_MASK,
+    CMD_DRAW,
+    CMD_DRAW_INDIRECT,
+    CMD_UPDATE_BUFFER,
+    CMD_COPY_BUFFERS_TO_TEXTURE,
+    CMD_BLIT_TEXTURE,
+    CMD_DISPATCH,
+    CMD_PIPELINE_BARRIER,
+    CMD_BEGIN_QUERY,
+    CMD_END_QUERY,
+    CMD_RESET_QUERY_POOL,
+    CMD_COMPLETE_QUERY_POOL,
+    CMD_UPDATE_BUFFER_RANGE,
+};
+CC_ENUM_CONVERSION_OPERATOR(CaptureOp);
+
+// A block of raw bytes stored inline in the trace, e.g. buffer or texture upload data.
+// When read back, `data` points into the trace itself.
+struct CaptureBytes {
+    const void *data{nullptr};
+    uint32_t size{0U};
+};
+
+// One descriptor slot of a descriptor set, only the bound slots are recorded.
+struct CaptureDescriptor {
+    uint32_t binding{0U};
+    uint32_t index{0U};
+    Buffer *buffer{nullptr};
+    Texture *texture{nullptr};
+    Sampler *sampler{nullptr};
+};
+using CaptureDescriptorList = ccstd::vector<CaptureDescriptor>;
+
+// Objects replayed so far, keyed by their capture ID.
+struct CaptureContext {
+    Device *device{nullptr};
+    ccstd::unordered_map<uint32_t, GFXObject *> objects;
+
+    template <typename T>
+    T *get(uint32_t id) const {
+        auto iter = objects.find(id);
+        return iter != objects.end() ? static_cast<T *>(iter->second) : nullptr;
+    }
+};
+
+// Plain structs without pointers or containers are stored as they are in memory.
+template <typename T>
+struct CaptureAsBytes : std::false_type {};
+
+template <> struct CaptureAsBytes<BufferInfo> : std::true_type {};
+template <> struct CaptureAsBytes<DrawInfo> : std::true_type {};
+template <> struct CaptureAsBytes<Viewport> : std::true_type {};
+template <> struct CaptureAsBytes<Rect> : std::true_type {};
+template <> struct CaptureAsBytes<Color> : std::true_type {};
+template <> struct CaptureAsBytes<Offset> : std::true_type {};
+template <> struct CaptureAsBytes<Extent> : std::true_type {};
+template <> struct CaptureAsBytes<TextureSubresLayers> : std::true_type {};
+template <> struct CaptureAsBytes<TextureBlit> : std::true_type {};
+template <> struct CaptureAsBytes<BufferTextureCopy> : std::true_type {};
+template <> struct CaptureAsBytes<SamplerInfo> : std::true_type {};
+template <> struct CaptureAsBytes<GeneralBarrierInfo> : std::true_type {};
+template <> struct CaptureAsBytes<RasterizerState> : std::true_type {};
+template <> struct CaptureAsBytes<DepthStencilState> : std::true_type {};
+template <> struct CaptureAsBytes<BlendTarget> : std::true_type {};
+
+template <typename T>
+constexpr bool CAPTURE_AS_BYTES = std::is_arithmetic<T>::value || std::is_enum<T>::value || CaptureAsBytes<T>::value;
+
+uint32_t getCaptureID(const Queue *queue);
+uint32_t getCaptureID(const QueryPool *queryPool);
+uint32_t getCaptureID(const CommandBuffer *cmdBuff);
+uint32_t getCaptureID(const Swapchain *swapchain);
+uint32_t getCaptureID(const Buffer *buffer);
+uint32_t getCaptureID(const Texture *texture);
+uint32_t getCaptureID(const Shader *shader);
+uint32_t getCaptureID(const InputAssembler *inputAssembler);
+uint32_t getCaptureID(const RenderPass *renderPass);
+uint32_t getCaptureID(const Framebuffer *framebuffer);
+uint32_t getCaptureID(const DescriptorSetLayout *descriptorSetLayout);
+uint32_t getCaptureID(const PipelineLayout *pipelineLayout);
+uint32_t getCaptureID(const DescriptorSet *descriptorSet);
+uint32_t getCaptureID(const PipelineState *pipelineState);
+
+// Source buffers of a copyBuffersToTexture call, sized the way the backends consume them.
+ccstd::vector<CaptureBytes> getCopyBufferBytes(const Texture *texture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count);
+
+class CC_DLL CaptureWriter final {
+public:
+    void beginRecord(CaptureOp op);
+    void endRecord();
+    void append(const CaptureWriter &other);
+    void clear();
+
+    inline bool empty() const { return _data.empty(); }
+    inline uint32_t size() const { return static_cast<uint32_t>(_data.size()); }
+    inline const uint8_t *data() const { return _data.data(); }
+    inline ccstd::vector<uint8_t> &getData() { return _data; }
+
+    template <typename... Args>
+    void operator()(const Args &...args) {
+        (write(args), ...);
+    }
+
+    template <typename T>
+    std::enable_if_t<CAPTURE_AS_BYTES<T>> write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types can be captured as bytes");
+        writeRaw(&value, sizeof(T));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_class<T>::value && !CAPTURE_AS_BYTES<T>> write(const T &value) {
+        // serialize() is shared with CaptureReader and only reads the fields here.
+        serialize(*this, const_cast<T &>(value));
+    }
+
+    template <typename T>
+    void write(const ccstd::vector<T> &values) {
+        write(static_cast<uint32_t>(values.size()));
+        for (const auto &value : values) write(value);
+    }
+
+    void write(const ccstd::string &value);
+    void write(const CaptureBytes &bytes);
+
+    template <typename T, typename = std::enable_if_t<std::is_base_of<GFXObject, T>::value>>
+    void write(const T *object) {
+        write(getCaptureID(object));
+    }
+
+    void write(const Sampler *sampler);
+    void write(const GeneralBarrier *barrier);
+    void write(const TextureBarrier *barrier);
+    void write(const BufferBarrier *barrier);
+
+private:
+    void writeRaw(const void *data, size_t size);
+
+    ccstd::vector<uint8_t> _data;
+    size_t _recordBegin{0U};
+};
+
+class CC_DLL CaptureReader final {
+public:
+    CaptureReader() = default;
+    CaptureReader(const uint8_t *data, uint32_t size, CaptureContext *context);
+
+    // Moves to the next record and points `payload` to its content.
+    bool nextRecord(CaptureOp &op, CaptureReader &payload);
+
+    inline bool isEnd() const { return _offset >= _size; }
+    inline bool isFailed() const { return _failed; }
+
+    template <typename... Args>
+    void operator()(Args &...args) {
+        (read(args), ...);
+    }
+
+    template <typename T>
+    T read() {
+        T value{};
+        read(value);
+        return value;
+    }
+
+    template <typename T>
+    std::enable_if_t<CAPTURE_AS_BYTES<T>> read(T &value) {
+        readRaw(&value, sizeof(T));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_class<T>::value && !CAPTURE_AS_BYTES<T>> read(T &value) {
+        serialize(*this, value);
+    }
+
+    template <typename T>
+    void read(ccstd::vector<T> &values) {
+        const auto count = read<uint32_t>();
+        // every element takes at least one byte, anything larger is a corrupted count
+        if (_failed || count > _size - _offset) {
+            _failed = true;
+            values.clear();
+            return;
+        }
+        values.resize(count);
+        for (auto &value : values) read(value);
+    }
+
+    void read(ccstd::string &value);
+    void read(CaptureBytes &bytes);
+
+    template <typename T, typename = std::enable_if_t<std::is_base_of<GFXObject, T>::value>>
+    void read(T *&object) {
+        const auto id = read<uint32_t>();
+        object = _context ? _context->get<T>(id) : nullptr;
+    }
+
+    void read(Sampler *&sampler);
+    void read(GeneralBarrier *&barrier);
+    void read(TextureBarrier *&barrier);
+    void read(BufferBarrier *&barrier);
+
+private:
+    void readRaw(void *data, size_t size);
+
+    const uint8_t *_data{nullptr};
+    uint32_t _size{0U};
+    uint32_t _offset{0U};
+    CaptureContext *_context{nullptr};
+    bool _failed{false};
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+template <typename Ar>
+void serialize(Ar &ar, BufferViewInfo &v) {
+    ar(v.buffer, v.offset, v.range);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, TextureInfo &v) {
+    // externalRes is a native handle that can not be replayed
+    ar(v.type, v.usage, v.format, v.width, v.height, v.flags, v.layerCount, v.levelCount, v.samples, v.depth);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, TextureViewInfo &v) {
+    ar(v.texture, v.type, v.format, v.baseLevel, v.levelCount, v.baseLayer, v.layerCount);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, SwapchainInfo &v) {
+    ar(v.windowId, v.vsyncMode, v.width, v.height);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DispatchInfo &v) {
+    ar(v.groupCountX, v.groupCountY, v.groupCountZ, v.indirectBuffer, v.indirectOffset);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, Uniform &v) {
+    ar(v.name, v.type, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformBlock &v) {
+    ar(v.set, v.binding, v.name, v.members, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformSamplerTexture &v) {
+    ar(v.set, v.binding, v.name, v.type, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformSampler &v) {
+    ar(v.set, v.binding, v.name, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformTexture &v) {
+    ar(v.set, v.binding, v.name, v.type, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformStorageImage &v) {
+    ar(v.set, v.binding, v.name, v.type, v.count, v.memoryAccess);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformStorageBuffer &v) {
+    ar(v.set, v.binding, v.name, v.count, v.memoryAccess);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, UniformInputAttachment &v) {
+    ar(v.set, v.binding, v.name, v.count);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ShaderStage &v) {
+    ar(v.stage, v.source);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, Attribute &v) {
+    ar(v.name, v.format, v.isNormalized, v.stream, v.isInstanced, v.location);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ShaderInfo &v) {
+    ar(v.name, v.stages, v.attributes, v.blocks, v.buffers, v.samplerTextures, v.samplers, v.textures, v.images, v.subpassInputs);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, InputAssemblerInfo &v) {
+    ar(v.attributes, v.vertexBuffers, v.indexBuffer, v.indirectBuffer);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, ColorAttachment &v) {
+    ar(v.format, v.sampleCount, v.loadOp, v.storeOp, v.barrier, v.isGeneralLayout);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DepthStencilAttachment &v) {
+    ar(v.format, v.sampleCount, v.depthLoadOp, v.depthStoreOp, v.stencilLoadOp, v.stencilStoreOp, v.barrier, v.isGeneralLayout);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, SubpassInfo &v) {
+    ar(v.inputs, v.colors, v.resolves, v.preserves, v.depthStencil, v.depthStencilResolve, v.depthResolveMode, v.stencilResolveMode);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, SubpassDependency &v) {
+    // per-resource barriers of subpass dependencies are not used by any backend yet
+    ar(v.srcSubpass, v.dstSubpass, v.generalBarrier);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, RenderPassInfo &v) {
+    ar(v.colorAttachments, v.depthStencilAttachment, v.subpasses, v.dependencies);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, FramebufferInfo &v) {
+    ar(v.renderPass, v.colorTextures, v.depthStencilTexture);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetLayoutBinding &v) {
+    ar(v.binding, v.descriptorType, v.count, v.stageFlags, v.immutableSamplers);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetLayoutInfo &v) {
+    ar(v.bindings);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, DescriptorSetInfo &v) {
+    ar(v.layout);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, PipelineLayoutInfo &v) {
+    ar(v.setLayouts);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, InputState &v) {
+    ar(v.attributes);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, BlendState &v) {
+    ar(v.isA2C, v.isIndepend, v.blendColor, v.targets);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, PipelineStateInfo &v) {
+    ar(v.shader, v.pipelineLayout, v.renderPass, v.inputState, v.rasterizerState, v.depthStencilState, v.blendState,
+       v.primitive, v.dynamicStates, v.bindPoint, v.subpass);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, CommandBufferInfo &v) {
+    ar(v.queue, v.type);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, QueueInfo &v) {
+    ar(v.type);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, QueryPoolInfo &v) {
+    ar(v.type, v.maxQueryObjects, v.forceWait);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, TextureBarrierInfo &v) {
+    // queue ownership transfers are not replayed
+    ar(v.prevAccesses, v.nextAccesses, v.type, v.baseMipLevel, v.levelCount, v.baseSlice, v.sliceCount, v.discardContents);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, BufferBarrierInfo &v) {
+    ar(v.prevAccesses, v.nextAccesses, v.type, v.offset, v.size, v.discardContents);
+}
+
+template <typename Ar>
+void serialize(Ar &ar, CaptureDescriptor &v) {
+    ar(v.binding, v.index, v.buffer, v.texture, v.sampler);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,319 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandBufferCapture.h"
+#include "BufferCapture.h"
+#include "DescriptorSetCapture.h"
+#include "DeviceCapture.h"
+#include "FramebufferCapture.h"
+#include "InputAssemblerCapture.h"
+#include "PipelineStateCapture.h"
+#include "QueryPoolCapture.h"
+#include "QueueCapture.h"
+#include "RenderPassCapture.h"
+#include "TextureCapture.h"
+#include "gfx-base/GFXRenderPass.h"
+
+namespace cc {
+namespace gfx {
+
+CommandBufferCapture::CommandBufferCapture(CommandBuffer *actor)
+: Agent<CommandBuffer>(actor) {
+    _typedID = actor->getTypedID();
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+CommandBufferCapture::~CommandBufferCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    CC_SAFE_DELETE(_actor);
+}
+
+void CommandBufferCapture::doInit(const CommandBufferInfo &info) {
+    CommandBufferInfo actorInfo = info;
+    actorInfo.queue = static_cast<QueueCapture *>(info.queue)->getActor();
+
+    _actor->initialize(actorInfo);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_COMMAND_BUFFER, _captureID, info);
+}
+
+void CommandBufferCapture::doDestroy() {
+    _actor->destroy();
+
+    _commands.clear();
+    _recording = false;
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void CommandBufferCapture::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *framebuffer) {
+    RenderPass *renderPassActor = renderPass ? static_cast<RenderPassCapture *>(renderPass)->getActor() : nullptr;
+    Framebuffer *framebufferActor = framebuffer ? static_cast<FramebufferCapture *>(framebuffer)->getActor() : nullptr;
+
+    _actor->begin(renderPassActor, subpass, framebufferActor);
+
+    _commands.clear();
+    _recording = DeviceCapture::getInstance()->isCapturing();
+    record(CaptureOp::CMD_BEGIN, renderPass, subpass, framebuffer);
+}
+
+void CommandBufferCapture::end() {
+    _actor->end();
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_END);
+    DeviceCapture::getInstance()->record(CaptureOp::COMMAND_BUFFER, _captureID, CaptureBytes{_commands.data(), _commands.size()});
+    _commands.clear();
+    _recording = false;
+}
+
+void CommandBufferCapture::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    static ccstd::vector<CommandBuffer *> secondaryCBActors;
+    secondaryCBActors.resize(secondaryCBCount);
+
+    CommandBuffer **actorSecondaryCBs = nullptr;
+    if (secondaryCBCount) {
+        actorSecondaryCBs = secondaryCBActors.data();
+        for (uint32_t i = 0; i < secondaryCBCount; ++i) {
+            actorSecondaryCBs[i] = static_cast<CommandBufferCapture *>(secondaryCBs[i])->getActor();
+        }
+    }
+
+    RenderPass *renderPassActor = static_cast<RenderPassCapture *>(renderPass)->getActor();
+    Framebuffer *framebufferActor = static_cast<FramebufferCapture *>(fbo)->getActor();
+
+    _actor->beginRenderPass(renderPassActor, framebufferActor, renderArea, colors, depth, stencil, actorSecondaryCBs, secondaryCBCount);
+
+    if (!_recording) return;
+    const size_t colorCount = renderPass->getColorAttachments().size();
+    record(CaptureOp::CMD_BEGIN_RENDER_PASS, renderPass, fbo, renderArea, ccstd::vector<Color>(colors, colors + (colors ? colorCount : 0U)),
+           depth, stencil, ccstd::vector<CommandBuffer *>(secondaryCBs, secondaryCBs + secondaryCBCount));
+}
+
+void CommandBufferCapture::nextSubpass() {
+    _actor->nextSubpass();
+
+    record(CaptureOp::CMD_NEXT_SUBPASS);
+}
+
+void CommandBufferCapture::endRenderPass() {
+    _actor->endRenderPass();
+
+    record(CaptureOp::CMD_END_RENDER_PASS);
+}
+
+void CommandBufferCapture::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    static ccstd::vector<CommandBuffer *> cmdBuffActors;
+    cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        cmdBuffActors[i] = static_cast<CommandBufferCapture *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->execute(cmdBuffActors.data(), count);
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_EXECUTE, ccstd::vector<CommandBuffer *>(cmdBuffs, cmdBuffs + count));
+}
+
+void CommandBufferCapture::bindPipelineState(PipelineState *pso) {
+    _actor->bindPipelineState(static_cast<PipelineStateCapture *>(pso)->getActor());
+
+    record(CaptureOp::CMD_BIND_PIPELINE_STATE, pso);
+}
+
+void CommandBufferCapture::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    _actor->bindDescriptorSet(set, static_cast<DescriptorSetCapture *>(descriptorSet)->getActor(), dynamicOffsetCount, dynamicOffsets);
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_BIND_DESCRIPTOR_SET, set, descriptorSet, ccstd::vector<uint32_t>(dynamicOffsets, dynamicOffsets + dynamicOffsetCount));
+}
+
+void CommandBufferCapture::bindInputAssembler(InputAssembler *ia) {
+    _actor->bindInputAssembler(static_cast<InputAssemblerCapture *>(ia)->getActor());
+
+    record(CaptureOp::CMD_BIND_INPUT_ASSEMBLER, ia);
+}
+
+void CommandBufferCapture::setViewport(const Viewport &vp) {
+    _actor->setViewport(vp);
+
+    record(CaptureOp::CMD_SET_VIEWPORT, vp);
+}
+
+void CommandBufferCapture::setScissor(const Rect &rect) {
+    _actor->setScissor(rect);
+
+    record(CaptureOp::CMD_SET_SCISSOR, rect);
+}
+
+void CommandBufferCapture::setLineWidth(float width) {
+    _actor->setLineWidth(width);
+
+    record(CaptureOp::CMD_SET_LINE_WIDTH, width);
+}
+
+void CommandBufferCapture::setDepthBias(float constant, float clamp, float slope) {
+    _actor->setDepthBias(constant, clamp, slope);
+
+    record(CaptureOp::CMD_SET_DEPTH_BIAS, constant, clamp, slope);
+}
+
+void CommandBufferCapture::setBlendConstants(const Color &constants) {
+    _actor->setBlendConstants(constants);
+
+    record(CaptureOp::CMD_SET_BLEND_CONSTANTS, constants);
+}
+
+void CommandBufferCapture::setDepthBound(float minBounds, float maxBounds) {
+    _actor->setDepthBound(minBounds, maxBounds);
+
+    record(CaptureOp::CMD_SET_DEPTH_BOUND, minBounds, maxBounds);
+}
+
+void CommandBufferCapture::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    _actor->setStencilWriteMask(face, mask);
+
+    record(CaptureOp::CMD_SET_STENCIL_WRITE_MASK, face, mask);
+}
+
+void CommandBufferCapture::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    _actor->setStencilCompareMask(face, ref, mask);
+
+    record(CaptureOp::CMD_SET_STENCIL_COMPARE_MASK, face, ref, mask);
+}
+
+void CommandBufferCapture::draw(const DrawInfo &info) {
+    _actor->draw(info);
+
+    record(CaptureOp::CMD_DRAW, info);
+}
+
+void CommandBufferCapture::drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) {
+    _actor->drawIndirect(static_cast<BufferCapture *>(indirectBuffer)->getActor(), firstDraw, drawCount);
+
+    record(CaptureOp::CMD_DRAW_INDIRECT, indirectBuffer, firstDraw, drawCount);
+}
+
+void CommandBufferCapture::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    _actor->updateBuffer(static_cast<BufferCapture *>(buff)->getActor(), data, size);
+
+    record(CaptureOp::CMD_UPDATE_BUFFER, buff, CaptureBytes{data, size});
+}
+
+void CommandBufferCapture::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    _actor->updateBufferRange(static_cast<BufferCapture *>(buff)->getActor(), data, offset, size);
+
+    record(CaptureOp::CMD_UPDATE_BUFFER_RANGE, buff, offset, CaptureBytes{data, size});
+}
+
+void CommandBufferCapture::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    _actor->copyBuffersToTexture(buffers, static_cast<TextureCapture *>(texture)->getActor(), regions, count);
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE, texture, ccstd::vector<BufferTextureCopy>(regions, regions + count), getCopyBufferBytes(texture, buffers, regions, count));
+}
+
+void CommandBufferCapture::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    Texture *actorSrcTexture = nullptr;
+    Texture *actorDstTexture = nullptr;
+    if (srcTexture) actorSrcTexture = static_cast<TextureCapture *>(srcTexture)->getActor();
+    if (dstTexture) actorDstTexture = static_cast<TextureCapture *>(dstTexture)->getActor();
+
+    _actor->blitTexture(actorSrcTexture, actorDstTexture, regions, count, filter);
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_BLIT_TEXTURE, srcTexture, dstTexture, ccstd::vector<TextureBlit>(regions, regions + count), filter);
+}
+
+void CommandBufferCapture::dispatch(const DispatchInfo &info) {
+    DispatchInfo actorInfo = info;
+    if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferCapture *>(info.indirectBuffer)->getActor();
+
+    _actor->dispatch(actorInfo);
+
+    record(CaptureOp::CMD_DISPATCH, info);
+}
+
+void CommandBufferCapture::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferBarrierCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    static ccstd::vector<Texture *> textureActors;
+    textureActors.resize(textureBarrierCount);
+
+    Texture **actorTextures = nullptr;
+    if (textureBarrierCount) {
+        actorTextures = textureActors.data();
+        for (uint32_t i = 0U; i < textureBarrierCount; ++i) {
+            actorTextures[i] = textures[i] ? static_cast<const TextureCapture *>(textures[i])->getActor() : nullptr;
+        }
+    }
+
+    static ccstd::vector<Buffer *> bufferActors;
+    bufferActors.resize(bufferBarrierCount);
+
+    Buffer **actorBuffers = nullptr;
+    if (bufferBarrierCount) {
+        actorBuffers = bufferActors.data();
+        for (uint32_t i = 0U; i < bufferBarrierCount; ++i) {
+            actorBuffers[i] = buffers[i] ? static_cast<const BufferCapture *>(buffers[i])->getActor() : nullptr;
+        }
+    }
+
+    _actor->pipelineBarrier(barrier, bufferBarriers, actorBuffers, bufferBarrierCount, textureBarriers, actorTextures, textureBarrierCount);
+
+    if (!_recording) return;
+    record(CaptureOp::CMD_PIPELINE_BARRIER, barrier,
+           ccstd::vector<const BufferBarrier *>(bufferBarriers, bufferBarriers + bufferBarrierCount),
+           ccstd::vector<const Buffer *>(buffers, buffers + bufferBarrierCount),
+           ccstd::vector<const TextureBarrier *>(textureBarriers, textureBarriers + textureBarrierCount),
+           ccstd::vector<const Texture *>(textures, textures + textureBarrierCount));
+}
+
+void CommandBufferCapture::beginQuery(QueryPool *queryPool, uint32_t id) {
+    _actor->beginQuery(static_cast<QueryPoolCapture *>(queryPool)->getActor(), id);
+
+    record(CaptureOp::CMD_BEGIN_QUERY, queryPool, id);
+}
+
+void CommandBufferCapture::endQuery(QueryPool *queryPool, uint32_t id) {
+    _actor->endQuery(static_cast<QueryPoolCapture *>(queryPool)->getActor(), id);
+
+    record(CaptureOp::CMD_END_QUERY, queryPool, id);
+}
+
+void CommandBufferCapture::resetQueryPool(QueryPool *queryPool) {
+    _actor->resetQueryPool(static_cast<QueryPoolCapture *>(queryPool)->getActor());
+
+    record(CaptureOp::CMD_RESET_QUERY_POOL, queryPool);
+}
+
+void CommandBufferCapture::completeQueryPool(QueryPool *queryPool) {
+    _actor->completeQueryPool(static_cast<QueryPoolCapture *>(queryPool)->getActor());
+
+    record(CaptureOp::CMD_COMPLETE_QUERY_POOL, queryPool);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DescriptorSetCapture.h"
+#include "BufferCapture.h"
+#include "DescriptorSetLayoutCapture.h"
+#include "DeviceCapture.h"
+#include "TextureCapture.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+
+namespace cc {
+namespace gfx {
+
+DescriptorSetCapture::DescriptorSetCapture(DescriptorSet *actor)
+: Agent<DescriptorSet>(actor) {
+    _typedID = actor->getTypedID();
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+DescriptorSetCapture::~DescriptorSetCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    CC_SAFE_DELETE(_actor);
+}
+
+void DescriptorSetCapture::doInit(const DescriptorSetInfo &info) {
+    DescriptorSetInfo actorInfo;
+    actorInfo.layout = static_cast<DescriptorSetLayoutCapture *>(info.layout)->getActor();
+
+    _actor->initialize(actorInfo);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_DESCRIPTOR_SET, _captureID, info);
+}
+
+void DescriptorSetCapture::doDestroy() {
+    _actor->destroy();
+
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void DescriptorSetCapture::update() {
+    if (!_isDirty) return;
+
+    _actor->update();
+    _isDirty = false;
+
+    updateBindings();
+}
+
+void DescriptorSetCapture::forceUpdate() {
+    _isDirty = true;
+    _actor->forceUpdate();
+    _isDirty = false;
+
+    updateBindings();
+}
+
+void DescriptorSetCapture::updateBindings() {
+    // The whole binding table is recorded on each update, so the last record alone restores the set.
+    CaptureDescriptorList descriptors;
+    const auto &descriptorIndices = _layout->getDescriptorIndices();
+    for (const auto &binding : _layout->getBindings()) {
+        for (uint32_t index = 0U; index < binding.count; ++index) {
+            const uint32_t descriptorIndex = descriptorIndices[binding.binding] + index;
+            Buffer *buffer = _buffers[descriptorIndex].ptr;
+            Texture *texture = _textures[descriptorIndex].ptr;
+            Sampler *sampler = _samplers[descriptorIndex].ptr;
+            if (buffer || texture || sampler) {
+                descriptors.push_back({binding.binding, index, buffer, texture, sampler});
+            }
+        }
+    }
+
+    DeviceCapture::getInstance()->updateBindings(_captureID, CaptureOp::UPDATE_DESCRIPTOR_SET, _captureID, descriptors);
+}
+
+void DescriptorSetCapture::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t index) {
+    DescriptorSet::bindBuffer(binding, buffer, index);
+
+    _actor->bindBuffer(binding, static_cast<BufferCapture *>(buffer)->getActor(), index);
+}
+
+void DescriptorSetCapture::bindTexture(uint32_t binding, Texture *texture, uint32_t index) {
+    DescriptorSet::bindTexture(binding, texture, index);
+
+    _actor->bindTexture(binding, static_cast<TextureCapture *>(texture)->getActor(), index);
+}
+
+void DescriptorSetCapture::bindSampler(uint32_t binding, Sampler *sampler, uint32_t index) {
+    DescriptorSet::bindSampler(binding, sampler, index);
+
+    _actor->bindSampler(binding, sampler, index);
+}
+
+} // namespace gfx
+} // namespace cc
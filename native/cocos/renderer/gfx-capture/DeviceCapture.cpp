@@ -0,0 +1,310 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+
+#include "BufferCapture.h"
+#include "CommandBufferCapture.h"
+#include "DescriptorSetCapture.h"
+#include "DescriptorSetLayoutCapture.h"
+#include "DeviceCapture.h"
+#include "FramebufferCapture.h"
+#include "InputAssemblerCapture.h"
+#include "PipelineLayoutCapture.h"
+#include "PipelineStateCapture.h"
+#include "QueryPoolCapture.h"
+#include "QueueCapture.h"
+#include "RenderPassCapture.h"
+#include "ShaderCapture.h"
+#include "SwapchainCapture.h"
+#include "TextureCapture.h"
+
+#include <cstring>
+
+namespace cc {
+namespace gfx {
+
+DeviceCapture *DeviceCapture::instance = nullptr;
+
+DeviceCapture *DeviceCapture::getInstance() {
+    return DeviceCapture::instance;
+}
+
+DeviceCapture::DeviceCapture(Device *device) : Agent(device) {
+    DeviceCapture::instance = this;
+}
+
+DeviceCapture::~DeviceCapture() {
+    CC_SAFE_DELETE(_actor);
+    DeviceCapture::instance = nullptr;
+}
+
+bool DeviceCapture::doInit(const DeviceInfo &info) {
+    if (!_actor->initialize(info)) {
+        return false;
+    }
+    _api = _actor->getGfxAPI();
+    _deviceName = _actor->getDeviceName();
+    _queue = ccnew QueueCapture(_actor->getQueue());
+    _queryPool = ccnew QueryPoolCapture(_actor->getQueryPool());
+    _cmdBuff = ccnew CommandBufferCapture(_actor->getCommandBuffer());
+    _renderer = _actor->getRenderer();
+    _vendor = _actor->getVendor();
+    _caps = _actor->_caps;
+    memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
+    // captures record every command of a frame, bundles would leave the replayed ones out
+    _features[toNumber(Feature::COMMAND_BUNDLE)] = false;
+    memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
+
+    static_cast<CommandBufferCapture *>(_cmdBuff)->_queue = _queue;
+
+    CC_LOG_INFO("Device capture enabled.");
+
+    return true;
+}
+
+void DeviceCapture::doDestroy() {
+    if (_cmdBuff) {
+        static_cast<CommandBufferCapture *>(_cmdBuff)->_actor = nullptr;
+        delete _cmdBuff;
+        _cmdBuff = nullptr;
+    }
+    if (_queryPool) {
+        static_cast<QueryPoolCapture *>(_queryPool)->_actor = nullptr;
+        delete _queryPool;
+        _queryPool = nullptr;
+    }
+    if (_queue) {
+        static_cast<QueueCapture *>(_queue)->_actor = nullptr;
+        delete _queue;
+        _queue = nullptr;
+    }
+
+    _capturing = false;
+    _pendingFrames = 0U;
+    _trace.clear();
+    _resources.clear();
+    _bindings.clear();
+
+    _actor->destroy();
+}
+
+void DeviceCapture::startCapture(uint32_t frameCount, const ccstd::string &path) {
+    if (_capturing || !frameCount) return;
+
+    _pendingFrames = frameCount;
+    _capturePath = path;
+}
+
+void DeviceCapture::beginCaptureWindow() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _trace.clear();
+    _trace(CAPTURE_MAGIC, CAPTURE_VERSION);
+
+    _trace.beginRecord(CaptureOp::DEVICE_OBJECTS);
+    _trace(_queue, _queryPool, _cmdBuff);
+    _trace.endRecord();
+
+    // Recreate everything alive so far, IDs are issued in creation order so dependencies come first.
+    // Buffer and texture contents uploaded before the window are not kept.
+    for (const auto &resource : _resources) _trace.append(resource.second);
+    for (const auto &bindings : _bindings) _trace.append(bindings.second);
+
+    _remainingFrames = _pendingFrames;
+    _pendingFrames = 0U;
+    _capturing = true;
+}
+
+void DeviceCapture::endCaptureWindow() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capturing = false;
+        _lastCapture.swap(_trace.getData());
+        _trace.clear();
+    }
+
+    CC_LOG_INFO("GFX capture finished, %u bytes recorded.", static_cast<uint32_t>(_lastCapture.size()));
+
+    if (_capturePath.empty()) return;
+
+    Data data;
+    data.copy(_lastCapture.data(), static_cast<uint32_t>(_lastCapture.size()));
+    if (!FileUtils::getInstance()->writeDataToFile(data, _capturePath)) {
+        CC_LOG_ERROR("Failed to write GFX capture to %s", _capturePath.c_str());
+    }
+}
+
+void DeviceCapture::eraseResource(uint32_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_resources.erase(id)) return;
+    _bindings.erase(id);
+
+    if (_capturing) {
+        _trace.beginRecord(CaptureOp::DESTROY);
+        _trace(id);
+        _trace.endRecord();
+    }
+}
+
+void DeviceCapture::acquire(Swapchain *const *swapchains, uint32_t count) {
+    if (_pendingFrames) beginCaptureWindow();
+
+    static ccstd::vector<Swapchain *> swapchainActors;
+    swapchainActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        auto *swapchain = static_cast<SwapchainCapture *>(swapchains[i]);
+        swapchainActors[i] = swapchain->getActor();
+    }
+
+    if (_onAcquire) _onAcquire->execute();
+    _actor->acquire(swapchainActors.data(), count);
+
+    if (_capturing) record(CaptureOp::ACQUIRE, ccstd::vector<Swapchain *>(swapchains, swapchains + count));
+}
+
+void DeviceCapture::present() {
+    _actor->present();
+
+    if (!_capturing) return;
+    record(CaptureOp::PRESENT);
+    if (!--_remainingFrames) endCaptureWindow();
+}
+
+CommandBuffer *DeviceCapture::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
+    CommandBuffer *actor = _actor->createCommandBuffer(info, hasAgent);
+    return ccnew CommandBufferCapture(actor);
+}
+
+Queue *DeviceCapture::createQueue() {
+    Queue *actor = _actor->createQueue();
+    return ccnew QueueCapture(actor);
+}
+
+QueryPool *DeviceCapture::createQueryPool() {
+    QueryPool *actor = _actor->createQueryPool();
+    return ccnew QueryPoolCapture(actor);
+}
+
+Swapchain *DeviceCapture::createSwapchain() {
+    Swapchain *actor = _actor->createSwapchain();
+    return ccnew SwapchainCapture(actor);
+}
+
+Buffer *DeviceCapture::createBuffer() {
+    Buffer *actor = _actor->createBuffer();
+    return ccnew BufferCapture(actor);
+}
+
+Texture *DeviceCapture::createTexture() {
+    Texture *actor = _actor->createTexture();
+    return ccnew TextureCapture(actor);
+}
+
+Shader *DeviceCapture::createShader() {
+    Shader *actor = _actor->createShader();
+    return ccnew ShaderCapture(actor);
+}
+
+InputAssembler *DeviceCapture::createInputAssembler() {
+    InputAssembler *actor = _actor->createInputAssembler();
+    return ccnew InputAssemblerCapture(actor);
+}
+
+RenderPass *DeviceCapture::createRenderPass() {
+    RenderPass *actor = _actor->createRenderPass();
+    return ccnew RenderPassCapture(actor);
+}
+
+Framebuffer *DeviceCapture::createFramebuffer() {
+    Framebuffer *actor = _actor->createFramebuffer();
+    return ccnew FramebufferCapture(actor);
+}
+
+DescriptorSet *DeviceCapture::createDescriptorSet() {
+    DescriptorSet *actor = _actor->createDescriptorSet();
+    return ccnew DescriptorSetCapture(actor);
+}
+
+DescriptorSetLayout *DeviceCapture::createDescriptorSetLayout() {
+    DescriptorSetLayout *actor = _actor->createDescriptorSetLayout();
+    return ccnew DescriptorSetLayoutCapture(actor);
+}
+
+PipelineLayout *DeviceCapture::createPipelineLayout() {
+    PipelineLayout *actor = _actor->createPipelineLayout();
+    return ccnew PipelineLayoutCapture(actor);
+}
+
+PipelineState *DeviceCapture::createPipelineState() {
+    PipelineState *actor = _actor->createPipelineState();
+    return ccnew PipelineStateCapture(actor);
+}
+
+void DeviceCapture::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) {
+    auto *textureCapture = static_cast<TextureCapture *>(dst);
+
+    _actor->copyBuffersToTexture(buffers, textureCapture->getActor(), regions, count);
+
+    if (_capturing) record(CaptureOp::COPY_BUFFERS_TO_TEXTURE, dst, ccstd::vector<BufferTextureCopy>(regions, regions + count), getCopyBufferBytes(dst, buffers, regions, count));
+}
+
+void DeviceCapture::copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count) {
+    auto *textureCapture = static_cast<TextureCapture *>(src);
+
+    // read-backs are not part of the trace
+    _actor->copyTextureToBuffers(textureCapture->getActor(), buffers, regions, count);
+}
+
+void DeviceCapture::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    static ccstd::vector<CommandBuffer *> cmdBuffActors;
+    cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        cmdBuffActors[i] = static_cast<CommandBufferCapture *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->flushCommands(cmdBuffActors.data(), count);
+
+    if (_capturing) record(CaptureOp::FLUSH_COMMANDS, ccstd::vector<CommandBuffer *>(cmdBuffs, cmdBuffs + count));
+}
+
+void DeviceCapture::getQueryPoolResults(QueryPool *queryPool) {
+    auto *queryPoolCapture = static_cast<QueryPoolCapture *>(queryPool);
+    auto *actorQueryPool = queryPoolCapture->getActor();
+
+    _actor->getQueryPoolResults(actorQueryPool);
+
+    std::lock_guard<std::mutex> lock(queryPoolCapture->_mutex);
+    queryPoolCapture->_results = static_cast<QueryPoolCapture *>(actorQueryPool)->_results;
+}
+
+} // namespace gfx
+} // namespace cc
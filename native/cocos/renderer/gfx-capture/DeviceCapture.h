@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include "CaptureUtils.h"
+#include "base/Agent.h"
+#include "base/std/container/map.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+class CC_DLL DeviceCapture final : public Agent<Device> {
+public:
+    static DeviceCapture *getInstance();
+
+    ~DeviceCapture() override;
+
+    using Device::copyBuffersToTexture;
+    using Device::createBuffer;
+    using Device::createCommandBuffer;
+    using Device::createDescriptorSet;
+    using Device::createDescriptorSetLayout;
+    using Device::createFramebuffer;
+    using Device::createGeneralBarrier;
+    using Device::createInputAssembler;
+    using Device::createPipelineLayout;
+    using Device::createPipelineState;
+    using Device::createQueryPool;
+    using Device::createQueue;
+    using Device::createRenderPass;
+    using Device::createSampler;
+    using Device::createShader;
+    using Device::createTexture;
+    using Device::createTextureBarrier;
+
+    void acquire(Swapchain *const *swapchains, uint32_t count) override;
+    void present() override;
+
+    CommandBuffer *createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) override;
+    Queue *createQueue() override;
+    QueryPool *createQueryPool() override;
+    Swapchain *createSwapchain() override;
+    Buffer *createBuffer() override;
+    Texture *createTexture() override;
+    Shader *createShader() override;
+    InputAssembler *createInputAssembler() override;
+    RenderPass *createRenderPass() override;
+    Framebuffer *createFramebuffer() override;
+    DescriptorSet *createDescriptorSet() override;
+    DescriptorSetLayout *createDescriptorSetLayout() override;
+    PipelineLayout *createPipelineLayout() override;
+    PipelineState *createPipelineState() override;
+
+    Sampler *getSampler(const SamplerInfo &info) override { return _actor->getSampler(info); }
+    GeneralBarrier *getGeneralBarrier(const GeneralBarrierInfo &info) override { return _actor->getGeneralBarrier(info); }
+    TextureBarrier *getTextureBarrier(const TextureBarrierInfo &info) override { return _actor->getTextureBarrier(info); }
+
+    void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
+    void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
+    void getQueryPoolResults(QueryPool *queryPool) override;
+
+    void flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) override;
+    MemoryStatus &getMemoryStatus() override { return _actor->getMemoryStatus(); }
+    uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
+    uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
+    uint32_t getNumTris() const override { return _actor->getNumTris(); }
+
+    // Captures the next `frameCount` frames, starting from the next acquire.
+    // The trace is written to `path` when finished, or only kept in memory if the path is empty.
+    void startCapture(uint32_t frameCount, const ccstd::string &path);
+    inline bool isCapturing() const { return _capturing; }
+    inline bool isCapturePending() const { return _pendingFrames > 0; }
+    inline const ccstd::vector<uint8_t> &getLastCapture() const { return _lastCapture; }
+
+    inline uint32_t generateCaptureID() { return _nextCaptureID++; }
+
+    // Appends a record to the trace, only while capturing.
+    template <typename... Args>
+    void record(CaptureOp op, const Args &...args) {
+        if (!_capturing) return;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _trace.beginRecord(op);
+        _trace(args...);
+        _trace.endRecord();
+    }
+
+    // Replaces the record that recreates resource `id` when a capture window opens,
+    // the record is also appended to the trace while capturing.
+    template <typename... Args>
+    void updateResource(uint32_t id, CaptureOp op, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        updateState(_resources[id], true, op, args...);
+    }
+
+    // Same as updateResource, for in-place changes that are recorded as a different op in the trace.
+    template <typename... Args>
+    void replaceResource(uint32_t id, CaptureOp op, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        updateState(_resources[id], false, op, args...);
+    }
+
+    // Same as updateResource for descriptor bindings, which may refer to resources created later.
+    template <typename... Args>
+    void updateBindings(uint32_t id, CaptureOp op, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        updateState(_bindings[id], true, op, args...);
+    }
+
+    void eraseResource(uint32_t id);
+
+protected:
+    static DeviceCapture *instance;
+
+    friend class DeviceManager;
+
+    explicit DeviceCapture(Device *device);
+
+    bool doInit(const DeviceInfo &info) override;
+    void doDestroy() override;
+
+    void bindContext(bool bound) override { _actor->bindContext(bound); }
+
+    template <typename... Args>
+    void updateState(CaptureWriter &state, bool append, CaptureOp op, const Args &...args) {
+        state.clear();
+        state.beginRecord(op);
+        state(args...);
+        state.endRecord();
+        if (append && _capturing) _trace.append(state);
+    }
+
+    void beginCaptureWindow();
+    void endCaptureWindow();
+
+    std::mutex _mutex;
+    CaptureWriter _trace;
+    ccstd::map<uint32_t, CaptureWriter> _resources;
+    ccstd::map<uint32_t, CaptureWriter> _bindings;
+    ccstd::vector<uint8_t> _lastCapture;
+    ccstd::string _capturePath;
+
+    uint32_t _nextCaptureID{1U};
+    uint32_t _pendingFrames{0U};
+    uint32_t _remainingFrames{0U};
+    bool _capturing{false};
+};
+
+} // namespace gfx
+} // namespace cc
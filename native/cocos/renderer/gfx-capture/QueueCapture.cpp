@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "QueueCapture.h"
+#include "CommandBufferCapture.h"
+#include "DeviceCapture.h"
+
+namespace cc {
+namespace gfx {
+
+QueueCapture::QueueCapture(Queue *actor)
+: Agent<Queue>(actor) {
+    _typedID = actor->getTypedID();
+    _type = actor->getType();
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+QueueCapture::~QueueCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    CC_SAFE_DELETE(_actor);
+}
+
+void QueueCapture::doInit(const QueueInfo &info) {
+    _actor->initialize(info);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_QUEUE, _captureID, info);
+}
+
+void QueueCapture::doDestroy() {
+    _actor->destroy();
+
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void QueueCapture::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    static ccstd::vector<CommandBuffer *> cmdBuffActors;
+    cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        cmdBuffActors[i] = static_cast<CommandBufferCapture *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->submit(cmdBuffActors.data(), count);
+
+    auto *device = DeviceCapture::getInstance();
+    if (device->isCapturing()) device->record(CaptureOp::SUBMIT, _captureID, ccstd::vector<CommandBuffer *>(cmdBuffs, cmdBuffs + count));
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "SwapchainCapture.h"
+#include "DeviceCapture.h"
+#include "TextureCapture.h"
+
+namespace cc {
+namespace gfx {
+
+SwapchainCapture::SwapchainCapture(Swapchain *actor)
+: Agent<Swapchain>(actor) {
+    _typedID = actor->getTypedID();
+    _preRotationEnabled = static_cast<SwapchainCapture *>(actor)->_preRotationEnabled;
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+SwapchainCapture::~SwapchainCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    CC_SAFE_DELETE(_actor);
+}
+
+void SwapchainCapture::doInit(const SwapchainInfo &info) {
+    _actor->initialize(info);
+
+    auto *colorTexture = ccnew TextureCapture(_actor->getColorTexture());
+    colorTexture->renounceOwnership();
+    _colorTexture = colorTexture;
+
+    auto *depthStencilTexture = ccnew TextureCapture(_actor->getDepthStencilTexture());
+    depthStencilTexture->renounceOwnership();
+    _depthStencilTexture = depthStencilTexture;
+
+    SwapchainTextureInfo textureInfo;
+    textureInfo.swapchain = this;
+    textureInfo.format = _actor->getColorTexture()->getFormat();
+    textureInfo.width = _actor->getWidth();
+    textureInfo.height = _actor->getHeight();
+    initTexture(textureInfo, _colorTexture);
+
+    textureInfo.format = _actor->getDepthStencilTexture()->getFormat();
+    initTexture(textureInfo, _depthStencilTexture);
+
+    _transform = _actor->getSurfaceTransform();
+
+    updateResource(true);
+}
+
+void SwapchainCapture::doDestroy() {
+    _depthStencilTexture = nullptr;
+    _colorTexture = nullptr;
+
+    _actor->destroy();
+
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void SwapchainCapture::updateInfo() {
+    _generation = _actor->getGeneration();
+    SwapchainTextureInfo textureInfo;
+    textureInfo.swapchain = this;
+    textureInfo.format = _actor->getColorTexture()->getFormat();
+    textureInfo.width = _actor->getWidth();
+    textureInfo.height = _actor->getHeight();
+    updateTextureInfo(textureInfo, _colorTexture);
+
+    textureInfo.format = _actor->getDepthStencilTexture()->getFormat();
+    updateTextureInfo(textureInfo, _depthStencilTexture);
+
+    _transform = _actor->getSurfaceTransform();
+}
+
+void SwapchainCapture::updateResource(bool append) {
+    SwapchainInfo info;
+    info.windowId = _windowId;
+    info.vsyncMode = _vsyncMode;
+    info.width = getWidth();
+    info.height = getHeight();
+
+    // the swapchain textures are recreated along with the swapchain, only their IDs are needed
+    auto *device = DeviceCapture::getInstance();
+    const uint32_t colorTextureID = static_cast<TextureCapture *>(_colorTexture.get())->getCaptureID();
+    const uint32_t depthStencilTextureID = static_cast<TextureCapture *>(_depthStencilTexture.get())->getCaptureID();
+    if (append) {
+        device->updateResource(_captureID, CaptureOp::CREATE_SWAPCHAIN, _captureID, info, colorTextureID, depthStencilTextureID);
+    } else {
+        device->replaceResource(_captureID, CaptureOp::CREATE_SWAPCHAIN, _captureID, info, colorTextureID, depthStencilTextureID);
+    }
+}
+
+void SwapchainCapture::doResize(uint32_t width, uint32_t height, SurfaceTransform transform) {
+    _actor->resize(width, height, transform);
+
+    updateInfo();
+
+    updateResource(false);
+    DeviceCapture::getInstance()->record(CaptureOp::RESIZE_SWAPCHAIN, _captureID, width, height, transform);
+}
+
+void SwapchainCapture::doDestroySurface() {
+    _actor->destroySurface();
+}
+
+void SwapchainCapture::doCreateSurface(void *windowHandle) {
+    _actor->createSurface(windowHandle);
+
+    updateInfo();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "TextureCapture.h"
+#include "DeviceCapture.h"
+
+namespace cc {
+namespace gfx {
+
+TextureCapture::TextureCapture(Texture *actor)
+: Agent<Texture>(actor) {
+    _typedID = actor->getTypedID();
+    _captureID = DeviceCapture::getInstance()->generateCaptureID();
+}
+
+TextureCapture::~TextureCapture() {
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+    if (_ownTheActor) CC_SAFE_DELETE(_actor);
+}
+
+void TextureCapture::doInit(const TextureInfo &info) {
+    _actor->initialize(info);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_TEXTURE, _captureID, info);
+}
+
+void TextureCapture::doInit(const TextureViewInfo &info) {
+    TextureViewInfo actorInfo = info;
+    actorInfo.texture = static_cast<TextureCapture *>(info.texture)->getActor();
+
+    _actor->initialize(actorInfo);
+
+    DeviceCapture::getInstance()->updateResource(_captureID, CaptureOp::CREATE_TEXTURE_VIEW, _captureID, info);
+}
+
+void TextureCapture::doInit(const SwapchainTextureInfo & /*info*/) {
+    // the actor is already initialized, and recreated along with the swapchain on replay
+}
+
+void TextureCapture::doDestroy() {
+    _actor->destroy();
+
+    DeviceCapture::getInstance()->eraseResource(_captureID);
+}
+
+void TextureCapture::doResize(uint32_t width, uint32_t height, uint32_t /*size*/) {
+    _actor->resize(width, height);
+
+    // _info is updated after this call, the level count already is
+    TextureInfo info = _info;
+    info.width = width;
+    info.height = height;
+    auto *device = DeviceCapture::getInstance();
+    device->replaceResource(_captureID, CaptureOp::CREATE_TEXTURE, _captureID, info);
+    device->record(CaptureOp::RESIZE_TEXTURE, _captureID, width, height);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -35,9 +35,12 @@ void EmptyCommandBuffer::doDestroy() {
 }
 
 void EmptyCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    _isBundle = false;
 }
 
 void EmptyCommandBuffer::end() {
+    _isBundle = _recordingBundle;
+    _recordingBundle = false;
 }
 
 void EmptyCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
@@ -88,9 +91,15 @@ void EmptyCommandBuffer::nextSubpass() {
 void EmptyCommandBuffer::draw(const DrawInfo &info) {
 }
 
+void EmptyCommandBuffer::drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) {
+}
+
 void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
 }
 
+void EmptyCommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+}
+
 void EmptyCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
 }
 
@@ -111,5 +120,19 @@ void EmptyCommandBuffer::endQuery(QueryPool *queryPool, uint32_t id) {
 void EmptyCommandBuffer::resetQueryPool(QueryPool *queryPool) {
 }
 
+bool EmptyCommandBuffer::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    begin(renderPass, subpass, frameBuffer);
+    _recordingBundle = true;
+    return true;
+}
+
+void EmptyCommandBuffer::releaseBundle() {
+    _isBundle = false;
+}
+
+bool EmptyCommandBuffer::updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    return _isBundle;
+}
+
 } // namespace gfx
 } // namespace cc
@@ -49,7 +49,9 @@ public:
     void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
+    void drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
@@ -58,6 +60,9 @@ public:
     void beginQuery(QueryPool *queryPool, uint32_t id) override;
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
+    bool beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) override;
+    void releaseBundle() override;
+    bool updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override;
 
 protected:
     void doInit(const CommandBufferInfo &info) override;
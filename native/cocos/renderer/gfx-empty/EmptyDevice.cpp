@@ -73,6 +73,10 @@ bool EmptyDevice::doInit(const DeviceInfo & /*info*/) {
 
     _formatFeatures.fill(static_cast<FormatFeature>(-1)); // allow all usages for all formats
     _formatFeatures[toNumber(Format::UNKNOWN)] = FormatFeature::NONE;
+    // lets headless runs exercise the indirect draw paths and the merged 32-bit index buffers
+    _features[toNumber(Feature::DRAW_INDIRECT_FIRST_INSTANCE)] = true;
+    _features[toNumber(Feature::ELEMENT_INDEX_UINT)] = true;
+    _features[toNumber(Feature::COMMAND_BUNDLE)] = true;
 
     CC_LOG_INFO("Empty device initialized.");
 
@@ -299,6 +299,20 @@ void GLES2CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t s
     }
 }
 
+void GLES2CommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    GLES2GPUBuffer *gpuBuffer = static_cast<GLES2Buffer *>(buff)->gpuBuffer();
+    if (gpuBuffer) {
+        GLES2CmdUpdateBuffer *cmd = _cmdAllocator->updateBufferCmdPool.alloc();
+        cmd->gpuBuffer = gpuBuffer;
+        cmd->offset = offset;
+        cmd->size = size;
+        cmd->buffer = static_cast<const uint8_t *>(data);
+
+        _curCmdPackage->updateBufferCmds.push(cmd);
+        _curCmdPackage->cmds.push(GLESCmdType::UPDATE_BUFFER);
+    }
+}
+
 void GLES2CommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     GLES2GPUTexture *gpuTexture = static_cast<GLES2Texture *>(texture)->gpuTexture();
     if (gpuTexture) {
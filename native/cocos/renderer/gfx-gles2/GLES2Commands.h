@@ -88,6 +88,7 @@ public:
     void clear() override {
         gpuBuffer = nullptr;
         buffer = nullptr;
+        offset = 0;
     }
 };
 
@@ -143,6 +143,13 @@ void GLES2PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uin
     }
 }
 
+void GLES2PrimaryCommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    GLES2GPUBuffer *gpuBuffer = static_cast<GLES2Buffer *>(buff)->gpuBuffer();
+    if (gpuBuffer) {
+        cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), gpuBuffer, data, offset, size);
+    }
+}
+
 void GLES2PrimaryCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     GLES2GPUTexture *gpuTexture = static_cast<GLES2Texture *>(texture)->gpuTexture();
     if (gpuTexture) {
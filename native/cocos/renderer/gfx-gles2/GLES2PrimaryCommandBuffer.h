@@ -44,6 +44,7 @@ public:
     void setViewport(const Viewport &vp) override;
     void setScissor(const Rect &rect) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
@@ -62,6 +62,7 @@ void GLES3CommandBuffer::doInit(const CommandBufferInfo & /*info*/) {
 void GLES3CommandBuffer::doDestroy() {
     if (!_cmdAllocator) return;
 
+    releaseBundle();
     _cmdAllocator->clearCmds(_curCmdPackage);
     CC_SAFE_DELETE(_curCmdPackage);
 
@@ -84,6 +85,9 @@ void GLES3CommandBuffer::doDestroy() {
 }
 
 void GLES3CommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    if (_isBundle) {
+        releaseBundle();
+    }
     _curGPUPipelineState = nullptr;
     _curGPUInputAssember = nullptr;
     _curGPUDescriptorSets.assign(_curGPUDescriptorSets.size(), nullptr);
@@ -100,7 +104,13 @@ void GLES3CommandBuffer::end() {
         bindStates();
     }
 
-    _pendingPackages.push(_curCmdPackage);
+    if (_recordingBundle) {
+        _bundlePackage = _curCmdPackage;
+        _recordingBundle = false;
+        _isBundle = true;
+    } else {
+        _pendingPackages.push(_curCmdPackage);
+    }
     if (!_freePackages.empty()) {
         _curCmdPackage = _freePackages.front();
         _freePackages.pop();
@@ -141,6 +151,7 @@ void GLES3CommandBuffer::nextSubpass() {
 }
 
 void GLES3CommandBuffer::bindPipelineState(PipelineState *pso) {
+    retainBundleResource(pso);
     GLES3GPUPipelineState *gpuPipelineState = static_cast<GLES3PipelineState *>(pso)->gpuPipelineState();
     if (_curGPUPipelineState != gpuPipelineState) {
         _curGPUPipelineState = gpuPipelineState;
@@ -150,6 +161,7 @@ void GLES3CommandBuffer::bindPipelineState(PipelineState *pso) {
 
 void GLES3CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
     CC_ASSERT(_curGPUDescriptorSets.size() > set);
+    retainBundleResource(descriptorSet);
 
     GLES3GPUDescriptorSet *gpuDescriptorSet = static_cast<GLES3DescriptorSet *>(descriptorSet)->gpuDescriptorSet();
     if (_curGPUDescriptorSets[set] != gpuDescriptorSet) {
@@ -166,6 +178,7 @@ void GLES3CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void GLES3CommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    retainBundleResource(ia);
     _curGPUInputAssember = static_cast<GLES3InputAssembler *>(ia)->gpuInputAssembler();
     _isStateInvalid = true;
 }
@@ -312,6 +325,20 @@ void GLES3CommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, c
     _curCmdPackage->cmds.push(GLESCmdType::BLIT_TEXTURE);
 }
 
+void GLES3CommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    GLES3GPUBuffer *gpuBuffer = static_cast<GLES3Buffer *>(buff)->gpuBuffer();
+    if (gpuBuffer) {
+        GLES3CmdUpdateBuffer *cmd = _cmdAllocator->updateBufferCmdPool.alloc();
+        cmd->gpuBuffer = gpuBuffer;
+        cmd->offset = offset;
+        cmd->size = size;
+        cmd->buffer = static_cast<const uint8_t *>(data);
+
+        _curCmdPackage->updateBufferCmds.push(cmd);
+        _curCmdPackage->cmds.push(GLESCmdType::UPDATE_BUFFER);
+    }
+}
+
 void GLES3CommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     GLES3GPUTexture *gpuTexture = static_cast<GLES3Texture *>(texture)->gpuTexture();
     if (gpuTexture) {
@@ -389,6 +416,44 @@ void GLES3CommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
     }
 }
 
+bool GLES3CommandBuffer::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    CC_ASSERT(_type == CommandBufferType::SECONDARY); // Only secondary command buffers could be recorded as bundles.
+    releaseBundle();
+    _recordingBundle = true;
+    begin(renderPass, subpass, frameBuffer);
+    return true;
+}
+
+void GLES3CommandBuffer::releaseBundle() {
+    if (_bundlePackage) {
+        _cmdAllocator->clearCmds(_bundlePackage);
+        _freePackages.push(_bundlePackage);
+        _bundlePackage = nullptr;
+    }
+    _recordingBundle = false;
+    _isBundle = false;
+    _bundleResources.clear();
+}
+
+bool GLES3CommandBuffer::updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (!_bundlePackage) return false;
+
+    // the offsets are flattened per pipeline layout in each bind command
+    for (uint32_t i = 0; i < _bundlePackage->bindStatesCmds.size(); ++i) {
+        GLES3CmdBindStates *cmd = _bundlePackage->bindStatesCmds[i];
+        if (!cmd->gpuPipelineState || set >= cmd->gpuDescriptorSets.size() || !cmd->gpuDescriptorSets[set]) {
+            continue;
+        }
+        const auto &dynamicOffsetOffsets = cmd->gpuPipelineState->gpuPipelineLayout->dynamicOffsetOffsets;
+        if (set + 1 >= dynamicOffsetOffsets.size()) {
+            continue;
+        }
+        const uint32_t count = std::min(dynamicOffsetCount, dynamicOffsetOffsets[set + 1] - dynamicOffsetOffsets[set]);
+        if (count) memcpy(&cmd->dynamicOffsets[dynamicOffsetOffsets[set]], dynamicOffsets, count * sizeof(uint32_t));
+    }
+    return true;
+}
+
 void GLES3CommandBuffer::bindStates() {
     GLES3CmdBindStates *cmd = _cmdAllocator->bindStatesCmdPool.alloc();
     cmd->gpuPipelineState = _curGPUPipelineState;
@@ -61,6 +61,7 @@ public:
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
@@ -69,6 +70,9 @@ public:
     void beginQuery(QueryPool *queryPool, uint32_t id) override;
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
+    bool beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) override;
+    void releaseBundle() override;
+    bool updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override;
 
 protected:
     friend class GLES3Queue;
@@ -84,6 +88,8 @@ protected:
     GLES3GPUCommandAllocator *_cmdAllocator = nullptr;
     GLES3CmdPackage *_curCmdPackage = nullptr;
     ccstd::queue<GLES3CmdPackage *> _pendingPackages, _freePackages;
+    // the package kept by the bundle, executed without being recycled
+    GLES3CmdPackage *_bundlePackage = nullptr;
 
     uint32_t _curSubpassIdx = 0U;
     GLES3GPUPipelineState *_curGPUPipelineState = nullptr;
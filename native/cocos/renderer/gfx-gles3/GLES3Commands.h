@@ -112,6 +112,7 @@ public:
     void clear() override {
         gpuBuffer = nullptr;
         buffer = nullptr;
+        offset = 0;
     }
 };
 
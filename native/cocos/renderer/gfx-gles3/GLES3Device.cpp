@@ -113,6 +113,7 @@ bool GLES3Device::doInit(const DeviceInfo & /*info*/) {
     _features[toNumber(Feature::MULTIPLE_RENDER_TARGETS)] = true;
     _features[toNumber(Feature::BLEND_MINMAX)] = true;
     _features[toNumber(Feature::ELEMENT_INDEX_UINT)] = true;
+    _features[toNumber(Feature::COMMAND_BUNDLE)] = true;
 
     if (_gpuConstantRegistry->glMinorVersion) {
         _features[toNumber(Feature::COMPUTE_SHADER)] = true;
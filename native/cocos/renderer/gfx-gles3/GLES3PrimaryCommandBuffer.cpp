@@ -54,6 +54,8 @@ void GLES3PrimaryCommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*su
     _numDrawCalls = 0;
     _numInstances = 0;
     _numTriangles = 0;
+    _numReplayedDrawCalls = 0;
+    _numRecordedDrawCalls = 0;
 }
 
 void GLES3PrimaryCommandBuffer::end() {
@@ -135,6 +137,13 @@ void GLES3PrimaryCommandBuffer::updateBuffer(Buffer *buff, const void *data, uin
     }
 }
 
+void GLES3PrimaryCommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    GLES3GPUBuffer *gpuBuffer = static_cast<GLES3Buffer *>(buff)->gpuBuffer();
+    if (gpuBuffer) {
+        cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), gpuBuffer, data, offset, size);
+    }
+}
+
 void GLES3PrimaryCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     GLES3GPUTexture *gpuTexture = static_cast<GLES3Texture *>(texture)->gpuTexture();
     if (gpuTexture) {
@@ -179,7 +188,11 @@ void GLES3PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t
     for (uint32_t i = 0; i < count; ++i) {
         auto *cmdBuff = static_cast<GLES3PrimaryCommandBuffer *>(cmdBuffs[i]);
 
-        if (!cmdBuff->_pendingPackages.empty()) {
+        if (cmdBuff->_bundlePackage) {
+            // bundles keep their package, replay it as is
+            cmdFuncGLES3ExecuteCmds(GLES3Device::getInstance(), cmdBuff->_bundlePackage);
+            _numReplayedDrawCalls += cmdBuff->_numDrawCalls;
+        } else if (!cmdBuff->_pendingPackages.empty()) {
             GLES3CmdPackage *cmdPackage = cmdBuff->_pendingPackages.front();
 
             cmdFuncGLES3ExecuteCmds(GLES3Device::getInstance(), cmdPackage);
@@ -188,6 +201,7 @@ void GLES3PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t
             cmdBuff->_freePackages.push(cmdPackage);
             cmdBuff->_cmdAllocator->clearCmds(cmdPackage);
             cmdBuff->_cmdAllocator->reset();
+            _numRecordedDrawCalls += cmdBuff->_numDrawCalls;
         }
 
         _numDrawCalls += cmdBuff->_numDrawCalls;
@@ -196,6 +210,12 @@ void GLES3PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t
     }
 }
 
+bool GLES3PrimaryCommandBuffer::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    // commands are executed right away, nothing could be kept
+    begin(renderPass, subpass, frameBuffer);
+    return false;
+}
+
 void GLES3PrimaryCommandBuffer::bindStates() {
     if (_curGPUPipelineState) {
         ccstd::vector<uint32_t> &dynamicOffsetOffsets = _curGPUPipelineState->gpuPipelineLayout->dynamicOffsetOffsets;
@@ -44,6 +44,7 @@ public:
     void setViewport(const Viewport &vp) override;
     void setScissor(const Rect &rect) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
+    void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     void dispatch(const DispatchInfo &info) override;
@@ -52,6 +53,7 @@ public:
     void beginQuery(QueryPool *queryPool, uint32_t id) override;
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
+    bool beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) override;
 
 protected:
     friend class GLES3Queue;
@@ -684,6 +684,26 @@ void CCMTLCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t s
     [encoder endEncoding];
 }
 
+void CCMTLCommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    CC_PROFILE(CCMTLCmdBufUpdateBufferRange);
+    if (!buff) {
+        CC_LOG_ERROR("CCMTLCommandBuffer::updateBufferRange: buffer is nullptr.");
+        return;
+    }
+
+    CCMTLGPUBuffer stagingBuffer;
+    stagingBuffer.size = size;
+    _mtlDevice->gpuStagingBufferPool()->alloc(&stagingBuffer);
+    memcpy(stagingBuffer.mappedData, data, size);
+    id<MTLBlitCommandEncoder> encoder = [getMTLCommandBuffer() blitCommandEncoder];
+    [encoder copyFromBuffer:stagingBuffer.mtlBuffer
+               sourceOffset:stagingBuffer.startOffset
+                   toBuffer:static_cast<CCMTLBuffer *>(buff)->getMTLBuffer()
+          destinationOffset:offset
+                       size:size];
+    [encoder endEncoding];
+}
+
 void CCMTLCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     if (!texture) {
         CC_LOG_ERROR("CCMTLCommandBuffer::copyBufferToTexture: texture is nullptr");
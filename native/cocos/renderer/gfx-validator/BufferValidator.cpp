@@ -166,7 +166,7 @@ void BufferValidator::update(const void *buffer, uint32_t size) {
     _actor->update(buffer, size);
 }
 
-void BufferValidator::sanityCheck(const void *buffer, uint32_t size) {
+void BufferValidator::sanityCheck(const void *buffer, uint32_t size, uint32_t offset) {
     uint64_t cur = DeviceValidator::getInstance()->currentFrame();
 
     if (cur == _lastUpdateFrame) {
@@ -178,7 +178,7 @@ void BufferValidator::sanityCheck(const void *buffer, uint32_t size) {
 
     if (DeviceValidator::getInstance()->isRecording()) {
         _buffer.resize(_size);
-        memcpy(_buffer.data(), buffer, size);
+        memcpy(_buffer.data() + offset, buffer, size);
     }
 
     _lastUpdateFrame = cur;
@@ -38,7 +38,7 @@ public:
 
     void update(const void *buffer, uint32_t size) override;
 
-    void sanityCheck(const void *buffer, uint32_t size);
+    void sanityCheck(const void *buffer, uint32_t size, uint32_t offset = 0U);
 
     inline bool isInited() const { return _inited; }
 
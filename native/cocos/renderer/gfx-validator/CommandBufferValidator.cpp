@@ -110,7 +110,45 @@ void CommandBufferValidator::begin(RenderPass *renderPass, uint32_t subpass, Fra
     RenderPass *renderPassActor = renderPass ? static_cast<RenderPassValidator *>(renderPass)->getActor() : nullptr;
     Framebuffer *framebufferActor = framebuffer ? static_cast<FramebufferValidator *>(framebuffer)->getActor() : nullptr;
 
-    _actor->begin(renderPassActor, subpass, framebufferActor);
+    // the actor drops its previous bundle either way, before the validators are released
+    ccstd::vector<IntrusivePtr<RefCounted>> releasedResources;
+    releasedResources.swap(_bundleResources);
+    if (_recordingBundle) {
+        _recordingBundle = _actor->beginBundle(renderPassActor, subpass, framebufferActor);
+        retainBundleResource(renderPass);
+        retainBundleResource(framebuffer);
+    } else {
+        _actor->begin(renderPassActor, subpass, framebufferActor);
+    }
+}
+
+bool CommandBufferValidator::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *framebuffer) {
+    // Only secondary command buffers could be recorded as bundles.
+    CC_ASSERT(_type == CommandBufferType::SECONDARY);
+
+    _recordingBundle = true;
+    begin(renderPass, subpass, framebuffer);
+    return _recordingBundle;
+}
+
+void CommandBufferValidator::releaseBundle() {
+    CC_ASSERT(isInited());
+
+    /////////// execute ///////////
+
+    _actor->releaseBundle();
+
+    // the actor references the actors of these until it released the bundle
+    _bundleResources.clear();
+}
+
+bool CommandBufferValidator::updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    CC_ASSERT(isInited());
+    CC_ASSERT(!dynamicOffsetCount || dynamicOffsets);
+
+    /////////// execute ///////////
+
+    return _actor->updateBundleDynamicOffsets(set, dynamicOffsetCount, dynamicOffsets);
 }
 
 void CommandBufferValidator::end() {
@@ -120,6 +158,7 @@ void CommandBufferValidator::end() {
     // Still inside a render pass?
     CC_ASSERT(_type != CommandBufferType::PRIMARY || !_insideRenderPass);
     _insideRenderPass = false;
+    _recordingBundle = false;
 
     /////////// execute ///////////
 
@@ -235,6 +274,7 @@ void CommandBufferValidator::bindPipelineState(PipelineState *pso) {
     CC_ASSERT(pso && static_cast<PipelineStateValidator *>(pso)->isInited());
 
     _curStates.pipelineState = pso;
+    retainBundleResource(pso);
 
     /////////// execute ///////////
 
@@ -249,6 +289,7 @@ void CommandBufferValidator::bindDescriptorSet(uint32_t set, DescriptorSet *desc
     // CC_ASSERT(descriptorSet->getLayout()->getDynamicBindings().size() == dynamicOffsetCount); // be more lenient on this
 
     _curStates.descriptorSets[set] = descriptorSet;
+    retainBundleResource(descriptorSet);
     _curStates.dynamicOffsets[set].assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
 
     /////////// execute ///////////
@@ -261,6 +302,7 @@ void CommandBufferValidator::bindInputAssembler(InputAssembler *ia) {
     CC_ASSERT(ia && static_cast<InputAssemblerValidator *>(ia)->isInited());
 
     _curStates.inputAssembler = ia;
+    retainBundleResource(ia);
 
     /////////// execute ///////////
 
@@ -385,6 +427,31 @@ void CommandBufferValidator::draw(const DrawInfo &info) {
     _actor->draw(info);
 }
 
+void CommandBufferValidator::drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) {
+    CC_ASSERT(isInited());
+    CC_ASSERT(indirectBuffer && static_cast<BufferValidator *>(indirectBuffer)->isInited());
+
+    // Command 'drawIndirect' must be recorded inside render passes.
+    CC_ASSERT(_insideRenderPass);
+    // The device should support indirect draws with instance offsets.
+    CC_ASSERT(DeviceValidator::getInstance()->hasFeature(Feature::DRAW_INDIRECT_FIRST_INSTANCE));
+    // The buffer should be created with the indirect usage.
+    CC_ASSERT(hasFlag(indirectBuffer->getUsage(), BufferUsageBit::INDIRECT));
+    // The draws should be within the buffer.
+    CC_ASSERT(firstDraw + drawCount <= indirectBuffer->getCount());
+    // A pipeline state and an input assembler should be bound.
+    CC_ASSERT(_curStates.pipelineState && _curStates.inputAssembler);
+    retainBundleResource(indirectBuffer);
+
+    if (DeviceValidator::getInstance()->isRecording()) {
+        _recorder.recordDrawcall(_curStates);
+    }
+
+    /////////// execute ///////////
+
+    _actor->drawIndirect(static_cast<BufferValidator *>(indirectBuffer)->getActor(), firstDraw, drawCount);
+}
+
 void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     CC_ASSERT(isInited());
     CC_ASSERT(buff && static_cast<BufferValidator *>(buff)->isInited());
@@ -402,6 +469,29 @@ void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32
     _actor->updateBuffer(bufferValidator->getActor(), data, size);
 }
 
+void CommandBufferValidator::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    CC_ASSERT(isInited());
+    CC_ASSERT(buff && static_cast<BufferValidator *>(buff)->isInited());
+
+    // Command 'updateBufferRange' must be recorded in primary command buffers.
+    CC_ASSERT(_type == CommandBufferType::PRIMARY);
+    // Command 'updateBufferRange' must be recorded outside render passes.
+    CC_ASSERT(!_insideRenderPass);
+    // Offset and size should be 4-byte aligned.
+    CC_ASSERT(!(offset & 3) && !(size & 3));
+    // The updated range should lie inside the buffer.
+    CC_ASSERT(offset + size <= buff->getSize());
+    // Indirect buffers are converted per DrawInfo, so ranges have to cover whole entries.
+    CC_ASSERT(!hasFlag(buff->getUsage(), BufferUsageBit::INDIRECT) || (!(offset % sizeof(DrawInfo)) && !(size % sizeof(DrawInfo))));
+
+    auto *bufferValidator = static_cast<BufferValidator *>(buff);
+    bufferValidator->sanityCheck(data, size, offset);
+
+    /////////// execute ///////////
+
+    _actor->updateBufferRange(bufferValidator->getActor(), data, offset, size);
+}
+
 void CommandBufferValidator::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     CC_ASSERT(isInited());
     CC_ASSERT(texture && static_cast<TextureValidator *>(texture)->isInited());
@@ -430,6 +520,8 @@ void CommandBufferValidator::blitTexture(Texture *srcTexture, Texture *dstTextur
 
     // Command 'blitTexture' must be recorded outside render passes.
     CC_ASSERT(!_insideRenderPass);
+    // Bundles can't keep transfer commands.
+    CC_ASSERT(!_recordingBundle);
 
     for (uint32_t i = 0; i < count; ++i) {
         const auto &region = regions[i];
@@ -457,6 +549,7 @@ void CommandBufferValidator::dispatch(const DispatchInfo &info) {
 
     // Command 'dispatch' must be recorded outside render passes.
     CC_ASSERT(!_insideRenderPass);
+    retainBundleResource(info.indirectBuffer);
 
     /////////// execute ///////////
 
@@ -476,6 +569,8 @@ void CommandBufferValidator::pipelineBarrier(const GeneralBarrier *barrier, cons
     for (uint32_t i = 0U; i < bufferBarrierCount; ++i) {
         CC_ASSERT(buffers[i] && static_cast<const BufferValidator *>(buffers[i])->isInited());
     }
+    // Bundles can't keep barriers.
+    CC_ASSERT(!_recordingBundle);
     /////////// execute ///////////
 
     static ccstd::vector<Texture *> textureActors;
@@ -64,6 +64,14 @@ void CCVKCommandBuffer::doInit(const CommandBufferInfo & /*info*/) {
 }
 
 void CCVKCommandBuffer::doDestroy() {
+    if (_bundleVkCommandPool != VK_NULL_HANDLE) {
+        CCVKDevice *device = CCVKDevice::getInstance();
+        device->waitAllFences();
+        vkDestroyCommandPool(device->gpuDevice()->vkDevice, _bundleVkCommandPool, nullptr);
+        _bundleVkCommandPool = VK_NULL_HANDLE;
+        _bundleVkCommandBuffers.clear();
+    }
+    _bundleRecordedMask = 0U;
     _gpuCommandBuffer = nullptr;
 }
 
@@ -71,26 +79,48 @@ void CCVKCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuf
     CC_ASSERT(!_gpuCommandBuffer->began);
     if (_gpuCommandBuffer->began) return;
 
-    CCVKDevice::getInstance()->gpuDevice()->getCommandBufferPool()->request(_gpuCommandBuffer);
+    VkCommandBufferUsageFlags flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (_recordingBundle) {
+        requestBundleCommandBuffer();
+        retainBundleResource(renderPass);
+        retainBundleResource(frameBuffer);
+        _bundleRenderPass = renderPass;
+        _bundleSubpass = subpass;
+        // replays have to set the same dynamic states as the first recording
+        _curDynamicStates = {};
+        flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    } else {
+        if (_isBundle) {
+            releaseBundle();
+        }
+        CCVKDevice::getInstance()->gpuDevice()->getCommandBufferPool()->request(_gpuCommandBuffer);
+    }
+
+    _numDrawCalls = 0;
+    _numInstances = 0;
+    _numTriangles = 0;
+    _numReplayedDrawCalls = 0;
+    _numRecordedDrawCalls = 0;
+
+    beginVkCommandBuffer(renderPass, subpass, frameBuffer, flags);
+}
 
+void CCVKCommandBuffer::beginVkCommandBuffer(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer, VkCommandBufferUsageFlags flags) {
     _curGPUPipelineState = nullptr;
     _curGPUInputAssembler = nullptr;
     _curGPUDescriptorSets.assign(_curGPUDescriptorSets.size(), nullptr);
     _curDynamicOffsetsArray.assign(_curDynamicOffsetsArray.size(), {});
     _firstDirtyDescriptorSet = UINT_MAX;
 
-    _numDrawCalls = 0;
-    _numInstances = 0;
-    _numTriangles = 0;
-
     VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.flags = flags;
     VkCommandBufferInheritanceInfo inheritanceInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
 
     if (renderPass) {
         inheritanceInfo.renderPass = static_cast<CCVKRenderPass *>(renderPass)->gpuRenderPass()->vkRenderPass;
         inheritanceInfo.subpass = subpass;
-        if (frameBuffer) {
+        // the framebuffer is optional, bundles leave it out since swapchain images rotate
+        if (frameBuffer && !_recordingBundle) {
             CCVKGPUFramebuffer *gpuFBO = static_cast<CCVKFramebuffer *>(frameBuffer)->gpuFBO();
             if (gpuFBO->isOffscreen) {
                 inheritanceInfo.framebuffer = gpuFBO->vkFramebuffer;
@@ -119,7 +149,118 @@ void CCVKCommandBuffer::end() {
     _gpuCommandBuffer->began = false;
 
     _pendingQueue.push(_gpuCommandBuffer->vkCommandBuffer);
-    CCVKDevice::getInstance()->gpuDevice()->getCommandBufferPool()->yield(_gpuCommandBuffer);
+    CCVKGPUDevice *gpuDevice = CCVKDevice::getInstance()->gpuDevice();
+    if (_recordingBundle && _gpuCommandBuffer->vkCommandBuffer == _bundleVkCommandBuffers[gpuDevice->curBackBufferIndex]) {
+        // the command buffer belongs to the bundle, not to the shared pool,
+        // the other back buffers replay the commands on their first execute
+        _gpuCommandBuffer->vkCommandBuffer = VK_NULL_HANDLE;
+        _bundleRecordedMask = 1U << gpuDevice->curBackBufferIndex;
+        _bundleUsedFrame = gpuDevice->frameIndex;
+    } else {
+        gpuDevice->getCommandBufferPool()->yield(_gpuCommandBuffer);
+    }
+    _isBundle = _recordingBundle;
+    _recordingBundle = false;
+}
+
+bool CCVKCommandBuffer::beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    CC_ASSERT(_type == CommandBufferType::SECONDARY); // Only secondary command buffers could be recorded as bundles.
+    if (_isBundle) {
+        releaseBundle();
+    }
+    _recordingBundle = true;
+    begin(renderPass, subpass, frameBuffer);
+    return true;
+}
+
+void CCVKCommandBuffer::releaseBundle() {
+    // The recordings may still be in flight, they are only recorded again when
+    // their back buffer comes around, after its fence has been waited for.
+    _bundleRecordedMask = 0U;
+    _bundleCommands.clear();
+    _bundleDynamicOffsets.clear();
+    _bundleRenderPass = nullptr;
+    _isBundle = false;
+    _bundleResources.clear();
+}
+
+bool CCVKCommandBuffer::updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (!_isBundle) return false;
+
+    bool changed = false;
+    for (auto &binding : _bundleDynamicOffsets) {
+        if (binding.first != set) continue;
+        const uint32_t count = std::min(dynamicOffsetCount, utils::toUint(binding.second.size()));
+        if (std::equal(dynamicOffsets, dynamicOffsets + count, binding.second.begin())) continue;
+        std::copy(dynamicOffsets, dynamicOffsets + count, binding.second.begin());
+        changed = true;
+    }
+    // the offsets are baked into the recordings, the next executes replay the commands with the new ones
+    if (changed) _bundleRecordedMask = 0U;
+    return true;
+}
+
+void CCVKCommandBuffer::requestBundleCommandBuffer() {
+    CCVKGPUDevice *gpuDevice = CCVKDevice::getInstance()->gpuDevice();
+    if (_bundleVkCommandPool == VK_NULL_HANDLE) {
+        VkCommandPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        createInfo.queueFamilyIndex = _gpuCommandBuffer->queueFamilyIndex;
+        createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        VK_CHECK(vkCreateCommandPool(gpuDevice->vkDevice, &createInfo, nullptr, &_bundleVkCommandPool));
+
+        _bundleVkCommandBuffers.resize(gpuDevice->backBufferCount);
+        VkCommandBufferAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocateInfo.commandPool = _bundleVkCommandPool;
+        allocateInfo.commandBufferCount = gpuDevice->backBufferCount;
+        allocateInfo.level = _gpuCommandBuffer->level;
+        VK_CHECK(vkAllocateCommandBuffers(gpuDevice->vkDevice, &allocateInfo, _bundleVkCommandBuffers.data()));
+    }
+    if (_bundleUsedFrame == gpuDevice->frameIndex) {
+        // the recording of this back buffer is referenced by the frame being recorded,
+        // record into a transient one, the bundle's own is replayed when the back buffer comes around
+        gpuDevice->getCommandBufferPool()->request(_gpuCommandBuffer);
+    } else {
+        // implicitly reset by vkBeginCommandBuffer
+        _gpuCommandBuffer->vkCommandBuffer = _bundleVkCommandBuffers[gpuDevice->curBackBufferIndex];
+    }
+}
+
+VkCommandBuffer CCVKCommandBuffer::getBundleVkCommandBuffer() {
+    CCVKGPUDevice *gpuDevice = CCVKDevice::getInstance()->gpuDevice();
+    if (_bundleRecordedMask & (1U << gpuDevice->curBackBufferIndex)) {
+        _bundleUsedFrame = gpuDevice->frameIndex;
+        return _bundleVkCommandBuffers[gpuDevice->curBackBufferIndex];
+    }
+
+    const bool inUse = _bundleUsedFrame == gpuDevice->frameIndex;
+    if (inUse) {
+        gpuDevice->getCommandBufferPool()->request(_gpuCommandBuffer);
+    } else {
+        _gpuCommandBuffer->vkCommandBuffer = _bundleVkCommandBuffers[gpuDevice->curBackBufferIndex];
+    }
+
+    _numDrawCalls = 0;
+    _numInstances = 0;
+    _numTriangles = 0;
+    _curDynamicStates = {};
+    beginVkCommandBuffer(_bundleRenderPass, _bundleSubpass, nullptr,
+                         inUse ? VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT : VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+    for (const auto &command : _bundleCommands) {
+        command();
+    }
+    _curGPUInputAssembler = nullptr;
+    VK_CHECK(vkEndCommandBuffer(_gpuCommandBuffer->vkCommandBuffer));
+    _gpuCommandBuffer->began = false;
+
+    VkCommandBuffer vkCommandBuffer = _gpuCommandBuffer->vkCommandBuffer;
+    if (inUse) {
+        gpuDevice->getCommandBufferPool()->yield(_gpuCommandBuffer);
+    } else {
+        _gpuCommandBuffer->vkCommandBuffer = VK_NULL_HANDLE;
+        _bundleRecordedMask |= 1U << gpuDevice->curBackBufferIndex;
+        _bundleUsedFrame = gpuDevice->frameIndex;
+    }
+    return vkCommandBuffer;
 }
 
 void CCVKCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors,
@@ -227,6 +368,10 @@ void CCVKCommandBuffer::endRenderPass() {
 }
 
 void CCVKCommandBuffer::bindPipelineState(PipelineState *pso) {
+    if (_recordingBundle) {
+        retainBundleResource(pso);
+        _bundleCommands.emplace_back([this, pso]() { bindPipelineState(pso); });
+    }
     CCVKGPUPipelineState *gpuPipelineState = static_cast<CCVKPipelineState *>(pso)->gpuPipelineState();
 
     if (_curGPUPipelineState != gpuPipelineState) {
@@ -237,6 +382,16 @@ void CCVKCommandBuffer::bindPipelineState(PipelineState *pso) {
 
 void CCVKCommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
     CC_ASSERT(_curGPUDescriptorSets.size() > set);
+    if (_recordingBundle) {
+        retainBundleResource(descriptorSet);
+        // replays read the offsets back, so updateBundleDynamicOffsets can patch them
+        const auto binding = utils::toUint(_bundleDynamicOffsets.size());
+        _bundleDynamicOffsets.emplace_back(set, ccstd::vector<uint32_t>(dynamicOffsets, dynamicOffsets + dynamicOffsetCount));
+        _bundleCommands.emplace_back([this, set, descriptorSet, binding]() {
+            const auto &offsets = _bundleDynamicOffsets[binding].second;
+            bindDescriptorSet(set, descriptorSet, utils::toUint(offsets.size()), offsets.data());
+        });
+    }
 
     CCVKGPUDescriptorSet *gpuDescriptorSet = static_cast<CCVKDescriptorSet *>(descriptorSet)->gpuDescriptorSet();
 
@@ -253,6 +408,10 @@ void CCVKCommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descripto
 }
 
 void CCVKCommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    if (_recordingBundle) {
+        retainBundleResource(ia);
+        _bundleCommands.emplace_back([this, ia]() { bindInputAssembler(ia); });
+    }
     CCVKGPUInputAssembler *gpuInputAssembler = static_cast<CCVKInputAssembler *>(ia)->gpuInputAssembler();
 
     if (_curGPUInputAssembler != gpuInputAssembler) {
@@ -282,6 +441,7 @@ void CCVKCommandBuffer::bindInputAssembler(InputAssembler *ia) {
 }
 
 void CCVKCommandBuffer::setViewport(const Viewport &vp) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, vp]() { setViewport(vp); });
     if (_curDynamicStates.viewport != vp) {
         _curDynamicStates.viewport = vp;
 
@@ -291,6 +451,7 @@ void CCVKCommandBuffer::setViewport(const Viewport &vp) {
 }
 
 void CCVKCommandBuffer::setScissor(const Rect &rect) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, rect]() { setScissor(rect); });
     if (_curDynamicStates.scissor != rect) {
         _curDynamicStates.scissor = rect;
 
@@ -300,6 +461,7 @@ void CCVKCommandBuffer::setScissor(const Rect &rect) {
 }
 
 void CCVKCommandBuffer::setLineWidth(float width) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, width]() { setLineWidth(width); });
     if (math::isNotEqualF(_curDynamicStates.lineWidth, width)) {
         _curDynamicStates.lineWidth = width;
         vkCmdSetLineWidth(_gpuCommandBuffer->vkCommandBuffer, width);
@@ -307,6 +469,7 @@ void CCVKCommandBuffer::setLineWidth(float width) {
 }
 
 void CCVKCommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, constant, clamp, slope]() { setDepthBias(constant, clamp, slope); });
     if (math::isNotEqualF(_curDynamicStates.depthBiasConstant, constant) ||
         math::isNotEqualF(_curDynamicStates.depthBiasClamp, clamp) ||
         math::isNotEqualF(_curDynamicStates.depthBiasSlope, slope)) {
@@ -318,6 +481,7 @@ void CCVKCommandBuffer::setDepthBias(float constant, float clamp, float slope) {
 }
 
 void CCVKCommandBuffer::setBlendConstants(const Color &constants) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, constants]() { setBlendConstants(constants); });
     if (math::isNotEqualF(_curDynamicStates.blendConstant.x, constants.x) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.y, constants.y) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.z, constants.z) ||
@@ -331,6 +495,7 @@ void CCVKCommandBuffer::setBlendConstants(const Color &constants) {
 }
 
 void CCVKCommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, minBounds, maxBounds]() { setDepthBound(minBounds, maxBounds); });
     if (math::isNotEqualF(_curDynamicStates.depthMinBounds, minBounds) ||
         math::isNotEqualF(_curDynamicStates.depthMaxBounds, maxBounds)) {
         _curDynamicStates.depthMinBounds = minBounds;
@@ -340,6 +505,7 @@ void CCVKCommandBuffer::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void CCVKCommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, face, mask]() { setStencilWriteMask(face, mask); });
     DynamicStencilStates &front = _curDynamicStates.stencilStatesFront;
     DynamicStencilStates &back = _curDynamicStates.stencilStatesBack;
     if (face == StencilFace::ALL) {
@@ -358,6 +524,7 @@ void CCVKCommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void CCVKCommandBuffer::setStencilCompareMask(StencilFace face, uint32_t reference, uint32_t mask) {
+    if (_recordingBundle) _bundleCommands.emplace_back([this, face, reference, mask]() { setStencilCompareMask(face, reference, mask); });
     DynamicStencilStates &front = _curDynamicStates.stencilStatesFront;
     DynamicStencilStates &back = _curDynamicStates.stencilStatesBack;
     if (face == StencilFace::ALL) {
@@ -388,6 +555,7 @@ void CCVKCommandBuffer::nextSubpass() {
 
 void CCVKCommandBuffer::draw(const DrawInfo &info) {
     CC_PROFILE(CCVKCmdBufDraw);
+    if (_recordingBundle) _bundleCommands.emplace_back([this, info]() { draw(info); });
     if (_firstDirtyDescriptorSet < _curGPUDescriptorSets.size()) {
         bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS);
     }
@@ -461,6 +629,57 @@ void CCVKCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void CCVKCommandBuffer::drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) {
+    CC_PROFILE(CCVKCmdBufDrawIndirect);
+    if (!drawCount) return;
+    if (_recordingBundle) {
+        retainBundleResource(indirectBuffer);
+        _bundleCommands.emplace_back([this, indirectBuffer, firstDraw, drawCount]() { drawIndirect(indirectBuffer, firstDraw, drawCount); });
+    }
+    if (_firstDirtyDescriptorSet < _curGPUDescriptorSets.size()) {
+        bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS);
+    }
+
+    auto *buffer = static_cast<CCVKBuffer *>(indirectBuffer);
+    const auto *gpuBuffer = buffer->gpuBuffer();
+    CCVKGPUDevice *gpuDevice = CCVKDevice::getInstance()->gpuDevice();
+    const bool indexed = gpuBuffer->isDrawIndirectByIndex;
+    const uint32_t stride = indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+    const VkDeviceSize offset = buffer->gpuBufferView()->getStartOffset(gpuDevice->curBackBufferIndex) + firstDraw * stride;
+
+    const uint32_t callCount = gpuDevice->useMultiDrawIndirect ? 1 : drawCount;
+    const uint32_t countPerCall = gpuDevice->useMultiDrawIndirect ? drawCount : 1;
+    for (uint32_t i = 0U; i < callCount; ++i) {
+        if (indexed) {
+            vkCmdDrawIndexedIndirect(_gpuCommandBuffer->vkCommandBuffer, gpuBuffer->vkBuffer, offset + i * stride, countPerCall, stride);
+        } else {
+            vkCmdDrawIndirect(_gpuCommandBuffer->vkCommandBuffer, gpuBuffer->vkBuffer, offset + i * stride, countPerCall, stride);
+        }
+    }
+
+    // stats are taken from the CPU copy of the commands, one draw call per command
+    const auto cmdCount = static_cast<uint32_t>(indexed ? gpuBuffer->indexedIndirectCmds.size() : gpuBuffer->indirectCmds.size());
+    const uint32_t end = std::min(firstDraw + drawCount, cmdCount);
+    for (uint32_t i = firstDraw; i < end; ++i) {
+        const uint32_t count = indexed ? gpuBuffer->indexedIndirectCmds[i].indexCount : gpuBuffer->indirectCmds[i].vertexCount;
+        const uint32_t instanceCount = indexed ? gpuBuffer->indexedIndirectCmds[i].instanceCount : gpuBuffer->indirectCmds[i].instanceCount;
+        ++_numDrawCalls;
+        _numInstances += instanceCount;
+        if (_curGPUPipelineState) {
+            switch (_curGPUPipelineState->primitive) {
+                case PrimitiveMode::TRIANGLE_LIST:
+                    _numTriangles += count / 3 * instanceCount;
+                    break;
+                case PrimitiveMode::TRIANGLE_STRIP:
+                case PrimitiveMode::TRIANGLE_FAN:
+                    _numTriangles += (count - 2) * instanceCount;
+                    break;
+                default: break;
+            }
+        }
+    }
+}
+
 void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
     _vkCommandBuffers.resize(count);
@@ -471,11 +690,17 @@ void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
         if (!cmdBuff->_pendingQueue.empty()) {
             _vkCommandBuffers[validCount++] = cmdBuff->_pendingQueue.front();
             cmdBuff->_pendingQueue.pop();
-
-            _numDrawCalls += cmdBuff->_numDrawCalls;
-            _numInstances += cmdBuff->_numInstances;
-            _numTriangles += cmdBuff->_numTriangles;
+            _numRecordedDrawCalls += cmdBuff->_numDrawCalls;
+        } else if (cmdBuff->_isBundle) {
+            _vkCommandBuffers[validCount++] = cmdBuff->getBundleVkCommandBuffer();
+            _numReplayedDrawCalls += cmdBuff->_numDrawCalls;
+        } else {
+            continue;
         }
+
+        _numDrawCalls += cmdBuff->_numDrawCalls;
+        _numInstances += cmdBuff->_numInstances;
+        _numTriangles += cmdBuff->_numTriangles;
     }
     if (validCount) {
         vkCmdExecuteCommands(_gpuCommandBuffer->vkCommandBuffer, validCount,
@@ -489,6 +714,12 @@ void CCVKCommandBuffer::updateBuffer(Buffer *buffer, const void *data, uint32_t
     cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), gpuBuffer, data, size, _gpuCommandBuffer);
 }
 
+void CCVKCommandBuffer::updateBufferRange(Buffer *buffer, const void *data, uint32_t offset, uint32_t size) {
+    CC_PROFILE(CCVKCmdBufUpdateBufferRange);
+    CCVKGPUBuffer *gpuBuffer = static_cast<CCVKBuffer *>(buffer)->gpuBuffer();
+    cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), gpuBuffer, data, size, _gpuCommandBuffer, offset);
+}
+
 void CCVKCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     cmdFuncCCVKCopyBuffersToTexture(CCVKDevice::getInstance(), buffers, static_cast<CCVKTexture *>(texture)->gpuTexture(), regions, count, _gpuCommandBuffer);
 }
@@ -614,6 +845,10 @@ void CCVKCommandBuffer::bindDescriptorSets(VkPipelineBindPoint bindPoint) {
 }
 
 void CCVKCommandBuffer::dispatch(const DispatchInfo &info) {
+    if (_recordingBundle) {
+        retainBundleResource(info.indirectBuffer);
+        _bundleCommands.emplace_back([this, info]() { dispatch(info); });
+    }
     if (_firstDirtyDescriptorSet < _curGPUDescriptorSets.size()) {
         bindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE);
     }
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include "base/std/container/queue.h"
 #include "gfx-base/GFXCommandBuffer.h"
 
@@ -55,7 +56,9 @@ public:
     void setStencilCompareMask(StencilFace face, uint32_t reference, uint32_t mask) override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
+    void drawIndirect(Buffer *indirectBuffer, uint32_t firstDraw, uint32_t drawCount) override;
     void updateBuffer(Buffer *buffer, const void *data, uint32_t size) override;
+    void updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
     void execute(CommandBuffer *const *cmdBuffs, uint32_t count) override;
@@ -64,6 +67,9 @@ public:
     void beginQuery(QueryPool *queryPool, uint32_t id) override;
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
+    bool beginBundle(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) override;
+    void releaseBundle() override;
+    bool updateBundleDynamicOffsets(uint32_t set, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override;
 
 protected:
     friend class CCVKQueue;
@@ -75,6 +81,9 @@ protected:
     void doDestroy() override;
 
     void bindDescriptorSets(VkPipelineBindPoint bindPoint);
+    void beginVkCommandBuffer(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer, VkCommandBufferUsageFlags flags);
+    void requestBundleCommandBuffer();
+    VkCommandBuffer getBundleVkCommandBuffer();
 
     IntrusivePtr<CCVKGPUCommandBuffer> _gpuCommandBuffer;
 
@@ -100,6 +109,21 @@ protected:
     ccstd::unordered_map<const GFXObject *, VkEvent> _barrierEvents;
 
     ccstd::queue<VkCommandBuffer> _pendingQueue;
+
+    // Bundles keep one recording per back buffer, since buffers and descriptor sets are instanced
+    // per back buffer. The commands are kept too: the first execute on a back buffer without a
+    // recording, or after the dynamic offsets changed, replays them into that back buffer's recording.
+    VkCommandPool _bundleVkCommandPool = VK_NULL_HANDLE;
+    ccstd::vector<VkCommandBuffer> _bundleVkCommandBuffers;
+    uint32_t _bundleRecordedMask = 0U;
+    // the frame in which the recording of the current back buffer was last recorded or executed,
+    // it can't be recorded again before the frame is submitted
+    uint64_t _bundleUsedFrame = UINT64_MAX;
+    ccstd::vector<std::function<void()>> _bundleCommands;
+    // set index and dynamic offsets of each descriptor set bound in the bundle
+    ccstd::vector<std::pair<uint32_t, ccstd::vector<uint32_t>>> _bundleDynamicOffsets;
+    RenderPass *_bundleRenderPass = nullptr;
+    uint32_t _bundleSubpass = 0U;
 };
 
 } // namespace gfx
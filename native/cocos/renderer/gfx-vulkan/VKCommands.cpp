@@ -1171,18 +1171,20 @@ void bufferUpload(const CCVKGPUBufferView &stagingBuffer, CCVKGPUBuffer &gpuBuff
 };
 } // namespace
 
-void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint32_t size, const CCVKGPUCommandBuffer *cmdBuffer) {
+void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const void *buffer, uint32_t size, const CCVKGPUCommandBuffer *cmdBuffer, uint32_t offset) {
     if (!gpuBuffer) return;
 
     const void *dataToUpload = nullptr;
     size_t sizeToUpload = 0U;
+    uint32_t offsetToUpload = offset;
 
     if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         size_t drawInfoCount = size / sizeof(DrawInfo);
+        size_t firstDrawInfo = offset / sizeof(DrawInfo);
         const auto *drawInfo = static_cast<const DrawInfo *>(buffer);
         if (drawInfoCount > 0) {
             if (drawInfo->indexCount) {
-                for (size_t i = 0; i < drawInfoCount; ++i) {
+                for (size_t i = firstDrawInfo; i < firstDrawInfo + drawInfoCount; ++i) {
                     gpuBuffer->indexedIndirectCmds[i].indexCount = drawInfo->indexCount;
                     gpuBuffer->indexedIndirectCmds[i].instanceCount = std::max(drawInfo->instanceCount, 1U);
                     gpuBuffer->indexedIndirectCmds[i].firstIndex = drawInfo->firstIndex;
@@ -1190,19 +1192,21 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
                     gpuBuffer->indexedIndirectCmds[i].firstInstance = drawInfo->firstInstance;
                     drawInfo++;
                 }
-                dataToUpload = gpuBuffer->indexedIndirectCmds.data();
+                dataToUpload = gpuBuffer->indexedIndirectCmds.data() + firstDrawInfo;
                 sizeToUpload = drawInfoCount * sizeof(VkDrawIndexedIndirectCommand);
+                offsetToUpload = firstDrawInfo * sizeof(VkDrawIndexedIndirectCommand);
                 gpuBuffer->isDrawIndirectByIndex = true;
             } else {
-                for (size_t i = 0; i < drawInfoCount; ++i) {
+                for (size_t i = firstDrawInfo; i < firstDrawInfo + drawInfoCount; ++i) {
                     gpuBuffer->indirectCmds[i].vertexCount = drawInfo->vertexCount;
                     gpuBuffer->indirectCmds[i].instanceCount = std::max(drawInfo->instanceCount, 1U);
                     gpuBuffer->indirectCmds[i].firstVertex = drawInfo->firstVertex;
                     gpuBuffer->indirectCmds[i].firstInstance = drawInfo->firstInstance;
                     drawInfo++;
                 }
-                dataToUpload = gpuBuffer->indirectCmds.data();
+                dataToUpload = gpuBuffer->indirectCmds.data() + firstDrawInfo;
                 sizeToUpload = drawInfoCount * sizeof(VkDrawIndirectCommand);
+                offsetToUpload = firstDrawInfo * sizeof(VkDrawIndirectCommand);
                 gpuBuffer->isDrawIndirectByIndex = false;
             }
         }
@@ -1214,9 +1218,10 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
     // back buffer instances update command
     uint32_t backBufferIndex = device->gpuDevice()->curBackBufferIndex;
     if (gpuBuffer->instanceSize) {
-        device->gpuBufferHub()->record(gpuBuffer, backBufferIndex, sizeToUpload, !cmdBuffer);
+        // the other back buffers copy the whole prefix, which is up to date in this one
+        device->gpuBufferHub()->record(gpuBuffer, backBufferIndex, offsetToUpload + sizeToUpload, !cmdBuffer);
         if (!cmdBuffer) {
-            uint8_t *dst = gpuBuffer->mappedData + backBufferIndex * gpuBuffer->instanceSize;
+            uint8_t *dst = gpuBuffer->mappedData + backBufferIndex * gpuBuffer->instanceSize + offsetToUpload;
             memcpy(dst, dataToUpload, sizeToUpload);
             return;
         }
@@ -1235,7 +1240,7 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
 
         VkBufferCopy region{
             stagingBuffer->offset,
-            gpuBuffer->getStartOffset(backBufferIndex) + chunkOffset,
+            gpuBuffer->getStartOffset(backBufferIndex) + offsetToUpload + chunkOffset,
             chunkSizeToUpload,
         };
 
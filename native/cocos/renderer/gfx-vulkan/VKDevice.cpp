@@ -49,6 +49,7 @@
 
 #include "application/ApplicationManager.h"
 #include "gfx-base/SPIRVUtils.h"
+#include "platform/FileUtils.h"
 #include "platform/interfaces/modules/IXRInterface.h"
 #include "profiler/Profiler.h"
 
@@ -140,6 +141,7 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     requestedFeatures2.features.samplerAnisotropy = deviceFeatures.samplerAnisotropy;
     requestedFeatures2.features.depthBounds = deviceFeatures.depthBounds;
     requestedFeatures2.features.multiDrawIndirect = deviceFeatures.multiDrawIndirect;
+    requestedFeatures2.features.drawIndirectFirstInstance = deviceFeatures.drawIndirectFirstInstance;
     //requestedFeatures2.features.se
     requestedVulkan12Features.separateDepthStencilLayouts = _gpuContext->physicalDeviceVulkan12Features.separateDepthStencilLayouts;
 
@@ -232,6 +234,9 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     volkLoadDevice(_gpuDevice->vkDevice);
 
     SPIRVUtils::getInstance()->initialize(static_cast<int>(_gpuDevice->minorVersion));
+    // keep the compiled SPIR-V across runs, a cache prewarmed at build time is picked up from the package when present
+    SPIRVUtils::getInstance()->setCacheDirectory(FileUtils::getInstance()->getWritablePath() + "spirv-cache/");
+    SPIRVUtils::getInstance()->setPrewarmedCacheDirectory("spirv-cache/");
 
     ///////////////////// Gather Device Properties /////////////////////
 
@@ -270,6 +275,8 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     _features[toNumber(Feature::BLEND_MINMAX)] = true;
     _features[toNumber(Feature::COMPUTE_SHADER)] = true;
     _features[toNumber(Feature::INPUT_ATTACHMENT_BENEFIT)] = true;
+    _features[toNumber(Feature::DRAW_INDIRECT_FIRST_INSTANCE)] = deviceFeatures.drawIndirectFirstInstance;
+    _features[toNumber(Feature::COMMAND_BUNDLE)] = true;
 
     initFormatFeature();
 
@@ -703,6 +710,7 @@ void CCVKDevice::present() {
     }
 
     _gpuDevice->curBackBufferIndex = (_gpuDevice->curBackBufferIndex + 1) % _gpuDevice->backBufferCount;
+    ++_gpuDevice->frameIndex;
 
     uint32_t fenceCount = gpuFencePool()->size();
     if (fenceCount) {
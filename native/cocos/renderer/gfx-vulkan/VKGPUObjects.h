@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include "VKStd.h"
 #include "VKUtils.h"
 #include "base/Log.h"
@@ -435,6 +436,7 @@ public:
 
     uint32_t curBackBufferIndex{0U};
     uint32_t backBufferCount{3U};
+    uint64_t frameIndex{0U};
 
     bool useDescriptorUpdateTemplate{false};
     bool useMultiDrawIndirect{false};
@@ -1309,7 +1311,9 @@ public:
             if (i == backBufferIndex) {
                 _buffersToBeUpdated[i].erase(gpuBuffer);
             } else {
-                _buffersToBeUpdated[i][gpuBuffer] = {backBufferIndex, size, canMemcpy};
+                // keep the larger pending size, a ranged update must not truncate an earlier full one
+                auto &update = _buffersToBeUpdated[i][gpuBuffer];
+                update = {backBufferIndex, std::max(update.size, size), canMemcpy};
             }
         }
     }
@@ -572,7 +572,7 @@ void CCWGPUCommandBuffer::draw(const DrawInfo &info) {
 }
 
 namespace {
-void updatBuffer(CCWGPUCommandBuffer *cmdBuffer, CCWGPUBuffer *buffer, const void *data, uint32_t buffSize) {
+void updatBuffer(CCWGPUCommandBuffer *cmdBuffer, CCWGPUBuffer *buffer, const void *data, uint32_t buffSize, uint32_t dstOffset = 0) {
     WGPUBufferDescriptor descriptor = {
         .nextInChain = nullptr,
         .label = nullptr,
@@ -588,7 +588,7 @@ void updatBuffer(CCWGPUCommandBuffer *cmdBuffer, CCWGPUBuffer *buffer, const voi
 
     auto *bufferObj = buffer->gpuBufferObject();
     auto *commandBufferObj = cmdBuffer->gpuCommandBufferObject();
-    size_t offset = buffer->isBufferView() ? buffer->getOffset() : 0;
+    size_t offset = (buffer->isBufferView() ? buffer->getOffset() : 0) + dstOffset;
 
     if (commandBufferObj->wgpuCommandEncoder) {
         wgpuCommandEncoderCopyBufferToBuffer(commandBufferObj->wgpuCommandEncoder, stagingBuffer, 0, bufferObj->wgpuBuffer, offset, buffSize);
@@ -644,6 +644,12 @@ void CCWGPUCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t
     auto *ccBuffer = static_cast<CCWGPUBuffer *>(buff);
     updatBuffer(this, ccBuffer, data, buffSize);
 }
+
+void CCWGPUCommandBuffer::updateBufferRange(Buffer *buff, const void *data, uint32_t offset, uint32_t size) {
+    uint32_t alignedSize = ceil(size / 4.0) * 4;
+    auto *ccBuffer = static_cast<CCWGPUBuffer *>(buff);
+    updatBuffer(this, ccBuffer, data, alignedSize, offset);
+}
 // WGPU_EXPORT void wgpuCommandEncoderCopyBufferToTexture(WGPUCommandEncoder commandEncoder, WGPUImageCopyBuffer const * source, WGPUImageCopyTexture const * destination, WGPUExtent3D const * copySize);
 void CCWGPUCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
     auto encoder = _gpuCommandBufferObj->wgpuCommandEncoder;
@@ -75,6 +75,9 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint32_t passIdx, con
     const auto vbCount = flatBuffer.count;
     const auto *const pass = subModel->getPass(passIdx);
     auto *const shader = subModel->getShader(passIdx);
+    if (!shader) {
+        return; // the shader variant is still compiling
+    }
     auto *const descriptorSet = subModel->getDescriptorSet();
     bool isBatchExist = false;
 
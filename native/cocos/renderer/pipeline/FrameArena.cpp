@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace cc {
+namespace pipeline {
+
+FrameArena::FrameArena(size_t blockSize)
+: _blockSize(std::max(blockSize, BLOCK_ALIGNMENT)) {
+    _current = addBlock(_blockSize);
+}
+
+FrameArena::~FrameArena() {
+    clearBlocks();
+}
+
+ThreadSafeLinearAllocator *FrameArena::addBlock(size_t size) {
+    auto *block = ccnew ThreadSafeLinearAllocator(size, BLOCK_ALIGNMENT);
+    _blocks.emplace_back(block);
+    return block;
+}
+
+void FrameArena::clearBlocks() {
+    for (auto *block : _blocks) {
+        delete block;
+    }
+    _blocks.clear();
+    _current = nullptr;
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    bytes = std::max<std::size_t>(bytes, 1);
+
+    // lock-free path, the current block still has room
+    void *ptr = _current.load(std::memory_order_acquire)->allocate<uint8_t>(bytes, alignment);
+    if (ptr) {
+        return ptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // another thread may have added a block meanwhile
+    ptr = _current.load(std::memory_order_relaxed)->allocate<uint8_t>(bytes, alignment);
+    if (ptr) {
+        return ptr;
+    }
+    auto *block = addBlock(std::max(_blockSize, bytes + alignment));
+    ptr = block->allocate<uint8_t>(bytes, alignment);
+    _current.store(block, std::memory_order_release);
+    return ptr;
+}
+
+void FrameArena::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const size_t usedSize = usedSizeLocked();
+    _lastFrameUsage = usedSize;
+    _peakUsage = std::max(_peakUsage, usedSize);
+
+    if (_blocks.size() > 1) {
+        // Merge into one block large enough for the biggest frame so far.
+        _blockSize = std::max(_blockSize, capacityLocked());
+        clearBlocks();
+        addBlock(_blockSize);
+    }
+    _blocks.front()->recycle();
+    _current.store(_blocks.front(), std::memory_order_release);
+    ++_generation;
+}
+
+size_t FrameArena::getUsedSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return usedSizeLocked();
+}
+
+size_t FrameArena::getCapacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return capacityLocked();
+}
+
+size_t FrameArena::usedSizeLocked() const {
+    size_t usedSize = 0;
+    for (const auto *block : _blocks) {
+        usedSize += block->getUsedSize();
+    }
+    return usedSize;
+}
+
+size_t FrameArena::capacityLocked() const {
+    size_t capacity = 0;
+    for (const auto *block : _blocks) {
+        capacity += block->getCapacity();
+    }
+    return capacity;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "base/threading/ThreadSafeLinearAllocator.h"
+#include "boost/container/pmr/memory_resource.hpp"
+
+namespace cc {
+namespace pipeline {
+
+/**
+ * Linear memory resource for scratch data that lives at most one frame, e.g. render queues and light lists.
+ * Deallocation is a no-op, all memory is recycled at once by reset(). Blocks are kept across frames and
+ * merged into one block when a frame needed more than one, so a steady frame does not touch the heap.
+ *
+ * Containers using it must hold trivially destructible elements and must be rebound to the arena
+ * (or destroyed) before being used again after a reset.
+ */
+class CC_DLL FrameArena final : public boost::container::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE{256 * 1024};
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    FrameArena(const FrameArena &) = delete;
+    FrameArena(FrameArena &&) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+    FrameArena &operator=(FrameArena &&) = delete;
+    ~FrameArena() override;
+
+    void reset();
+    /**
+     * Incremented by every reset(), containers compare it to know whether their storage is still valid.
+     */
+    inline uint32_t getGeneration() const { return _generation; }
+
+    size_t getUsedSize() const;
+    size_t getCapacity() const;
+    inline size_t getLastFrameUsage() const { return _lastFrameUsage; }
+    inline size_t getPeakUsage() const { return _peakUsage; }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void * /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+    bool do_is_equal(const boost::container::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    ThreadSafeLinearAllocator *addBlock(size_t size);
+    void clearBlocks();
+    size_t usedSizeLocked() const;
+    size_t capacityLocked() const;
+
+    static constexpr size_t BLOCK_ALIGNMENT{16};
+
+    mutable std::mutex _mutex;
+    ccstd::vector<ThreadSafeLinearAllocator *> _blocks;
+    std::atomic<ThreadSafeLinearAllocator *> _current{nullptr};
+    size_t _blockSize{DEFAULT_BLOCK_SIZE};
+    size_t _lastFrameUsage{0};
+    size_t _peakUsage{0};
+    uint32_t _generation{0};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -24,16 +24,24 @@
 ****************************************************************************/
 
 #include "InstancedBuffer.h"
+#include <algorithm>
 #include "Define.h"
+#include "StaticMeshPool.h"
+#include "core/scene-graph/Node.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXInputAssembler.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 namespace pipeline {
 
+bool InstancedBuffer::persistentModeEnabled{false};
+bool InstancedBuffer::indirectModeEnabled{false};
+uint32_t InstancedBuffer::frameIndex{0};
+
 InstancedBuffer::InstancedBuffer(const scene::Pass *pass)
 : _pass(pass),
   _device(gfx::Device::getInstance()) {
@@ -42,12 +50,47 @@ InstancedBuffer::InstancedBuffer(const scene::Pass *pass)
 InstancedBuffer::~InstancedBuffer() = default;
 
 void InstancedBuffer::destroy() {
-    for (auto &instance : _instances) {
+    destroyItems(_instances);
+    _slots.clear();
+    destroyViews();
+}
+
+void InstancedBuffer::destroyItems(InstancedItemList &instances) {
+    for (auto &instance : instances) {
         CC_SAFE_DESTROY_AND_DELETE(instance.vb);
         CC_SAFE_DESTROY_AND_DELETE(instance.ia);
+        CC_SAFE_DESTROY_AND_DELETE(instance.indirectBuffer);
         CC_FREE(instance.data);
     }
-    _instances.clear();
+    instances.clear();
+}
+
+void InstancedBuffer::destroyViews() {
+    for (auto &view : _views) {
+        destroyItems(view.instances);
+    }
+    _views.clear();
+    _viewIndex = 0;
+}
+
+void InstancedBuffer::setPersistentModeEnabled(bool enabled) {
+    persistentModeEnabled = enabled;
+}
+
+bool InstancedBuffer::isPersistentModeEnabled() {
+    return persistentModeEnabled;
+}
+
+void InstancedBuffer::setIndirectModeEnabled(bool enabled) {
+    indirectModeEnabled = enabled;
+}
+
+bool InstancedBuffer::isIndirectModeEnabled() {
+    return indirectModeEnabled;
+}
+
+void InstancedBuffer::beginFrame() {
+    ++frameIndex;
 }
 
 void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx) {
@@ -70,28 +113,24 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     if (!shader) {
         shader = subModel->getShader(passIdx);
     }
+    if (!shader) {
+        return; // the shader variant is still compiling
+    }
 
-    for (auto &instance : _instances) {
-        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.count >= MAX_CAPACITY) {
-            continue;
-        }
+    if (_indirect && mergeIndirect(subModel, shader, descriptorSet, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType)) {
+        return;
+    }
 
-        // check same binding
-        if (instance.lightingMap != lightingMap) {
-            continue;
-        }
+    if (_persistent) {
+        mergePersistent(subModel, shader, descriptorSet, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType);
+        return;
+    }
 
-        if (instance.reflectionProbeType != reflectionProbeType) {
-            continue;
-        }
-        if (instance.reflectionProbeCubemap != reflectionProbeCubemap) {
-            continue;
-        }
-        if (instance.reflectionProbePlanarMap != reflectionProbePlanarMap) {
+    for (auto &instance : _instances) {
+        if (instance.count >= MAX_CAPACITY) {
             continue;
         }
-
-        if (instance.stride != stride) {
+        if (!isCompatible(instance, sourceIA->getIndexBuffer(), stride, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType)) {
             continue;
         }
         if (instance.count >= instance.capacity) { // resize buffers
@@ -111,7 +150,210 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         return;
     }
 
-    // Create a new instance
+    createInstance(subModel, shader, descriptorSet, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType);
+    _hasPendingModels = true;
+}
+
+void InstancedBuffer::mergePersistent(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                                      gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                                      gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType) {
+    const auto *src = subModel->getInstancedAttributeBlock().buffer.buffer()->getData();
+    const auto stride = subModel->getInstancedAttributeBlock().buffer.length();
+    auto *sourceIA = subModel->getInputAssembler();
+
+    InstancedItem *target = nullptr;
+    InstancedSlots *targetSlots = nullptr;
+    for (size_t i = 0; i < _instances.size(); ++i) {
+        auto &instance = _instances[i];
+        if (!isCompatible(instance, sourceIA->getIndexBuffer(), stride, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType)) {
+            continue;
+        }
+        auto &slots = _slots[i];
+        auto iter = slots.indices.find(subModel);
+        if (iter != slots.indices.end()) {
+            // the sub-model already owns a slot, only rewrite it when the attributes changed
+            const auto slot = iter->second;
+            auto *dst = instance.data + instance.stride * slot;
+            if (memcmp(dst, src, stride) != 0) {
+                memcpy(dst, src, stride);
+                slots.dirtySlots.emplace_back(slot);
+            }
+            if (slots.generations[slot] != _generation) {
+                slots.generations[slot] = _generation;
+                ++slots.mergedCount;
+            }
+            instance.shader = shader;
+            instance.descriptorSet = descriptorSet;
+            _hasPendingModels = true;
+            return;
+        }
+        if (!target && instance.count < MAX_CAPACITY) {
+            target = &instance;
+            targetSlots = &slots;
+        }
+    }
+
+    if (!target) {
+        createInstance(subModel, shader, descriptorSet, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType);
+        auto &slots = _slots.back();
+        slots.indices.emplace(subModel, 0);
+        slots.owners.emplace_back(subModel);
+        slots.generations.emplace_back(_generation);
+        slots.mergedCount = 1;
+        slots.dirtyAll = true;
+        _hasPendingModels = true;
+        return;
+    }
+
+    if (target->count >= target->capacity) { // resize buffers
+        target->capacity <<= 1;
+        const auto newSize = target->stride * target->capacity;
+        target->data = static_cast<uint8_t *>(CC_REALLOC(target->data, newSize));
+        target->vb->resize(newSize);
+        // the resized buffer has lost its content
+        targetSlots->dirtyAll = true;
+    }
+    target->shader = shader;
+    target->descriptorSet = descriptorSet;
+
+    const auto slot = target->count++;
+    memcpy(target->data + target->stride * slot, src, stride);
+    targetSlots->indices.emplace(subModel, slot);
+    targetSlots->owners.emplace_back(subModel);
+    targetSlots->generations.emplace_back(_generation);
+    targetSlots->dirtySlots.emplace_back(slot);
+    ++targetSlots->mergedCount;
+    _hasPendingModels = true;
+}
+
+bool InstancedBuffer::mergeIndirect(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                                    gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                                    gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType) {
+    const auto *owner = subModel->getOwner();
+    if (!owner || !owner->getNode() || !owner->getNode()->isStatic()) {
+        return false;
+    }
+    const auto *range = StaticMeshPool::getInstance()->acquire(owner, subModel->getSubMesh());
+    if (!range) {
+        return false;
+    }
+
+    const auto &attrs = subModel->getInstancedAttributeBlock();
+    const auto stride = attrs.buffer.length();
+    auto *indexBuffer = range->arena->indexBuffer.get();
+
+    InstancedItem *target = nullptr;
+    for (auto &instance : _instances) {
+        if (instance.indirectBuffer && instance.count < MAX_CAPACITY &&
+            isCompatible(instance, indexBuffer, stride, lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType)) {
+            target = &instance;
+            break;
+        }
+    }
+
+    if (!target) {
+        const auto newSize = stride * INITIAL_CAPACITY;
+        auto *vb = _device->createBuffer({
+            gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            static_cast<uint32_t>(newSize),
+            static_cast<uint32_t>(stride),
+        });
+        auto *indirectBuffer = _device->createBuffer({
+            gfx::BufferUsageBit::INDIRECT | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            static_cast<uint32_t>(sizeof(gfx::DrawInfo) * INITIAL_CAPACITY),
+            static_cast<uint32_t>(sizeof(gfx::DrawInfo)),
+        });
+
+        auto attributes = range->arena->attributes;
+        for (const auto &attribute : attrs.attributes) {
+            attributes.emplace_back(gfx::Attribute{
+                attribute.name,
+                attribute.format,
+                attribute.isNormalized,
+                1, // stream
+                true,
+                attribute.location});
+        }
+        const gfx::InputAssemblerInfo iaInfo = {attributes, {range->arena->vertexBuffer.get(), vb}, indexBuffer};
+        auto *ia = _device->createInputAssembler(iaInfo);
+        auto *data = static_cast<uint8_t *>(CC_MALLOC(newSize));
+        InstancedItem item = {0, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
+                              lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType};
+        item.indirectBuffer = indirectBuffer;
+        _instances.emplace_back(item);
+        if (_persistent) {
+            // keeps the slots parallel to `_instances`, indirect items are rebuilt every frame
+            _slots.emplace_back();
+        }
+        target = &_instances.back();
+    }
+
+    if (target->count >= target->capacity) { // resize buffers
+        target->capacity <<= 1;
+        const auto newSize = target->stride * target->capacity;
+        target->data = static_cast<uint8_t *>(CC_REALLOC(target->data, newSize));
+        target->vb->resize(newSize);
+        target->indirectBuffer->resize(static_cast<uint32_t>(sizeof(gfx::DrawInfo) * target->capacity));
+    }
+    target->shader = shader;
+    target->descriptorSet = descriptorSet;
+
+    const auto slot = target->count++;
+    memcpy(target->data + target->stride * slot, attrs.buffer.buffer()->getData(), stride);
+
+    // consecutive instances of the same mesh range share one draw
+    auto &draws = target->draws;
+    if (!draws.empty()) {
+        auto &last = draws.back();
+        if (last.firstIndex == range->firstIndex && last.indexCount == range->indexCount &&
+            last.vertexOffset == range->vertexOffset && last.firstInstance + last.instanceCount == slot) {
+            ++last.instanceCount;
+            _hasPendingModels = true;
+            return true;
+        }
+    }
+    gfx::DrawInfo draw;
+    draw.indexCount = range->indexCount;
+    draw.firstIndex = range->firstIndex;
+    draw.vertexOffset = range->vertexOffset;
+    draw.instanceCount = 1;
+    draw.firstInstance = slot;
+    draws.emplace_back(draw);
+    _hasPendingModels = true;
+    return true;
+}
+
+bool InstancedBuffer::isCompatible(const InstancedItem &instance, const gfx::Buffer *indexBuffer, uint32_t stride,
+                                   const gfx::Texture *lightingMap, const gfx::Texture *reflectionProbeCubemap,
+                                   const gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType) const {
+    if (instance.ia->getIndexBuffer() != indexBuffer) {
+        return false;
+    }
+    // check same binding
+    if (instance.lightingMap != lightingMap) {
+        return false;
+    }
+    if (instance.reflectionProbeType != reflectionProbeType) {
+        return false;
+    }
+    if (instance.reflectionProbeCubemap != reflectionProbeCubemap) {
+        return false;
+    }
+    if (instance.reflectionProbePlanarMap != reflectionProbePlanarMap) {
+        return false;
+    }
+    return instance.stride == stride;
+}
+
+InstancedItem &InstancedBuffer::createInstance(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                                               gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                                               gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType) {
+    auto &attrs = subModel->getInstancedAttributeBlock();
+    const auto stride = attrs.buffer.length();
+    auto *sourceIA = subModel->getInputAssembler();
+
     const auto newSize = stride * INITIAL_CAPACITY;
     auto *vb = _device->createBuffer({
         gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
@@ -142,21 +384,166 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     InstancedItem item = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
                           lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType};
     _instances.emplace_back(item);
-    _hasPendingModels = true;
+    if (_persistent) {
+        _slots.emplace_back();
+    }
+    return _instances.back();
 }
 
-void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) const {
-    for (const auto &instance : _instances) {
-        if (!instance.count) continue;
+void InstancedBuffer::compact(InstancedItem &instance, InstancedSlots &slots) {
+    if (slots.mergedCount == instance.count) {
+        return; // every slot was merged again, the common case of a static view
+    }
+    // Swap-remove the slots which were not merged in the current generation,
+    // only the slots that get moved need to be uploaded again.
+    uint32_t slot = 0;
+    while (slot < instance.count) {
+        if (slots.generations[slot] == _generation) {
+            ++slot;
+            continue;
+        }
+        slots.indices.erase(slots.owners[slot]);
+        const auto last = --instance.count;
+        if (slot != last) {
+            memcpy(instance.data + instance.stride * slot, instance.data + instance.stride * last, instance.stride);
+            slots.owners[slot] = slots.owners[last];
+            slots.generations[slot] = slots.generations[last];
+            slots.indices[slots.owners[slot]] = slot;
+            slots.dirtySlots.emplace_back(slot);
+        }
+        slots.owners.pop_back();
+        slots.generations.pop_back();
+    }
+}
 
-        cmdBuff->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
+void InstancedBuffer::uploadDirtySlots(gfx::CommandBuffer *cmdBuff, InstancedItem &instance, InstancedSlots &slots) {
+    if (slots.dirtyAll) {
+        if (!instance.count) {
+            return; // stays dirty until slots get merged into the buffer again
+        }
+        const auto size = instance.stride * instance.count;
+        cmdBuff->updateBuffer(instance.vb, instance.data, size);
+        CC_PROFILE_RENDER_INC(InstancedBufferUploadBytes, size);
+    } else if (!slots.dirtySlots.empty()) {
+        auto &dirtySlots = slots.dirtySlots;
+        std::sort(dirtySlots.begin(), dirtySlots.end());
+        const auto upload = [&](uint32_t first, uint32_t last) {
+            const auto offset = instance.stride * first;
+            const auto size = instance.stride * (last - first);
+            cmdBuff->updateBufferRange(instance.vb, instance.data + offset, offset, size);
+            CC_PROFILE_RENDER_INC(InstancedBufferUploadBytes, size);
+        };
+        // slots past the end were removed by compact()
+        uint32_t first = dirtySlots[0];
+        uint32_t last = first + 1;
+        for (const auto slot : dirtySlots) {
+            if (slot >= instance.count) {
+                break;
+            }
+            if (slot <= last + DIRTY_RANGE_MERGE_GAP) {
+                last = std::max(last, slot + 1);
+                continue;
+            }
+            upload(first, last);
+            first = slot;
+            last = slot + 1;
+        }
+        if (first < instance.count) {
+            upload(first, last);
+        }
+    }
+    slots.dirtySlots.clear();
+    slots.dirtyAll = false;
+}
+
+void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) {
+    if (_indirect) {
+        // only appends, the compaction is done by the flush before the frame is rendered
+        StaticMeshPool::getInstance()->upload();
+    }
+    for (size_t i = 0; i < _instances.size(); ++i) {
+        auto &instance = _instances[i];
+        if (instance.indirectBuffer) {
+            if (!instance.count) continue;
+
+            const auto size = instance.stride * instance.count;
+            cmdBuff->updateBuffer(instance.vb, instance.data, size);
+            const auto drawSize = static_cast<uint32_t>(sizeof(gfx::DrawInfo) * instance.draws.size());
+            cmdBuff->updateBuffer(instance.indirectBuffer, instance.draws.data(), drawSize);
+            CC_PROFILE_RENDER_INC(InstancedBufferUploadBytes, size + drawSize);
+        } else if (_persistent) {
+            auto &slots = _slots[i];
+            compact(instance, slots);
+            uploadDirtySlots(cmdBuff, instance, slots);
+            if (!instance.count) continue;
+        } else {
+            if (!instance.count) continue;
+
+            const auto size = instance.stride * instance.count;
+            cmdBuff->updateBuffer(instance.vb, instance.data, size);
+            CC_PROFILE_RENDER_INC(InstancedBufferUploadBytes, size);
+        }
         instance.ia->setInstanceCount(instance.count);
     }
 }
 
+void InstancedBuffer::switchView(uint32_t viewIndex) {
+    if (_views.size() <= std::max(viewIndex, _viewIndex)) {
+        _views.resize(std::max(viewIndex, _viewIndex) + 1);
+    }
+    auto &parked = _views[_viewIndex];
+    std::swap(_instances, parked.instances);
+    std::swap(_slots, parked.slots);
+    std::swap(_generation, parked.generation);
+
+    auto &active = _views[viewIndex];
+    std::swap(_instances, active.instances);
+    std::swap(_slots, active.slots);
+    std::swap(_generation, active.generation);
+    _viewIndex = viewIndex;
+}
+
 void InstancedBuffer::clear() {
+    _indirect = indirectModeEnabled && _device->hasFeature(gfx::Feature::DRAW_INDIRECT_FIRST_INSTANCE) &&
+                _pass->getBlendState()->targets[0].blend == 0;
+    // the mode is only switched here so that it stays the same during a whole frame
+    if (persistentModeEnabled) {
+        if (!_persistent) {
+            for (auto &instance : _instances) {
+                instance.count = 0;
+            }
+            _slots.clear();
+            _slots.resize(_instances.size());
+            _persistent = true;
+        }
+        const auto viewIndex = _viewFrame == frameIndex ? std::min(_viewIndex + 1, MAX_VIEWS - 1) : 0U;
+        _viewFrame = frameIndex;
+        if (viewIndex != _viewIndex) {
+            switchView(viewIndex);
+        }
+        // keep the slots, the ones which are not merged again get removed in uploadBuffers
+        ++_generation;
+        for (auto &slots : _slots) {
+            slots.mergedCount = 0;
+        }
+    } else {
+        if (_persistent) {
+            // keep the active view only
+            switchView(0);
+            destroyViews();
+            _persistent = false;
+        }
+        for (auto &instance : _instances) {
+            instance.count = 0;
+        }
+        _slots.clear();
+    }
+    // indirect items are rebuilt every frame in both modes
     for (auto &instance : _instances) {
-        instance.count = 0;
+        if (instance.indirectBuffer) {
+            instance.count = 0;
+            instance.draws.clear();
+        }
     }
     _hasPendingModels = false;
 }
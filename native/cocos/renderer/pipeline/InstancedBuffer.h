@@ -25,9 +25,11 @@
 
 #pragma once
 
+#include <limits>
 #include "Define.h"
 #include "base/RefCounted.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "scene/Model.h"
 #include "scene/Pass.h"
 
@@ -51,6 +53,10 @@ struct CC_DLL InstancedItem {
     gfx::Texture *reflectionProbeCubemap = nullptr;
     gfx::Texture *reflectionProbePlanarMap = nullptr;
     uint32_t reflectionProbeType = 0;
+    // Indirect mode only: the item draws merged static meshes, one draw per mesh range,
+    // each draw picks its instance attributes with firstInstance.
+    gfx::Buffer *indirectBuffer = nullptr;
+    ccstd::vector<gfx::DrawInfo> draws;
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint32_t>;
@@ -66,7 +72,7 @@ public:
     void destroy();
     void merge(scene::SubModel *, uint32_t);
     void merge(scene::SubModel *, uint32_t, gfx::Shader *);
-    void uploadBuffers(gfx::CommandBuffer *cmdBuff) const;
+    void uploadBuffers(gfx::CommandBuffer *cmdBuff);
     void clear();
     void setDynamicOffset(uint32_t idx, uint32_t value);
 
@@ -75,8 +81,83 @@ public:
     inline bool hasPendingModels() const { return _hasPendingModels; }
     inline const DynamicOffsetList &dynamicOffsets() const { return _dynamicOffsets; }
 
+    // Persistent mode keeps every sub-model in the same instance slot across frames,
+    // only rewrites slots whose attributes changed and only uploads the dirty range.
+    // The mode is picked up by each buffer on its next clear().
+    static void setPersistentModeEnabled(bool enabled);
+    static bool isPersistentModeEnabled();
+
+    // Called once at the start of every frame by the pipeline. In persistent mode the n-th clear()
+    // of a buffer in a frame resumes the slots of its n-th clear() in the previous frame,
+    // so every camera or light drawing the pass keeps its own slots.
+    static void beginFrame();
+
+    // Indirect mode merges the geometry of static opaque sub-models into the StaticMeshPool
+    // and draws all the sub-models of an item with a single indirect draw call.
+    // It needs gfx::Feature::DRAW_INDIRECT_FIRST_INSTANCE and is picked up by each buffer on its next clear().
+    static void setIndirectModeEnabled(bool enabled);
+    static bool isIndirectModeEnabled();
+
 private:
+    // Upper bound of the views kept per buffer, later clear() calls in the same frame share the last one.
+    static constexpr uint32_t MAX_VIEWS = 16;
+    // Dirty slots at most this far apart are uploaded with one command, clean slots in between included.
+    static constexpr uint32_t DIRTY_RANGE_MERGE_GAP = 4;
+
+    // Per-item slot bookkeeping of the persistent mode, parallel to `_instances`.
+    struct InstancedSlots {
+        // `const scene::SubModel *`: weak reference
+        ccstd::unordered_map<const scene::SubModel *, uint32_t> indices;
+        ccstd::vector<const scene::SubModel *> owners;
+        // generation in which each slot was last merged
+        ccstd::vector<uint32_t> generations;
+        // slots rewritten since the last upload, unsorted and may contain duplicates
+        ccstd::vector<uint32_t> dirtySlots;
+        // number of slots merged in the current generation
+        uint32_t mergedCount{0};
+        // the vertex buffer was created or resized, all the slots need to be uploaded
+        bool dirtyAll{false};
+    };
+
+    // The items and slots of one clear() in a frame, see beginFrame().
+    struct InstancedView {
+        InstancedItemList instances;
+        ccstd::vector<InstancedSlots> slots;
+        uint32_t generation{0};
+    };
+
+    void mergePersistent(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                         gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                         gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType);
+    bool mergeIndirect(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                       gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                       gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType);
+    void compact(InstancedItem &instance, InstancedSlots &slots);
+    void uploadDirtySlots(gfx::CommandBuffer *cmdBuff, InstancedItem &instance, InstancedSlots &slots);
+    void switchView(uint32_t viewIndex);
+    void destroyViews();
+    static void destroyItems(InstancedItemList &instances);
+    bool isCompatible(const InstancedItem &instance, const gfx::Buffer *indexBuffer, uint32_t stride,
+                      const gfx::Texture *lightingMap, const gfx::Texture *reflectionProbeCubemap,
+                      const gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType) const;
+    InstancedItem &createInstance(scene::SubModel *subModel, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet,
+                                  gfx::Texture *lightingMap, gfx::Texture *reflectionProbeCubemap,
+                                  gfx::Texture *reflectionProbePlanarMap, uint32_t reflectionProbeType);
+
+    static bool persistentModeEnabled;
+    static bool indirectModeEnabled;
+    static uint32_t frameIndex;
+
+    // the active view
     InstancedItemList _instances;
+    ccstd::vector<InstancedSlots> _slots;
+    uint32_t _generation{0};
+    // parked views of the persistent mode, the entry of the active view is empty
+    ccstd::vector<InstancedView> _views;
+    uint32_t _viewIndex{0};
+    uint32_t _viewFrame{std::numeric_limits<uint32_t>::max()};
+    bool _persistent{false};
+    bool _indirect{false};
     // weak reference
     const scene::Pass *_pass{nullptr};
     bool _hasPendingModels{false};
@@ -33,19 +33,12 @@
 namespace cc {
 namespace pipeline {
 
-/**
- * @zh LOD所有级别中存储的model集合；包含多个LODGroup的所有LOD
- * @en The collection of models stored in all levels of LOD, All LODs containing multiple LODGroups.
- */
-ccstd::unordered_map<const scene::Model *, bool> modelsInAnyLODGroup;
+namespace {
+// shared by the legacy pipeline, which culls cameras one by one
+LODModelsCache cachedLODModels;
+} // namespace
 
-/**
- * @zh 指定相机下，某一级LOD使用的model集合；可能包含多个LODGroup的某一级LOD
- * @en Specify the model set used by a level of LOD under the camera, LOD of a level that may contain multiple LODGroups.
- */
-ccstd::unordered_map<const scene::Model *, bool> visibleModelsByAnyLODGroup;
-
-void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene, const scene::Camera *camera) {
+void LODModelsCache::update(const scene::RenderScene *scene, const scene::Camera *camera) {
     for (const auto &lodGroup : scene->getLODGroups()) {
         if (lodGroup->isEnabled()) {
             const auto &lodLevels = lodGroup->getLockedLODLevels();
@@ -60,12 +53,12 @@ void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene
                             if (lodLevels[i] == index) {
                                 auto *node = model->getNode();
                                 if (node && node->isActive()) {
-                                    visibleModelsByAnyLODGroup[model] = true;
+                                    _visibleModelsByAnyLODGroup.emplace(model);
                                     break;
                                 }
                             }
                         }
-                        modelsInAnyLODGroup[model] = true;
+                        _modelsInAnyLODGroup.emplace(model);
                     }
                 }
                 continue;
@@ -77,22 +70,34 @@ void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene
                 for (const auto &model : lod->getModels()) {
                     auto *node = model->getNode();
                     if (visIndex == index && node && node->isActive()) {
-                        visibleModelsByAnyLODGroup[model] = true;
+                        _visibleModelsByAnyLODGroup.emplace(model);
                     }
-                    modelsInAnyLODGroup[model] = true;
+                    _modelsInAnyLODGroup.emplace(model);
                 }
             }
         }
     }
 }
 
+bool LODModelsCache::isLODModelCulled(const scene::Model *model) const {
+    return _modelsInAnyLODGroup.count(model) != 0 && _visibleModelsByAnyLODGroup.count(model) == 0;
+}
+
+void LODModelsCache::clear() {
+    _modelsInAnyLODGroup.clear();
+    _visibleModelsByAnyLODGroup.clear();
+}
+
+void LODModelsCachedUtils::updateCachedLODModels(const scene::RenderScene *scene, const scene::Camera *camera) {
+    cachedLODModels.update(scene, camera);
+}
+
 bool LODModelsCachedUtils::isLODModelCulled(const scene::Model *model) {
-    return modelsInAnyLODGroup[model] && !visibleModelsByAnyLODGroup[model];
+    return cachedLODModels.isLODModelCulled(model);
 }
 
 void LODModelsCachedUtils::clearCachedLODModels() {
-    modelsInAnyLODGroup.clear();
-    visibleModelsByAnyLODGroup.clear();
+    cachedLODModels.clear();
 }
 } // namespace pipeline
 } // namespace cc
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include "base/std/container/unordered_set.h"
+
 namespace cc {
 namespace scene {
 class Model;
@@ -34,6 +36,31 @@ class RenderScene;
 
 namespace pipeline {
 
+/**
+ * @en LOD visibility of models under one camera. Each camera owns its cache,
+ * so different cameras can be culled on different threads.
+ * @zh 单个相机下的 LOD 模型可见性，每个相机持有自己的缓存，不同相机可以在不同线程剔除。
+ */
+class LODModelsCache {
+public:
+    void update(const scene::RenderScene *scene, const scene::Camera *camera);
+    bool isLODModelCulled(const scene::Model *model) const;
+    void clear();
+
+private:
+    /**
+     * @zh LOD所有级别中存储的model集合；包含多个LODGroup的所有LOD
+     * @en The collection of models stored in all levels of LOD, All LODs containing multiple LODGroups.
+     */
+    ccstd::unordered_set<const scene::Model *> _modelsInAnyLODGroup;
+
+    /**
+     * @zh 指定相机下，某一级LOD使用的model集合；可能包含多个LODGroup的某一级LOD
+     * @en Specify the model set used by a level of LOD under the camera, LOD of a level that may contain multiple LODGroups.
+     */
+    ccstd::unordered_set<const scene::Model *> _visibleModelsByAnyLODGroup;
+};
+
 class LODModelsCachedUtils {
 public:
     static void updateCachedLODModels(const scene::RenderScene *scene, const scene::Camera *camera);
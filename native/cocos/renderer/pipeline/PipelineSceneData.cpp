@@ -25,12 +25,14 @@
 
 #include "PipelineSceneData.h"
 #include <sstream>
+#include "SoftwareOcclusionCulling.h"
 #include "core/ArrayBuffer.h"
 #include "core/assets/Material.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXFramebuffer.h"
 #include "scene/Ambient.h"
+#include "scene/Define.h"
 #include "scene/Fog.h"
 #include "scene/Octree.h"
 #include "scene/Pass.h"
@@ -49,6 +51,7 @@ PipelineSceneData::PipelineSceneData() {
     _csmLayers = ccnew CSMLayers();
     _octree = ccnew scene::Octree();
     _lightProbes = ccnew gi::LightProbes();
+    _softwareOcclusionCulling = ccnew SoftwareOcclusionCulling();
 }
 
 PipelineSceneData::~PipelineSceneData() {
@@ -59,6 +62,7 @@ PipelineSceneData::~PipelineSceneData() {
     CC_SAFE_DELETE(_octree);
     CC_SAFE_DELETE(_csmLayers);
     CC_SAFE_DELETE(_lightProbes);
+    CC_SAFE_DELETE(_softwareOcclusionCulling);
 }
 
 void PipelineSceneData::activate(gfx::Device *device) {
@@ -79,6 +83,7 @@ void PipelineSceneData::activate(gfx::Device *device) {
 
 void PipelineSceneData::destroy() {
     _shadowFrameBufferMap.clear();
+    _softwareOcclusionCulling->clearOccluders();
     _validPunctualLights.clear();
 
     _occlusionQueryInputAssembler = nullptr;
@@ -137,6 +142,7 @@ void PipelineSceneData::initDebugRenderer() {
         _debugRendererMaterial->initialize(info);
         _debugRendererPass = (*_debugRendererMaterial->getPasses())[0];
         _debugRendererShader = _debugRendererPass->getShaderVariant();
+        _debugRendererSDFShader = _debugRendererPass->getShaderVariant({{"USE_SDF", true}});
     }
 }
 
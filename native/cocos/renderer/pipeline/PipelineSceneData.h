@@ -51,6 +51,8 @@ class LightProbes;
 
 namespace pipeline {
 
+class SoftwareOcclusionCulling;
+
 class CC_DLL PipelineSceneData : public RefCounted {
 public:
     PipelineSceneData();
@@ -74,6 +76,7 @@ public:
     inline scene::Fog *getFog() const { return _fog; }
     inline scene::Octree *getOctree() const { return _octree; }
     inline gi::LightProbes *getLightProbes() const { return _lightProbes; }
+    inline SoftwareOcclusionCulling *getSoftwareOcclusionCulling() const { return _softwareOcclusionCulling; }
     inline gfx::InputAssembler *getOcclusionQueryInputAssembler() const { return _occlusionQueryInputAssembler; }
     inline scene::Pass *getOcclusionQueryPass() const { return _occlusionQueryPass; }
     inline gfx::Shader *getOcclusionQueryShader() const { return _occlusionQueryShader; }
@@ -82,6 +85,7 @@ public:
     inline const ccstd::vector<gfx::Shader *> &getGeometryRendererShaders() const { return _geometryRendererShaders; }
     inline scene::Pass *getDebugRendererPass() const { return _debugRendererPass; }
     inline gfx::Shader *getDebugRendererShader() const { return _debugRendererShader; }
+    inline gfx::Shader *getDebugRendererSDFShader() const { return _debugRendererSDFShader; }
     inline void addRenderObject(RenderObject &&obj) { _renderObjects.emplace_back(obj); }
     inline void clearRenderObjects() { _renderObjects.clear(); }
     inline void addValidPunctualLight(scene::Light *light) { _validPunctualLights.emplace_back(light); }
@@ -105,11 +109,12 @@ protected:
     IntrusivePtr<Material> _occlusionQueryMaterial{nullptr};
     IntrusivePtr<Material> _debugRendererMaterial{nullptr};
 
-    gfx::Shader *_occlusionQueryShader{nullptr}; // weak reference
-    scene::Pass *_occlusionQueryPass{nullptr};   // weak reference
-    gfx::Shader *_debugRendererShader{nullptr};  // weak reference
-    scene::Pass *_debugRendererPass{nullptr};    // weak reference
-    gfx::Device *_device{nullptr};               // weak reference
+    gfx::Shader *_occlusionQueryShader{nullptr};   // weak reference
+    scene::Pass *_occlusionQueryPass{nullptr};     // weak reference
+    gfx::Shader *_debugRendererShader{nullptr};    // weak reference
+    gfx::Shader *_debugRendererSDFShader{nullptr}; // weak reference
+    scene::Pass *_debugRendererPass{nullptr};      // weak reference
+    gfx::Device *_device{nullptr};                 // weak reference
     // manage memory manually
     scene::Fog *_fog{nullptr};
     // manage memory manually
@@ -124,6 +129,8 @@ protected:
     gi::LightProbes *_lightProbes{nullptr};
 
     CSMLayers *_csmLayers{nullptr};
+    // manage memory manually
+    SoftwareOcclusionCulling *_softwareOcclusionCulling{nullptr};
 
     bool _isHDR{true};
     bool _csmSupported{true};
@@ -103,7 +103,7 @@ void ReflectionProbeBatchedQueue::add(const scene::Model *model) {
             passIdx = getDefaultPassIndex(subModel);
             bUseReflectPass = false;
         }
-        if (passIdx == -1) {
+        if (passIdx == -1 || !subModel->getShader(passIdx)) {
             continue;
         }
 
@@ -26,6 +26,7 @@
 #include "RenderAdditiveLightQueue.h"
 #include "BatchedBuffer.h"
 #include "Define.h"
+#include "FrameArena.h"
 #include "GlobalDescriptorSetManager.h"
 #include "InstancedBuffer.h"
 #include "PipelineSceneData.h"
@@ -97,7 +98,7 @@ void RenderAdditiveLightQueue::recordCommandBuffer(gfx::Device *device, scene::C
             const auto *pass = lightPass.pass;
             const auto &dynamicOffsets = lightPass.dynamicOffsets;
             auto *shader = lightPass.shader;
-            const auto lights = lightPass.lights;
+            const auto &lights = lightPass.lights;
             auto *ia = subModel->getInputAssembler();
             auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
             auto *descriptorSet = subModel->getDescriptorSet();
@@ -175,10 +176,6 @@ void RenderAdditiveLightQueue::clear() {
     _instancedQueue->clear();
     _batchedQueue->clear();
 
-    for (auto lightPass : _lightPasses) {
-        lightPass.dynamicOffsets.clear();
-        lightPass.lights.clear();
-    }
     _lightPasses.clear();
 
     _instancedLightPass.dynamicOffsets.clear();
@@ -197,15 +194,22 @@ bool RenderAdditiveLightQueue::cullSpotLight(const scene::SpotLight *light, cons
 }
 
 void RenderAdditiveLightQueue::addRenderQueue(scene::SubModel *subModel, const scene::Model *model, scene::Pass *pass, uint32_t lightPassIdx) {
+    // the shader variant is still compiling
+    if (!subModel->getShader(lightPassIdx)) {
+        return;
+    }
+
     const auto lightCount = _lightIndices.size();
     const auto batchingScheme = pass->getBatchingScheme();
 
-    AdditiveLightPass lightPass;
+    // light lists of single passes only live for this frame
+    AdditiveLightPass lightPass(_pipeline->getFrameArena());
     if (batchingScheme == scene::BatchingSchemes::NONE) {
         lightPass.subModel = subModel;
         lightPass.pass = pass;
         lightPass.shader = subModel->getShader(lightPassIdx);
         lightPass.dynamicOffsets.resize(lightCount);
+        lightPass.lights.reserve(lightCount);
     }
 
     for (uint32_t i = 0; i < lightCount; ++i) {
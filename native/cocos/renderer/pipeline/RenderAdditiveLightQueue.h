@@ -45,11 +45,14 @@ class RenderBatchedQueue;
 class ForwardPipeline;
 
 struct AdditiveLightPass {
+    AdditiveLightPass() = default;
+    explicit AdditiveLightPass(boost::container::pmr::memory_resource *mr) : dynamicOffsets(mr), lights(mr) {}
+
     const scene::SubModel *subModel{nullptr}; // weak reference
     const scene::Pass *pass{nullptr};         // weak reference
     gfx::Shader *shader{nullptr};             //weak reference
-    ccstd::vector<uint32_t> dynamicOffsets;
-    ccstd::vector<const scene::Light *> lights; //light is weak reference
+    ccstd::pmr::vector<uint32_t> dynamicOffsets;
+    ccstd::pmr::vector<const scene::Light *> lights; //light is weak reference
 };
 
 class RenderAdditiveLightQueue final {
@@ -92,6 +95,8 @@ private:
     AdditiveLightPass _batchedLightPass;
 
     ccstd::vector<uint32_t> _dynamicOffsets;
+    // Scratch list refilled for every model. It stays a heap vector because its capacity survives across frames.
+    // A FrameArena vector would have to be rebound and regrown after every arena reset.
     ccstd::vector<uint32_t> _lightIndices;
 
     ccstd::vector<float> _lightBufferData;
@@ -84,7 +84,11 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
                     cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
                 }
                 cmdBuffer->bindInputAssembler(instance.ia);
-                cmdBuffer->draw(instance.ia);
+                if (instance.indirectBuffer) {
+                    cmdBuffer->drawIndirect(instance.indirectBuffer, 0, static_cast<uint32_t>(instance.draws.size()));
+                } else {
+                    cmdBuffer->draw(instance.ia);
+                }
             }
         }
     };
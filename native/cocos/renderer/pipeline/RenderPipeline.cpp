@@ -25,6 +25,7 @@
 
 #include "RenderPipeline.h"
 #include "BatchedBuffer.h"
+#include "FrameArena.h"
 #if CC_USE_GEOMETRY_RENDERER
     #include "GeometryRenderer.h"
 #endif
@@ -40,6 +41,7 @@
 #include "frame-graph/FrameGraph.h"
 #include "gfx-base/GFXDevice.h"
 #include "helper/Utils.h"
+#include "profiler/Profiler.h"
 #if CC_USE_DEBUG_RENDERER
     #include "profiler/DebugRenderer.h"
 #endif
@@ -66,10 +68,12 @@ RenderPipeline::RenderPipeline()
 
     _globalDSManager = ccnew GlobalDSManager();
     _pipelineUBO = ccnew PipelineUBO();
+    _frameArena = ccnew FrameArena();
 }
 
 RenderPipeline::~RenderPipeline() {
     RenderPipeline::instance = nullptr;
+    CC_SAFE_DELETE(_frameArena);
 }
 
 bool RenderPipeline::initialize(const RenderPipelineInfo &info) {
@@ -104,6 +108,8 @@ bool RenderPipeline::activate(gfx::Swapchain * /*swapchain*/) {
 }
 
 void RenderPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
+    resetFrameArena();
+    InstancedBuffer::beginFrame();
     for (auto const &flow : _flows) {
         for (auto *camera : cameras) {
             flow->render(camera);
@@ -113,6 +119,13 @@ void RenderPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     RenderPipeline::framegraphGC();
 }
 
+void RenderPipeline::resetFrameArena() {
+    // Everything allocated from the arena in the previous frame is dead at this point.
+    _frameArena->reset();
+    CC_PROFILE_MEMORY_UPDATE(FrameArenaLastFrame, _frameArena->getLastFrameUsage());
+    CC_PROFILE_MEMORY_UPDATE(FrameArenaPeak, _frameArena->getPeakUsage());
+}
+
 void RenderPipeline::onGlobalPipelineStateChanged() {
     // do nothing
 }
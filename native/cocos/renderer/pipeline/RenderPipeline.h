@@ -52,6 +52,7 @@ namespace pipeline {
 
 class PipelineUBO;
 class PipelineSceneData;
+class FrameArena;
 class GlobalDSManager;
 class RenderStage;
 class GeometryRenderer;
@@ -93,6 +94,7 @@ public:
     inline const gfx::CommandBufferList &getCommandBuffers() const { return _commandBuffers; }
     inline const gfx::QueryPoolList &getQueryPools() const { return _queryPools; }
     inline PipelineUBO *getPipelineUBO() const { return _pipelineUBO; }
+    inline FrameArena *getFrameArena() const { return _frameArena; }
     inline const ccstd::string &getConstantMacros() const { return _constantMacros; }
     inline gfx::Device *getDevice() const { return _device; }
     RenderStage *getRenderstageByName(const ccstd::string &name) const;
@@ -152,6 +154,7 @@ protected:
 
     void generateConstantMacros();
     void destroyQuadInputAssembler();
+    void resetFrameArena();
 
 #if CC_USE_GEOMETRY_RENDERER
     void updateGeometryRenderer(const ccstd::vector<scene::Camera *> &cameras);
@@ -175,6 +178,8 @@ protected:
     gfx::DescriptorSet *_descriptorSet{nullptr};
     // manage memory manually
     PipelineUBO *_pipelineUBO{nullptr};
+    // manage memory manually, per-frame scratch memory of render queues
+    FrameArena *_frameArena{nullptr};
     IntrusivePtr<scene::Model> _profiler;
     IntrusivePtr<PipelineSceneData> _pipelineSceneData;
 
@@ -26,6 +26,7 @@
 #include "RenderQueue.h"
 
 #include <utility>
+#include "FrameArena.h"
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
@@ -40,11 +41,23 @@ namespace cc {
 namespace pipeline {
 
 RenderQueue::RenderQueue(RenderPipeline *pipeline, RenderQueueCreateInfo desc, bool useOcclusionQuery)
-: _pipeline(pipeline), _passDesc(std::move(desc)), _useOcclusionQuery(useOcclusionQuery) {
+: _pipeline(pipeline), _queue(pipeline->getFrameArena()), _passDesc(std::move(desc)), _useOcclusionQuery(useOcclusionQuery) {
+    _arenaGeneration = pipeline->getFrameArena()->getGeneration();
 }
 
 void RenderQueue::clear() {
-    _queue.clear();
+    auto *arena = _pipeline->getFrameArena();
+    if (arena->getGeneration() == _arenaGeneration) {
+        // still the same frame, the storage is valid
+        _queue.clear();
+        return;
+    }
+
+    // The arena was reset since the last clear, rebind once per frame with the capacity reached in the last one.
+    const auto lastCapacity = _queue.capacity();
+    _queue = ccstd::pmr::vector<RenderPass>(arena);
+    _queue.reserve(lastCapacity);
+    _arenaGeneration = arena->getGeneration();
 }
 
 bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint32_t subModelIdx, uint32_t passIdx) {
@@ -56,6 +69,11 @@ bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint32_t subMo
         return false;
     }
 
+    // the shader variant is still compiling
+    if (!subModel->getShader(passIdx)) {
+        return false;
+    }
+
     auto passPriority = static_cast<uint32_t>(pass->getPriority());
     auto modelPriority = static_cast<uint32_t>(subModel->getPriority());
     auto shaderId = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(subModel->getShader(passIdx)));
@@ -48,7 +48,10 @@ public:
 private:
     // weak reference
     RenderPipeline *_pipeline{nullptr};
-    RenderPassList _queue;
+    // allocated from the frame arena of the pipeline
+    ccstd::pmr::vector<RenderPass> _queue;
+    // generation of the frame arena the storage of _queue belongs to
+    uint32_t _arenaGeneration{0};
     RenderQueueCreateInfo _passDesc;
     bool _useOcclusionQuery{false};
 };
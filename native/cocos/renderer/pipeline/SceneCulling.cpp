@@ -30,6 +30,7 @@
 #include "PipelineSceneData.h"
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
+#include "SoftwareOcclusionCulling.h"
 #include "base/std/container/map.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
@@ -161,6 +162,9 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
 
     LODModelsCachedUtils::updateCachedLODModels(scene, camera);
 
+    SoftwareOcclusionCulling *occlusionCulling = sceneData->getSoftwareOcclusionCulling();
+    const bool occlusionCullingEnabled = occlusionCulling->prepare(camera);
+
     const scene::Octree *octree = scene->getOctree();
     if (octree && octree->isEnabled()) {
         for (const auto &model : scene->getModels()) {
@@ -196,6 +200,9 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
             if (LODModelsCachedUtils::isLODModelCulled(model)) {
                 continue;
             }
+            if (occlusionCullingEnabled && occlusionCulling->isOccluded(*model)) {
+                continue;
+            }
             sceneData->addRenderObject(genRenderObject(model, camera));
         }
     } else {
@@ -223,14 +230,22 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
                     }
 
                     // frustum culling
-                    if (modelWorldBounds->aabbFrustum(camera->getFrustum())) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
+                    if (!modelWorldBounds->aabbFrustum(camera->getFrustum())) {
+                        continue;
+                    }
+                    // occlusion culling
+                    if (occlusionCullingEnabled && occlusionCulling->isOccluded(*model)) {
+                        continue;
                     }
+                    sceneData->addRenderObject(genRenderObject(model, camera));
                 }
             }
         }
     }
     LODModelsCachedUtils::clearCachedLODModels();
+    if (occlusionCullingEnabled) {
+        occlusionCulling->finish();
+    }
 
     csmLayers = nullptr;
 }
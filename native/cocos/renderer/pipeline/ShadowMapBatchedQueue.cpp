@@ -119,7 +119,7 @@ void ShadowMapBatchedQueue::clear() {
 void ShadowMapBatchedQueue::add(const scene::Model *model) {
     for (const auto &subModel : model->getSubModels()) {
         const auto shadowPassIdx = getShadowPassIndex(subModel);
-        if (shadowPassIdx == -1) {
+        if (shadowPassIdx == -1 || !subModel->getShader(shadowPassIdx)) {
             continue;
         }
 
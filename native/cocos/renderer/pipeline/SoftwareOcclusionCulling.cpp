@@ -0,0 +1,463 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "SoftwareOcclusionCulling.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include "3d/assets/Types.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "core/geometry/AABB.h"
+#include "core/scene-graph/Node.h"
+#include "math/Float4.h"
+#include "profiler/Profiler.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/SubModel.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+
+constexpr float FAR_DEPTH = std::numeric_limits<float>::max();
+constexpr float MIN_CLIP_W = 1e-5F;
+// relative depth tolerance of the occlusion test, the rasterized depth and the projected bounds
+// are computed differently and disagree by a few ulps on surfaces lying in the bounds
+constexpr float DEPTH_BIAS = 1e-5F;
+
+inline bool isBehind(float z, float depth) {
+    return z - depth > DEPTH_BIAS * std::max(1.F, std::abs(depth));
+}
+
+using namespace math; // NOLINT(google-build-using-namespace)
+
+// one pixel per lane, set for the pixels inside all three edges
+inline Mask4 insideMask4(Float4 e0, Float4 e1, Float4 e2) {
+    const auto zero = splat4(0.F);
+    return and4(and4(greaterEqual4(e0, zero), greaterEqual4(e1, zero)), greaterEqual4(e2, zero));
+}
+
+// Edge function of the directed edge a->b: e(x, y) = A * x + B * y + C, positive on the left side.
+struct EdgeEquation {
+    EdgeEquation(const Vec3 &a, const Vec3 &b)
+    : A(a.y - b.y), B(b.x - a.x), C(-(A * a.x + B * a.y)) {}
+    float A;
+    float B;
+    float C;
+};
+
+inline float elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+SoftwareOcclusionCulling::SoftwareOcclusionCulling() {
+    setResolution(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+SoftwareOcclusionCulling::~SoftwareOcclusionCulling() = default;
+
+void SoftwareOcclusionCulling::setResolution(uint32_t width, uint32_t height) {
+    _width = std::max(4U, (width + 3U) & ~3U);
+    _height = std::max(1U, height);
+
+    _maxLevels.clear();
+    _minLevels.clear();
+    _levelWidths.clear();
+    _levelHeights.clear();
+
+    uint32_t w = _width;
+    uint32_t h = _height;
+    while (true) {
+        _levelWidths.emplace_back(w);
+        _levelHeights.emplace_back(h);
+        _maxLevels.emplace_back(static_cast<size_t>(w) * h, FAR_DEPTH);
+        // level 0 has only one depth per pixel, see sampleMin
+        _minLevels.emplace_back(_maxLevels.size() == 1 ? 0 : static_cast<size_t>(w) * h, FAR_DEPTH);
+        if (w == 1 && h == 1) {
+            break;
+        }
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+void SoftwareOcclusionCulling::addOccluder(scene::Model *model) {
+    CC_ASSERT(model);
+    removeOccluder(model);
+
+    Occluder occluder;
+    occluder.model = model;
+    for (const auto &subModel : model->getSubModels()) {
+        auto *subMesh = subModel->getSubMesh();
+        if (!subMesh || subMesh->getPrimitiveMode() != gfx::PrimitiveMode::TRIANGLE_LIST) {
+            continue;
+        }
+        const auto &info = subMesh->getGeometricInfo();
+        const auto &positions = info.positions;
+        const auto base = static_cast<uint32_t>(occluder.positions.size());
+        const auto vertexCount = positions.length() / 3;
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            occluder.positions.emplace_back(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]);
+        }
+        if (info.indices.has_value()) {
+            const auto &indices = info.indices.value();
+            const auto indexCount = ccstd::visit([](const auto &arr) { return arr.length(); }, indices);
+            for (uint32_t i = 0; i + 2 < indexCount; i += 3) {
+                occluder.indices.emplace_back(base + getIBArrayValue<uint32_t>(indices, i));
+                occluder.indices.emplace_back(base + getIBArrayValue<uint32_t>(indices, i + 1));
+                occluder.indices.emplace_back(base + getIBArrayValue<uint32_t>(indices, i + 2));
+            }
+        } else {
+            for (uint32_t i = 0; i + 2 < vertexCount; i += 3) {
+                occluder.indices.emplace_back(base + i);
+                occluder.indices.emplace_back(base + i + 1);
+                occluder.indices.emplace_back(base + i + 2);
+            }
+        }
+    }
+    if (!occluder.indices.empty()) {
+        _occluderModels.emplace(model);
+        _occluders.emplace_back(std::move(occluder));
+    }
+}
+
+void SoftwareOcclusionCulling::removeOccluder(const scene::Model *model) {
+    _occluderModels.erase(model);
+    _occluders.erase(std::remove_if(_occluders.begin(), _occluders.end(),
+                                    [model](const Occluder &occluder) { return occluder.model.get() == model; }),
+                     _occluders.end());
+}
+
+void SoftwareOcclusionCulling::clearOccluders() {
+    _occluderModels.clear();
+    _occluders.clear();
+}
+
+bool SoftwareOcclusionCulling::prepare(const scene::Camera *camera) {
+    if (!_enabled || _occluders.empty()) {
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    _currentStats = &_stats[camera];
+    *_currentStats = {};
+    beginView(camera->getMatViewProj());
+
+    const auto visibility = camera->getVisibility();
+    for (const auto &occluder : _occluders) {
+        const auto *model = occluder.model.get();
+        if (!model->isEnabled() || !model->getNode()) {
+            continue;
+        }
+        const auto layer = model->getNode()->getLayer();
+        if ((visibility & layer) != layer) {
+            continue;
+        }
+        const auto *bounds = model->getWorldBounds();
+        if (bounds && !bounds->aabbFrustum(camera->getFrustum())) {
+            continue;
+        }
+        rasterize(model->getTransform()->getWorldMatrix(), occluder.positions, occluder.indices);
+    }
+    endView();
+
+    _currentStats->rasterizeMs = elapsedMs(start);
+    _passStart = std::chrono::steady_clock::now();
+    return true;
+}
+
+void SoftwareOcclusionCulling::beginView(const Mat4 &viewProj) {
+    _viewThread = std::this_thread::get_id();
+    _viewProj = viewProj;
+    std::fill(_maxLevels[0].begin(), _maxLevels[0].end(), FAR_DEPTH);
+}
+
+void SoftwareOcclusionCulling::endView() {
+    CC_ASSERT(_viewThread == std::this_thread::get_id());
+    buildHierarchy();
+}
+
+void SoftwareOcclusionCulling::rasterize(const Mat4 &world, const ccstd::vector<Vec3> &positions, const ccstd::vector<uint32_t> &indices) {
+    CC_ASSERT(_viewThread == std::this_thread::get_id());
+    Mat4 matrix;
+    Mat4::multiply(_viewProj, world, &matrix);
+    const auto *m = matrix.m;
+    const auto halfWidth = static_cast<float>(_width) * 0.5F;
+    const auto halfHeight = static_cast<float>(_height) * 0.5F;
+
+    // screen space x, y and ndc depth, NaN marks vertices behind the near plane
+    _clipPositions.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto &p = positions[i];
+        const float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+        if (w < MIN_CLIP_W) {
+            _clipPositions[i].x = std::numeric_limits<float>::quiet_NaN();
+            continue;
+        }
+        const float invW = 1.F / w;
+        const float x = (m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12]) * invW;
+        const float y = (m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13]) * invW;
+        const float z = (m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]) * invW;
+        _clipPositions[i].set((x + 1.F) * halfWidth, (y + 1.F) * halfHeight, z);
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const auto &v0 = _clipPositions[indices[i]];
+        const auto &v1 = _clipPositions[indices[i + 1]];
+        const auto &v2 = _clipPositions[indices[i + 2]];
+        // skipping triangles crossing the near plane only makes the result more conservative
+        if (std::isnan(v0.x) || std::isnan(v1.x) || std::isnan(v2.x)) {
+            continue;
+        }
+        rasterizeTriangle(v0, v1, v2);
+        if (_currentStats) {
+            ++_currentStats->occluderTriangles;
+        }
+    }
+}
+
+void SoftwareOcclusionCulling::rasterizeTriangle(const Vec3 &v0, const Vec3 &v1, const Vec3 &v2) {
+    // occluders are treated as double sided, make the winding counter-clockwise
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::abs(area) < 1e-6F) {
+        return;
+    }
+    const Vec3 &a = v0;
+    const Vec3 &b = area > 0.F ? v1 : v2;
+    const Vec3 &c = area > 0.F ? v2 : v1;
+    area = std::abs(area);
+
+    const auto minX = std::max(0, static_cast<int32_t>(std::floor(std::min({a.x, b.x, c.x}))));
+    const auto maxX = std::min(static_cast<int32_t>(_width) - 1, static_cast<int32_t>(std::ceil(std::max({a.x, b.x, c.x}))));
+    const auto minY = std::max(0, static_cast<int32_t>(std::floor(std::min({a.y, b.y, c.y}))));
+    const auto maxY = std::min(static_cast<int32_t>(_height) - 1, static_cast<int32_t>(std::ceil(std::max({a.y, b.y, c.y}))));
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    // e0 weights a, e1 weights b, e2 weights c
+    const EdgeEquation e0(b, c);
+    const EdgeEquation e1(c, a);
+    const EdgeEquation e2(a, b);
+    const float invArea = 1.F / area;
+    const float zA = (e0.A * a.z + e1.A * b.z + e2.A * c.z) * invArea;
+    const float zB = (e0.B * a.z + e1.B * b.z + e2.B * c.z) * invArea;
+    const float zC = (e0.C * a.z + e1.C * b.z + e2.C * c.z) * invArea;
+
+    const auto e0A = splat4(e0.A);
+    const auto e1A = splat4(e1.A);
+    const auto e2A = splat4(e2.A);
+    const auto zA4 = splat4(zA);
+    const auto laneOffsets = set4(0.5F, 1.5F, 2.5F, 3.5F);
+
+    auto *depth = _maxLevels[0].data();
+    const int32_t startX = minX & ~3;
+    for (int32_t y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5F;
+        const auto e0Row = splat4(e0.B * py + e0.C);
+        const auto e1Row = splat4(e1.B * py + e1.C);
+        const auto e2Row = splat4(e2.B * py + e2.C);
+        const auto zRow = splat4(zB * py + zC);
+        auto *row = depth + static_cast<size_t>(y) * _width;
+        for (int32_t x = startX; x <= maxX; x += 4) {
+            const auto px = add4(splat4(static_cast<float>(x)), laneOffsets);
+            const auto mask = insideMask4(madd4(e0A, px, e0Row), madd4(e1A, px, e1Row), madd4(e2A, px, e2Row));
+            if (!any4(mask)) {
+                continue;
+            }
+            const auto z = madd4(zA4, px, zRow);
+            const auto old = load4(row + x);
+            store4(row + x, select4(mask, min4(old, z), old));
+        }
+    }
+}
+
+void SoftwareOcclusionCulling::buildHierarchy() {
+    for (size_t level = 1; level < _maxLevels.size(); ++level) {
+        const auto srcWidth = _levelWidths[level - 1];
+        const auto srcHeight = _levelHeights[level - 1];
+        const auto &srcMax = _maxLevels[level - 1];
+        // level 0 stores a single depth, which is both the min and the max
+        const auto &srcMin = level == 1 ? _maxLevels[0] : _minLevels[level - 1];
+        const auto width = _levelWidths[level];
+        const auto height = _levelHeights[level];
+        auto &dstMax = _maxLevels[level];
+        auto &dstMin = _minLevels[level];
+        for (uint32_t y = 0; y < height; ++y) {
+            const auto y0 = y * 2;
+            const auto y1 = std::min(y0 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < width; ++x) {
+                const auto x0 = x * 2;
+                const auto x1 = std::min(x0 + 1, srcWidth - 1);
+                const auto i00 = y0 * srcWidth + x0;
+                const auto i01 = y0 * srcWidth + x1;
+                const auto i10 = y1 * srcWidth + x0;
+                const auto i11 = y1 * srcWidth + x1;
+                dstMax[y * width + x] = std::max(std::max(srcMax[i00], srcMax[i01]), std::max(srcMax[i10], srcMax[i11]));
+                dstMin[y * width + x] = std::min(std::min(srcMin[i00], srcMin[i01]), std::min(srcMin[i10], srcMin[i11]));
+            }
+        }
+    }
+}
+
+float SoftwareOcclusionCulling::sampleMax(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+    const auto &depth = _maxLevels[level];
+    const auto width = _levelWidths[level];
+    float result = -FAR_DEPTH;
+    for (int32_t y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int32_t x = x0 >> level; x <= (x1 >> level); ++x) {
+            result = std::max(result, depth[y * width + x]);
+        }
+    }
+    return result;
+}
+
+float SoftwareOcclusionCulling::sampleMin(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1) const {
+    const auto &depth = level == 0 ? _maxLevels[0] : _minLevels[level];
+    const auto width = _levelWidths[level];
+    float result = FAR_DEPTH;
+    for (int32_t y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int32_t x = x0 >> level; x <= (x1 >> level); ++x) {
+            result = std::min(result, depth[y * width + x]);
+        }
+    }
+    return result;
+}
+
+bool SoftwareOcclusionCulling::isOccluded(const geometry::AABB &bounds) {
+    CC_ASSERT(_viewThread == std::this_thread::get_id());
+
+    const auto *m = _viewProj.m;
+    const auto &center = bounds.getCenter();
+    const auto &halfExtents = bounds.getHalfExtents();
+    float minX = FAR_DEPTH;
+    float minY = FAR_DEPTH;
+    float maxX = -FAR_DEPTH;
+    float maxY = -FAR_DEPTH;
+    float minZ = FAR_DEPTH;
+    bool occluded = true;
+    for (uint32_t i = 0; i < 8; ++i) {
+        const float px = center.x + ((i & 1) ? halfExtents.x : -halfExtents.x);
+        const float py = center.y + ((i & 2) ? halfExtents.y : -halfExtents.y);
+        const float pz = center.z + ((i & 4) ? halfExtents.z : -halfExtents.z);
+        const float w = m[3] * px + m[7] * py + m[11] * pz + m[15];
+        if (w < MIN_CLIP_W) {
+            // the bounds cross the near plane
+            occluded = false;
+            break;
+        }
+        const float invW = 1.F / w;
+        const float x = (m[0] * px + m[4] * py + m[8] * pz + m[12]) * invW;
+        const float y = (m[1] * px + m[5] * py + m[9] * pz + m[13]) * invW;
+        const float z = (m[2] * px + m[6] * py + m[10] * pz + m[14]) * invW;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, z);
+    }
+
+    if (occluded) {
+        const auto halfWidth = static_cast<float>(_width) * 0.5F;
+        const auto halfHeight = static_cast<float>(_height) * 0.5F;
+        const auto toPixel = [](float v, float half, int32_t size) {
+            return std::clamp(static_cast<int32_t>(std::floor((v + 1.F) * half)), 0, size - 1);
+        };
+        if (maxX < -1.F || minX > 1.F || maxY < -1.F || minY > 1.F) {
+            // out of the screen, left to the frustum culling
+            occluded = false;
+        } else {
+            const auto x0 = toPixel(minX, halfWidth, static_cast<int32_t>(_width));
+            const auto x1 = toPixel(maxX, halfWidth, static_cast<int32_t>(_width));
+            const auto y0 = toPixel(minY, halfHeight, static_cast<int32_t>(_height));
+            const auto y1 = toPixel(maxY, halfHeight, static_cast<int32_t>(_height));
+
+            // the coarsest test covers at most 2x2 texels
+            uint32_t level = 0;
+            while (level + 1 < _maxLevels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+                ++level;
+            }
+            if (isBehind(minZ, sampleMax(level, x0, y0, x1, y1))) {
+                occluded = true;
+            } else if (minZ <= sampleMin(level, x0, y0, x1, y1)) {
+                // in front of every occluder in the area
+                occluded = false;
+            } else {
+                // refine with up to 8x8 texels
+                const auto fineLevel = level > 2 ? level - 2 : 0;
+                occluded = isBehind(minZ, sampleMax(fineLevel, x0, y0, x1, y1));
+            }
+        }
+    }
+
+    if (_currentStats) {
+        ++_currentStats->testedModels;
+        if (occluded) {
+            ++_currentStats->culledModels;
+        }
+    }
+    return occluded;
+}
+
+bool SoftwareOcclusionCulling::isOccluded(const scene::Model &model) {
+    CC_ASSERT(model.getWorldBounds());
+    if (_occluderModels.count(&model)) {
+        return false;
+    }
+    return isOccluded(*model.getWorldBounds());
+}
+
+void SoftwareOcclusionCulling::finish() {
+    if (_currentStats) {
+        CC_ASSERT(_viewThread == std::this_thread::get_id());
+        _currentStats->testMs = elapsedMs(_passStart);
+        CC_PROFILE_RENDER_INC(OcclusionCulledModels, _currentStats->culledModels);
+    }
+    _currentStats = nullptr;
+}
+
+const OcclusionCullingStats *SoftwareOcclusionCulling::getStats(const scene::Camera *camera) const {
+    auto iter = _stats.find(camera);
+    return iter != _stats.end() ? &iter->second : nullptr;
+}
+
+void SoftwareOcclusionCulling::removeCamera(const scene::Camera *camera) {
+    auto iter = _stats.find(camera);
+    if (iter == _stats.end()) {
+        return;
+    }
+
+    if (_currentStats == &iter->second) {
+        _currentStats = nullptr;
+    }
+    _stats.erase(iter);
+}
+
+} // namespace pipeline
+} // namespace cc
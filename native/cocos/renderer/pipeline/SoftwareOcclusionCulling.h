@@ -0,0 +1,145 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Vec3.h"
+
+namespace cc {
+namespace geometry {
+class AABB;
+} // namespace geometry
+namespace scene {
+class Camera;
+class Model;
+} // namespace scene
+
+namespace pipeline {
+
+struct OcclusionCullingStats {
+    uint32_t occluderTriangles{0};
+    uint32_t testedModels{0};
+    uint32_t culledModels{0};
+    // cost of rasterizing the occluders and building the depth hierarchy
+    float rasterizeMs{0.F};
+    // cost of the culling pass between prepare() and finish(), the occlusion tests included,
+    // measured once per pass rather than per tested model
+    float testMs{0.F};
+};
+
+/**
+ * Software occlusion culling: the registered occluder models are rasterized on the CPU
+ * into a low resolution depth buffer, a min/max depth hierarchy is built on top of it,
+ * and the world bounds of the other models are tested against the hierarchy.
+ * The test is conservative, a model is only culled if all of its bounds lie behind the occluders.
+ *
+ * Not thread-safe: the depth buffer and the statistics are shared, so the cameras have to be culled
+ * one at a time and each pass from prepare() to finish() has to run on one thread, debug builds assert it.
+ */
+class CC_DLL SoftwareOcclusionCulling final {
+public:
+    static constexpr uint32_t DEFAULT_WIDTH{256};
+    static constexpr uint32_t DEFAULT_HEIGHT{128};
+
+    SoftwareOcclusionCulling();
+    ~SoftwareOcclusionCulling();
+    SoftwareOcclusionCulling(const SoftwareOcclusionCulling &) = delete;
+    SoftwareOcclusionCulling &operator=(const SoftwareOcclusionCulling &) = delete;
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool val) { _enabled = val; }
+    // the width is rounded up to a multiple of 4
+    void setResolution(uint32_t width, uint32_t height);
+    inline uint32_t getWidth() const { return _width; }
+    inline uint32_t getHeight() const { return _height; }
+
+    // the occluder geometry is read from the sub-meshes once, only triangle lists are used
+    void addOccluder(scene::Model *model);
+    void removeOccluder(const scene::Model *model);
+    void clearOccluders();
+    inline size_t getOccluderCount() const { return _occluders.size(); }
+
+    // rasterizes the occluders from the camera view, returns false if there is nothing to test against
+    bool prepare(const scene::Camera *camera);
+    // only valid after prepare() returned true for the camera
+    bool isOccluded(const geometry::AABB &bounds);
+    // tests the world bounds of the model, registered occluders are never culled by their own depth
+    bool isOccluded(const scene::Model &model);
+    void finish();
+
+    // The steps of prepare() without a scene: clear the depth buffer for a view, rasterize
+    // triangle lists given in model space, then build the depth hierarchy used by isOccluded().
+    void beginView(const Mat4 &viewProj);
+    void rasterize(const Mat4 &world, const ccstd::vector<Vec3> &positions, const ccstd::vector<uint32_t> &indices);
+    void endView();
+
+    const OcclusionCullingStats *getStats(const scene::Camera *camera) const;
+    // drops the statistics of a camera leaving its scene
+    void removeCamera(const scene::Camera *camera);
+
+private:
+    struct Occluder {
+        IntrusivePtr<scene::Model> model;
+        ccstd::vector<Vec3> positions;
+        ccstd::vector<uint32_t> indices;
+    };
+
+    void rasterizeTriangle(const Vec3 &v0, const Vec3 &v1, const Vec3 &v2);
+    void buildHierarchy();
+    float sampleMax(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1) const;
+    float sampleMin(uint32_t level, int32_t x0, int32_t y0, int32_t x1, int32_t y1) const;
+
+    bool _enabled{false};
+    uint32_t _width{DEFAULT_WIDTH};
+    uint32_t _height{DEFAULT_HEIGHT};
+
+    ccstd::vector<Occluder> _occluders;
+    ccstd::unordered_set<const scene::Model *> _occluderModels;
+
+    // level 0 is the rasterized depth, each further level halves the resolution
+    ccstd::vector<ccstd::vector<float>> _maxLevels;
+    ccstd::vector<ccstd::vector<float>> _minLevels;
+    ccstd::vector<uint32_t> _levelWidths;
+    ccstd::vector<uint32_t> _levelHeights;
+    ccstd::vector<Vec3> _clipPositions;
+
+    Mat4 _viewProj;
+    OcclusionCullingStats *_currentStats{nullptr};
+    std::chrono::steady_clock::time_point _passStart;
+    // thread of the current pass, checked by the assertions
+    std::thread::id _viewThread;
+    ccstd::unordered_map<const scene::Camera *, OcclusionCullingStats> _stats;
+};
+
+} // namespace pipeline
+} // namespace cc
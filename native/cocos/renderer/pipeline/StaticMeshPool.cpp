@@ -0,0 +1,337 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "StaticMeshPool.h"
+#include <algorithm>
+#include "3d/assets/Mesh.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+
+bool isSameLayout(const gfx::AttributeList &lhs, const gfx::AttributeList &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        const auto &a = lhs[i];
+        const auto &b = rhs[i];
+        if (a.name != b.name || a.format != b.format || a.isNormalized != b.isNormalized ||
+            a.stream != b.stream || a.isInstanced != b.isInstanced || a.location != b.location) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void appendIndices(const uint8_t *src, uint32_t count, ccstd::vector<uint32_t> *dst) {
+    const auto *indices = reinterpret_cast<const T *>(src);
+    for (uint32_t i = 0; i < count; ++i) {
+        dst->emplace_back(static_cast<uint32_t>(indices[i]));
+    }
+}
+
+void uploadBuffer(gfx::Buffer *buffer, const void *data, uint32_t size) {
+    if (!size) {
+        return;
+    }
+    if (buffer->getSize() < size) {
+        // grow geometrically, the arenas mostly get appended
+        buffer->resize(std::max(size, buffer->getSize() * 2));
+    } else if (size * 4 < buffer->getSize()) {
+        // shrink once a compaction left most of the buffer unused
+        buffer->resize(size * 2);
+    }
+    buffer->update(data, size);
+}
+
+} // namespace
+
+StaticMeshPool *StaticMeshPool::getInstance() {
+    static StaticMeshPool instance;
+    return &instance;
+}
+
+const StaticMeshRange *StaticMeshPool::acquire(const scene::Model *model, RenderingSubMesh *subMesh) {
+    auto *mesh = subMesh->getMesh();
+    if (!mesh) {
+        return nullptr;
+    }
+    retain(model, mesh);
+
+    auto iter = _ranges.find(subMesh);
+    if (iter == _ranges.end()) {
+        auto &meshEntry = _meshes[mesh];
+        RangeEntry entry;
+        entry.subMesh = subMesh;
+        entry.mesh = mesh;
+        entry.bundle = merge(subMesh, &meshEntry, &entry.range);
+        iter = _ranges.emplace(subMesh, std::move(entry)).first;
+        meshEntry.subMeshes.emplace_back(subMesh);
+    }
+    return iter->second.bundle ? &iter->second.range : nullptr;
+}
+
+void StaticMeshPool::retain(const scene::Model *model, Mesh *mesh) {
+    auto &meshes = _modelMeshes[model];
+    if (std::find(meshes.begin(), meshes.end(), mesh) != meshes.end()) {
+        return;
+    }
+    meshes.emplace_back(mesh);
+    auto &entry = _meshes[mesh];
+    entry.mesh = mesh;
+    ++entry.refCount;
+}
+
+void StaticMeshPool::release(const scene::Model *model) {
+    auto iter = _modelMeshes.find(model);
+    if (iter == _modelMeshes.end()) {
+        return;
+    }
+    for (const auto *mesh : iter->second) {
+        auto meshIter = _meshes.find(mesh);
+        if (meshIter == _meshes.end() || --meshIter->second.refCount > 0) {
+            continue;
+        }
+        releaseMesh(meshIter->second);
+        _meshes.erase(meshIter);
+    }
+    _modelMeshes.erase(iter);
+}
+
+void StaticMeshPool::releaseMesh(const MeshEntry &entry) {
+    // the geometry stays in place until the next flush(), the draws of this frame may still use it
+    for (const auto *subMesh : entry.subMeshes) {
+        _ranges.erase(subMesh);
+    }
+    for (const auto bundle : entry.bundles) {
+        auto iter = _bundles.find({entry.mesh.get(), bundle});
+        if (iter != _bundles.end()) {
+            iter->second.arena->fragmented = true;
+            _bundles.erase(iter);
+        }
+    }
+}
+
+const StaticMeshPool::BundleEntry *StaticMeshPool::merge(RenderingSubMesh *subMesh, MeshEntry *meshEntry, StaticMeshRange *range) {
+    auto *device = gfx::Device::getInstance();
+    if (!device->hasFeature(gfx::Feature::ELEMENT_INDEX_UINT)) {
+        return nullptr;
+    }
+    auto *mesh = subMesh->getMesh();
+    const auto &subMeshIdx = subMesh->getSubMeshIdx();
+    if (!subMeshIdx.has_value() || !mesh->isAllowDataAccess()) {
+        return nullptr;
+    }
+    const auto &meshStruct = mesh->getStruct();
+    auto &meshData = mesh->getData();
+    if (subMeshIdx.value() >= meshStruct.primitives.size() || !meshData.buffer()) {
+        return nullptr;
+    }
+    const auto &primitive = meshStruct.primitives[subMeshIdx.value()];
+    if (primitive.primitiveMode != gfx::PrimitiveMode::TRIANGLE_LIST ||
+        !primitive.indexView.has_value() || primitive.vertexBundelIndices.size() != 1) {
+        return nullptr;
+    }
+    const auto bundleIdx = primitive.vertexBundelIndices[0];
+    if (bundleIdx >= meshStruct.vertexBundles.size()) {
+        return nullptr;
+    }
+    const auto &bundle = meshStruct.vertexBundles[bundleIdx];
+    const auto &indexView = primitive.indexView.value();
+    if (!bundle.view.stride || (indexView.stride != 1 && indexView.stride != 2 && indexView.stride != 4)) {
+        return nullptr;
+    }
+    const uint8_t *src = meshData.buffer()->getData() + meshData.byteOffset();
+
+    // vertices are shared by all the sub-meshes referencing the same bundle
+    const BundleKey key{mesh, bundleIdx};
+    auto bundleIter = _bundles.find(key);
+    if (bundleIter == _bundles.end()) {
+        auto *arena = getOrCreateArena(device, bundle.attributes, bundle.view.stride);
+        if (!arena) {
+            return nullptr;
+        }
+        BundleEntry entry;
+        entry.arena = arena;
+        entry.vertexOffset = static_cast<int32_t>(arena->vertices.size() / arena->stride);
+        entry.vertexCount = bundle.view.length / arena->stride;
+        arena->vertices.insert(arena->vertices.end(), src + bundle.view.offset, src + bundle.view.offset + bundle.view.length);
+        arena->dirty = true;
+        bundleIter = _bundles.emplace(key, std::move(entry)).first;
+        meshEntry->bundles.emplace_back(bundleIdx);
+    }
+
+    auto *arena = bundleIter->second.arena;
+    range->arena = arena;
+    range->firstIndex = static_cast<uint32_t>(arena->indices.size());
+    range->indexCount = indexView.count;
+    range->vertexOffset = bundleIter->second.vertexOffset;
+
+    arena->indices.reserve(arena->indices.size() + indexView.count);
+    const uint8_t *indices = src + indexView.offset;
+    if (indexView.stride == 1) {
+        appendIndices<uint8_t>(indices, indexView.count, &arena->indices);
+    } else if (indexView.stride == 2) {
+        appendIndices<uint16_t>(indices, indexView.count, &arena->indices);
+    } else {
+        appendIndices<uint32_t>(indices, indexView.count, &arena->indices);
+    }
+    arena->dirty = true;
+    return &bundleIter->second;
+}
+
+StaticMeshArena *StaticMeshPool::getOrCreateArena(gfx::Device *device, const gfx::AttributeList &attributes, uint32_t stride) {
+    for (auto &arena : _arenas) {
+        if (arena->stride == stride && isSameLayout(arena->attributes, attributes)) {
+            return arena.get();
+        }
+    }
+
+    auto arena = std::make_unique<StaticMeshArena>();
+    arena->attributes = attributes;
+    arena->stride = stride;
+    arena->vertexBuffer = device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        stride,
+        stride,
+    });
+    arena->indexBuffer = device->createBuffer({
+        gfx::BufferUsageBit::INDEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(uint32_t),
+        sizeof(uint32_t),
+    });
+    if (!arena->vertexBuffer || !arena->indexBuffer) {
+        return nullptr;
+    }
+    _arenas.emplace_back(std::move(arena));
+    return _arenas.back().get();
+}
+
+void StaticMeshPool::compactArenas() {
+    struct FragmentedArena {
+        StaticMeshArena *arena{nullptr};
+        ccstd::vector<BundleEntry *> bundles;
+        ccstd::vector<RangeEntry *> ranges;
+    };
+    ccstd::vector<FragmentedArena> fragmented;
+    for (auto &arena : _arenas) {
+        if (arena->fragmented) {
+            fragmented.emplace_back().arena = arena.get();
+        }
+    }
+    if (fragmented.empty()) {
+        return;
+    }
+
+    // a single pass over the entries for all the arenas, there are only a few of them
+    const auto find = [&fragmented](const StaticMeshArena *arena) -> FragmentedArena * {
+        for (auto &item : fragmented) {
+            if (item.arena == arena) {
+                return &item;
+            }
+        }
+        return nullptr;
+    };
+    for (auto &pair : _bundles) {
+        if (auto *item = find(pair.second.arena)) {
+            item->bundles.emplace_back(&pair.second);
+        }
+    }
+    for (auto &pair : _ranges) {
+        if (!pair.second.bundle) {
+            continue;
+        }
+        if (auto *item = find(pair.second.range.arena)) {
+            item->ranges.emplace_back(&pair.second);
+        }
+    }
+    for (auto &item : fragmented) {
+        compact(item.arena, item.bundles, item.ranges);
+    }
+}
+
+void StaticMeshPool::compact(StaticMeshArena *arena, ccstd::vector<BundleEntry *> &bundles, ccstd::vector<RangeEntry *> &ranges) {
+    // keeps the order of the live geometry, so that every offset only moves down
+    std::sort(bundles.begin(), bundles.end(), [](const BundleEntry *lhs, const BundleEntry *rhs) {
+        return lhs->vertexOffset < rhs->vertexOffset;
+    });
+    std::sort(ranges.begin(), ranges.end(), [](const RangeEntry *lhs, const RangeEntry *rhs) {
+        return lhs->range.firstIndex < rhs->range.firstIndex;
+    });
+
+    // indices are relative to the vertex offset of their bundle, moving the vertices does not touch them
+    ccstd::vector<uint8_t> vertices;
+    for (auto *bundle : bundles) {
+        const auto *src = arena->vertices.data() + static_cast<size_t>(bundle->vertexOffset) * arena->stride;
+        bundle->vertexOffset = static_cast<int32_t>(vertices.size() / arena->stride);
+        vertices.insert(vertices.end(), src, src + static_cast<size_t>(bundle->vertexCount) * arena->stride);
+    }
+    ccstd::vector<uint32_t> indices;
+    for (auto *entry : ranges) {
+        const auto *src = arena->indices.data() + entry->range.firstIndex;
+        entry->range.firstIndex = static_cast<uint32_t>(indices.size());
+        entry->range.vertexOffset = entry->bundle->vertexOffset;
+        indices.insert(indices.end(), src, src + entry->range.indexCount);
+    }
+    arena->vertices = std::move(vertices);
+    arena->indices = std::move(indices);
+    arena->fragmented = false;
+    arena->dirty = true;
+}
+
+void StaticMeshPool::flush() {
+    compactArenas();
+    upload();
+}
+
+void StaticMeshPool::upload() {
+    // empty arenas are kept, the input assemblers of the instanced buffers still reference their buffers
+    for (auto &arena : _arenas) {
+        if (!arena->dirty) {
+            continue;
+        }
+        uploadBuffer(arena->vertexBuffer, arena->vertices.data(), static_cast<uint32_t>(arena->vertices.size()));
+        uploadBuffer(arena->indexBuffer, arena->indices.data(), static_cast<uint32_t>(arena->indices.size() * sizeof(uint32_t)));
+        arena->dirty = false;
+    }
+}
+
+void StaticMeshPool::destroy() {
+    _ranges.clear();
+    _bundles.clear();
+    _modelMeshes.clear();
+    _meshes.clear();
+    _arenas.clear();
+}
+
+} // namespace pipeline
+} // namespace cc
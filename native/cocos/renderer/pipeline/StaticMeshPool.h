@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+
+namespace cc {
+
+class Mesh;
+class RenderingSubMesh;
+
+namespace scene {
+class Model;
+} // namespace scene
+
+namespace gfx {
+class Device;
+} // namespace gfx
+
+namespace pipeline {
+
+/**
+ * Shared vertex and index storage of all static meshes which have the same vertex layout.
+ * Indices are always 32-bit so that every merged mesh could be addressed by the draw ranges.
+ */
+struct StaticMeshArena {
+    gfx::AttributeList attributes;
+    uint32_t stride{0};
+    IntrusivePtr<gfx::Buffer> vertexBuffer;
+    IntrusivePtr<gfx::Buffer> indexBuffer;
+    ccstd::vector<uint8_t> vertices;
+    ccstd::vector<uint32_t> indices;
+    bool dirty{false};
+    // some geometry got released, the arena is compacted by the next flush()
+    bool fragmented{false};
+};
+
+struct StaticMeshRange {
+    // weak reference
+    const StaticMeshArena *arena{nullptr};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    int32_t vertexOffset{0};
+};
+
+/**
+ * Merges the geometry of static sub-meshes into a few mega buffers, so that the sub-meshes sharing
+ * a vertex layout could be drawn with one input assembler and a single indirect draw call.
+ * Only indexed triangle lists with one vertex bundle and accessible mesh data could be merged,
+ * acquire() returns nullptr for the others and they keep using their own input assembler.
+ * The geometry of a mesh is kept as long as a model which acquired it is attached to a scene,
+ * release() drops the model's references and the arenas which lost geometry are compacted by the next flush().
+ */
+class CC_DLL StaticMeshPool final {
+public:
+    static StaticMeshPool *getInstance();
+
+    const StaticMeshRange *acquire(const scene::Model *model, RenderingSubMesh *subMesh);
+    // Drops the meshes acquired by the model, the ones no other model uses are removed from the arenas.
+    void release(const scene::Model *model);
+    // Compacts the arenas which lost geometry and uploads the changed ones, once per frame before rendering,
+    // so that the ranges copied by the draws of a frame are never moved under them.
+    void flush();
+    // Uploads the geometry appended since the last call, the offsets of the existing ranges are kept.
+    void upload();
+    void destroy();
+
+    inline size_t getArenaCount() const { return _arenas.size(); }
+    inline size_t getMeshCount() const { return _meshes.size(); }
+
+private:
+    struct BundleKey {
+        const Mesh *mesh{nullptr};
+        uint32_t bundle{0};
+
+        inline bool operator==(const BundleKey &rhs) const { return mesh == rhs.mesh && bundle == rhs.bundle; }
+    };
+    struct BundleKeyHash {
+        inline size_t operator()(const BundleKey &key) const {
+            return std::hash<const Mesh *>{}(key.mesh) ^ (static_cast<size_t>(key.bundle) << 1);
+        }
+    };
+    struct MeshEntry {
+        // keeps the mesh alive so that the keys stay unique
+        IntrusivePtr<Mesh> mesh;
+        // number of models which acquired the mesh
+        uint32_t refCount{0};
+        // keys of the geometry merged from the mesh
+        ccstd::vector<const RenderingSubMesh *> subMeshes;
+        ccstd::vector<uint32_t> bundles;
+    };
+    struct BundleEntry {
+        StaticMeshArena *arena{nullptr};
+        int32_t vertexOffset{0};
+        uint32_t vertexCount{0};
+    };
+    struct RangeEntry {
+        IntrusivePtr<RenderingSubMesh> subMesh;
+        const Mesh *mesh{nullptr};
+        // weak reference, null if the sub-mesh could not be merged
+        const BundleEntry *bundle{nullptr};
+        StaticMeshRange range;
+    };
+
+    void retain(const scene::Model *model, Mesh *mesh);
+    void releaseMesh(const MeshEntry &entry);
+    void compactArenas();
+    static void compact(StaticMeshArena *arena, ccstd::vector<BundleEntry *> &bundles, ccstd::vector<RangeEntry *> &ranges);
+    const BundleEntry *merge(RenderingSubMesh *subMesh, MeshEntry *meshEntry, StaticMeshRange *range);
+    StaticMeshArena *getOrCreateArena(gfx::Device *device, const gfx::AttributeList &attributes, uint32_t stride);
+
+    ccstd::vector<std::unique_ptr<StaticMeshArena>> _arenas;
+    ccstd::unordered_map<const Mesh *, MeshEntry> _meshes;
+    ccstd::unordered_map<const scene::Model *, ccstd::vector<const Mesh *>> _modelMeshes;
+    // element addresses are stable, the range entries point to their bundle
+    ccstd::unordered_map<BundleKey, BundleEntry, BundleKeyHash> _bundles;
+    ccstd::unordered_map<const RenderingSubMesh *, RangeEntry> _ranges;
+};
+
+} // namespace pipeline
+} // namespace cc
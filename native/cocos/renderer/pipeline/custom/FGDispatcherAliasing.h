@@ -0,0 +1,75 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+#include "cocos/renderer/pipeline/custom/Map.h"
+#include "cocos/renderer/pipeline/custom/RenderGraphTypes.h"
+
+namespace cc {
+
+namespace render {
+
+struct ResourceAliasTransition {
+    ResourceGraph::vertex_descriptor resourceID{0xFFFFFFFF};
+    ResourceAccessGraph::vertex_descriptor passID{0xFFFFFFFF};
+    AccessStatus lastStatus;
+    AccessStatus currStatus;
+};
+
+struct ResourceAliasing {
+    using allocator_type = boost::container::pmr::polymorphic_allocator<char>;
+    allocator_type get_allocator() const noexcept { // NOLINT
+        return {aliasTransitions.get_allocator().resource()};
+    }
+
+    ResourceAliasing(const allocator_type& alloc) noexcept // NOLINT
+    : resourceAliases(alloc),
+      aliasTransitions(alloc) {}
+    ResourceAliasing(ResourceAliasing&& rhs) = delete;
+    ResourceAliasing(ResourceAliasing const& rhs) = delete;
+    ResourceAliasing& operator=(ResourceAliasing&& rhs) = delete;
+    ResourceAliasing& operator=(ResourceAliasing const& rhs) = delete;
+
+    // aliased resource -> resource which owns the memory
+    PmrFlatMap<ResourceGraph::vertex_descriptor, ResourceGraph::vertex_descriptor> resourceAliases;
+    ccstd::pmr::vector<ResourceAliasTransition> aliasTransitions;
+    uint64_t transientMemorySize{0};
+    uint64_t aliasedMemorySize{0};
+};
+
+// Call after FrameGraphDispatcher::run(). Leaves aliasing empty unless memory aliasing is enabled,
+// otherwise adds a FULL front barrier wherever a resource takes over the memory of a retired one.
+void aliasTransientResources(FrameGraphDispatcher& fgDispatcher, ResourceAliasing& aliasing);
+
+// Aliased resources borrow the gfx object of their owner for the current frame only.
+void mountAlias(ResourceGraph& resg, gfx::Device* device, ResourceGraph::vertex_descriptor vertID, ResourceGraph::vertex_descriptor ownerID);
+void unmountAlias(ResourceGraph& resg, ResourceGraph::vertex_descriptor vertID);
+
+} // namespace render
+
+} // namespace cc
@@ -33,6 +33,7 @@
 #include <iterator>
 #include <limits>
 #include <vector>
+#include "FGDispatcherAliasing.h"
 #include "FGDispatcherGraphs.h"
 #include "FGDispatcherTypes.h"
 #include "LayoutGraphGraphs.h"
@@ -62,16 +63,12 @@ namespace render {
 static constexpr bool ENABLE_BRANCH_CULLING = true;
 
 void passReorder(FrameGraphDispatcher &fgDispatcher);
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher);
 void buildBarriers(FrameGraphDispatcher &fgDispatcher);
 
 void FrameGraphDispatcher::run() {
     if (_enablePassReorder) {
         passReorder(*this);
     }
-    if (_enableMemoryAliasing) {
-        memoryAliasing(*this);
-    }
     buildBarriers(*this);
 }
 
@@ -707,6 +704,31 @@ struct BarrierVisitor : public boost::bfs_visitor<> {
     ResourceLifeRecordMap &resourceLifeRecord;
 };
 
+void genGFXBarrierOf(Barrier &passBarrier, const ResourceGraph &resourceGraph) {
+    const auto &desc = get(ResourceGraph::Desc, resourceGraph, passBarrier.resourceID);
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        gfx::BufferBarrierInfo info;
+        info.prevAccesses = passBarrier.beginStatus.accessFlag;
+        info.nextAccesses = passBarrier.endStatus.accessFlag;
+        const auto &range = ccstd::get<BufferRange>(passBarrier.beginStatus.range);
+        info.offset = range.offset;
+        info.size = range.size;
+        info.type = passBarrier.type;
+        passBarrier.barrier = gfx::Device::getInstance()->getBufferBarrier(info);
+    } else {
+        gfx::TextureBarrierInfo info;
+        info.prevAccesses = passBarrier.beginStatus.accessFlag;
+        info.nextAccesses = passBarrier.endStatus.accessFlag;
+        const auto &range = ccstd::get<TextureRange>(passBarrier.beginStatus.range);
+        info.baseMipLevel = range.mipLevel;
+        info.levelCount = range.levelCount;
+        info.baseSlice = range.firstSlice;
+        info.sliceCount = range.numSlices;
+        info.type = passBarrier.type;
+        passBarrier.barrier = gfx::Device::getInstance()->getTextureBarrier(info);
+    }
+}
+
 void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
     auto *scratch = fgDispatcher.scratch;
     const auto &graph = fgDispatcher.graph;
@@ -782,31 +804,9 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         }
     }
 
-    const auto &resDescs = get(ResourceGraph::Desc, resourceGraph);
-    auto genGFXBarrier = [&resDescs](std::vector<Barrier> &barriers) {
+    auto genGFXBarrier = [&resourceGraph](std::vector<Barrier> &barriers) {
         for (auto &passBarrier : barriers) {
-            const auto &desc = get(resDescs, passBarrier.resourceID);
-            if (desc.dimension == ResourceDimension::BUFFER) {
-                gfx::BufferBarrierInfo info;
-                info.prevAccesses = passBarrier.beginStatus.accessFlag;
-                info.nextAccesses = passBarrier.endStatus.accessFlag;
-                const auto &range = ccstd::get<BufferRange>(passBarrier.beginStatus.range);
-                info.offset = range.offset;
-                info.size = range.size;
-                info.type = passBarrier.type;
-                passBarrier.barrier = gfx::Device::getInstance()->getBufferBarrier(info);
-            } else {
-                gfx::TextureBarrierInfo info;
-                info.prevAccesses = passBarrier.beginStatus.accessFlag;
-                info.nextAccesses = passBarrier.endStatus.accessFlag;
-                const auto &range = ccstd::get<TextureRange>(passBarrier.beginStatus.range);
-                info.baseMipLevel = range.mipLevel;
-                info.levelCount = range.levelCount;
-                info.baseSlice = range.firstSlice;
-                info.sliceCount = range.numSlices;
-                info.type = passBarrier.type;
-                passBarrier.barrier = gfx::Device::getInstance()->getTextureBarrier(info);
-            }
+            genGFXBarrierOf(passBarrier, resourceGraph);
         }
     };
 
@@ -1360,9 +1360,168 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
 
 #pragma endregion PASS_REORDER
 
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher) {
+#pragma region MEMORY_ALIASING
+
+uint64_t getResourceMemorySize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
+    }
+    const bool is3D = desc.dimension == ResourceDimension::TEXTURE3D;
+    const uint32_t depth = is3D ? std::max<uint32_t>(desc.depthOrArraySize, 1) : 1;
+    const uint32_t layers = is3D ? 1 : std::max<uint32_t>(desc.depthOrArraySize, 1);
+    const uint32_t mipLevels = std::max<uint32_t>(desc.mipLevels, 1);
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip != mipLevels; ++mip) {
+        size += gfx::formatSize(
+            desc.format,
+            std::max(desc.width >> mip, 1U),
+            std::max(desc.height >> mip, 1U),
+            std::max(depth >> mip, 1U));
+    }
+    return size * layers;
+}
+
+bool isAliasCompatible(const ResourceDesc &lhs, const ResourceDesc &rhs) {
+    return lhs.dimension == rhs.dimension &&
+           lhs.width == rhs.width &&
+           lhs.height == rhs.height &&
+           lhs.depthOrArraySize == rhs.depthOrArraySize &&
+           lhs.mipLevels == rhs.mipLevels &&
+           lhs.format == rhs.format &&
+           lhs.sampleCount == rhs.sampleCount &&
+           lhs.textureFlags == rhs.textureFlags &&
+           lhs.flags == rhs.flags;
 }
 
+bool isTransientResource(ResourceGraph::vertex_descriptor resID, const ResourceGraph &resourceGraph) {
+    const auto &traits = get(ResourceGraph::Traits, resourceGraph, resID);
+    if (traits.residency != ResourceResidency::MANAGED) {
+        return false;
+    }
+    return holds<ManagedTag>(resID, resourceGraph) ||
+           holds<ManagedBufferTag>(resID, resourceGraph) ||
+           holds<ManagedTextureTag>(resID, resourceGraph);
+}
+
+// gfx has no placed resources, so aliasing shares whole resources:
+// a transient resource borrows the memory of another transient resource
+// with an identical desc whose lifetime ended before its first use.
+void aliasTransientResources(FrameGraphDispatcher &fgDispatcher, ResourceAliasing &aliasing) {
+    auto &aliases = aliasing.resourceAliases;
+    auto &transitions = aliasing.aliasTransitions;
+    aliases.clear();
+    transitions.clear();
+    aliasing.transientMemorySize = 0;
+    aliasing.aliasedMemorySize = 0;
+    if (!fgDispatcher._enableMemoryAliasing) {
+        return;
+    }
+
+    auto *scratch = fgDispatcher.scratch;
+    const auto &graph = fgDispatcher.graph;
+    const auto &layoutGraph = fgDispatcher.layoutGraph;
+    const auto &resourceGraph = fgDispatcher.resourceGraph;
+    auto &relationGraph = fgDispatcher.relationGraph;
+    auto &rag = fgDispatcher.resourceAccessGraph;
+
+    if (!fgDispatcher._accessGraphBuilt) {
+        const Graphs graphs{resourceGraph, layoutGraph, rag, relationGraph};
+        buildAccessGraph(graph, graphs);
+        fgDispatcher._accessGraphBuilt = true;
+    }
+
+    struct ResourceLifetime {
+        ResourceGraph::vertex_descriptor resID{ResourceGraph::null_vertex()};
+        AccessVertex first{INVALID_ID};
+        AccessVertex last{INVALID_ID};
+        AccessStatus firstStatus;
+        AccessStatus lastStatus;
+    };
+
+    // passes are executed in access graph vertex order, culled passes have no status left.
+    PmrFlatMap<ResourceGraph::vertex_descriptor, ResourceLifetime> lifetimes(scratch);
+    for (const auto ragVert : makeRange(vertices(rag))) {
+        const auto &node = get(ResourceAccessGraph::AccessNode, rag, ragVert);
+        for (const auto &status : node.attachmentStatus) {
+            auto iter = lifetimes.find(status.vertID);
+            if (iter == lifetimes.end()) {
+                lifetimes.emplace(status.vertID, ResourceLifetime{status.vertID, ragVert, ragVert, status, status});
+            } else {
+                iter->second.last = ragVert;
+                iter->second.lastStatus = status;
+            }
+        }
+    }
+
+    ccstd::pmr::vector<ResourceLifetime> candidates(scratch);
+    candidates.reserve(lifetimes.size());
+    for (const auto &[resID, lifetime] : lifetimes) {
+        if (isTransientResource(resID, resourceGraph)) {
+            candidates.emplace_back(lifetime);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const ResourceLifetime &lhs, const ResourceLifetime &rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    struct MemorySlot {
+        ResourceGraph::vertex_descriptor ownerID{ResourceGraph::null_vertex()};
+        AccessVertex lastPass{INVALID_ID};
+        AccessStatus lastStatus;
+    };
+
+    ccstd::pmr::vector<MemorySlot> slots(scratch);
+    for (const auto &candidate : candidates) {
+        const auto &desc = get(ResourceGraph::Desc, resourceGraph, candidate.resID);
+        const auto size = getResourceMemorySize(desc);
+        aliasing.transientMemorySize += size;
+
+        auto iter = std::find_if(slots.begin(), slots.end(), [&](const MemorySlot &slot) {
+            return slot.lastPass < candidate.first &&
+                   holds<ManagedTag>(slot.ownerID, resourceGraph) == holds<ManagedTag>(candidate.resID, resourceGraph) &&
+                   holds<ManagedBufferTag>(slot.ownerID, resourceGraph) == holds<ManagedBufferTag>(candidate.resID, resourceGraph) &&
+                   isAliasCompatible(get(ResourceGraph::Desc, resourceGraph, slot.ownerID), desc);
+        });
+        if (iter == slots.end()) {
+            slots.emplace_back(MemorySlot{candidate.resID, candidate.last, candidate.lastStatus});
+            aliasing.aliasedMemorySize += size;
+            continue;
+        }
+        aliases.emplace(candidate.resID, iter->ownerID);
+        // in barrier status vertID is pass ID
+        auto lastStatus = iter->lastStatus;
+        lastStatus.vertID = iter->lastPass;
+        auto currStatus = candidate.firstStatus;
+        currStatus.vertID = candidate.first;
+        transitions.emplace_back(ResourceAliasTransition{
+            candidate.resID,
+            candidate.first,
+            lastStatus,
+            currStatus,
+        });
+        iter->lastPass = candidate.last;
+        iter->lastStatus = candidate.lastStatus;
+    }
+
+    // aliased resource reuses memory of a retired one, wait for its last access first.
+    auto &batchedBarriers = fgDispatcher.barrierMap;
+    for (const auto &transition : transitions) {
+        auto &frontBarriers = batchedBarriers[transition.passID].blockBarrier.frontBarriers;
+        auto &barrier = *frontBarriers.insert(
+            frontBarriers.begin(),
+            Barrier{
+                transition.resourceID,
+                gfx::BarrierType::FULL,
+                nullptr,
+                transition.lastStatus,
+                transition.currStatus,
+            });
+        genGFXBarrierOf(barrier, resourceGraph);
+    }
+}
+
+#pragma endregion MEMORY_ALIASING
+
 #pragma region assisstantFuncDefinition
 template <typename Graph>
 bool tryAddEdge(uint32_t srcVertex, uint32_t dstVertex, Graph &graph) {
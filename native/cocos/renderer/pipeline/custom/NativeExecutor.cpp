@@ -1,28 +1,32 @@
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include <variant>
+#include "FGDispatcherAliasing.h"
 #include "FGDispatcherGraphs.h"
 #include "GraphTypes.h"
 #include "GraphView.h"
 #include "GslUtils.h"
 #include "NativePipelineFwd.h"
 #include "NativePipelineTypes.h"
+#include "NativeRenderGraphCache.h"
+#include "NativeSceneCulling.h"
 #include "Pmr.h"
 #include "Range.h"
 #include "RenderCommonFwd.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
 #include "Set.h"
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/renderer/gfx-base/GFXBarrier.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "cocos/renderer/pipeline/InstancedBuffer.h"
-#include "cocos/renderer/pipeline/LODModelsUtil.h"
+#include "cocos/renderer/pipeline/PipelineSceneData.h"
+#include "cocos/renderer/pipeline/SoftwareOcclusionCulling.h"
+#include "cocos/scene/LODGroup.h"
 #include "cocos/scene/Model.h"
-#include "cocos/scene/Octree.h"
 #include "cocos/scene/Pass.h"
 #include "cocos/scene/RenderScene.h"
-#include "cocos/scene/Skybox.h"
 
 namespace cc {
 
@@ -37,6 +41,7 @@ struct RenderGraphVisitorContext {
         ResourceGraph& resgIn,
         const FrameGraphDispatcher& fgdIn,
         const FrameGraphDispatcher::BarrierMap& barrierMapIn,
+        const ResourceAliasing& aliasingIn,
         const ccstd::pmr::vector<bool>& validPassesIn,
         gfx::Device* deviceIn,
         cc::gfx::CommandBuffer* cmdBuffIn,
@@ -50,6 +55,7 @@ struct RenderGraphVisitorContext {
       resourceGraph(resgIn),
       fgd(fgdIn),
       barrierMap(barrierMapIn),
+      aliasing(aliasingIn),
       validPasses(validPassesIn),
       device(deviceIn),
       cmdBuff(cmdBuffIn),
@@ -62,6 +68,7 @@ struct RenderGraphVisitorContext {
     ResourceGraph& resourceGraph;
     const FrameGraphDispatcher& fgd;
     const FrameGraphDispatcher::BarrierMap& barrierMap;
+    const ResourceAliasing& aliasing;
     const ccstd::pmr::vector<bool>& validPasses;
     gfx::Device* device = nullptr;
     cc::gfx::CommandBuffer* cmdBuff = nullptr;
@@ -539,18 +546,28 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
     void end(const gfx::Viewport& pass) const {
     }
 
+    void mountResource(ResourceGraph::vertex_descriptor resID) const {
+        auto& resg = ctx.resourceGraph;
+        auto iter = ctx.aliasing.resourceAliases.find(resID);
+        if (iter != ctx.aliasing.resourceAliases.end()) {
+            mountAlias(resg, ctx.device, resID, iter->second);
+        } else {
+            resg.mount(ctx.device, resID);
+        }
+    }
+
     void mountResources(const RasterPass& pass) const {
         auto& resg = ctx.resourceGraph;
         // mount managed resources
         for (const auto& [name, view] : pass.rasterViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
     }
 
@@ -560,7 +577,7 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
     }
 
@@ -570,7 +587,7 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& [name, views] : pass.computeViews) {
             auto resID = findVertex(name, resg);
             CC_EXPECTS(resID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, resID);
+            mountResource(resID);
         }
     }
 
@@ -580,10 +597,10 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         for (const auto& pair : pass.copyPairs) {
             const auto& srcID = findVertex(pair.source, resg);
             CC_EXPECTS(srcID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, srcID);
+            mountResource(srcID);
             const auto& dstID = findVertex(pair.target, resg);
             CC_EXPECTS(dstID != ResourceGraph::null_vertex());
-            resg.mount(ctx.device, dstID);
+            mountResource(dstID);
         }
     }
 
@@ -735,176 +752,15 @@ struct CommandSubmitter {
     gfx::CommandBuffer* primaryCommandBuffer = nullptr;
 };
 
-bool isNodeVisible(const scene::Model& model, const uint32_t visibility) {
-    const auto* const node = model.getNode();
-    CC_EXPECTS(node);
-    return model.getNode() && ((visibility & node->getLayer()) == node->getLayer());
-}
-
-bool isInstanceVisible(const scene::Model& model, const uint32_t visibility) {
-    return isNodeVisible(model, visibility) ||
-           (visibility & static_cast<uint32_t>(model.getVisFlags()));
-}
-
-bool isPointInstanceAndNotSkybox(const scene::Model& model, const scene::Skybox* skyBox) {
-    const auto* modelWorldBounds = model.getWorldBounds();
-    return !modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != &model);
-}
-
-bool isPointInstance(const scene::Model& model) {
-    return !model.getWorldBounds();
-}
-
-void addShadowCastObject() {
-    // csmLayers->addCastShadowObject(genRenderObject(model, camera));
-    // csmLayers->addLayerObject(genRenderObject(model, camera));
-}
-
-bool isTransparent(const scene::Pass& pass) {
-    bool bBlend = false;
-    for (const auto& target : pass.getBlendState()->targets) {
-        if (target.blend) {
-            bBlend = true;
-        }
-    }
-    return bBlend;
-}
-
-float computeSortingDepth(const scene::Camera& camera, const scene::Model& model) {
-    float depth = 0;
-    if (model.getNode()) {
-        const auto* node = model.getTransform();
-        cc::Vec3 position;
-        cc::Vec3::subtract(node->getWorldPosition(), camera.getPosition(), &position);
-        depth = position.dot(camera.getForward());
-    }
-    return depth;
-}
-
-void addRenderObject(
-    const scene::Camera& camera, const scene::Model& model, NativeRenderQueue& queue) {
-    const bool bDrawTransparent = any(queue.sceneFlags & SceneFlags::TRANSPARENT_OBJECT);
-    bool bDrawOpaqueOrCutout = any(queue.sceneFlags & (SceneFlags::OPAQUE_OBJECT | SceneFlags::CUTOUT_OBJECT));
-    if (!bDrawTransparent && !bDrawOpaqueOrCutout) {
-        bDrawOpaqueOrCutout = true;
-    }
-
-    const auto& subModels = model.getSubModels();
-    const auto subModelCount = subModels.size();
-    for (uint32_t subModelIdx = 0; subModelIdx < subModelCount; ++subModelIdx) {
-        const auto& subModel = subModels[subModelIdx];
-        const auto& passes = subModel->getPasses();
-        const auto passCount = passes.size();
-        for (uint32_t passIdx = 0; passIdx < passCount; ++passIdx) {
-            auto& pass = *passes[passIdx];
-            const bool bTransparent = isTransparent(pass);
-            const bool bOpaqueOrCutout = !bTransparent;
-
-            if (!bDrawTransparent && bTransparent) {
-                // skip transparent object
-                continue;
-            }
-
-            if (!bDrawOpaqueOrCutout && bOpaqueOrCutout) {
-                // skip opaque object
-                continue;
-            }
-
-            if (pass.getBatchingScheme() == scene::BatchingSchemes::INSTANCING) {
-                auto& instancedBuffer = *pass.getInstancedBuffer();
-                instancedBuffer.merge(subModel, passIdx);
-                if (bTransparent) {
-                    queue.transparentInstancingQueue.add(instancedBuffer);
-                } else {
-                    queue.opaqueInstancingQueue.add(instancedBuffer);
-                }
-            } else {
-                const float depth = computeSortingDepth(camera, model);
-                if (bTransparent) {
-                    queue.transparentQueue.add(model, depth, subModelIdx, passIdx);
-                } else {
-                    queue.opaqueQueue.add(model, depth, subModelIdx, passIdx);
-                }
-            }
-        }
-    }
-}
-
-void octreeCulling(
-    const scene::Octree* octree,
-    const scene::RenderScene* scene,
-    const scene::Skybox* skyBox,
-    const scene::Camera& camera,
-    NativeRenderQueue& queue) {
-    // add special instances
-    for (const auto& pModel : scene->getModels()) {
-        CC_EXPECTS(pModel);
-        const auto& model = *pModel;
-        // filter model by view visibility
-        if (!model.isEnabled()) {
-            continue;
-        }
-        if (pipeline::LODModelsCachedUtils::isLODModelCulled(&model)) {
-            continue;
-        }
-        if (any(queue.sceneFlags & SceneFlags::SHADOW_CASTER) && model.isCastShadow()) {
-            addShadowCastObject();
-        }
-        const auto visibility = camera.getVisibility();
-        if (isInstanceVisible(model, visibility) && isPointInstanceAndNotSkybox(model, skyBox)) {
-            addRenderObject(camera, model, queue);
-        }
-    }
-
-    // add plain instances
-    ccstd::vector<scene::Model*> models;
-    models.reserve(scene->getModels().size() / 4);
-    octree->queryVisibility(&camera, camera.getFrustum(), false, models);
-    for (const auto& pModel : models) {
-        const auto& model = *pModel;
-        CC_EXPECTS(!isPointInstance(model));
-        if (pipeline::LODModelsCachedUtils::isLODModelCulled(&model)) {
-            continue;
-        }
-        addRenderObject(camera, model, queue);
-    }
-}
-
-void frustumCulling(
-    const scene::RenderScene* scene,
-    const scene::Camera& camera,
-    NativeRenderQueue& queue) {
-    const auto& models = scene->getModels();
-    for (const auto& pModel : models) {
-        CC_EXPECTS(pModel);
-        const auto& model = *pModel;
-        if (!model.isEnabled()) {
-            continue;
-        }
-        // filter model by view visibility
-        if (pipeline::LODModelsCachedUtils::isLODModelCulled(&model)) {
-            continue;
-        }
-        const auto visibility = camera.getVisibility();
-        const auto* const node = model.getNode();
-
-        // cast shadow render Object
-        if (any(queue.sceneFlags & SceneFlags::SHADOW_CASTER) && model.isCastShadow()) {
-            addShadowCastObject();
-        }
-
-        // add render objects
-        if (isInstanceVisible(model, visibility)) {
-            const auto* modelWorldBounds = model.getWorldBounds();
-            // object has no volume
-            if (!modelWorldBounds) {
-                addRenderObject(camera, model, queue);
-                continue;
-            }
-            // frustum culling
-            if (modelWorldBounds->aabbFrustum(camera.getFrustum())) {
-                addRenderObject(camera, model, queue);
-            }
+// the draws are sorted already, a queue filled by an earlier camera pass has to be sorted again
+void appendSortedDraws(const RenderDrawQueue& draws, RenderDrawQueue& queue, bool bTransparent) {
+    const bool bSorted = queue.instances.empty();
+    queue.instances.insert(queue.instances.end(), draws.instances.begin(), draws.instances.end());
+    if (!bSorted) {
+        if (bTransparent) {
+            queue.sortTransparent();
+        } else {
+            queue.sortOpaqueOrCutout();
         }
     }
 }
@@ -914,7 +770,8 @@ void mergeSceneFlags(
     ccstd::pmr::unordered_map<
         const scene::RenderScene*,
         ccstd::pmr::unordered_map<scene::Camera*, NativeRenderQueue>>&
-        sceneQueues) {
+        sceneQueues,
+    ccstd::pmr::vector<std::pair<const scene::RenderScene*, scene::Camera*>>& cameras) {
     for (const auto vertID : makeRange(vertices(rg))) {
         if (!holds<SceneTag>(vertID, rg)) {
             continue;
@@ -922,7 +779,12 @@ void mergeSceneFlags(
         const auto& sceneData = get(SceneTag{}, vertID, rg);
         const auto* scene = sceneData.camera->getScene();
         if (scene) {
-            sceneQueues[scene][sceneData.camera].sceneFlags |= sceneData.flags;
+            auto& queues = sceneQueues[scene];
+            if (queues.find(sceneData.camera) == queues.end()) {
+                // keep render graph order, queues are built deterministically
+                cameras.emplace_back(scene, sceneData.camera);
+            }
+            queues[sceneData.camera].sceneFlags |= sceneData.flags;
         }
     }
 }
@@ -939,32 +801,60 @@ void extendResourceLifetime(const NativeRenderQueue& queue, ResourceGroup& group
 
 void buildRenderQueues(
     NativeRenderContext& context,
+    pipeline::SoftwareOcclusionCulling& occlusionCulling,
+    const ccstd::pmr::vector<std::pair<const scene::RenderScene*, scene::Camera*>>& cameras,
     ccstd::pmr::unordered_map<
         const scene::RenderScene*,
         ccstd::pmr::unordered_map<scene::Camera*, NativeRenderQueue>>& sceneQueues) {
-    const scene::Skybox* skyBox = nullptr;
-
     auto& group = context.resourceGroups[context.nextFenceValue];
 
-    for (auto&& [scene, queues] : sceneQueues) {
-        const scene::Octree* octree = scene->getOctree();
-        for (auto&& [camera, queue] : queues) {
-            CC_EXPECTS(camera);
-            if (!camera->isCullingEnabled()) {
-                continue;
+    ccstd::pmr::vector<CameraCullingTask> tasks(sceneQueues.get_allocator().resource());
+    tasks.reserve(cameras.size());
+    for (const auto& [scene, camera] : cameras) {
+        CC_EXPECTS(camera);
+        if (!camera->isCullingEnabled()) {
+            continue;
+        }
+        auto& task = tasks.emplace_back();
+        task.scene = scene;
+        task.camera = camera;
+        task.queue = &sceneQueues.at(scene).at(camera);
+    }
+
+    // LOD selection and sorting depth read world transforms, which update lazily, flush them before going wide
+    for (const auto& [scene, queues] : sceneQueues) {
+        for (const auto& lodGroup : scene->getLODGroups()) {
+            if (auto* node = lodGroup->getNode()) {
+                node->updateWorldTransform();
             }
-            pipeline::LODModelsCachedUtils::updateCachedLODModels(scene, camera);
-            if (octree && octree->isEnabled()) {
-                octreeCulling(octree, scene, skyBox, *camera, queue);
-            } else {
-                frustumCulling(scene, *camera, queue);
+        }
+        for (const auto& model : scene->getModels()) {
+            if (auto* node = model->getTransform()) {
+                node->updateWorldTransform();
             }
-            pipeline::LODModelsCachedUtils::clearCachedLODModels();
+        }
+    }
+
+    cullCameras(tasks, occlusionCulling, JobSystem::getInstance());
 
-            queue.sort();
+    // merge in render graph order
+    for (auto& task : tasks) {
+        auto& queue = *task.queue;
+        appendSortedDraws(task.opaqueDraws, queue.opaqueQueue, false);
+        appendSortedDraws(task.transparentDraws, queue.transparentQueue, true);
 
-            extendResourceLifetime(queue, group);
+        for (const auto& instance : task.pendingInstances) {
+            instance.instancedBuffer->merge(instance.subModel, instance.passIndex);
+            if (instance.bTransparent) {
+                queue.transparentInstancingQueue.add(*instance.instancedBuffer);
+            } else {
+                queue.opaqueInstancingQueue.add(*instance.instancedBuffer);
+            }
         }
+        queue.opaqueInstancingQueue.sort();
+        queue.transparentInstancingQueue.sort();
+
+        extendResourceLifetime(queue, group);
     }
 }
 
@@ -979,18 +869,26 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     RenderGraphContextCleaner contextCleaner(ppl.nativeContext);
     ResourceCleaner cleaner(ppl.resourceGraph);
 
-    FrameGraphDispatcher fgd(
-        ppl.resourceGraph, rg,
-        ppl.layoutGraph, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
-    fgd.setParalellWeight(0);
-    fgd.run();
-
+    // graph topology rarely changes, reuse barriers, aliasing and culling results
     AddressableView<RenderGraph> graphView(rg);
-    ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
     auto colors = rg.colors(scratch);
-    { // Mark all culled vertices
+    const auto graphHash = hashRenderGraph(rg, ppl.resourceGraph);
+    auto* compiledGraph = getCompiledRenderGraph(ppl);
+    if (!compiledGraph || !compiledGraph->isValid(rg, ppl.resourceGraph, graphHash)) {
+        auto& compiled = resetCompiledRenderGraph(ppl, rg);
+        compiled.graphHash = graphHash;
+        compiledGraph = &compiled;
+
+        auto& fgd = compiled.fgd;
+        fgd.enableMemoryAliasing(true);
+        fgd.enablePassReorder(false);
+        fgd.setParalellWeight(0);
+        fgd.run();
+        aliasTransientResources(fgd, compiled.aliasing);
+
+        // Mark all culled vertices
+        auto& validPasses = compiled.validPasses;
+        validPasses.assign(num_vertices(rg), true);
         RenderGraphCullVisitor visitor{{}, validPasses};
         for (const auto& vertID : fgd.resourceAccessGraph.culledPasses) {
             const auto passID = get(ResourceAccessGraph::PassID, fgd.resourceAccessGraph, vertID);
@@ -1001,7 +899,13 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
         }
         colors.clear();
         colors.resize(num_vertices(rg), boost::white_color);
+
+        // framebuffers might refer to resized or aliased resources
+        ppl.nativeContext.renderPasses.clear();
     }
+    const auto& fgd = compiledGraph->fgd;
+    const auto& aliasing = compiledGraph->aliasing;
+    const auto& validPasses = compiledGraph->validPasses;
 
     // scene culling
     ccstd::pmr::unordered_map<
@@ -1009,8 +913,9 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
         ccstd::pmr::unordered_map<scene::Camera*, NativeRenderQueue>>
         sceneQueues(scratch);
     {
-        mergeSceneFlags(rg, sceneQueues);
-        buildRenderQueues(ppl.nativeContext, sceneQueues);
+        ccstd::pmr::vector<std::pair<const scene::RenderScene*, scene::Camera*>> cameras(scratch);
+        mergeSceneFlags(rg, sceneQueues, cameras);
+        buildRenderQueues(ppl.nativeContext, *ppl.pipelineSceneData->getSoftwareOcclusionCulling(), cameras, sceneQueues);
     }
 
     // Execute all valid passes
@@ -1034,6 +939,7 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
         RenderGraphVisitorContext ctx(
             ppl.nativeContext, rg, ppl.resourceGraph,
             fgd, fgd.barrierMap,
+            aliasing,
             validPasses,
             ppl.device, submit.primaryCommandBuffer,
             sceneQueues,
@@ -1042,6 +948,11 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
 
         RenderGraphVisitor visitor{{}, ctx};
         boost::depth_first_search(fg, visitor, get(colors, rg));
+
+        // aliased resources only borrow memory for this frame
+        for (const auto& [resID, ownerID] : aliasing.resourceAliases) {
+            unmountAlias(ppl.resourceGraph, resID);
+        }
     }
 }
 
@@ -38,6 +38,7 @@
 #include "LayoutGraphTypes.h"
 #include "NativePipelineFwd.h"
 #include "NativePipelineTypes.h"
+#include "NativeRenderGraphCache.h"
 #include "Pmr.h"
 #include "Range.h"
 #include "RenderCommonTypes.h"
@@ -416,12 +417,14 @@ bool NativePipeline::destroy() noexcept {
         pipelineSceneData->destroy();
         pipelineSceneData = {};
     }
+    releaseCompiledRenderGraph(*this);
 
     return true;
 }
 
 void NativePipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     std::ignore = cameras;
+    pipeline::InstancedBuffer::beginFrame();
     const auto *sceneData = pipelineSceneData.get();
     auto *commandBuffer = device->getCommandBuffer();
 
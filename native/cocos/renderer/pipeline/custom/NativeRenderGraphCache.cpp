@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include "NativePipelineTypes.h"
+#include "NativeRenderGraphCache.h"
+#include "Range.h"
+#include "RenderGraphGraphs.h"
+#include "cocos/base/std/container/unordered_map.h"
+#include "cocos/base/std/hash/hash.h"
+
+namespace cc {
+
+namespace render {
+
+namespace {
+
+ccstd::unordered_map<const NativePipeline*, std::unique_ptr<CompiledRenderGraph>> sCompiledRenderGraphs;
+
+} // namespace
+
+CompiledRenderGraph::CompiledRenderGraph(ResourceGraph& resourceGraphIn, const RenderGraph& graphIn, LayoutGraphData& layoutGraphIn, boost::container::pmr::memory_resource* scratchIn, const allocator_type& alloc) noexcept
+: numPasses(static_cast<uint32_t>(num_vertices(graphIn))),
+  numResources(static_cast<uint32_t>(num_vertices(resourceGraphIn))),
+  fgd(resourceGraphIn, graphIn, layoutGraphIn, scratchIn, alloc),
+  aliasing(alloc),
+  validPasses(alloc) {}
+
+bool CompiledRenderGraph::isValid(const RenderGraph& rg, const ResourceGraph& resg, ccstd::hash_t hash) const noexcept {
+    return graphHash == hash &&
+           &fgd.graph == &rg && &fgd.resourceGraph == &resg &&
+           numPasses == num_vertices(rg) &&
+           numResources == num_vertices(resg);
+}
+
+// Structural hash of the render graph and the resources it refers to.
+// Everything the FrameGraphDispatcher depends on must be hashed here,
+// per-frame data (scenes, cameras, constants, clear values) must not.
+ccstd::hash_t hashRenderGraph(const RenderGraph& rg, const ResourceGraph& resg) {
+    ccstd::hash_t seed = 0;
+    ccstd::hash_combine(seed, num_vertices(rg));
+    for (const auto vertID : makeRange(vertices(rg))) {
+        ccstd::hash_combine(seed, tag(vertID, rg).index());
+        ccstd::hash_combine(seed, parent(vertID, rg));
+        ccstd::hash_combine(seed, get(RenderGraph::Layout, rg, vertID));
+        visitObject(
+            vertID, rg,
+            [&](const RasterPass& pass) {
+                ccstd::hash_combine(seed, pass);
+            },
+            [&](const ComputePass& pass) {
+                ccstd::hash_combine(seed, pass.computeViews);
+            },
+            [&](const CopyPass& pass) {
+                for (const auto& pair : pass.copyPairs) {
+                    ccstd::hash_combine(seed, pair.source);
+                    ccstd::hash_combine(seed, pair.target);
+                }
+            },
+            [&](const MovePass& pass) {
+                for (const auto& pair : pass.movePairs) {
+                    ccstd::hash_combine(seed, pair.source);
+                    ccstd::hash_combine(seed, pair.target);
+                }
+            },
+            [&](const RaytracePass& pass) {
+                ccstd::hash_combine(seed, pass.computeViews);
+            },
+            [&](const PresentPass& pass) {
+                for (const auto& [name, present] : pass.presents) {
+                    ccstd::hash_combine(seed, name);
+                }
+            },
+            [&](const auto& /*queue*/) {
+                // not used by dispatcher
+            });
+    }
+
+    // resized or replaced resources invalidate barriers, aliasing and framebuffers
+    ccstd::hash_combine(seed, num_vertices(resg));
+    for (const auto resID : makeRange(vertices(resg))) {
+        const auto& desc = get(ResourceGraph::Desc, resg, resID);
+        ccstd::hash_combine(seed, static_cast<uint32_t>(desc.dimension));
+        ccstd::hash_combine(seed, desc.width);
+        ccstd::hash_combine(seed, desc.height);
+        ccstd::hash_combine(seed, desc.depthOrArraySize);
+        ccstd::hash_combine(seed, desc.mipLevels);
+        ccstd::hash_combine(seed, static_cast<uint32_t>(desc.format));
+        ccstd::hash_combine(seed, static_cast<uint32_t>(desc.sampleCount));
+        ccstd::hash_combine(seed, static_cast<uint32_t>(desc.textureFlags));
+        ccstd::hash_combine(seed, static_cast<uint32_t>(desc.flags));
+        ccstd::hash_combine(seed, static_cast<uint32_t>(get(ResourceGraph::Traits, resg, resID).residency));
+        visitObject(
+            resID, resg,
+            [&](const IntrusivePtr<gfx::Buffer>& buffer) {
+                ccstd::hash_combine(seed, buffer.get());
+            },
+            [&](const IntrusivePtr<gfx::Texture>& texture) {
+                ccstd::hash_combine(seed, texture.get());
+            },
+            [&](const IntrusivePtr<gfx::Framebuffer>& fb) {
+                ccstd::hash_combine(seed, fb.get());
+            },
+            [&](const RenderSwapchain& sc) {
+                ccstd::hash_combine(seed, sc.swapchain);
+            },
+            [&](const auto& /*managed*/) {
+                // created on demand, identified by desc
+            });
+    }
+    return seed;
+}
+
+CompiledRenderGraph* getCompiledRenderGraph(const NativePipeline& ppl) noexcept {
+    auto iter = sCompiledRenderGraphs.find(&ppl);
+    return iter != sCompiledRenderGraphs.end() ? iter->second.get() : nullptr;
+}
+
+CompiledRenderGraph& resetCompiledRenderGraph(NativePipeline& ppl, const RenderGraph& rg) {
+    auto& compiled = sCompiledRenderGraphs[&ppl];
+    compiled.reset();
+    compiled = std::make_unique<CompiledRenderGraph>(
+        ppl.resourceGraph, rg,
+        ppl.layoutGraph, &ppl.unsyncPool, ppl.get_allocator());
+    return *compiled;
+}
+
+void releaseCompiledRenderGraph(const NativePipeline& ppl) noexcept {
+    sCompiledRenderGraphs.erase(&ppl);
+}
+
+} // namespace render
+
+} // namespace cc
@@ -0,0 +1,71 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "cocos/base/std/hash/hash_fwd.hpp"
+#include "cocos/renderer/pipeline/custom/FGDispatcherAliasing.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
+
+namespace cc {
+
+namespace render {
+
+// Dispatch results of a render graph, reused while its structure doesn't change.
+struct CompiledRenderGraph {
+    using allocator_type = boost::container::pmr::polymorphic_allocator<char>;
+    allocator_type get_allocator() const noexcept { // NOLINT
+        return {validPasses.get_allocator().resource()};
+    }
+
+    CompiledRenderGraph(ResourceGraph& resourceGraphIn, const RenderGraph& graphIn, LayoutGraphData& layoutGraphIn, boost::container::pmr::memory_resource* scratchIn, const allocator_type& alloc) noexcept;
+    CompiledRenderGraph(CompiledRenderGraph&& rhs) = delete;
+    CompiledRenderGraph(CompiledRenderGraph const& rhs) = delete;
+    CompiledRenderGraph& operator=(CompiledRenderGraph&& rhs) = delete;
+    CompiledRenderGraph& operator=(CompiledRenderGraph const& rhs) = delete;
+
+    // the cached results only hold for the graph objects and the structure they were compiled from,
+    // the vertex counts are checked as well so that a hash collision cannot index past the compiled passes
+    bool isValid(const RenderGraph& rg, const ResourceGraph& resg, ccstd::hash_t hash) const noexcept;
+
+    ccstd::hash_t graphHash{0};
+    uint32_t numPasses{0};    // num_vertices of the render graph at compile time
+    uint32_t numResources{0}; // num_vertices of the resource graph at compile time
+    FrameGraphDispatcher fgd;
+    ResourceAliasing aliasing;
+    ccstd::pmr::vector<bool> validPasses;
+};
+
+// Structural hash of the render graph and the resources it refers to, see CompiledRenderGraph::isValid.
+ccstd::hash_t hashRenderGraph(const RenderGraph& rg, const ResourceGraph& resg);
+
+// NativePipeline is generated, so its compiled render graph is kept aside, one per pipeline.
+CompiledRenderGraph* getCompiledRenderGraph(const NativePipeline& ppl) noexcept;
+CompiledRenderGraph& resetCompiledRenderGraph(NativePipeline& ppl, const RenderGraph& rg);
+void releaseCompiledRenderGraph(const NativePipeline& ppl) noexcept;
+
+} // namespace render
+
+} // namespace cc
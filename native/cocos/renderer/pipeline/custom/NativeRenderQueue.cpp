@@ -68,7 +68,7 @@ void RenderInstancingQueue::sort() {
 }
 
 void RenderInstancingQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) const {
-    for (const auto *instanceBuffer : batches) {
+    for (auto *instanceBuffer : batches) {
         if (instanceBuffer->hasPendingModels()) {
             instanceBuffer->uploadBuffers(cmdBuffer);
         }
@@ -106,7 +106,11 @@ void RenderInstancingQueue::recordCommandBuffer(
                 cmdBuffer->bindDescriptorSet(pipeline::localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
             }
             cmdBuffer->bindInputAssembler(instance.ia);
-            cmdBuffer->draw(instance.ia);
+            if (instance.indirectBuffer) {
+                cmdBuffer->drawIndirect(instance.indirectBuffer, 0, static_cast<uint32_t>(instance.draws.size()));
+            } else {
+                cmdBuffer->draw(instance.ia);
+            }
         }
     }
 }
@@ -23,6 +23,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include "FGDispatcherAliasing.h"
 #include "NativePipelineTypes.h"
 #include "Range.h"
 #include "RenderGraphGraphs.h"
@@ -203,6 +204,58 @@ void ResourceGraph::unmount(uint64_t completedFenceValue) {
     }
 }
 
+void mountAlias(ResourceGraph& resg, gfx::Device* device, ResourceGraph::vertex_descriptor vertID, ResourceGraph::vertex_descriptor ownerID) {
+    resg.mount(device, ownerID);
+    visitObject(
+        vertID, resg,
+        [&](const ManagedResource& resource) {
+            // to be removed
+        },
+        [&](ManagedBuffer& buffer) {
+            const auto& owner = get(ManagedBufferTag{}, ownerID, resg);
+            buffer.buffer = owner.buffer;
+            CC_ENSURES(buffer.buffer);
+            buffer.fenceValue = resg.nextFenceValue;
+        },
+        [&](ManagedTexture& texture) {
+            const auto& owner = get(ManagedTextureTag{}, ownerID, resg);
+            texture.texture = owner.texture;
+            CC_ENSURES(texture.texture);
+            texture.fenceValue = resg.nextFenceValue;
+        },
+        [&](const IntrusivePtr<gfx::Buffer>& pass) {
+        },
+        [&](const IntrusivePtr<gfx::Texture>& pass) {
+        },
+        [&](const IntrusivePtr<gfx::Framebuffer>& pass) {
+        },
+        [&](const RenderSwapchain& queue) {
+        });
+}
+
+void unmountAlias(ResourceGraph& resg, ResourceGraph::vertex_descriptor vertID) {
+    // memory is owned by the alias owner, aliasing might change next frame
+    visitObject(
+        vertID, resg,
+        [&](const ManagedResource& resource) {
+            // to be removed
+        },
+        [&](ManagedBuffer& buffer) {
+            buffer.buffer.reset();
+        },
+        [&](ManagedTexture& texture) {
+            texture.texture.reset();
+        },
+        [&](const IntrusivePtr<gfx::Buffer>& pass) {
+        },
+        [&](const IntrusivePtr<gfx::Texture>& pass) {
+        },
+        [&](const IntrusivePtr<gfx::Framebuffer>& pass) {
+        },
+        [&](const RenderSwapchain& queue) {
+        });
+}
+
 } // namespace render
 
 } // namespace cc
@@ -0,0 +1,273 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "NativeSceneCulling.h"
+#include "GslUtils.h"
+#include "cocos/renderer/pipeline/InstancedBuffer.h"
+#include "cocos/renderer/pipeline/SoftwareOcclusionCulling.h"
+#include "cocos/scene/Camera.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Octree.h"
+#include "cocos/scene/Pass.h"
+#include "cocos/scene/RenderScene.h"
+#include "cocos/scene/Skybox.h"
+
+namespace cc {
+
+namespace render {
+
+namespace {
+
+bool isNodeVisible(const scene::Model& model, const uint32_t visibility) {
+    const auto* const node = model.getNode();
+    CC_EXPECTS(node);
+    return model.getNode() && ((visibility & node->getLayer()) == node->getLayer());
+}
+
+bool isInstanceVisible(const scene::Model& model, const uint32_t visibility) {
+    return isNodeVisible(model, visibility) ||
+           (visibility & static_cast<uint32_t>(model.getVisFlags()));
+}
+
+bool isPointInstanceAndNotSkybox(const scene::Model& model, const scene::Skybox* skyBox) {
+    const auto* modelWorldBounds = model.getWorldBounds();
+    return !modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != &model);
+}
+
+bool isPointInstance(const scene::Model& model) {
+    return !model.getWorldBounds();
+}
+
+void addShadowCastObject() {
+    // csmLayers->addCastShadowObject(genRenderObject(model, camera));
+    // csmLayers->addLayerObject(genRenderObject(model, camera));
+}
+
+bool isTransparent(const scene::Pass& pass) {
+    bool bBlend = false;
+    for (const auto& target : pass.getBlendState()->targets) {
+        if (target.blend) {
+            bBlend = true;
+        }
+    }
+    return bBlend;
+}
+
+float computeSortingDepth(const scene::Camera& camera, const scene::Model& model) {
+    float depth = 0;
+    if (model.getNode()) {
+        const auto* node = model.getTransform();
+        cc::Vec3 position;
+        cc::Vec3::subtract(node->getWorldPosition(), camera.getPosition(), &position);
+        depth = position.dot(camera.getForward());
+    }
+    return depth;
+}
+
+void addRenderObject(const scene::Model& model, CameraCullingTask& task) {
+    const auto& camera = *task.camera;
+    const auto& queue = *task.queue;
+    const bool bDrawTransparent = any(queue.sceneFlags & SceneFlags::TRANSPARENT_OBJECT);
+    bool bDrawOpaqueOrCutout = any(queue.sceneFlags & (SceneFlags::OPAQUE_OBJECT | SceneFlags::CUTOUT_OBJECT));
+    if (!bDrawTransparent && !bDrawOpaqueOrCutout) {
+        bDrawOpaqueOrCutout = true;
+    }
+
+    task.visibleModels.emplace_back(&model);
+
+    const auto& subModels = model.getSubModels();
+    const auto subModelCount = subModels.size();
+    for (uint32_t subModelIdx = 0; subModelIdx < subModelCount; ++subModelIdx) {
+        const auto& subModel = subModels[subModelIdx];
+        const auto& passes = subModel->getPasses();
+        const auto passCount = passes.size();
+        for (uint32_t passIdx = 0; passIdx < passCount; ++passIdx) {
+            auto& pass = *passes[passIdx];
+            const bool bTransparent = isTransparent(pass);
+            const bool bOpaqueOrCutout = !bTransparent;
+
+            if (!bDrawTransparent && bTransparent) {
+                // skip transparent object
+                continue;
+            }
+
+            if (!bDrawOpaqueOrCutout && bOpaqueOrCutout) {
+                // skip opaque object
+                continue;
+            }
+
+            if (!subModel->getShader(passIdx)) {
+                // shader variant still compiling
+                continue;
+            }
+
+            if (pass.getBatchingScheme() == scene::BatchingSchemes::INSTANCING) {
+                task.pendingInstances.emplace_back(PendingInstance{
+                    pass.getInstancedBuffer(), subModel.get(), passIdx, bTransparent});
+            } else {
+                const float depth = computeSortingDepth(camera, model);
+                if (bTransparent) {
+                    task.transparentDraws.add(model, depth, subModelIdx, passIdx);
+                } else {
+                    task.opaqueDraws.add(model, depth, subModelIdx, passIdx);
+                }
+            }
+        }
+    }
+}
+
+void octreeCulling(
+    const scene::Octree* octree,
+    const scene::Skybox* skyBox,
+    pipeline::SoftwareOcclusionCulling* occlusionCulling,
+    CameraCullingTask& task) {
+    const auto& camera = *task.camera;
+    const auto& queue = *task.queue;
+    // add special instances
+    for (const auto& pModel : task.scene->getModels()) {
+        CC_EXPECTS(pModel);
+        const auto& model = *pModel;
+        // filter model by view visibility
+        if (!model.isEnabled()) {
+            continue;
+        }
+        if (task.lodCache.isLODModelCulled(&model)) {
+            continue;
+        }
+        if (any(queue.sceneFlags & SceneFlags::SHADOW_CASTER) && model.isCastShadow()) {
+            addShadowCastObject();
+        }
+        const auto visibility = camera.getVisibility();
+        if (isInstanceVisible(model, visibility) && isPointInstanceAndNotSkybox(model, skyBox)) {
+            addRenderObject(model, task);
+        }
+    }
+
+    // add plain instances
+    ccstd::vector<scene::Model*> models;
+    models.reserve(task.scene->getModels().size() / 4);
+    octree->queryVisibility(&camera, camera.getFrustum(), false, models);
+    for (const auto& pModel : models) {
+        const auto& model = *pModel;
+        CC_EXPECTS(!isPointInstance(model));
+        if (task.lodCache.isLODModelCulled(&model)) {
+            continue;
+        }
+        if (occlusionCulling && occlusionCulling->isOccluded(model)) {
+            continue;
+        }
+        addRenderObject(model, task);
+    }
+}
+
+void frustumCulling(
+    pipeline::SoftwareOcclusionCulling* occlusionCulling,
+    CameraCullingTask& task) {
+    const auto& camera = *task.camera;
+    const auto& queue = *task.queue;
+    const auto& models = task.scene->getModels();
+    for (const auto& pModel : models) {
+        CC_EXPECTS(pModel);
+        const auto& model = *pModel;
+        if (!model.isEnabled()) {
+            continue;
+        }
+        // filter model by view visibility
+        if (task.lodCache.isLODModelCulled(&model)) {
+            continue;
+        }
+        const auto visibility = camera.getVisibility();
+        const auto* const node = model.getNode();
+
+        // cast shadow render Object
+        if (any(queue.sceneFlags & SceneFlags::SHADOW_CASTER) && model.isCastShadow()) {
+            addShadowCastObject();
+        }
+
+        // add render objects
+        if (isInstanceVisible(model, visibility)) {
+            const auto* modelWorldBounds = model.getWorldBounds();
+            // object has no volume
+            if (!modelWorldBounds) {
+                addRenderObject(model, task);
+                continue;
+            }
+            // frustum culling
+            if (!modelWorldBounds->aabbFrustum(camera.getFrustum())) {
+                continue;
+            }
+            // occlusion culling
+            if (occlusionCulling && occlusionCulling->isOccluded(model)) {
+                continue;
+            }
+            addRenderObject(model, task);
+        }
+    }
+}
+
+void cullCamera(CameraCullingTask& task, pipeline::SoftwareOcclusionCulling* occlusionCulling) {
+    const scene::Skybox* skyBox = nullptr;
+    const scene::Octree* octree = task.scene->getOctree();
+
+    task.lodCache.update(task.scene, task.camera);
+    if (octree && octree->isEnabled()) {
+        octreeCulling(octree, skyBox, occlusionCulling, task);
+    } else {
+        frustumCulling(occlusionCulling, task);
+    }
+    task.lodCache.clear();
+
+    task.opaqueDraws.sortOpaqueOrCutout();
+    task.transparentDraws.sortTransparent();
+}
+
+} // namespace
+
+void cullCameras(ccstd::pmr::vector<CameraCullingTask>& tasks, pipeline::SoftwareOcclusionCulling& occlusionCulling, JobSystem* jobSystem) {
+    const auto taskCount = static_cast<uint32_t>(tasks.size());
+    if (occlusionCulling.isEnabled() || taskCount < 2) {
+        // occlusion culling rasterizes into a single depth buffer, cull cameras one by one
+        for (auto& task : tasks) {
+            auto* occlusion = occlusionCulling.prepare(task.camera) ? &occlusionCulling : nullptr;
+            cullCamera(task, occlusion);
+            if (occlusion) {
+                occlusion->finish();
+            }
+        }
+        return;
+    }
+
+    JobGraph g(jobSystem);
+    g.createForEachIndexJob(1U, taskCount, 1U, [&tasks](uint32_t i) {
+        cullCamera(tasks[i], nullptr);
+    });
+    g.run();
+    cullCamera(tasks[0], nullptr);
+    g.waitForAll();
+}
+
+} // namespace render
+
+} // namespace cc
@@ -0,0 +1,71 @@
+/****************************************************************************
+ Copyright (c) 2021-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "cocos/base/job-system/JobSystem.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/pipeline/LODModelsUtil.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineTypes.h"
+
+namespace cc {
+
+namespace pipeline {
+class InstancedBuffer;
+class SoftwareOcclusionCulling;
+} // namespace pipeline
+
+namespace render {
+
+struct PendingInstance {
+    pipeline::InstancedBuffer* instancedBuffer{nullptr};
+    scene::SubModel* subModel{nullptr};
+    uint32_t passIndex{0};
+    bool bTransparent{false};
+};
+
+// Culling state of a single camera, different cameras are culled on different threads.
+// The render queues are allocated from the unsynchronized pool of the pipeline,
+// so the jobs only write heap-allocated task-local lists that are merged on the calling thread.
+// The draw lists are sorted by the jobs, merging them only appends.
+struct CameraCullingTask {
+    const scene::RenderScene* scene{nullptr};
+    scene::Camera* camera{nullptr};
+    NativeRenderQueue* queue{nullptr};
+    pipeline::LODModelsCache lodCache;
+    // models that passed culling, in culling order
+    ccstd::vector<const scene::Model*> visibleModels;
+    // instanced buffers are shared by cameras
+    ccstd::vector<PendingInstance> pendingInstances;
+    RenderDrawQueue opaqueDraws{RenderDrawQueue::allocator_type{boost::container::pmr::get_default_resource()}};
+    RenderDrawQueue transparentDraws{RenderDrawQueue::allocator_type{boost::container::pmr::get_default_resource()}};
+};
+
+// Culls the scene of each task for its camera and sorts the draws, the cameras are culled in parallel on jobSystem.
+// Occlusion culling rasterizes into a single depth buffer, when it is enabled the cameras are culled one by one.
+void cullCameras(ccstd::pmr::vector<CameraCullingTask>& tasks, pipeline::SoftwareOcclusionCulling& occlusionCulling, JobSystem* jobSystem);
+
+} // namespace render
+
+} // namespace cc
@@ -25,6 +25,7 @@
 
 #include "DeferredPipeline.h"
 #include "../GlobalDescriptorSetManager.h"
+#include "../InstancedBuffer.h"
 #include "../PipelineUBO.h"
 #include "../RenderPipeline.h"
 #include "../SceneCulling.h"
@@ -105,6 +106,8 @@ bool DeferredPipeline::activate(gfx::Swapchain *swapchain) {
 
 void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     CC_PROFILE(DeferredPipelineRender);
+    resetFrameArena();
+    InstancedBuffer::beginFrame();
 #if CC_USE_GEOMETRY_RENDERER
     updateGeometryRenderer(cameras); // for capability
 #endif
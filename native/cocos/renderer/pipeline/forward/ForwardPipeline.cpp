@@ -25,6 +25,7 @@
 
 #include "ForwardPipeline.h"
 #include "../GlobalDescriptorSetManager.h"
+#include "../InstancedBuffer.h"
 #include "../PipelineSceneData.h"
 #include "../PipelineUBO.h"
 #include "../SceneCulling.h"
@@ -95,6 +96,8 @@ bool ForwardPipeline::activate(gfx::Swapchain *swapchain) {
 
 void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     CC_PROFILE(ForwardPipelineRender);
+    resetFrameArena();
+    InstancedBuffer::beginFrame();
 #if CC_USE_GEOMETRY_RENDERER
     updateGeometryRenderer(cameras); // for capability
 #endif
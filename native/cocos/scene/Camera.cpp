@@ -30,6 +30,9 @@
 #include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/SoftwareOcclusionCulling.h"
+#include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #if CC_USE_GEOMETRY_RENDERER
     #include "renderer/pipeline/GeometryRenderer.h"
 #endif
@@ -128,6 +131,12 @@ void Camera::attachToScene(RenderScene *scene) {
 void Camera::detachFromScene() {
     _enabled = false;
     _scene = nullptr;
+
+    // occlusion culling statistics are kept per camera
+    auto *pipeline = Root::getInstance() ? Root::getInstance()->getPipeline() : nullptr;
+    if (pipeline && pipeline->getPipelineSceneData()) {
+        pipeline->getPipelineSceneData()->getSoftwareOcclusionCulling()->removeCamera(this);
+    }
 }
 
 void Camera::resize(uint32_t width, uint32_t height) {
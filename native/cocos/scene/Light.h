@@ -27,6 +27,7 @@
 
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/SlotMap.h"
 #include "base/std/container/string.h"
 #include "math/Vec3.h"
 #include "pipeline/Define.h"
@@ -89,6 +90,8 @@ public:
     inline void setName(const ccstd::string &name) { _name = name; }
 
     inline RenderScene *getScene() const { return _scene; }
+    inline const SlotMapHandle &getSceneHandle() const { return _sceneHandle; }
+    inline void setSceneHandle(const SlotMapHandle &handle) { _sceneHandle = handle; }
 
     inline const Vec3 &getColorTemperatureRGB() const { return _colorTemperatureRGB; }
     inline void setColorTemperatureRGB(const Vec3 &value) { _colorTemperatureRGB = value; }
@@ -106,6 +109,7 @@ protected:
 
     IntrusivePtr<Node> _node;
     RenderScene *_scene{nullptr};
+    SlotMapHandle _sceneHandle; // handle in the light list of RenderScene
 
     float _colorTemp{6550.F};
 
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "scene/LocalUBOPool.h"
+#include <algorithm>
+#include <cstring>
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+
+namespace cc {
+namespace scene {
+
+LocalUBOPool *LocalUBOPool::getInstance() {
+    static LocalUBOPool instance;
+    return &instance;
+}
+
+LocalUBOPool::Chunk *LocalUBOPool::acquireChunk(gfx::Device *device, uint32_t *chunkIndex) {
+    uint32_t emptyIndex = LocalUBOSlot::INVALID_CHUNK;
+    for (uint32_t i = 0; i < _chunks.size(); ++i) {
+        const auto &chunk = _chunks[i];
+        if (!chunk) {
+            if (emptyIndex == LocalUBOSlot::INVALID_CHUNK) {
+                emptyIndex = i;
+            }
+        } else if (chunk->used < SLOTS_PER_CHUNK) {
+            *chunkIndex = i;
+            return chunk.get();
+        }
+    }
+
+    if (_stride == 0) {
+        const uint32_t alignment = std::max(device->getCapabilities().uboOffsetAlignment, 16U);
+        _stride = (pipeline::UBOLocal::SIZE + alignment - 1) / alignment * alignment;
+    }
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->buffer = device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                          gfx::MemoryUsageBit::DEVICE,
+                                          _stride * SLOTS_PER_CHUNK,
+                                          _stride});
+    if (!chunk->buffer) {
+        return nullptr;
+    }
+    chunk->data.resize(_stride * SLOTS_PER_CHUNK);
+    chunk->freeSlots.reserve(SLOTS_PER_CHUNK);
+    for (uint32_t i = SLOTS_PER_CHUNK; i > 0; --i) {
+        chunk->freeSlots.emplace_back(i - 1);
+    }
+
+    if (emptyIndex == LocalUBOSlot::INVALID_CHUNK) {
+        emptyIndex = static_cast<uint32_t>(_chunks.size());
+        _chunks.emplace_back();
+    }
+    _chunks[emptyIndex] = std::move(chunk);
+    *chunkIndex = emptyIndex;
+    return _chunks[emptyIndex].get();
+}
+
+gfx::Buffer *LocalUBOPool::allocate(gfx::Device *device, LocalUBOSlot *slot) {
+    CC_ASSERT(slot && !slot->isValid());
+    uint32_t chunkIndex = LocalUBOSlot::INVALID_CHUNK;
+    Chunk *chunk = acquireChunk(device, &chunkIndex);
+    if (!chunk) {
+        return nullptr;
+    }
+
+    const uint32_t index = chunk->freeSlots.back();
+    gfx::BufferViewInfo viewInfo;
+    viewInfo.buffer = chunk->buffer;
+    viewInfo.offset = index * _stride;
+    viewInfo.range = pipeline::UBOLocal::SIZE;
+    auto *view = device->createBuffer(viewInfo);
+    if (!view) {
+        if (chunk->used == 0) {
+            _chunks[chunkIndex].reset();
+        }
+        return nullptr;
+    }
+
+    chunk->freeSlots.pop_back();
+    ++chunk->used;
+    chunk->highWater = std::max(chunk->highWater, index + 1);
+    memset(chunk->data.data() + viewInfo.offset, 0, _stride);
+
+    slot->chunk = chunkIndex;
+    slot->index = index;
+    return view;
+}
+
+void LocalUBOPool::free(LocalUBOSlot *slot) {
+    // The pool may have been destroyed before the model releases its slot.
+    if (!slot->isValid() || slot->chunk >= _chunks.size() || !_chunks[slot->chunk]) {
+        *slot = {};
+        return;
+    }
+    auto &chunk = _chunks[slot->chunk];
+    chunk->freeSlots.emplace_back(slot->index);
+    if (--chunk->used == 0) {
+        // The views referencing the chunk should be destroyed by now.
+        chunk->buffer->destroy();
+        chunk.reset();
+    }
+    *slot = {};
+}
+
+float *LocalUBOPool::getData(const LocalUBOSlot &slot) const {
+    CC_ASSERT(slot.isValid());
+    return reinterpret_cast<float *>(_chunks[slot.chunk]->data.data() + slot.index * _stride);
+}
+
+void LocalUBOPool::markDirty(const LocalUBOSlot &slot) {
+    CC_ASSERT(slot.isValid());
+    _chunks[slot.chunk]->dirty.store(true, std::memory_order_relaxed);
+}
+
+uint32_t LocalUBOPool::update() {
+    uint32_t uploaded = 0;
+    for (const auto &chunk : _chunks) {
+        if (chunk && chunk->dirty.exchange(false, std::memory_order_relaxed)) {
+            chunk->buffer->update(chunk->data.data(), chunk->highWater * _stride);
+            ++uploaded;
+        }
+    }
+    return uploaded;
+}
+
+void LocalUBOPool::destroy() {
+    for (const auto &chunk : _chunks) {
+        if (chunk) {
+            chunk->buffer->destroy();
+        }
+    }
+    _chunks.clear();
+    _stride = 0;
+}
+
+} // namespace scene
+} // namespace cc
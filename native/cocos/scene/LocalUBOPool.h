@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+
+namespace cc {
+
+namespace gfx {
+class Device;
+} // namespace gfx
+
+namespace scene {
+
+struct LocalUBOSlot {
+    static constexpr uint32_t INVALID_CHUNK{0xFFFFFFFF};
+
+    uint32_t chunk{INVALID_CHUNK};
+    uint32_t index{0};
+
+    inline bool isValid() const { return chunk != INVALID_CHUNK; }
+};
+
+/**
+ * Shares the UBOLocal storage of models between a few large chunk buffers.
+ * Each model owns a persistent slot in a chunk and binds a buffer view of it,
+ * so the descriptor sets never need to be rebuilt. Models write their data to
+ * the CPU copy of the chunk and the dirty chunks are uploaded once per frame,
+ * instead of issuing one buffer update per model.
+ * The pool is opt-in, models fall back to their own local buffer when it is disabled.
+ */
+class LocalUBOPool final {
+public:
+    static constexpr uint32_t SLOTS_PER_CHUNK{256};
+
+    static LocalUBOPool *getInstance();
+
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+    inline bool isEnabled() const { return _enabled; }
+
+    // Returns a buffer view of the slot, the caller takes the ownership of the view.
+    gfx::Buffer *allocate(gfx::Device *device, LocalUBOSlot *slot);
+    void free(LocalUBOSlot *slot);
+
+    float *getData(const LocalUBOSlot &slot) const;
+    // Thread-safe, could be called from the jobs updating models.
+    void markDirty(const LocalUBOSlot &slot);
+
+    // Uploads the dirty chunks, returns how many were uploaded.
+    uint32_t update();
+    void destroy();
+
+    inline uint32_t getStride() const { return _stride; }
+    inline uint32_t getChunkCount() const { return static_cast<uint32_t>(_chunks.size()); }
+
+private:
+    struct Chunk {
+        IntrusivePtr<gfx::Buffer> buffer;
+        ccstd::vector<uint8_t> data;
+        ccstd::vector<uint32_t> freeSlots;
+        uint32_t used{0};
+        uint32_t highWater{0};
+        std::atomic<bool> dirty{false};
+    };
+
+    Chunk *acquireChunk(gfx::Device *device, uint32_t *chunkIndex);
+
+    ccstd::vector<std::unique_ptr<Chunk>> _chunks;
+    uint32_t _stride{0};
+    bool _enabled{false};
+};
+
+} // namespace scene
+} // namespace cc
@@ -34,7 +34,9 @@
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/InstancedBuffer.h"
+#include "renderer/pipeline/StaticMeshPool.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
+#include "scene/LocalUBOPool.h"
 #include "scene/Model.h"
 #include "scene/Pass.h"
 #include "scene/RenderScene.h"
@@ -89,6 +91,8 @@ void Model::destroy() {
     _subModels.clear();
 
     CC_SAFE_DESTROY_NULL(_localBuffer);
+    LocalUBOPool::getInstance()->free(&_localUBOSlot);
+    pipeline::StaticMeshPool::getInstance()->release(this);
     CC_SAFE_DESTROY_NULL(_localSHBuffer);
     CC_SAFE_DESTROY_NULL(_worldBoundBuffer);
 
@@ -101,6 +105,11 @@ void Model::destroy() {
     _isDynamicBatching = false;
 }
 
+void Model::detachFromScene() {
+    _scene = nullptr;
+    pipeline::StaticMeshPool::getInstance()->release(this);
+}
+
 void Model::updateTransform(uint32_t stamp) {
     CC_PROFILE(ModelUpdateTransform);
     if (isModelImplementedInJS()) {
@@ -161,17 +170,31 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
+    updateSubModelUBOs(stamp);
+    updateLocalUBOs();
+}
+
+void Model::updateSubModelUBOs(uint32_t stamp) {
     for (SubModel *subModel : _subModels) {
         subModel->update();
     }
     _updateStamp = stamp;
 
     updateSHUBOs();
+}
 
+bool Model::isLocalUBOForced() {
     const auto *pipeline = Root::getInstance()->getPipeline();
     const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
-    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+    return shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+}
 
+void Model::updateLocalUBOs() {
+    writeLocalUBOs(isLocalUBOForced());
+    uploadLocalUBOs(Root::getInstance()->getPipeline()->isOcclusionQueryEnabled());
+}
+
+void Model::writeLocalUBOs(bool forceUpdateUBO) {
     if (!_localDataUpdated) {
         return;
     }
@@ -193,16 +216,36 @@ void Model::updateUBOs(uint32_t stamp) {
         Mat4 mat4;
         Mat4::inverseTranspose(worldMatrix, &mat4);
 
-        _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
-        _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
-        _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+        if (_localUBOSlot.isValid()) {
+            // written to the shared chunk, which is uploaded once per frame by the pool
+            auto *pool = LocalUBOPool::getInstance();
+            float *data = pool->getData(_localUBOSlot);
+            memcpy(data + pipeline::UBOLocal::MAT_WORLD_OFFSET, worldMatrix.m, sizeof(Mat4));
+            memcpy(data + pipeline::UBOLocal::MAT_WORLD_IT_OFFSET, mat4.m, sizeof(Mat4));
+            memcpy(data + pipeline::UBOLocal::LIGHTINGMAP_UVPARAM, &_lightmapUVParam, sizeof(Vec4));
+            memcpy(data + pipeline::UBOLocal::LOCAL_SHADOW_BIAS, &_shadowBias, sizeof(Vec4));
+            pool->markDirty(_localUBOSlot);
+        } else {
+            _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
+            _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+            _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+            _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+        }
+        _localUBOUploadPending = true;
+    }
+}
 
+void Model::uploadLocalUBOs(bool updateWorldBounds) {
+    if (!_localUBOUploadPending) {
+        return;
+    }
+    _localUBOUploadPending = false;
+    // pooled slots are uploaded with their chunk by LocalUBOPool::update
+    if (!_localUBOSlot.isValid()) {
         _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+    }
+    if (updateWorldBounds) {
+        updateWorldBoundUBOs();
     }
 }
 
@@ -372,18 +415,31 @@ void Model::clearSHUBOs() {
     updateSHBuffer();
 }
 
-void Model::updateSHUBOs() {
+bool Model::isSHDirty() const {
     if (!isLightProbeAvailable()) {
-        return;
+        return false;
     }
 
-    const auto center = _worldBounds->getCenter();
 #if !CC_EDITOR
-    if (center.approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
-        return;
+    if (_worldBounds->getCenter().approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
+        return false;
     }
 #endif
 
+    return true;
+}
+
+void Model::updateSHUBOs() {
+    if (_shBatchUpdated) {
+        _shBatchUpdated = false;
+        return;
+    }
+
+    if (!isSHDirty()) {
+        return;
+    }
+
+    const auto center = _worldBounds->getCenter();
     ccstd::vector<Vec3> coefficients;
     Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
     const auto *pipeline = Root::getInstance()->getPipeline();
@@ -396,10 +452,24 @@ void Model::updateSHUBOs() {
         return;
     }
 
+    updateSHData(coefficients);
+}
+
+void Model::applySHCoefficients(int32_t tetIndex, ccstd::vector<Vec3> &coefficients) {
+    _lastWorldBoundCenter.set(_worldBounds->getCenter());
+    _tetrahedronIndex = tetIndex;
+    _shBatchUpdated = true;
+
+    updateSHData(coefficients);
+}
+
+void Model::updateSHData(ccstd::vector<Vec3> &coefficients) {
     if (_localSHData.empty()) {
         return;
     }
 
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
     gi::SH::reduceRinging(coefficients, lightProbes->getReduceRinging());
     gi::SH::updateUBOData(_localSHData, pipeline::UBOSH::SH_LINEAR_CONST_R_OFFSET, coefficients);
     updateSHBuffer();
@@ -464,6 +534,9 @@ void Model::updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attri
 }
 
 void Model::initLocalDescriptors(index_t /*subModelIndex*/) {
+    if (!_localBuffer && LocalUBOPool::getInstance()->isEnabled()) {
+        _localBuffer = LocalUBOPool::getInstance()->allocate(_device, &_localUBOSlot);
+    }
     if (!_localBuffer) {
         _localBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
                                               gfx::MemoryUsageBit::DEVICE,
@@ -29,6 +29,7 @@
 #include <tuple>
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/SlotMap.h"
 #include "core/TypedArray.h"
 #include "core/assets/RenderingSubMesh.h"
 #include "core/assets/Texture2D.h"
@@ -40,6 +41,7 @@
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXTexture.h"
+#include "scene/LocalUBOPool.h"
 #include "scene/SubModel.h"
 #include "core/assets/TextureCube.h"
 
@@ -111,6 +113,19 @@ public:
     void updateLightingmap(Texture2D *texture, const Vec4 &uvParam);
     void clearSHUBOs();
     void updateSHUBOs();
+    // Whether the light probe SH of this model needs to be interpolated again.
+    bool isSHDirty() const;
+    // Applies SH interpolated in a batch by RenderScene, the following updateSHUBOs call is skipped.
+    void applySHCoefficients(int32_t tetIndex, ccstd::vector<Vec3> &coefficients);
+    // Split parts of updateUBOs, used by RenderScene to update plain models in phases.
+    void updateSubModelUBOs(uint32_t stamp);
+    void updateLocalUBOs();
+    // CPU half of updateLocalUBOs, only writes data owned by this model so it could run on a job.
+    void writeLocalUBOs(bool forceUpdate);
+    // GPU half of updateLocalUBOs, uploads what writeLocalUBOs wrote, stays on the render thread.
+    void uploadLocalUBOs(bool updateWorldBounds);
+    // Planar shadows read the local UBO of every model, instanced ones included.
+    static bool isLocalUBOForced();
     void updateOctree();
     void updateWorldBoundUBOs();
     void updateLocalShadowBias();
@@ -121,7 +136,7 @@ public:
         _scene = scene;
         _localDataUpdated = true;
     }
-    inline void detachFromScene() { _scene = nullptr; };
+    void detachFromScene();
     inline void setCastShadow(bool value) { _castShadow = value; }
     inline void setEnabled(bool value) { _enabled = value; }
     inline void setLocalBuffer(gfx::Buffer *buffer) { _localBuffer = buffer; }
@@ -143,12 +158,15 @@ public:
         _worldBoundsDirty = true;
     }
     inline void setOctreeNode(OctreeNode *node) { _octreeNode = node; }
+    inline void setSceneHandle(const SlotMapHandle &handle) { _sceneHandle = handle; }
     inline void setScene(RenderScene *scene) {
         _scene = scene;
         if (scene) _localDataUpdated = true;
     }
 
     inline bool isInited() const { return _inited; }
+    inline bool isWorldBoundsDirty() const { return _worldBoundsDirty; }
+    inline void resetWorldBoundsDirty() { _worldBoundsDirty = false; }
     inline bool isCastShadow() const { return _castShadow; }
     inline bool isEnabled() const { return _enabled; }
     inline bool getUseLightProbe() const { return _useLightProbe; }
@@ -182,6 +200,7 @@ public:
     inline void setType(Type type) { _type = type; }
     inline OctreeNode *getOctreeNode() const { return _octreeNode; }
     inline RenderScene *getScene() const { return _scene; }
+    inline const SlotMapHandle &getSceneHandle() const { return _sceneHandle; }
     inline void setDynamicBatching(bool val) { _isDynamicBatching = val; }
     inline bool isDynamicBatching() const { return _isDynamicBatching; }
     inline float getShadowBias() const { return _shadowBias.x; }
@@ -197,6 +216,10 @@ public:
         _worldBoundsDirty = true;
     }
     inline void setModelBounds(geometry::AABB *bounds) { _modelBounds = bounds; }
+    // Only touches its own data in updateTransform and updateLocalUBOs, see RenderScene::update.
+    inline bool isParallelUpdatable() const { return _type == Type::DEFAULT; }
+    // The local UBO data is written to the shared pool without any gfx call.
+    inline bool hasPooledLocalUBO() const { return _localUBOSlot.isValid(); }
     inline bool isModelImplementedInJS() const { return (_type != Type::DEFAULT && _type != Type::SKINNING && _type != Type::BAKED_SKINNING); };
 
 protected:
@@ -205,6 +228,7 @@ protected:
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
     void updateSHBuffer();
+    void updateSHData(ccstd::vector<Vec3> &coefficients);
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -217,11 +241,13 @@ protected:
 
     OctreeNode *_octreeNode{nullptr};
     RenderScene *_scene{nullptr};
+    SlotMapHandle _sceneHandle; // handle in RenderScene::_models
     gfx::Device *_device{nullptr};
 
     IntrusivePtr<Node> _transform;
     IntrusivePtr<Node> _node;
     IntrusivePtr<gfx::Buffer> _localBuffer;
+    LocalUBOSlot _localUBOSlot;
     IntrusivePtr<gfx::Buffer> _localSHBuffer;
     IntrusivePtr<gfx::Buffer> _worldBoundBuffer;
     IntrusivePtr<geometry::AABB> _worldBounds;
@@ -231,6 +257,7 @@ protected:
     int32_t _tetrahedronIndex{-1};
     Vec3 _lastWorldBoundCenter{INFINITY, INFINITY, INFINITY};
     bool _useLightProbe = false;
+    bool _shBatchUpdated{false};
 
     bool _bakeToReflectionProbe{true};
     int32_t _reflectionProbeType{0};
@@ -241,6 +268,7 @@ protected:
     bool _isDynamicBatching{false};
     bool _inited{false};
     bool _localDataUpdated{false};
+    bool _localUBOUploadPending{false};
     bool _worldBoundsDirty{true};
     // For JS
     bool _isCalledFromJS{false};
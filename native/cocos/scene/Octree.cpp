@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "Octree.h"
+#include <algorithm>
 #include <future>
 #include <utility>
 #include "scene/Camera.h"
@@ -63,6 +64,13 @@ void OctreeInfo::setDepth(uint32_t val) {
     }
 }
 
+void OctreeInfo::setLooseness(float val) {
+    _looseness = val;
+    if (_resource) {
+        _resource->setLooseness(val);
+    }
+}
+
 void OctreeInfo::activate(Octree *resource) {
     _resource = resource;
     _resource->initialize(*this);
@@ -97,6 +105,25 @@ OctreeNode::~OctreeNode() {
     }
 }
 
+namespace {
+
+BBox loosenBox(const BBox &box, float looseness) {
+    if (looseness <= 1.0F) {
+        return box;
+    }
+    const Vec3 center = box.getCenter();
+    const Vec3 halfExtents = (box.max - box.min) * (0.5F * looseness);
+    return {center - halfExtents, center + halfExtents};
+}
+
+} // namespace
+
+void OctreeNode::setBox(const BBox &aabb) {
+    _aabb = aabb;
+    // the root always holds everything intersecting the scene bounds, keep it tight
+    _looseBox = _parent ? loosenBox(aabb, _owner->getLooseness()) : aabb;
+}
+
 BBox OctreeNode::getChildBox(uint32_t index) const {
     cc::Vec3 min = _aabb.min;
     cc::Vec3 max = _aabb.max;
@@ -126,7 +153,7 @@ BBox OctreeNode::getChildBox(uint32_t index) const {
 OctreeNode *OctreeNode::getOrCreateChild(uint32_t index) {
     if (!_children[index]) {
         BBox childBox = getChildBox(index);
-        auto *child = _children[index] = ccnew OctreeNode(_owner, this);
+        auto *child = _children[index] = _owner->allocNode(this);
         child->setBox(childBox);
         child->setDepth(_depth + 1);
         child->setIndex(index);
@@ -137,7 +164,7 @@ OctreeNode *OctreeNode::getOrCreateChild(uint32_t index) {
 
 void OctreeNode::deleteChild(uint32_t index) {
     if (_children[index]) {
-        delete _children[index];
+        _owner->freeNode(_children[index]);
         _children[index] = nullptr;
     }
 }
@@ -153,7 +180,7 @@ void OctreeNode::insert(Model *model) { // NOLINT(misc-no-recursion)
         index += modelCenter.y < nodeCenter.y ? 0 : 2;
         index += modelCenter.z < nodeCenter.z ? 0 : 4;
 
-        BBox childBox = getChildBox(index);
+        BBox childBox = _children[index] ? _children[index]->getLooseBox() : loosenBox(getChildBox(index), _owner->getLooseness());
         if (childBox.contain(modelBox)) {
             split = true;
 
@@ -196,6 +223,11 @@ void OctreeNode::onRemoved() { // NOLINT(misc-no-recursion)
         return;
     }
 
+    if (_owner->_deferPrune) {
+        _owner->queuePrune(this);
+        return;
+    }
+
     for (auto *child : _children) {
         if (child) {
             return;
@@ -252,7 +284,7 @@ void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum
 
 void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
     geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
+    geometry::AABB::fromPoints(_looseBox.min, _looseBox.max, &box);
     if (!box.aabbFrustum(frustum)) {
         return;
     }
@@ -280,7 +312,7 @@ void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry:
 
 void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
     geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
+    geometry::AABB::fromPoints(_looseBox.min, _looseBox.max, &box);
     if (!box.aabbFrustum(frustum)) {
         return;
     }
@@ -299,11 +331,74 @@ void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometr
  * Octree class
  */
 Octree::Octree() {
-    _root = ccnew OctreeNode(this, nullptr);
+    _root = allocNode(nullptr);
 }
 
 Octree::~Octree() {
-    delete _root;
+    freeNode(_root);
+    for (auto *node : _freeNodes) {
+        delete node;
+    }
+}
+
+OctreeNode *Octree::allocNode(OctreeNode *parent) {
+    if (_freeNodes.empty()) {
+        return ccnew OctreeNode(this, parent);
+    }
+    auto *node = _freeNodes.back();
+    _freeNodes.pop_back();
+    node->_parent = parent;
+    return node;
+}
+
+void Octree::freeNode(OctreeNode *node) { // NOLINT(misc-no-recursion)
+    for (auto *&child : node->_children) {
+        if (child) {
+            freeNode(child);
+            child = nullptr;
+        }
+    }
+    // keep the capacity of the model list for the next use
+    node->_models.clear();
+    node->_parent = nullptr;
+    node->_pruneQueued = false;
+    _freeNodes.push_back(node);
+}
+
+void Octree::queuePrune(OctreeNode *node) {
+    if (node->_pruneQueued) {
+        return;
+    }
+    node->_pruneQueued = true;
+    if (node->_depth >= _pruneQueues.size()) {
+        _pruneQueues.resize(node->_depth + 1);
+    }
+    _pruneQueues[node->_depth].push_back(node);
+}
+
+void Octree::flushPrune() {
+    _deferPrune = false;
+    // deepest nodes first, so a node is always visited before its parent may be freed
+    for (auto depth = static_cast<uint32_t>(_pruneQueues.size()); depth-- > 0;) {
+        auto &queue = _pruneQueues[depth];
+        for (auto *node : queue) {
+            node->_pruneQueued = false;
+            if (!node->_parent || !node->_models.empty()) {
+                continue;
+            }
+            const bool hasChild = std::any_of(node->_children.begin(), node->_children.end(), [](const OctreeNode *child) {
+                return child != nullptr;
+            });
+            if (!hasChild) {
+                OctreeNode *parent = node->_parent;
+                parent->deleteChild(node->_index);
+                if (parent->_models.empty()) {
+                    queuePrune(parent);
+                }
+            }
+        }
+        queue.clear();
+    }
 }
 
 void Octree::initialize(const OctreeInfo &info) {
@@ -311,6 +406,7 @@ void Octree::initialize(const OctreeInfo &info) {
     _minPos = info.getMinPos();
     _maxPos = info.getMaxPos();
     _maxDepth = std::max(info.getDepth(), 1U);
+    _looseness = std::max(info.getLooseness(), 1.0F);
     setEnabled(info.isEnabled());
     _root->setBox(BBox{_minPos - expand, _maxPos});
     _root->setDepth(0);
@@ -336,6 +432,15 @@ void Octree::setMaxDepth(uint32_t val) {
     _maxDepth = val;
 }
 
+void Octree::setLooseness(float val) {
+    val = std::max(val, 1.0F);
+    if (_looseness == val) {
+        return;
+    }
+    _looseness = val;
+    rebuild(_root->getBox(), _maxDepth);
+}
+
 void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
     BBox rootBox = _root->getBox();
@@ -343,16 +448,21 @@ void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
         return;
     }
 
+    rebuild(BBox{minPos - expand, maxPos}, maxDepth);
+}
+
+void Octree::rebuild(const BBox &rootBox, uint32_t maxDepth) {
     ccstd::vector<Model *> models;
     _root->gatherModels(models);
 
-    delete _root;
-    _root = ccnew OctreeNode(this, nullptr);
-    _root->setBox(BBox{minPos - expand, maxPos});
+    freeNode(_root);
+    _root = allocNode(nullptr);
+    _root->setBox(rootBox);
     _root->setDepth(0);
     _root->setIndex(0);
 
     _maxDepth = std::max(maxDepth, 1U);
+    _totalCount = 0;
 
     for (auto *model : models) {
         model->setOctreeNode(nullptr);
@@ -390,10 +500,70 @@ void Octree::remove(Model *model) {
     }
 }
 
+void Octree::insert(const ccstd::vector<Model *> &models) {
+    // models already in the tree leave their old nodes, those are pruned once for the batch
+    _deferPrune = true;
+    for (auto *model : models) {
+        insert(model);
+    }
+    flushPrune();
+}
+
+void Octree::remove(const ccstd::vector<Model *> &models) {
+    _deferPrune = true;
+    ccstd::vector<OctreeNode *> nodes;
+    nodes.reserve(models.size());
+    for (auto *model : models) {
+        CC_ASSERT(model);
+        OctreeNode *node = model->getOctreeNode();
+        if (node) {
+            nodes.push_back(node);
+            model->setOctreeNode(nullptr);
+            _totalCount--;
+        }
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    for (auto *node : nodes) {
+        auto &nodeModels = node->_models;
+        nodeModels.erase(std::remove_if(nodeModels.begin(), nodeModels.end(), [node](const Model *model) {
+                             return model->getOctreeNode() != node;
+                         }),
+                         nodeModels.end());
+        node->onRemoved();
+    }
+    flushPrune();
+}
+
 void Octree::update(Model *model) {
+    OctreeNode *node = model->getOctreeNode();
+    if (node && node != _root && model->getWorldBounds()) {
+        const BBox modelBox(*model->getWorldBounds());
+        // still inside the bounds of its node, nothing to do
+        if (node->getLooseBox().contain(modelBox)) {
+            return;
+        }
+        // otherwise reinsert from the nearest ancestor still containing it
+        for (OctreeNode *parent = node->_parent; parent && parent != _root; parent = parent->_parent) {
+            if (parent->getLooseBox().contain(modelBox)) {
+                parent->insert(model);
+                return;
+            }
+        }
+    }
     insert(model);
 }
 
+void Octree::update(const ccstd::vector<Model *> &models) {
+    _deferPrune = true;
+    for (auto *model : models) {
+        update(model);
+    }
+    flushPrune();
+}
+
 void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
     if (_totalCount > USE_MULTI_THRESHOLD) {
         _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
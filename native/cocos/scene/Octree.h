@@ -28,6 +28,7 @@
 #include "base/Macros.h"
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 #include "core/geometry/AABB.h"
 #include "math/Vec3.h"
 
@@ -44,6 +45,7 @@ const Vec3 DEFAULT_WORLD_MIN_POS = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
+constexpr float DEFAULT_OCTREE_LOOSENESS = 1.0F; // child bounds scale, 1 means a regular octree
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -77,6 +79,13 @@ public:
     void setDepth(uint32_t val);
     inline uint32_t getDepth() const { return _depth; }
 
+    /**
+     * @en looseness of octree child bounds, 1 means a regular octree
+     * @zh 八叉树子节点包围盒的松散系数，1 表示普通八叉树
+     */
+    void setLooseness(float val);
+    inline float getLooseness() const { return _looseness; }
+
     void activate(Octree *resource);
 
     // JS deserialization require the properties to be public
@@ -85,6 +94,7 @@ public:
     Vec3 _minPos{DEFAULT_WORLD_MIN_POS};
     Vec3 _maxPos{DEFAULT_WORLD_MAX_POS};
     uint32_t _depth{DEFAULT_OCTREE_DEPTH};
+    float _looseness{DEFAULT_OCTREE_LOOSENESS};
 
 private:
     Octree *_resource{nullptr};
@@ -134,16 +144,24 @@ struct CC_DLL BBox final {
  * OctreeNode class
  */
 class CC_DLL OctreeNode final {
+public:
+    inline const BBox &getBox() const { return _aabb; }
+    // bounds the models of this node are contained in, enlarged in loose mode
+    inline const BBox &getLooseBox() const { return _looseBox; }
+    inline uint32_t getDepth() const { return _depth; }
+    inline OctreeNode *getParent() const { return _parent; }
+    inline OctreeNode *getChild(uint32_t index) const { return _children[index]; }
+    inline const ccstd::vector<Model *> &getModels() const { return _models; }
+
 private:
     OctreeNode(Octree *owner, OctreeNode *parent);
     ~OctreeNode();
 
-    inline void setBox(const BBox &aabb) { _aabb = aabb; }
+    void setBox(const BBox &aabb);
     inline void setDepth(uint32_t depth) { _depth = depth; }
     inline void setIndex(uint32_t index) { _index = index; }
 
     inline Octree *getOwner() const { return _owner; }
-    inline const BBox &getBox() const { return _aabb; }
     BBox getChildBox(uint32_t index) const;
     OctreeNode *getOrCreateChild(uint32_t index);
     void deleteChild(uint32_t index);
@@ -161,8 +179,10 @@ private:
     ccstd::array<OctreeNode *, OCTREE_CHILDREN_NUM> _children{};
     ccstd::vector<Model *> _models;
     BBox _aabb{};
+    BBox _looseBox{};
     uint32_t _depth{0};
     uint32_t _index{0};
+    bool _pruneQueued{false};
 
     friend class Octree;
 };
@@ -207,9 +227,24 @@ public:
     // remove a model from tree.
     void remove(Model *model);
 
+    // insert or remove a batch of models, emptied nodes are pruned once at the end of the batch
+    // and each node losing models is compacted only once on removal.
+    void insert(const ccstd::vector<Model *> &models);
+    void remove(const ccstd::vector<Model *> &models);
+
     // update model's location in the tree.
     void update(Model *model);
 
+    // update a batch of models, empty nodes are pruned once at the end of the batch.
+    void update(const ccstd::vector<Model *> &models);
+
+    /**
+     * @en Scale of the child bounds, a loose octree (e.g. 2) keeps moving models in the same node longer.
+     * @zh 子节点包围盒的缩放系数，松散八叉树（如 2）可减少移动模型的重新插入。
+     */
+    void setLooseness(float val);
+    inline float getLooseness() const { return _looseness; }
+
     /**
      * @en depth of octree
      * @zh 八叉树深度
@@ -224,10 +259,24 @@ public:
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
+    void rebuild(const BBox &rootBox, uint32_t maxDepth);
+
+    // nodes are recycled to avoid allocation churn of moving models
+    OctreeNode *allocNode(OctreeNode *parent);
+    void freeNode(OctreeNode *node);
+    void queuePrune(OctreeNode *node);
+    void flushPrune();
 
     OctreeNode *_root{nullptr};
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
+    float _looseness{DEFAULT_OCTREE_LOOSENESS};
+
+    ccstd::vector<OctreeNode *> _freeNodes;
+    ccstd::vector<ccstd::vector<OctreeNode *>> _pruneQueues; // indexed by node depth
+    bool _deferPrune{false};
+
+    friend class OctreeNode;
 
     bool _enabled{false};
     Vec3 _minPos;
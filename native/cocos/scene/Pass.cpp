@@ -135,8 +135,15 @@ ccstd::hash_t Pass::getPassHash(Pass *pass) {
     ccstd::hash_combine(hashValue, serializeDepthStencilState(pass->_depthStencilState));
     ccstd::hash_combine(hashValue, serializeRasterizerState(pass->_rs));
 
-    const ccstd::string &shaderKey = ProgramLib::getInstance()->getKey(pass->getProgram(), pass->getDefines());
-    ccstd::hash_range(hashValue, shaderKey.begin(), shaderKey.end());
+    auto *programLib = ProgramLib::getInstance();
+    ShaderVariantKey variantKey;
+    if (programLib->getVariantKey(pass->getProgram(), pass->getDefines(), variantKey)) {
+        ccstd::hash_combine(hashValue, ShaderVariantKeyHash{}(variantKey));
+        ccstd::hash_combine(hashValue, pass->_shaderInfo->hash);
+    } else {
+        const ccstd::string &shaderKey = programLib->getKey(pass->getProgram(), pass->getDefines());
+        ccstd::hash_range(hashValue, shaderKey.begin(), shaderKey.end());
+    }
 
     return hashValue;
 }
@@ -440,6 +447,7 @@ bool Pass::tryCompile() {
         return false;
     }
     _shader = shader;
+    _hasVariantKey = ProgramLib::getInstance()->getVariantKey(_programName, _defines, _variantKey);
     _pipelineLayout = ProgramLib::getInstance()->getTemplateInfo(_programName)->pipelineLayout;
     _hash = Pass::getPassHash(this);
     return true;
@@ -468,6 +476,11 @@ gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
     }
 #endif
 
+    auto *variant = findPatchedVariant(patches);
+    if (variant) {
+        return variant;
+    }
+
     auto *pipeline = _root->getPipeline();
     for (const auto &patch : patches) {
         _defines[patch.name] = patch.value;
@@ -484,6 +497,43 @@ gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
     return shader;
 }
 
+gfx::Shader *Pass::getShaderVariantAsync(const ccstd::vector<IMacroPatch> &patches, const std::function<void(gfx::Shader *)> &callback) {
+    auto *programLib = ProgramLib::getInstance();
+    if (patches.empty() || !programLib->isAsyncCompileEnabled()) {
+        return getShaderVariant(patches);
+    }
+    if (!_shader && !tryCompile()) {
+        CC_LOG_WARNING("pass resources incomplete");
+        return nullptr;
+    }
+
+    auto *variant = findPatchedVariant(patches);
+    if (variant) {
+        return variant;
+    }
+
+    // the default variant would ignore the patches, only the registered fallback of the program stands in
+    MacroRecord defines = _defines;
+    for (const auto &patch : patches) {
+        defines[patch.name] = patch.value;
+    }
+    return programLib->getGFXShaderAsync(_device, _programName, defines, _root->getPipeline(), callback);
+}
+
+gfx::Shader *Pass::findPatchedVariant(const ccstd::vector<IMacroPatch> &patches) const {
+    if (!_hasVariantKey) {
+        return nullptr;
+    }
+
+    // patch the key of the default variant, the defines are only rebuilt when the variant is not compiled yet
+    auto *programLib = ProgramLib::getInstance();
+    ShaderVariantKey key = _variantKey;
+    for (const auto &patch : patches) {
+        programLib->patchVariantKey(_programName, key, patch.name, patch.value);
+    }
+    return programLib->findShaderVariant(_programName, key);
+}
+
 IPassInfoFull Pass::getPassInfoFull() const {
     IPassInfoFull ret;
     ret.passIndex = _passIndex;
@@ -662,6 +712,8 @@ void Pass::initPassFromTarget(Pass *target, const gfx::DepthStencilState &dss, c
     _dynamics = target->_dynamics;
 
     _shader = target->_shader;
+    _variantKey = target->_variantKey;
+    _hasVariantKey = target->_hasVariantKey;
 
     _pipelineLayout = ProgramLib::getInstance()->getTemplateInfo(_programName)->pipelineLayout;
     _hash = target->_hash ^ hashFactor;
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
@@ -259,6 +260,17 @@ public:
     gfx::Shader *getShaderVariant();
     gfx::Shader *getShaderVariant(const ccstd::vector<IMacroPatch> &patches);
 
+    /**
+     * @en Gets the shader variant like getShaderVariant, but when ProgramLib compiles asynchronously a variant
+     * that is not compiled yet is queued, the registered fallback of the program or nullptr is returned meanwhile
+     * and the callback receives the real one.
+     * @zh 同 getShaderVariant，但 ProgramLib 开启异步编译时，未编译的变体会进入编译队列，
+     * 期间返回该 program 注册的备用 shader 或 nullptr，编译完成后通过回调返回真正的变体。
+     * @param patches The macro patches
+     * @param callback Called with the compiled variant, or nullptr if it failed, only if it was queued
+     */
+    gfx::Shader *getShaderVariantAsync(const ccstd::vector<IMacroPatch> &patches, const std::function<void(gfx::Shader *)> &callback);
+
     IPassInfoFull getPassInfoFull() const;
 
     // infos
@@ -310,6 +322,7 @@ public:
 protected:
     void setState(const gfx::BlendState &bs, const gfx::DepthStencilState &dss, const gfx::RasterizerState &rs, gfx::DescriptorSet *ds);
     void doInit(const IPassInfoFull &info, bool copyDefines = false);
+    gfx::Shader *findPatchedVariant(const ccstd::vector<IMacroPatch> &patches) const;
     virtual void syncBatchingScheme();
 
     // internal resources
@@ -328,6 +341,8 @@ protected:
 
     IProgramInfo *_shaderInfo; // weakref to template of ProgramLib
     MacroRecord _defines;
+    ShaderVariantKey _variantKey; // key of _shader, the base of the patched variants
+    bool _hasVariantKey{false};
     Record<ccstd::string, IPropertyInfo> _properties;
     IntrusivePtr<gfx::Shader> _shader;
     gfx::BlendState _blendState{};
@@ -26,12 +26,16 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/ParallelFor.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "gi/light-probe/LightProbe.h"
+#include "gi/light-probe/SH.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -85,23 +89,89 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
     _mainLight = dl;
 }
 
+namespace {
+
+constexpr uint32_t MIN_MODELS_PER_JOB{128};
+
+template <typename Func>
+void forEachModelParallel(JobSystem *jobSystem, const ccstd::vector<Model *> &models, Func &&func) {
+    parallelFor(jobSystem, static_cast<uint32_t>(models.size()), MIN_MODELS_PER_JOB, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            func(models[i]);
+        }
+    });
+}
+
+} // namespace
+
 void RenderScene::update(uint32_t stamp) {
     CC_PROFILE(RenderSceneUpdate);
 
     if (_mainLight) {
         _mainLight->update();
     }
-    for (const auto &light : _sphereLights) {
+    for (const auto &light : _sphereLights.values()) {
         light->update();
     }
-    for (const auto &spotLight : _spotLights) {
+    for (const auto &spotLight : _spotLights.values()) {
         spotLight->update();
     }
-    for (const auto &model : _models) {
-        if (model->isEnabled()) {
+
+    // Phase 1: transforms and world bounds. The world transforms of the parallel models
+    // are flushed serially first, since models may share parent nodes.
+    _parallelModels.clear();
+    {
+        CC_PROFILE(RenderSceneUpdateTransform);
+        for (const auto &model : _models.values()) {
+            if (!model->isEnabled()) {
+                continue;
+            }
+            if (model->isParallelUpdatable() && model->getTransform()) {
+                model->getTransform()->updateWorldTransform();
+                _parallelModels.emplace_back(model.get());
+            } else {
+                model->updateTransform(stamp);
+            }
+        }
+        forEachModelParallel(JobSystem::getInstance(), _parallelModels, [stamp](Model *model) {
             model->updateTransform(stamp);
-            model->updateUBOs(stamp);
-            model->updateOctree();
+        });
+    }
+
+    updateSHUBOs();
+
+    // Phase 2: UBOs. The jobs only fill the CPU side of the local UBOs,
+    // buffer updates stay on this thread.
+    {
+        CC_PROFILE(RenderSceneUpdateUBO);
+        _parallelModels.clear();
+        for (const auto &model : _models.values()) {
+            if (!model->isEnabled()) {
+                continue;
+            }
+            if (model->isParallelUpdatable()) {
+                model->updateSubModelUBOs(stamp);
+                _parallelModels.emplace_back(model.get());
+            } else {
+                model->updateUBOs(stamp);
+            }
+        }
+        updateLocalUBOs(_parallelModels, Model::isLocalUBOForced(),
+                        Root::getInstance()->getPipeline()->isOcclusionQueryEnabled());
+    }
+
+    // Phase 3: octree re-insertion, serialized and batched.
+    {
+        CC_PROFILE(RenderSceneUpdateOctree);
+        _parallelModels.clear();
+        for (const auto &model : _models.values()) {
+            if (model->isEnabled() && model->isWorldBoundsDirty()) {
+                model->resetWorldBoundsDirty();
+                _parallelModels.emplace_back(model.get());
+            }
+        }
+        if (_octree && _octree->isEnabled() && !_parallelModels.empty()) {
+            _octree->update(_parallelModels);
         }
     }
 
@@ -110,6 +180,49 @@ void RenderScene::update(uint32_t stamp) {
     CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
 }
 
+void RenderScene::updateLocalUBOs(const ccstd::vector<Model *> &models, bool forceUpdate, bool updateWorldBounds, JobSystem *jobSystem) {
+    forEachModelParallel(jobSystem ? jobSystem : JobSystem::getInstance(), models, [forceUpdate](Model *model) {
+        model->writeLocalUBOs(forceUpdate);
+    });
+    for (auto *model : models) {
+        model->uploadLocalUBOs(updateWorldBounds);
+    }
+}
+
+void RenderScene::updateSHUBOs() {
+    // Models moving through light probes are located and interpolated as one batch,
+    // the per model update in phase 2 then skips them.
+    const auto *lightProbes = Root::getInstance()->getPipeline()->getPipelineSceneData()->getLightProbes();
+    if (!lightProbes || lightProbes->empty()) {
+        return;
+    }
+
+    CC_PROFILE(RenderSceneUpdateSH);
+    _parallelModels.clear();
+    _shPositions.clear();
+    _shTetIndices.clear();
+    for (const auto &model : _models.values()) {
+        if (model->isEnabled() && !model->isModelImplementedInJS() && model->isSHDirty()) {
+            _parallelModels.emplace_back(model.get());
+            _shPositions.emplace_back(model->getWorldBounds()->getCenter());
+            _shTetIndices.emplace_back(model->getTetrahedronIndex());
+        }
+    }
+
+    if (_parallelModels.empty() ||
+        !lightProbes->getData()->interpolateSHCoefficients(_shPositions, _shTetIndices, _shCoefficients)) {
+        return;
+    }
+
+    const auto basisCount = gi::SH::getBasisCount();
+    ccstd::vector<Vec3> coefficients(basisCount);
+    for (size_t i = 0; i < _parallelModels.size(); i++) {
+        const auto begin = _shCoefficients.begin() + static_cast<std::ptrdiff_t>(i * basisCount);
+        std::copy(begin, begin + basisCount, coefficients.begin());
+        _parallelModels[i]->applySHCoefficients(_shTetIndices[i], coefficients);
+    }
+}
+
 void RenderScene::destroy() {
     removeCameras();
     removeSphereLights();
@@ -168,77 +281,132 @@ void RenderScene::removeDirectionalLight(DirectionalLight *dl) {
     }
 }
 
+namespace {
+
+template <typename T>
+bool isInSlotMap(const SlotMap<IntrusivePtr<T>> &slotMap, const T *object) {
+    const auto *slot = slotMap.get(object->getSceneHandle());
+    return slot && slot->get() == object;
+}
+
+// The slot map may hold the last reference, so the object is reset before being erased.
+template <typename T>
+bool eraseFromSlotMap(SlotMap<IntrusivePtr<T>> &slotMap, T *object) {
+    if (!isInSlotMap(slotMap, object)) {
+        return false;
+    }
+    const auto handle = object->getSceneHandle();
+    object->setSceneHandle({});
+    slotMap.erase(handle);
+    return true;
+}
+
+} // namespace
+
 void RenderScene::addSphereLight(SphereLight *light) {
-    _sphereLights.emplace_back(light);
+    light->setSceneHandle(_sphereLights.insert(light));
 }
 
 void RenderScene::removeSphereLight(SphereLight *sphereLight) {
-    auto iter = std::find(_sphereLights.begin(), _sphereLights.end(), sphereLight);
-    if (iter != _sphereLights.end()) {
-        _sphereLights.erase(iter);
-    } else {
+    if (!eraseFromSlotMap(_sphereLights, sphereLight)) {
         CC_LOG_WARNING("Try to remove invalid sphere light.");
     }
 }
 
 void RenderScene::addSpotLight(SpotLight *spotLight) {
-    _spotLights.emplace_back(spotLight);
+    spotLight->setSceneHandle(_spotLights.insert(spotLight));
 }
 
 void RenderScene::removeSpotLight(SpotLight *spotLight) {
-    auto iter = std::find(_spotLights.begin(), _spotLights.end(), spotLight);
-    if (iter != _spotLights.end()) {
-        _spotLights.erase(iter);
-    } else {
+    if (!eraseFromSlotMap(_spotLights, spotLight)) {
         CC_LOG_WARNING("Try to remove invalid spot light.");
     }
 }
 
 void RenderScene::removeSphereLights() {
-    for (const auto &sphereLight : _sphereLights) {
+    for (const auto &sphereLight : _sphereLights.values()) {
         sphereLight->detachFromScene();
+        sphereLight->setSceneHandle({});
     }
     _sphereLights.clear();
 }
 
 void RenderScene::removeSpotLights() {
-    for (const auto &spotLight : _spotLights) {
+    for (const auto &spotLight : _spotLights.values()) {
         spotLight->detachFromScene();
+        spotLight->setSceneHandle({});
     }
     _spotLights.clear();
 }
 
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
-    _models.emplace_back(model);
+    model->setSceneHandle(_models.insert(model));
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
 }
 
+bool RenderScene::eraseModel(Model *model) {
+    if (!isInSlotMap(_models, model)) {
+        return false;
+    }
+    model->detachFromScene();
+    return eraseFromSlotMap(_models, model);
+}
+
 void RenderScene::removeModel(Model *model) {
-    auto iter = std::find(_models.begin(), _models.end(), model);
-    if (iter != _models.end()) {
-        if (_octree && _octree->isEnabled()) {
-            _octree->remove(*iter);
-        }
-        model->detachFromScene();
-        _models.erase(iter);
-    } else {
+    if (!isInSlotMap(_models, model)) {
         CC_LOG_WARNING("Try to remove invalid model.");
+        return;
+    }
+    if (_octree && _octree->isEnabled()) {
+        _octree->remove(model);
+    }
+    eraseModel(model);
+}
+
+void RenderScene::addModels(const ccstd::vector<Model *> &models) {
+    _models.reserve(_models.size() + models.size());
+    for (auto *model : models) {
+        model->attachToScene(this);
+        model->setSceneHandle(_models.insert(model));
+    }
+    if (_octree && _octree->isEnabled()) {
+        _octree->insert(models);
+    }
+}
+
+void RenderScene::removeModels(const ccstd::vector<Model *> &models) {
+    ccstd::vector<Model *> removed;
+    removed.reserve(models.size());
+    for (auto *model : models) {
+        if (isInSlotMap(_models, model)) {
+            removed.emplace_back(model);
+        } else {
+            CC_LOG_WARNING("Try to remove invalid model.");
+        }
+    }
+    if (_octree && _octree->isEnabled()) {
+        _octree->remove(removed);
+    }
+    for (auto *model : removed) {
+        eraseModel(model);
     }
 }
 
 void RenderScene::removeModels() {
-    for (const auto &model : _models) {
+    for (const auto &model : _models.values()) {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(model);
         }
         model->detachFromScene();
+        model->setSceneHandle({});
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
 }
+
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
 }
@@ -263,7 +431,7 @@ void RenderScene::updateOctree(Model *model) {
 }
 
 void RenderScene::onGlobalPipelineStateChanged() {
-    for (const auto &model : _models) {
+    for (const auto &model : _models.values()) {
         model->onGlobalPipelineStateChanged();
     }
 }
@@ -28,8 +28,11 @@
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/SlotMap.h"
+#include "base/job-system/JobSystem.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "math/Vec3.h"
 
 namespace cc {
 
@@ -91,6 +94,9 @@ public:
     void addModel(Model *);
     void removeModel(Model *model);
     void removeModels();
+    // Bulk versions for streaming, the octree is updated once for the whole batch.
+    void addModels(const ccstd::vector<Model *> &models);
+    void removeModels(const ccstd::vector<Model *> &models);
 
     void addBatch(DrawBatch2D *);
     void removeBatch(DrawBatch2D *);
@@ -105,23 +111,36 @@ public:
     inline const ccstd::string &getName() const { return _name; }
     inline const ccstd::vector<IntrusivePtr<Camera>> &getCameras() const { return _cameras; }
     inline const ccstd::vector<IntrusivePtr<LODGroup>> &getLODGroups() const { return _lodGroups; }
-    inline const ccstd::vector<IntrusivePtr<SphereLight>> &getSphereLights() const { return _sphereLights; }
-    inline const ccstd::vector<IntrusivePtr<SpotLight>> &getSpotLights() const { return _spotLights; }
-    inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
+    inline const ccstd::vector<IntrusivePtr<SphereLight>> &getSphereLights() const { return _sphereLights.values(); }
+    inline const ccstd::vector<IntrusivePtr<SpotLight>> &getSpotLights() const { return _spotLights.values(); }
+    inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models.values(); }
     inline Octree *getOctree() const { return _octree; }
     void updateOctree(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
+    // Phase 2 of update() for plain models: the jobs write the local UBO data,
+    // the buffers are uploaded on the calling thread afterwards. The jobs run on jobSystem, the shared one when null.
+    static void updateLocalUBOs(const ccstd::vector<Model *> &models, bool forceUpdate, bool updateWorldBounds, JobSystem *jobSystem = nullptr);
+
 private:
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
-    ccstd::vector<IntrusivePtr<Model>> _models;
+    bool eraseModel(Model *model);
+    void updateSHUBOs();
+
+    // The slot maps keep the iteration dense and remove in O(1), removal does not preserve the order.
+    SlotMap<IntrusivePtr<Model>> _models;
+    ccstd::vector<Model *> _parallelModels; // scratch list of RenderScene::update
+    // scratch of the batched light probe SH update
+    ccstd::vector<Vec3> _shPositions;
+    ccstd::vector<int32_t> _shTetIndices;
+    ccstd::vector<Vec3> _shCoefficients;
     ccstd::vector<IntrusivePtr<Camera>> _cameras;
     ccstd::vector<IntrusivePtr<DirectionalLight>> _directionalLights;
     ccstd::vector<IntrusivePtr<LODGroup>> _lodGroups;
-    ccstd::vector<IntrusivePtr<SphereLight>> _sphereLights;
-    ccstd::vector<IntrusivePtr<SpotLight>> _spotLights;
+    SlotMap<IntrusivePtr<SphereLight>> _sphereLights;
+    SlotMap<IntrusivePtr<SpotLight>> _spotLights;
     ccstd::vector<DrawBatch2D *> _batches;
     Octree *_octree{nullptr};
 
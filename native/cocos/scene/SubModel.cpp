@@ -233,6 +233,7 @@ void SubModel::destroy() {
     _subMesh = nullptr;
     _passes.reset();
     _shaders.clear();
+    ++_shaderGeneration;
 
     CC_SAFE_DESTROY_NULL(_reflectionTex);
     _reflectionSampler = nullptr;
@@ -357,8 +358,16 @@ void SubModel::flushPassInfo() {
         _shaders.clear();
     }
     _shaders.resize(passes.size());
+    const auto generation = ++_shaderGeneration;
     for (size_t i = 0; i < passes.size(); ++i) {
-        _shaders[i] = passes[i]->getShaderVariant(_patches);
+        // a variant compiled in the background replaces the default variant once ready
+        IntrusivePtr<SubModel> self{this};
+        _shaders[i] = passes[i]->getShaderVariantAsync(_patches, [self, i, generation](gfx::Shader *shader) {
+            // a failed variant keeps the stand-in, the registered fallback or nothing
+            if (self->_shaderGeneration == generation && shader) {
+                self->_shaders[i] = shader;
+            }
+        });
     }
 }
 
@@ -122,6 +122,7 @@ protected:
 
     ccstd::vector<IMacroPatch> _patches;
     ccstd::vector<IntrusivePtr<gfx::Shader>> _shaders;
+    uint32_t _shaderGeneration{0}; // bumped when _shaders is rebuilt, stale compile callbacks are ignored
 
     std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> _passes;
 
@@ -0,0 +1,140 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_DEBUG_RENDERER
+
+    #include "core/assets/GlyphAtlas.h"
+    #include "gtest/gtest.h"
+
+using namespace cc;
+
+TEST(GlyphAtlasTest, shelvesPackByHeight) {
+    GlyphAtlas atlas(64, 64);
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    // no page yet
+    EXPECT_FALSE(atlas.allocate(1, 10, 8, 1, page, x, y));
+    atlas.addPage();
+
+    ASSERT_TRUE(atlas.allocate(1, 10, 8, 1, page, x, y));
+    EXPECT_EQ(page, 0U);
+    EXPECT_EQ(x, 0U);
+    EXPECT_EQ(y, 0U);
+    ASSERT_TRUE(atlas.allocate(2, 10, 8, 1, page, x, y));
+    EXPECT_EQ(x, 10U);
+    EXPECT_EQ(y, 0U);
+
+    // too tall for the first shelf, opens a new one below it
+    ASSERT_TRUE(atlas.allocate(3, 10, 16, 1, page, x, y));
+    EXPECT_EQ(x, 0U);
+    EXPECT_EQ(y, 8U);
+
+    // wastes 2 of 8 rows, fits the first shelf
+    ASSERT_TRUE(atlas.allocate(4, 10, 6, 1, page, x, y));
+    EXPECT_EQ(x, 20U);
+    EXPECT_EQ(y, 0U);
+
+    // would waste more than half of its height on any shelf, opens a new one
+    ASSERT_TRUE(atlas.allocate(5, 10, 2, 1, page, x, y));
+    EXPECT_EQ(x, 0U);
+    EXPECT_EQ(y, 24U);
+
+    EXPECT_FLOAT_EQ(atlas.getOccupancy(), static_cast<float>(10 * 8 * 2 + 10 * 16 + 10 * 6 + 10 * 2) / (64.F * 64.F));
+
+    // wider than the texture, or taller than what is left of it
+    EXPECT_FALSE(atlas.allocate(6, 65, 8, 1, page, x, y));
+    EXPECT_FALSE(atlas.allocate(7, 10, 40, 1, page, x, y));
+
+    // a second page takes what the first one cannot hold
+    atlas.addPage();
+    ASSERT_TRUE(atlas.allocate(7, 10, 40, 1, page, x, y));
+    EXPECT_EQ(page, 1U);
+    EXPECT_EQ(y, 0U);
+}
+
+TEST(GlyphAtlasTest, evictsLeastRecentlyUsedShelf) {
+    GlyphAtlas atlas(16, 16);
+    atlas.addPage();
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    ASSERT_TRUE(atlas.allocate(1, 16, 8, 1, page, x, y));
+    ASSERT_TRUE(atlas.allocate(2, 16, 8, 2, page, x, y));
+    EXPECT_EQ(y, 8U);
+    EXPECT_FALSE(atlas.allocate(3, 16, 8, 3, page, x, y));
+
+    // glyph 1 was used last, the shelf of glyph 2 goes
+    atlas.touch(1, 3);
+    ccstd::vector<uint32_t> evicted;
+    ASSERT_TRUE(atlas.evict(8, 4, evicted));
+    EXPECT_EQ(evicted, ccstd::vector<uint32_t>{2});
+    EXPECT_FLOAT_EQ(atlas.getOccupancy(), 0.5F);
+
+    ASSERT_TRUE(atlas.allocate(3, 16, 8, 4, page, x, y));
+    EXPECT_EQ(x, 0U);
+    EXPECT_EQ(y, 8U);
+
+    // shelves used since the protected stamp stay, so do shelves lower than the glyph
+    EXPECT_FALSE(atlas.evict(8, 3, evicted));
+    EXPECT_FALSE(atlas.evict(9, 5, evicted));
+
+    // touching an evicted glyph does not protect the shelf it used to be on
+    atlas.touch(2, 10);
+    ASSERT_TRUE(atlas.evict(8, 5, evicted));
+    EXPECT_EQ(evicted, ccstd::vector<uint32_t>{1});
+}
+
+TEST(GlyphAtlasTest, sdfDistances) {
+    // a solid 32 x 32 square rasterized at 4 times the SDF size
+    constexpr int32_t SCALE = 4;
+    constexpr uint32_t SIZE = 32;
+    const ccstd::vector<uint8_t> bitmap(SIZE * SIZE, 255U);
+    GlyphBitmap out;
+    generateSDF(bitmap.data(), SIZE, SIZE, static_cast<int32_t>(SIZE), 0, static_cast<int32_t>(SIZE), SCALE, out);
+
+    // SDF_SPREAD texels of padding on each side, the bearings move by the padding
+    ASSERT_EQ(out.glyph.width, SIZE / SCALE + 2 * SDF_SPREAD);
+    ASSERT_EQ(out.glyph.height, SIZE / SCALE + 2 * SDF_SPREAD);
+    EXPECT_EQ(out.glyph.bearingX, -static_cast<int32_t>(SDF_SPREAD));
+    EXPECT_EQ(out.glyph.bearingY, static_cast<int32_t>(SIZE / SCALE + SDF_SPREAD));
+    const uint32_t stride = out.glyph.width + 1U;
+    ASSERT_EQ(out.buffer.size(), stride * (out.glyph.height + 1U));
+
+    // across the middle row the value rises by 1 / (2 * SDF_SPREAD) per texel and crosses 0.5 on the outline
+    const ccstd::vector<uint8_t> expected{16, 48, 80, 112, 143, 175, 207, 237, 237, 207, 175, 143, 112, 80, 48, 16};
+    const uint32_t row = out.glyph.height / 2;
+    const ccstd::vector<uint8_t> middle(out.buffer.begin() + row * stride, out.buffer.begin() + row * stride + out.glyph.width);
+    EXPECT_EQ(middle, expected);
+
+    // far from the square the distance is clamped, the padding column and row stay empty
+    EXPECT_EQ(out.buffer[0], 0U);
+    EXPECT_EQ(out.buffer[row * stride + out.glyph.width], 0U);
+    EXPECT_EQ(out.buffer[out.glyph.height * stride + row], 0U);
+}
+
+#endif
@@ -0,0 +1,154 @@
+/****************************************************************************
+Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <map>
+#include <vector>
+#include "cocos/renderer/pipeline/custom/FGDispatcherAliasing.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/Range.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+// [first pass, last pass] of every resource accessed by the access graph
+std::map<uint32_t, std::pair<uint32_t, uint32_t>> collectLifetimes(const cc::render::ResourceAccessGraph& rag) {
+    using namespace cc;         // NOLINT
+    using namespace cc::render; // NOLINT
+    std::map<uint32_t, std::pair<uint32_t, uint32_t>> lifetimes;
+    for (const auto vertID : makeRange(vertices(rag))) {
+        const auto& node = get(ResourceAccessGraph::AccessNode, rag, vertID);
+        for (const auto& status : node.attachmentStatus) {
+            auto iter = lifetimes.find(status.vertID);
+            if (iter == lifetimes.end()) {
+                lifetimes.emplace(status.vertID, std::make_pair(vertID, vertID));
+            } else {
+                iter->second.second = vertID;
+            }
+        }
+    }
+    return lifetimes;
+}
+
+} // namespace
+
+TEST(fgDispatherAliasing, test1) {
+    TEST_CASE_1;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+    ResourceAliasing aliasing(resource);
+    aliasTransientResources(fgDispatcher, aliasing);
+
+    // "0" retires after pass 1, "5" is first written in pass 2 and takes its memory.
+    const auto res0 = rescGraph.valueIndex.at("0");
+    const auto res5 = rescGraph.valueIndex.at("5");
+    ExpectEq(aliasing.resourceAliases.size() == 1, true);
+    ExpectEq(aliasing.resourceAliases.at(res5) == res0, true);
+
+    // five 960x640 RGBA8 textures fit in four
+    const uint64_t textureSize = 960 * 640 * 4;
+    ExpectEq(aliasing.transientMemorySize == 5 * textureSize, true);
+    ExpectEq(aliasing.aliasedMemorySize == 4 * textureSize, true);
+
+    // alias barrier: last access of "0" in pass 1 -> first access of "5" in pass 2
+    const auto& barrierMap = fgDispatcher.getBarriers();
+    ExpectEq(barrierMap.find(2) != barrierMap.end(), true);
+    const auto& frontBarriers = barrierMap.at(2).blockBarrier.frontBarriers;
+    ExpectEq(!frontBarriers.empty(), true);
+    ExpectEq(frontBarriers.front().resourceID == res5, true);
+    ExpectEq(frontBarriers.front().beginStatus.vertID == 1, true);
+    ExpectEq(frontBarriers.front().endStatus.vertID == 2, true);
+}
+
+TEST(fgDispatherAliasing, test2) {
+    TEST_CASE_2;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+    ResourceAliasing aliasing(resource);
+    aliasTransientResources(fgDispatcher, aliasing);
+
+    // 11 transient textures, at most 6 alive at the same time
+    const uint64_t textureSize = 960 * 640 * 4;
+    ExpectEq(aliasing.resourceAliases.size() == 5, true);
+    ExpectEq(aliasing.transientMemorySize == 11 * textureSize, true);
+    ExpectEq(aliasing.aliasedMemorySize == 6 * textureSize, true);
+    ExpectEq(aliasing.aliasTransitions.size() == aliasing.resourceAliases.size(), true);
+
+    // resources sharing memory never overlap
+    const auto lifetimes = collectLifetimes(fgDispatcher.resourceAccessGraph);
+    std::map<uint32_t, std::vector<uint32_t>> owners;
+    for (const auto& [resID, ownerID] : aliasing.resourceAliases) {
+        ExpectEq(aliasing.resourceAliases.find(ownerID) == aliasing.resourceAliases.end(), true);
+        owners[ownerID].emplace_back(resID);
+    }
+    for (auto& [ownerID, aliases] : owners) {
+        aliases.emplace_back(ownerID);
+        for (size_t i = 0; i != aliases.size(); ++i) {
+            for (size_t j = i + 1; j != aliases.size(); ++j) {
+                const auto& lhs = lifetimes.at(aliases[i]);
+                const auto& rhs = lifetimes.at(aliases[j]);
+                ExpectEq(lhs.second < rhs.first || rhs.second < lhs.first, true);
+            }
+        }
+    }
+}
+
+TEST(fgDispatherAliasing, disabled) {
+    TEST_CASE_2;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(false);
+    fgDispatcher.run();
+    ResourceAliasing aliasing(resource);
+    aliasTransientResources(fgDispatcher, aliasing);
+
+    ExpectEq(aliasing.resourceAliases.empty(), true);
+    ExpectEq(aliasing.aliasTransitions.empty(), true);
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-capture/CaptureReplayer.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+constexpr uint32_t QUEUE_ID = 1U;
+constexpr uint32_t QUERY_POOL_ID = 2U;
+constexpr uint32_t CMD_BUFF_ID = 3U;
+constexpr uint32_t BUFFER_ID = 10U;
+
+template <typename... Args>
+void writeRecord(CaptureWriter &writer, CaptureOp op, const Args &...args) {
+    writer.beginRecord(op);
+    writer(args...);
+    writer.endRecord();
+}
+
+ccstd::vector<uint8_t> buildTrace() {
+    CaptureWriter trace;
+    trace(CAPTURE_MAGIC, CAPTURE_VERSION);
+    writeRecord(trace, CaptureOp::DEVICE_OBJECTS, QUEUE_ID, QUERY_POOL_ID, CMD_BUFF_ID);
+
+    const BufferInfo bufferInfo{BufferUsageBit::VERTEX | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, 64U, 16U};
+    writeRecord(trace, CaptureOp::CREATE_BUFFER, BUFFER_ID, bufferInfo);
+
+    const ccstd::vector<float> vertices(16U, 1.F);
+    const CaptureBytes bytes{vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))};
+    writeRecord(trace, CaptureOp::UPDATE_BUFFER, BUFFER_ID, bytes);
+    writeRecord(trace, CaptureOp::RESIZE_BUFFER, BUFFER_ID, 128U);
+
+    // object references are stored as capture IDs, 0 stands for null
+    CaptureWriter commands;
+    writeRecord(commands, CaptureOp::CMD_BEGIN, 0U, 0U, 0U);
+    writeRecord(commands, CaptureOp::CMD_UPDATE_BUFFER, BUFFER_ID, bytes);
+    writeRecord(commands, CaptureOp::CMD_END);
+    writeRecord(trace, CaptureOp::COMMAND_BUFFER, CMD_BUFF_ID, CaptureBytes{commands.data(), commands.size()});
+
+    writeRecord(trace, CaptureOp::DESTROY, BUFFER_ID);
+    return trace.getData();
+}
+
+} // namespace
+
+TEST(GFXCaptureTest, replay) {
+    CaptureReplayer replayer(Device::getInstance());
+    ASSERT_TRUE(replayer.load(buildTrace()));
+    EXPECT_TRUE(replayer.replay());
+    EXPECT_EQ(replayer.getStats().records, 6U);
+    EXPECT_EQ(replayer.getStats().frames, 0U);
+}
+
+TEST(GFXCaptureTest, rejectMalformedTrace) {
+    CaptureReplayer replayer(Device::getInstance());
+
+    auto trace = buildTrace();
+    trace[0] = 0U;
+    EXPECT_FALSE(replayer.load(trace));
+
+    trace = buildTrace();
+    trace.resize(trace.size() - 2U);
+    ASSERT_TRUE(replayer.load(trace));
+    EXPECT_FALSE(replayer.replay());
+    EXPECT_EQ(replayer.getStats().records, 5U);
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+class GFXCommandBundleTest : public testing::Test {
+protected:
+    void SetUp() override {
+        device = Device::getInstance();
+        ASSERT_TRUE(device->hasFeature(Feature::COMMAND_BUNDLE));
+
+        RenderPassInfo renderPassInfo;
+        ColorAttachment color;
+        color.format = Format::RGBA8;
+        renderPassInfo.colorAttachments.push_back(color);
+        renderPass = device->createRenderPass(renderPassInfo);
+
+        DescriptorSetLayoutInfo layoutInfo;
+        layoutInfo.bindings.push_back({0, DescriptorType::DYNAMIC_UNIFORM_BUFFER, 1, ShaderStageFlagBit::VERTEX});
+        layout = device->createDescriptorSetLayout(layoutInfo);
+        descriptorSet = device->createDescriptorSet({layout});
+
+        primary = device->createCommandBuffer({device->getQueue(), CommandBufferType::PRIMARY});
+        bundle = device->createCommandBuffer({device->getQueue(), CommandBufferType::SECONDARY});
+    }
+
+    void recordBundle(uint32_t dynamicOffset) {
+        ASSERT_TRUE(bundle->beginBundle(renderPass, 0, nullptr));
+        bundle->bindDescriptorSet(0, descriptorSet, 1, &dynamicOffset);
+        bundle->end();
+    }
+
+    void executeBundle() {
+        primary->begin();
+        CommandBuffer *secondaries[]{bundle.get()};
+        primary->execute(secondaries, 1);
+        primary->end();
+        flush();
+    }
+
+    // with a device thread, the resources of released bundles are kept until the commands are flushed
+    void flush() {
+        CommandBuffer *cmdBuffs[]{bundle.get(), primary.get()};
+        device->flushCommands(cmdBuffs, 2);
+    }
+
+    Device *device{nullptr};
+    IntrusivePtr<RenderPass> renderPass;
+    IntrusivePtr<DescriptorSetLayout> layout;
+    IntrusivePtr<DescriptorSet> descriptorSet;
+    IntrusivePtr<CommandBuffer> primary;
+    IntrusivePtr<CommandBuffer> bundle;
+};
+
+} // namespace
+
+TEST_F(GFXCommandBundleTest, recordAndExecute) {
+    const auto refCount = descriptorSet->getRefCount();
+    recordBundle(256U);
+    EXPECT_TRUE(bundle->isBundle());
+    // the bundle keeps what it binds
+    EXPECT_GT(descriptorSet->getRefCount(), refCount);
+
+    // replayed in later frames without recording again
+    for (uint32_t frame = 0; frame < 4; ++frame) {
+        executeBundle();
+        EXPECT_TRUE(bundle->isBundle());
+    }
+}
+
+TEST_F(GFXCommandBundleTest, release) {
+    const auto refCount = descriptorSet->getRefCount();
+    recordBundle(0U);
+    bundle->releaseBundle();
+    flush();
+    EXPECT_FALSE(bundle->isBundle());
+    EXPECT_EQ(descriptorSet->getRefCount(), refCount);
+
+    // a plain begin drops the bundle as well
+    recordBundle(0U);
+    bundle->begin(renderPass, 0, nullptr);
+    bundle->end();
+    flush();
+    EXPECT_FALSE(bundle->isBundle());
+    EXPECT_EQ(descriptorSet->getRefCount(), refCount);
+
+    // so does recording it again, the new recording keeps its own resources
+    recordBundle(0U);
+    flush();
+    const auto bundledRefCount = descriptorSet->getRefCount();
+    recordBundle(0U);
+    flush();
+    EXPECT_TRUE(bundle->isBundle());
+    EXPECT_EQ(descriptorSet->getRefCount(), bundledRefCount);
+}
+
+TEST_F(GFXCommandBundleTest, updateDynamicOffsets) {
+    const uint32_t offset = 512U;
+    EXPECT_FALSE(bundle->updateBundleDynamicOffsets(0, 1, &offset));
+
+    recordBundle(0U);
+    EXPECT_TRUE(bundle->updateBundleDynamicOffsets(0, 1, &offset));
+    executeBundle();
+    EXPECT_TRUE(bundle->isBundle());
+
+    bundle->releaseBundle();
+    EXPECT_FALSE(bundle->updateBundleDynamicOffsets(0, 1, &offset));
+}
@@ -0,0 +1,365 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include "base/Data.h"
+#include "glslang/Public/ShaderLang.h"
+#include "glslang/build_info.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+#include "renderer/gfx-base/SPIRVUtils.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+// entry header: magic, version, key, source size, code word count, input location count
+constexpr uint32_t ENTRY_MAGIC{0x56505343};
+constexpr uint32_t INDEX_MAGIC{0x49505343};
+constexpr uint32_t CACHE_VERSION{1};
+constexpr size_t ENTRY_HEADER_SIZE{28};
+constexpr size_t INDEX_HEADER_SIZE{12};
+constexpr size_t INDEX_RECORD_SIZE{20};
+// the generator word of the SPIR-V header, replaced to tell cached code from freshly compiled code
+constexpr size_t GENERATOR_OFFSET{ENTRY_HEADER_SIZE + 2 * sizeof(uint32_t)};
+constexpr uint32_t TAMPERED_GENERATOR{0xDEADBEEF};
+#if CC_DEBUG > 0
+constexpr uint32_t STRIP_DEBUG_INFO{0};
+#else
+constexpr uint32_t STRIP_DEBUG_INFO{1};
+#endif
+
+template <typename T>
+T readValue(const ccstd::vector<uint8_t> &bytes, size_t offset) {
+    T value{};
+    memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t fnv1aValue(uint64_t hash, T value) {
+    return fnv1a(hash, &value, sizeof(value));
+}
+
+// sources of the same length compiling to code of the same size, so that entries weigh the same in the cache
+ccstd::string vertexSource(uint32_t scale) {
+    return "#version 450\nlayout(location = 0) in vec4 a_position;\nvoid main() { gl_Position = a_position * " +
+           std::to_string(scale) + ".5; }\n";
+}
+
+class GFXSPIRVCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        fileUtils = FileUtils::getInstance();
+        directory = fileUtils->getWritablePath() + "spirv-cache-test/";
+        fileUtils->removeDirectory(directory);
+        spirv = SPIRVUtils::getInstance();
+        spirv->initialize(0);
+    }
+
+    void TearDown() override {
+        spirv->destroy();
+        fileUtils->removeDirectory(directory);
+    }
+
+    ccstd::vector<uint32_t> compile(const ccstd::string &source) {
+        spirv->compileGLSL(ShaderStageFlagBit::VERTEX, source);
+        const auto size = spirv->getOutputSize() / sizeof(uint32_t);
+        const auto *code = spirv->getOutputData();
+        return {code, code + size};
+    }
+
+    // compiles the source into the cache and returns the name of the entry it added
+    ccstd::string compileEntry(const ccstd::string &source) {
+        const auto before = entryNames(directory);
+        compile(source);
+        const auto after = entryNames(directory);
+        ccstd::vector<ccstd::string> added;
+        std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+        EXPECT_EQ(added.size(), 1U);
+        return added.empty() ? ccstd::string{} : added[0];
+    }
+
+    ccstd::vector<ccstd::string> entryNames(const ccstd::string &dir) const {
+        ccstd::vector<ccstd::string> names;
+        for (const auto &path : fileUtils->listFiles(dir)) {
+            const auto name = path.substr(path.find_last_of('/') + 1);
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".spv") == 0) {
+                names.push_back(name);
+            }
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    ccstd::vector<uint8_t> readFile(const ccstd::string &path) const {
+        const Data data = fileUtils->getDataFromFile(path);
+        return {data.getBytes(), data.getBytes() + data.getSize()};
+    }
+
+    void writeFile(const ccstd::string &path, const ccstd::vector<uint8_t> &bytes) const {
+        Data data;
+        data.copy(bytes.data(), static_cast<uint32_t>(bytes.size()));
+        fileUtils->writeDataToFile(data, path);
+    }
+
+    void tamperGenerator(const ccstd::string &path) const {
+        auto bytes = readFile(path);
+        ASSERT_GT(bytes.size(), GENERATOR_OFFSET + sizeof(uint32_t));
+        memcpy(bytes.data() + GENERATOR_OFFSET, &TAMPERED_GENERATOR, sizeof(uint32_t));
+        writeFile(path, bytes);
+    }
+
+    bool exists(const ccstd::string &name) const {
+        return fileUtils->isFileExist(directory + name);
+    }
+
+    FileUtils *fileUtils{nullptr};
+    SPIRVUtils *spirv{nullptr};
+    ccstd::string directory;
+};
+
+} // namespace
+
+TEST_F(GFXSPIRVCacheTest, entryFormat) {
+    spirv->setCacheDirectory(directory);
+    const auto source = vertexSource(2);
+    const auto code = compile(source);
+    const auto names = entryNames(directory);
+    ASSERT_EQ(names.size(), 1U);
+
+    // FNV-1a over the cache version, the glslang version, the strip flag, the targets, the stage and the source
+    uint64_t key = 14695981039346656037ULL;
+    key = fnv1aValue(key, CACHE_VERSION);
+    key = fnv1aValue(key, static_cast<uint32_t>(GLSLANG_VERSION_MAJOR));
+    key = fnv1aValue(key, static_cast<uint32_t>(GLSLANG_VERSION_MINOR));
+    key = fnv1aValue(key, static_cast<uint32_t>(GLSLANG_VERSION_PATCH));
+    key = fnv1aValue(key, STRIP_DEBUG_INFO);
+    key = fnv1aValue(key, static_cast<uint32_t>(100));
+    key = fnv1aValue(key, static_cast<uint32_t>(glslang::EShTargetVulkan_1_0));
+    key = fnv1aValue(key, static_cast<uint32_t>(glslang::EShTargetSpv_1_0));
+    key = fnv1aValue(key, static_cast<uint32_t>(ShaderStageFlagBit::VERTEX));
+    key = fnv1a(key, source.data(), source.size());
+    char expectedName[24];
+    snprintf(expectedName, sizeof(expectedName), "%016llx.spv", static_cast<unsigned long long>(key)); // NOLINT(google-runtime-int)
+    EXPECT_EQ(names[0], expectedName);
+
+    const auto bytes = readFile(directory + names[0]);
+    ASSERT_GE(bytes.size(), ENTRY_HEADER_SIZE);
+    EXPECT_EQ(readValue<uint32_t>(bytes, 0), ENTRY_MAGIC);
+    EXPECT_EQ(readValue<uint32_t>(bytes, 4), CACHE_VERSION);
+    EXPECT_EQ(readValue<uint64_t>(bytes, 8), key);
+    EXPECT_EQ(readValue<uint32_t>(bytes, 16), source.size());
+    const auto codeCount = readValue<uint32_t>(bytes, 20);
+    const auto inputCount = readValue<uint32_t>(bytes, 24);
+    EXPECT_EQ(codeCount, code.size());
+    // a_position is the only active input
+    EXPECT_EQ(inputCount, 1U);
+    ASSERT_EQ(bytes.size(), ENTRY_HEADER_SIZE + (codeCount + inputCount) * sizeof(uint32_t));
+    EXPECT_EQ(memcmp(bytes.data() + ENTRY_HEADER_SIZE, code.data(), code.size() * sizeof(uint32_t)), 0);
+
+    // the index is written when the cache is closed
+    spirv->setCacheDirectory("");
+    const auto index = readFile(directory + "index.bin");
+    ASSERT_EQ(index.size(), INDEX_HEADER_SIZE + INDEX_RECORD_SIZE);
+    EXPECT_EQ(readValue<uint32_t>(index, 0), INDEX_MAGIC);
+    EXPECT_EQ(readValue<uint32_t>(index, 4), CACHE_VERSION);
+    EXPECT_EQ(readValue<uint32_t>(index, 8), 1U);
+    EXPECT_EQ(readValue<uint64_t>(index, INDEX_HEADER_SIZE), key);
+    EXPECT_EQ(readValue<uint32_t>(index, INDEX_HEADER_SIZE + 8), bytes.size());
+}
+
+TEST_F(GFXSPIRVCacheTest, hitAndMiss) {
+    spirv->setCacheDirectory(directory);
+    const auto name = compileEntry(vertexSource(2));
+    tamperGenerator(directory + name);
+
+    // a hit returns the stored code as it is
+    EXPECT_EQ(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+    // another source misses and is added
+    const auto other = compileEntry(vertexSource(3));
+    EXPECT_NE(other, name);
+    EXPECT_NE(compile(vertexSource(3))[2], TAMPERED_GENERATOR);
+
+    // entries survive reopening the cache
+    spirv->setCacheDirectory(directory);
+    EXPECT_EQ(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+
+    // disabled cache compiles every time
+    spirv->setCacheDirectory("");
+    EXPECT_NE(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+}
+
+TEST_F(GFXSPIRVCacheTest, invalidEntries) {
+    spirv->setCacheDirectory(directory);
+    const auto name = compileEntry(vertexSource(2));
+    const auto path = directory + name;
+    const auto valid = readFile(path);
+
+    // truncated entries are compiled again and rewritten
+    auto truncated = valid;
+    truncated.resize(ENTRY_HEADER_SIZE + 8);
+    writeFile(path, truncated);
+    EXPECT_NE(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+    EXPECT_EQ(readFile(path), valid);
+
+    // so are entries with a bad magic
+    tamperGenerator(path);
+    auto corrupted = readFile(path);
+    corrupted[0] ^= 0xFF;
+    writeFile(path, corrupted);
+    EXPECT_NE(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+    EXPECT_EQ(readFile(path), valid);
+
+    // and entries whose code is not SPIR-V
+    tamperGenerator(path);
+    auto garbage = readFile(path);
+    memset(garbage.data() + ENTRY_HEADER_SIZE, 0, sizeof(uint32_t));
+    writeFile(path, garbage);
+    EXPECT_NE(compile(vertexSource(2))[2], TAMPERED_GENERATOR);
+    EXPECT_EQ(readFile(path), valid);
+}
+
+TEST_F(GFXSPIRVCacheTest, evictLeastRecentlyUsed) {
+    spirv->setCacheDirectory(directory);
+    ccstd::vector<ccstd::string> names;
+    for (uint32_t scale = 1; scale <= 4; ++scale) {
+        names.push_back(compileEntry(vertexSource(scale)));
+    }
+    const auto entrySize = fileUtils->getFileSize(directory + names[0]);
+    for (const auto &name : names) {
+        ASSERT_EQ(fileUtils->getFileSize(directory + name), entrySize);
+    }
+
+    // exactly full, nothing is evicted
+    spirv->setCacheDirectory(directory, static_cast<uint32_t>(entrySize * 4));
+    EXPECT_EQ(entryNames(directory).size(), 4U);
+
+    // the first entry becomes the most recently used one
+    compile(vertexSource(1));
+    // over the budget, the least recently used entries go until 3/4 of it is left
+    names.push_back(compileEntry(vertexSource(5)));
+    EXPECT_TRUE(exists(names[0]));
+    EXPECT_FALSE(exists(names[1]));
+    EXPECT_FALSE(exists(names[2]));
+    EXPECT_TRUE(exists(names[3]));
+    EXPECT_TRUE(exists(names[4]));
+
+    // the index no longer lists the evicted entries
+    spirv->setCacheDirectory("");
+    const auto index = readFile(directory + "index.bin");
+    EXPECT_EQ(readValue<uint32_t>(index, 8), 3U);
+}
+
+TEST_F(GFXSPIRVCacheTest, adoptUnindexedEntries) {
+    spirv->setCacheDirectory(directory);
+    const auto first = compileEntry(vertexSource(1));
+    const auto second = compileEntry(vertexSource(2));
+    spirv->setCacheDirectory("");
+    const auto entrySize = fileUtils->getFileSize(directory + first);
+
+    // written behind the back of the index, like the stores after the last index save of a crashed run
+    ASSERT_TRUE(spirv->precompile(0, ShaderStageFlagBit::VERTEX, vertexSource(3), directory));
+    const auto names = entryNames(directory);
+    ASSERT_EQ(names.size(), 3U);
+    ccstd::string adopted;
+    for (const auto &name : names) {
+        if (name != first && name != second) {
+            adopted = name;
+        }
+    }
+
+    spirv->setCacheDirectory(directory, static_cast<uint32_t>(entrySize * 3));
+    // adopting an entry rewrites the index
+    EXPECT_EQ(readValue<uint32_t>(readFile(directory + "index.bin"), 8), 3U);
+    // and the adopted entry is served
+    tamperGenerator(directory + adopted);
+    EXPECT_EQ(compile(vertexSource(3))[2], TAMPERED_GENERATOR);
+
+    // the adopted entry was just used, so the oldest indexed entry goes first, then the second one
+    compileEntry(vertexSource(4));
+    EXPECT_FALSE(exists(first));
+    EXPECT_FALSE(exists(second));
+    EXPECT_TRUE(exists(adopted));
+}
+
+TEST_F(GFXSPIRVCacheTest, adoptedEntriesAreEvictedFirst) {
+    spirv->setCacheDirectory(directory);
+    const auto first = compileEntry(vertexSource(1));
+    const auto second = compileEntry(vertexSource(2));
+    spirv->setCacheDirectory("");
+    const auto entrySize = fileUtils->getFileSize(directory + first);
+
+    ASSERT_TRUE(spirv->precompile(0, ShaderStageFlagBit::VERTEX, vertexSource(3), directory));
+    spirv->setCacheDirectory(directory, static_cast<uint32_t>(entrySize * 3));
+    const auto names = entryNames(directory);
+    ccstd::string adopted;
+    for (const auto &name : names) {
+        if (name != first && name != second) {
+            adopted = name;
+        }
+    }
+
+    // never used since adoption, so older than every indexed entry
+    compileEntry(vertexSource(4));
+    EXPECT_FALSE(exists(adopted));
+    EXPECT_FALSE(exists(first));
+    EXPECT_TRUE(exists(second));
+}
+
+TEST_F(GFXSPIRVCacheTest, precompile) {
+    const auto prewarmed = directory + "prewarmed/";
+    const auto source = vertexSource(2);
+    ASSERT_TRUE(spirv->precompile(0, ShaderStageFlagBit::VERTEX, source, prewarmed));
+    ASSERT_TRUE(spirv->precompile(1, ShaderStageFlagBit::VERTEX, source, prewarmed));
+    // the target version is part of the key
+    const auto names = entryNames(prewarmed);
+    ASSERT_EQ(names.size(), 2U);
+
+    // the versions of the runtime are restored, so the entry for version 0 is the one served
+    spirv->setPrewarmedCacheDirectory(prewarmed);
+    for (const auto &name : names) {
+        tamperGenerator(prewarmed + name);
+    }
+    EXPECT_EQ(compile(source)[2], TAMPERED_GENERATOR);
+
+    // the writable cache is consulted first and the prewarmed one left untouched on a miss
+    spirv->setCacheDirectory(directory);
+    EXPECT_FALSE(compile(vertexSource(3)).empty());
+    EXPECT_EQ(entryNames(prewarmed).size(), 2U);
+    EXPECT_EQ(entryNames(directory).size(), 1U);
+}
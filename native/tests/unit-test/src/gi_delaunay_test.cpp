@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "gi/light-probe/Delaunay.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace cc::gi;
+
+namespace {
+
+ccstd::vector<Vertex> randomProbes(uint32_t count) {
+    std::mt19937 random(count);
+    std::uniform_real_distribution<float> distribution(-50.0F, 50.0F);
+
+    ccstd::vector<Vertex> probes;
+    probes.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        probes.emplace_back(Vec3(distribution(random), distribution(random) * 0.2F, distribution(random)));
+    }
+
+    return probes;
+}
+
+ccstd::vector<Vertex> gridProbes(uint32_t size, float spacing) {
+    ccstd::vector<Vertex> probes;
+    for (uint32_t z = 0; z < size; z++) {
+        for (uint32_t y = 0; y < size; y++) {
+            for (uint32_t x = 0; x < size; x++) {
+                probes.emplace_back(Vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * spacing);
+            }
+        }
+    }
+
+    return probes;
+}
+
+float volume(const ccstd::vector<Vertex> &probes, const Tetrahedron &tetrahedron) {
+    const auto &p3 = probes[tetrahedron.vertex3].position;
+    Vec3 normal;
+    Vec3::cross(probes[tetrahedron.vertex1].position - p3, probes[tetrahedron.vertex2].position - p3, &normal);
+    return std::abs(normal.dot(probes[tetrahedron.vertex0].position - p3)) / 6.0F;
+}
+
+void expectSymmetricAdjacency(const ccstd::vector<Tetrahedron> &tetrahedrons) {
+    for (auto i = 0; i < static_cast<int32_t>(tetrahedrons.size()); i++) {
+        for (const auto neighbour : tetrahedrons[i].neighbours) {
+            ASSERT_GE(neighbour, 0);
+            const auto &neighbours = tetrahedrons[neighbour].neighbours;
+            EXPECT_NE(std::find(neighbours.begin(), neighbours.end(), i), neighbours.end());
+        }
+    }
+}
+
+} // namespace
+
+TEST(giDelaunayTest, emptyCircumSphere) {
+    Delaunay delaunay;
+    const auto tetrahedrons = delaunay.build(randomProbes(1000));
+    const auto &probes = delaunay.getProbes();
+    ASSERT_EQ(probes.size(), 1000);
+
+    for (const auto &tetrahedron : tetrahedrons) {
+        if (tetrahedron.isOuterCell()) {
+            continue;
+        }
+
+        for (auto i = 0; i < static_cast<int32_t>(probes.size()); i++) {
+            if (!tetrahedron.contain(i)) {
+                EXPECT_FALSE(tetrahedron.isInCircumSphere(probes[i].position));
+            }
+        }
+    }
+
+    expectSymmetricAdjacency(tetrahedrons);
+}
+
+TEST(giDelaunayTest, regularGrid) {
+    // every cube of the grid is cospherical, the tetrahedrons must still tile the grid exactly once
+    constexpr uint32_t size = 8;
+    constexpr float spacing = 2.0F;
+    Delaunay delaunay;
+    const auto tetrahedrons = delaunay.build(gridProbes(size, spacing));
+    const auto &probes = delaunay.getProbes();
+
+    float totalVolume = 0.0F;
+    for (const auto &tetrahedron : tetrahedrons) {
+        if (tetrahedron.isInnerTetrahedron()) {
+            totalVolume += volume(probes, tetrahedron);
+
+            // barycentric matrix maps vertex0 to (1, 0, 0)
+            Vec3 coord = probes[tetrahedron.vertex0].position - probes[tetrahedron.vertex3].position;
+            coord.transformMat3(coord, tetrahedron.matrix);
+            EXPECT_NEAR(coord.x, 1.0F, 1e-4F);
+            EXPECT_NEAR(coord.y, 0.0F, 1e-4F);
+            EXPECT_NEAR(coord.z, 0.0F, 1e-4F);
+        }
+    }
+
+    const float extent = static_cast<float>(size - 1) * spacing;
+    EXPECT_NEAR(totalVolume, extent * extent * extent, extent * extent * extent * 1e-4F);
+    expectSymmetricAdjacency(tetrahedrons);
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(giDelaunayTest, DISABLED_benchmark) {
+    for (const uint32_t count : {1000U, 10000U, 50000U}) {
+        const auto probes = randomProbes(count);
+        const auto start = std::chrono::steady_clock::now();
+        Delaunay delaunay;
+        const auto tetrahedrons = delaunay.build(probes);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("Delaunay %u probes: %zu tetrahedrons in %.1f ms\n", count, tetrahedrons.size(), elapsed);
+    }
+}
@@ -0,0 +1,94 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include "gi/light-probe/LightProbe.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace cc::gi;
+
+namespace {
+
+// coefficients linear in the position are reproduced exactly by the barycentric interpolation
+Vec3 getCoefficient(const Vec3 &position, uint32_t basis) {
+    return position * static_cast<float>(basis + 1) + Vec3(1.0F, 2.0F, 3.0F);
+}
+
+IntrusivePtr<LightProbesData> createData() {
+    ccstd::vector<Vec3> points;
+    for (uint32_t z = 0; z < 6; z++) {
+        for (uint32_t y = 0; y < 3; y++) {
+            for (uint32_t x = 0; x < 6; x++) {
+                points.emplace_back(static_cast<float>(x) * 4.0F, static_cast<float>(y) * 2.0F, static_cast<float>(z) * 4.0F);
+            }
+        }
+    }
+
+    IntrusivePtr<LightProbesData> data = new LightProbesData();
+    data->updateProbes(points);
+    data->updateTetrahedrons();
+    for (auto &probe : data->getProbes()) {
+        for (uint32_t i = 0; i < SH::getBasisCount(); i++) {
+            probe.coefficients.emplace_back(getCoefficient(probe.position, i));
+        }
+    }
+
+    return data;
+}
+
+} // namespace
+
+TEST(giLightProbeTest, interpolateSHCoefficients) {
+    auto data = createData();
+    const auto basisCount = SH::getBasisCount();
+
+    ccstd::vector<Vec3> positions{{1.0F, 1.0F, 1.0F}, {10.5F, 3.5F, 7.25F}, {19.0F, 0.5F, 19.0F}, {2.0F, 2.0F, 17.0F}};
+    ccstd::vector<int32_t> tetIndices(positions.size(), -1);
+    ccstd::vector<Vec3> coefficients;
+
+    // first frame from the cell grid, then teleport and small moves starting from the last tetrahedrons
+    for (const Vec3 offset : {Vec3::ZERO, Vec3(0.1F, 0.0F, 0.1F), Vec3(-0.5F, 0.2F, 0.3F)}) {
+        std::reverse(positions.begin(), positions.end());
+        for (auto &position : positions) {
+            position += offset;
+        }
+
+        ASSERT_TRUE(data->interpolateSHCoefficients(positions, tetIndices, coefficients));
+        ASSERT_EQ(coefficients.size(), positions.size() * basisCount);
+
+        for (size_t i = 0; i < positions.size(); i++) {
+            ASSERT_TRUE(tetIndices[i] >= 0 && tetIndices[i] < static_cast<int32_t>(data->getTetrahedrons().size()));
+            EXPECT_TRUE(data->getTetrahedrons()[tetIndices[i]].isInnerTetrahedron());
+
+            for (uint32_t k = 0; k < basisCount; k++) {
+                const auto expected = getCoefficient(positions[i], k);
+                const auto &result = coefficients[i * basisCount + k];
+                EXPECT_NEAR(result.x, expected.x, 1e-3F);
+                EXPECT_NEAR(result.y, expected.y, 1e-3F);
+                EXPECT_NEAR(result.z, expected.z, 1e-3F);
+            }
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <random>
+#include "base/job-system/JobSystem.h"
+#include "gi/light-probe/SH.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace cc::gi;
+
+namespace {
+
+ccstd::vector<Vec3> createValues(const ccstd::vector<Vec3> &samples, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> distribution(0.0F, 1.0F);
+
+    ccstd::vector<Vec3> values;
+    for (const auto &sample : samples) {
+        const Vec3 color{distribution(random), distribution(random), distribution(random)};
+        values.emplace_back(color * (sample.z + 1.5F));
+    }
+
+    return values;
+}
+
+} // namespace
+
+TEST(giSHTest, projectMatchesBasis) {
+    const auto samples = LightProbeSampler::uniformSampleSphereAll(128 * 128);
+    const auto basisCount = SH::getBasisCount();
+
+    // a function made of sh basis functions projects back to its coefficients
+    ccstd::vector<Vec3> expected;
+    for (uint32_t i = 0; i < basisCount; i++) {
+        expected.emplace_back(static_cast<float>(i) * 0.1F + 0.2F, 0.5F - static_cast<float>(i) * 0.05F, 0.3F);
+    }
+
+    ccstd::vector<Vec3> values;
+    for (const auto &sample : samples) {
+        values.push_back(SH::evaluate(sample, expected));
+    }
+
+    const auto coefficients = SH::project(samples, values);
+    ASSERT_EQ(coefficients.size(), basisCount);
+    for (uint32_t i = 0; i < basisCount; i++) {
+        EXPECT_NEAR(coefficients[i].x, expected[i].x, 0.01F);
+        EXPECT_NEAR(coefficients[i].y, expected[i].y, 0.01F);
+        EXPECT_NEAR(coefficients[i].z, expected[i].z, 0.01F);
+    }
+}
+
+TEST(giSHTest, projectProbesIsDeterministic) {
+    // an odd sample count leaves a partial block and partial lanes
+    const auto samples = LightProbeSampler::uniformSampleSphereAll(37 * 37);
+    const auto basisCount = SH::getBasisCount();
+    const uint32_t probeCount = 33;
+
+    ccstd::vector<Vec3> values;
+    for (uint32_t probe = 0; probe < probeCount; probe++) {
+        const auto probeValues = createValues(samples, probe);
+        values.insert(values.end(), probeValues.begin(), probeValues.end());
+    }
+
+    ccstd::vector<Vec3> coefficients;
+    SH::projectProbes(samples, values, coefficients);
+    ASSERT_EQ(coefficients.size(), probeCount * basisCount);
+    EXPECT_TRUE(SH::projectProbes(samples, values) == coefficients);
+
+    // bit-identical to projecting the probes one by one, however the work was spread over the threads
+    for (uint32_t probe = 0; probe < probeCount; probe++) {
+        const ccstd::vector<Vec3> probeValues(values.begin() + probe * samples.size(), values.begin() + (probe + 1) * samples.size());
+        const auto expected = SH::project(samples, probeValues);
+        for (uint32_t i = 0; i < basisCount; i++) {
+            EXPECT_EQ(coefficients[probe * basisCount + i].x, expected[i].x);
+            EXPECT_EQ(coefficients[probe * basisCount + i].y, expected[i].y);
+            EXPECT_EQ(coefficients[probe * basisCount + i].z, expected[i].z);
+        }
+    }
+}
+
+// projects with a job system of GetParam() workers, built through its thread count constructor
+class giSHWorkerCountTest : public testing::TestWithParam<uint32_t> {
+protected:
+    JobSystem singleWorker{1U};
+    JobSystem workers{GetParam()};
+};
+
+TEST_P(giSHWorkerCountTest, projectIsIndependentOfWorkerCount) {
+    // enough samples and probes to be split over every worker
+    const auto samples = LightProbeSampler::uniformSampleSphereAll(101 * 101);
+    const uint32_t probeCount = 41;
+
+    ccstd::vector<Vec3> values;
+    for (uint32_t probe = 0; probe < probeCount; probe++) {
+        const auto probeValues = createValues(samples, probe);
+        values.insert(values.end(), probeValues.begin(), probeValues.end());
+    }
+    const ccstd::vector<Vec3> firstProbeValues(values.begin(), values.begin() + samples.size());
+
+    const auto expectedProbes = SH::projectProbes(samples, values, &singleWorker);
+    const auto expected = SH::project(samples, firstProbeValues, &singleWorker);
+
+    EXPECT_TRUE(SH::projectProbes(samples, values, &workers) == expectedProbes);
+    EXPECT_TRUE(SH::project(samples, firstProbeValues, &workers) == expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Workers, giSHWorkerCountTest, testing::Values(2U, 3U, 8U));
@@ -0,0 +1,173 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+
+#if CC_USE_JOB_SYSTEM_NATIVE
+
+    #include <atomic>
+    #include <chrono>
+    #include <mutex>
+    #include <thread>
+    #include "base/job-system/ParallelFor.h"
+    #include "base/job-system/job-system-native/NativeJobGraph.h"
+
+using namespace cc;
+
+namespace {
+
+// Spins until `count` reaches `target`, gives up after a while so that a scheduling bug fails instead of hanging.
+bool waitUntil(const std::atomic<uint32_t> &count, uint32_t target) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (count.load(std::memory_order_acquire) < target) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(NativeJobSystemTest, dependencyOrdering) {
+    NativeJobSystem system(4);
+    NativeJobGraph graph(&system);
+
+    // a diamond followed by a chain: a -> (b, c) -> d -> e
+    std::mutex mutex;
+    ccstd::vector<char> order;
+    auto record = [&](char name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.emplace_back(name);
+    };
+    const auto a = graph.createJob([&]() { record('a'); });
+    const auto b = graph.createJob([&]() { record('b'); });
+    const auto c = graph.createJob([&]() { record('c'); });
+    const auto d = graph.createJob([&]() { record('d'); });
+    const auto e = graph.createJob([&]() { record('e'); });
+    graph.makeEdge(a, b);
+    graph.makeEdge(a, c);
+    graph.makeEdge(b, d);
+    graph.makeEdge(c, d);
+    graph.makeEdge(d, e);
+
+    for (int run = 0; run < 16; ++run) {
+        order.clear();
+        graph.run();
+        graph.waitForAll();
+
+        ASSERT_EQ(order.size(), 5);
+        EXPECT_EQ(order[0], 'a');
+        EXPECT_TRUE((order[1] == 'b' && order[2] == 'c') || (order[1] == 'c' && order[2] == 'b'));
+        EXPECT_EQ(order[3], 'd');
+        EXPECT_EQ(order[4], 'e');
+    }
+}
+
+TEST(NativeJobSystemTest, forEachIndexCoverage) {
+    NativeJobSystem system(3);
+
+    constexpr uint32_t BEGIN = 7;
+    constexpr uint32_t END = 10007;
+    for (uint32_t step : {1U, 3U, 64U}) {
+        ccstd::vector<std::atomic<uint32_t>> hits(END);
+        NativeJobGraph graph(&system);
+        graph.createForEachIndexJob(BEGIN, END, step, [&](uint32_t i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        graph.run();
+        graph.waitForAll();
+
+        for (uint32_t i = 0; i < END; ++i) {
+            const bool expected = i >= BEGIN && (i - BEGIN) % step == 0;
+            ASSERT_EQ(hits[i].load(), expected ? 1U : 0U) << "index " << i << " step " << step;
+        }
+    }
+
+    // empty ranges still release their successors
+    NativeJobGraph graph(&system);
+    bool ran = false;
+    const auto empty = graph.createForEachIndexJob(5, 5, 1, [](uint32_t /*i*/) {});
+    const auto after = graph.createJob([&]() { ran = true; });
+    graph.makeEdge(empty, after);
+    graph.run();
+    graph.waitForAll();
+    EXPECT_TRUE(ran);
+}
+
+TEST(NativeJobSystemTest, parallelForCoverage) {
+    JobSystem system(3);
+
+    constexpr uint32_t COUNT = 1001;
+    for (uint32_t minPerJob : {0U, 1U, 64U, 2000U}) {
+        ccstd::vector<std::atomic<uint32_t>> hits(COUNT);
+        parallelFor(&system, COUNT, minPerJob, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            ASSERT_EQ(hits[i].load(), 1U) << "index " << i << " minPerJob " << minPerJob;
+        }
+    }
+
+    // nothing to do
+    bool called = false;
+    parallelFor(&system, 0, 0, [&](uint32_t begin, uint32_t end) {
+        called = true;
+        EXPECT_EQ(begin, end);
+    });
+    EXPECT_TRUE(called);
+}
+
+TEST(NativeJobSystemTest, waitForAllRunsJobsOnCaller) {
+    // With a single worker, both jobs can only be inside the rendezvous at the same time
+    // when the waiting thread picks one of them up.
+    NativeJobSystem system(1);
+    NativeJobGraph graph(&system);
+
+    std::atomic<uint32_t> arrived{0};
+    std::atomic<uint32_t> met{0};
+    std::atomic<uint32_t> onCaller{0};
+    const auto caller = std::this_thread::get_id();
+    auto rendezvous = [&]() {
+        if (std::this_thread::get_id() == caller) {
+            onCaller.fetch_add(1, std::memory_order_relaxed);
+        }
+        arrived.fetch_add(1, std::memory_order_acq_rel);
+        if (waitUntil(arrived, 2)) {
+            met.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    graph.createJob(rendezvous);
+    graph.createJob(rendezvous);
+    graph.run();
+    graph.waitForAll();
+
+    EXPECT_EQ(met.load(), 2U);
+    EXPECT_EQ(onCaller.load(), 1U);
+}
+
+#endif
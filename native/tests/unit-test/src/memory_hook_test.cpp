@@ -0,0 +1,247 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "base/memory/MemoryHook.h"
+#include "gtest/gtest.h"
+
+#if USE_MEMORY_LEAK_DETECTOR && (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_LINUX)
+
+    #include <malloc.h>
+    #include <algorithm>
+    #include <cmath>
+    #include <cstdlib>
+
+using namespace cc;
+
+namespace {
+
+// Large enough to stand out from allocations made by other threads meanwhile.
+constexpr size_t BLOCK_SIZE = 1U << 20U;
+
+// Blocks of at least 32 intervals are recorded at their exact size.
+constexpr size_t SAMPLING_INTERVAL = BLOCK_SIZE / 64U;
+
+int64_t liveBytes() {
+    return static_cast<int64_t>(GMemoryHook.getTotalSize());
+}
+
+// The first sample point of a thread is skipped, so switch to sampling and get past it.
+void startSampling(size_t interval) {
+    GMemoryHook.setSamplingInterval(interval);
+    void *volatile ptr = malloc(BLOCK_SIZE);
+    free(ptr);
+}
+
+const MemorySnapshotEntry *findEntry(const MemorySnapshot &snapshot, uint32_t tag) {
+    auto iter = std::find_if(snapshot.entries.begin(), snapshot.entries.end(), [tag](const MemorySnapshotEntry &entry) {
+        return entry.tag == tag;
+    });
+    return iter != snapshot.entries.end() ? &*iter : nullptr;
+}
+
+bool isSortedByLiveBytes(const MemorySnapshot &snapshot) {
+    return std::is_sorted(snapshot.entries.begin(), snapshot.entries.end(), [](const MemorySnapshotEntry &lhs, const MemorySnapshotEntry &rhs) {
+        return lhs.liveBytes > rhs.liveBytes;
+    });
+}
+
+} // namespace
+
+TEST(MemoryHookTest, callocIsTracked) {
+    GMemoryHook.setSamplingInterval(0);
+    const auto before = liveBytes();
+    void *volatile ptr = calloc(BLOCK_SIZE / 16U, 16U);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_GE(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+    free(ptr);
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+}
+
+TEST(MemoryHookTest, reallocMovesRecord) {
+    GMemoryHook.setSamplingInterval(0);
+    const auto before = liveBytes();
+    void *volatile ptr = malloc(64U);
+    ASSERT_NE(ptr, nullptr);
+    ptr = realloc(ptr, BLOCK_SIZE);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_GE(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+    ptr = realloc(ptr, 2U * BLOCK_SIZE);
+    ASSERT_NE(ptr, nullptr);
+    // the record of the first block is replaced, not kept alongside the second one
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(3U * BLOCK_SIZE));
+    free(ptr);
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+}
+
+TEST(MemoryHookTest, alignedAllocationsAreTracked) {
+    GMemoryHook.setSamplingInterval(0);
+    const auto before = liveBytes();
+
+    void *aligned = nullptr;
+    ASSERT_EQ(posix_memalign(&aligned, 64U, BLOCK_SIZE), 0);
+    void *volatile ptr = aligned;
+    EXPECT_GE(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+    free(ptr);
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+
+    ptr = memalign(64U, BLOCK_SIZE);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_GE(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+    free(ptr);
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(BLOCK_SIZE));
+}
+
+TEST(MemoryHookTest, samplingEstimatesLiveBytes) {
+    constexpr size_t interval = 16U * 1024U;
+    constexpr size_t allocationSize = 1024U;
+    constexpr size_t allocationCount = 16U * 1024U;
+    static const uint32_t tag = MemoryHook::registerTag("memory-hook-test-rate");
+
+    ccstd::vector<void *> blocks;
+    blocks.reserve(allocationCount);
+    startSampling(interval);
+    EXPECT_TRUE(GMemoryHook.isSampling());
+    EXPECT_EQ(GMemoryHook.getSamplingInterval(), interval);
+    const auto before = liveBytes();
+    {
+        MemoryTagScope scope(tag);
+        for (size_t i = 0; i < allocationCount; ++i) {
+            blocks.push_back(malloc(allocationSize));
+        }
+    }
+
+    // about one sample per interval, each standing for about one interval of bytes
+    constexpr auto allocated = static_cast<double>(allocationSize * allocationCount);
+    const auto snapshot = GMemoryHook.takeSnapshot();
+    const auto *entry = findEntry(snapshot, tag);
+    ASSERT_NE(entry, nullptr);
+    const double expectedSamples = static_cast<double>(allocationCount) * (1.0 - std::exp(-static_cast<double>(allocationSize) / interval));
+    EXPECT_NEAR(static_cast<double>(entry->sampleCount), expectedSamples, expectedSamples * 0.25);
+    EXPECT_NEAR(static_cast<double>(entry->liveBytes), allocated, allocated * 0.25);
+    EXPECT_NEAR(static_cast<double>(liveBytes() - before), allocated, allocated * 0.25);
+
+    for (auto *block : blocks) {
+        free(block);
+    }
+    EXPECT_EQ(findEntry(GMemoryHook.takeSnapshot(), tag), nullptr);
+    EXPECT_LT(liveBytes() - before, static_cast<int64_t>(allocated * 0.1));
+    GMemoryHook.setSamplingInterval(0);
+}
+
+TEST(MemoryHookTest, tags) {
+    const uint32_t tag = MemoryHook::registerTag("memory-hook-test-tag");
+    EXPECT_NE(tag, MemoryHook::DEFAULT_TAG);
+    EXPECT_EQ(MemoryHook::registerTag("memory-hook-test-tag"), tag);
+    EXPECT_STREQ(MemoryHook::getTagName(tag), "memory-hook-test-tag");
+    EXPECT_STREQ(MemoryHook::getTagName(MemoryHook::MAX_TAG_COUNT), MemoryHook::getTagName(MemoryHook::DEFAULT_TAG));
+
+    EXPECT_EQ(MemoryHook::getCurrentTag(), MemoryHook::DEFAULT_TAG);
+    {
+        MemoryTagScope scope(tag);
+        EXPECT_EQ(MemoryHook::getCurrentTag(), tag);
+        {
+            MemoryTagScope inner(MemoryHook::DEFAULT_TAG);
+            EXPECT_EQ(MemoryHook::getCurrentTag(), MemoryHook::DEFAULT_TAG);
+        }
+        EXPECT_EQ(MemoryHook::getCurrentTag(), tag);
+    }
+    EXPECT_EQ(MemoryHook::getCurrentTag(), MemoryHook::DEFAULT_TAG);
+}
+
+TEST(MemoryHookTest, snapshotAttributesTags) {
+    static const uint32_t firstTag = MemoryHook::registerTag("memory-hook-test-first");
+    static const uint32_t secondTag = MemoryHook::registerTag("memory-hook-test-second");
+    startSampling(SAMPLING_INTERVAL);
+
+    void *volatile blocks[2] = {};
+    const uint32_t tags[2] = {firstTag, secondTag};
+    for (uint32_t i = 0; i < 2; ++i) {
+        MemoryTagScope scope(tags[i]);
+        // one more block for the second tag, so the entries sort in a known order
+        blocks[i] = malloc((i + 1) * BLOCK_SIZE);
+    }
+
+    const auto snapshot = GMemoryHook.takeSnapshot();
+    EXPECT_TRUE(isSortedByLiveBytes(snapshot));
+    const auto *first = findEntry(snapshot, firstTag);
+    const auto *second = findEntry(snapshot, secondTag);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(first->callstack.empty());
+    EXPECT_EQ(first->liveBytes, static_cast<int64_t>(BLOCK_SIZE));
+    EXPECT_EQ(first->sampleCount, 1);
+    EXPECT_EQ(second->liveBytes, static_cast<int64_t>(2U * BLOCK_SIZE));
+    EXPECT_EQ(second->sampleCount, 1);
+    EXPECT_LT(second - snapshot.entries.data(), first - snapshot.entries.data());
+    EXPECT_GE(snapshot.totalLiveBytes, static_cast<int64_t>(3U * BLOCK_SIZE));
+
+    free(blocks[0]);
+    free(blocks[1]);
+    GMemoryHook.setSamplingInterval(0);
+}
+
+TEST(MemoryHookTest, snapshotDiff) {
+    static const uint32_t grownTag = MemoryHook::registerTag("memory-hook-test-grown");
+    static const uint32_t releasedTag = MemoryHook::registerTag("memory-hook-test-released");
+    startSampling(SAMPLING_INTERVAL);
+
+    void *volatile released = nullptr;
+    {
+        MemoryTagScope scope(releasedTag);
+        released = malloc(BLOCK_SIZE);
+    }
+    const auto before = GMemoryHook.takeSnapshot();
+
+    free(released);
+    void *volatile grown = nullptr;
+    {
+        MemoryTagScope scope(grownTag);
+        grown = malloc(2U * BLOCK_SIZE);
+    }
+    const auto after = GMemoryHook.takeSnapshot();
+
+    const auto diff = MemoryHook::diffSnapshots(before, after);
+    EXPECT_EQ(diff.totalLiveBytes, after.totalLiveBytes - before.totalLiveBytes);
+    EXPECT_TRUE(isSortedByLiveBytes(diff));
+    const auto *grownEntry = findEntry(diff, grownTag);
+    ASSERT_NE(grownEntry, nullptr);
+    EXPECT_EQ(grownEntry->liveBytes, static_cast<int64_t>(2U * BLOCK_SIZE));
+    EXPECT_EQ(grownEntry->sampleCount, 1);
+    // a callsite released completely shows up with a negative delta
+    const auto *releasedEntry = findEntry(diff, releasedTag);
+    ASSERT_NE(releasedEntry, nullptr);
+    EXPECT_EQ(releasedEntry->liveBytes, -static_cast<int64_t>(BLOCK_SIZE));
+    EXPECT_EQ(releasedEntry->sampleCount, -1);
+    EXPECT_EQ(&diff.entries.front(), grownEntry);
+    EXPECT_EQ(&diff.entries.back(), releasedEntry);
+
+    // unchanged entries are left out
+    EXPECT_TRUE(MemoryHook::diffSnapshots(after, after).entries.empty());
+
+    free(grown);
+    GMemoryHook.setSamplingInterval(0);
+}
+
+#endif
@@ -0,0 +1,153 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include "core/scene-graph/Node.h"
+    #include "gtest/gtest.h"
+    #include "physics/physx/PhysXRigidBody.h"
+    #include "physics/physx/PhysXWorld.h"
+    #include "physics/physx/shapes/PhysXBox.h"
+
+using namespace cc;
+using namespace cc::physics;
+
+namespace {
+
+constexpr uint32_t BOX_COUNT{8};
+constexpr uint32_t STEP_COUNT{120};
+
+// a leaning stack of boxes toppling onto the ground, so that contacts are solved across several islands and frames
+ccstd::vector<Vec3> simulateStack(bool splitSimulation, uint32_t workerCount) {
+    auto *world = ccnew PhysXWorld();
+    world->setSplitSimulation(splitSimulation);
+    world->setSimulationWorkerCount(workerCount);
+
+    IntrusivePtr<Node> ground = ccnew Node("ground");
+    ground->setScale(20.F, 1.F, 20.F);
+    auto *groundShape = ccnew PhysXBox();
+    groundShape->initialize(ground);
+    groundShape->onEnable();
+
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<PhysXRigidBody *> bodies;
+    ccstd::vector<PhysXBox *> shapes;
+    for (uint32_t i = 0; i < BOX_COUNT; ++i) {
+        IntrusivePtr<Node> node = ccnew Node("box");
+        node->setPosition(0.2F * static_cast<float>(i), 1.5F + 1.05F * static_cast<float>(i), 0.1F * static_cast<float>(i % 2));
+        auto *body = ccnew PhysXRigidBody();
+        body->initialize(node, ERigidBodyType::DYNAMIC, 1);
+        body->onEnable();
+        auto *shape = ccnew PhysXBox();
+        shape->initialize(node);
+        shape->onEnable();
+        nodes.emplace_back(node);
+        bodies.emplace_back(body);
+        shapes.emplace_back(shape);
+    }
+
+    world->syncSceneToPhysics();
+    for (uint32_t i = 0; i < STEP_COUNT; ++i) {
+        world->step(1.F / 60.F);
+    }
+    // a split step is fetched by the next one, turning it off fetches the last step
+    world->setSplitSimulation(false);
+
+    ccstd::vector<Vec3> positions;
+    for (const auto &node : nodes) {
+        positions.emplace_back(node->getWorldPosition());
+    }
+
+    for (uint32_t i = 0; i < BOX_COUNT; ++i) {
+        shapes[i]->onDisable();
+        shapes[i]->onDestroy();
+        bodies[i]->onDisable();
+        bodies[i]->onDestroy();
+        delete shapes[i];
+        delete bodies[i];
+    }
+    groundShape->onDisable();
+    groundShape->onDestroy();
+    delete groundShape;
+    delete world;
+    return positions;
+}
+
+} // namespace
+
+TEST(physicsPhysXJobDispatcherTest, resultsIndependentOfScheduling) {
+    // every task inline and the step fetched right away, like PxDefaultCpuDispatcher(0)
+    const auto expected = simulateStack(false, 0);
+    ASSERT_EQ(expected.size(), BOX_COUNT);
+    // the stack did move
+    EXPECT_LT(expected.back().y, 1.5F + 1.05F * static_cast<float>(BOX_COUNT - 1) - 1.F);
+
+    const struct {
+        bool splitSimulation;
+        uint32_t workerCount;
+    } configs[] = {{false, 4}, {true, 0}, {true, 4}};
+    for (const auto &config : configs) {
+        SCOPED_TRACE(testing::Message() << "split " << config.splitSimulation << ", workers " << config.workerCount);
+        const auto positions = simulateStack(config.splitSimulation, config.workerCount);
+        ASSERT_EQ(positions.size(), BOX_COUNT);
+        for (uint32_t i = 0; i < BOX_COUNT; ++i) {
+            EXPECT_NEAR(positions[i].x, expected[i].x, 1e-4F);
+            EXPECT_NEAR(positions[i].y, expected[i].y, 1e-4F);
+            EXPECT_NEAR(positions[i].z, expected[i].z, 1e-4F);
+        }
+    }
+}
+
+TEST(physicsPhysXJobDispatcherTest, changeSchedulingBetweenSteps) {
+    auto *world = ccnew PhysXWorld();
+    IntrusivePtr<Node> node = ccnew Node("box");
+    node->setPosition(0.F, 10.F, 0.F);
+    auto *body = ccnew PhysXRigidBody();
+    body->initialize(node, ERigidBodyType::DYNAMIC, 1);
+    body->onEnable();
+    world->syncSceneToPhysics();
+
+    // the worker count and the split mode may change while a split step is in flight
+    world->setSplitSimulation(true);
+    world->step(1.F / 60.F);
+    world->setSimulationWorkerCount(0);
+    world->step(1.F / 60.F);
+    world->setSimulationWorkerCount(4);
+    world->step(1.F / 60.F);
+    world->setSplitSimulation(false);
+    world->step(1.F / 60.F);
+
+    // four steps of free fall
+    const float t = 4.F / 60.F;
+    EXPECT_LT(node->getWorldPosition().y, 10.F);
+    EXPECT_NEAR(node->getWorldPosition().y, 10.F - 0.5F * 10.F * t * t, 0.05F);
+
+    body->onDisable();
+    body->onDestroy();
+    delete body;
+    delete world;
+}
+
+#endif
@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include <cstring>
+    #include "core/scene-graph/Node.h"
+    #include "gtest/gtest.h"
+    #include "physics/physx/shapes/PhysXBox.h"
+    #include "physics/sdk/World.h"
+
+using namespace cc;
+using namespace cc::physics;
+
+namespace {
+
+constexpr uint32_t ALL_GROUPS{0xffffffff};
+constexpr uint32_t MAX_HITS{4};
+
+uint32_t readUint32(const Float32Array &array, uint32_t index) {
+    uint32_t v = 0;
+    memcpy(&v, &array[index], sizeof(v));
+    return v;
+}
+
+void writeUint32(Float32Array &array, uint32_t index, uint32_t v) {
+    memcpy(&array[index], &v, sizeof(v));
+}
+
+void writeQuery(Float32Array &queries, uint32_t query, ESceneQueryType type, const Vec3 &origin, const Vec3 &dir, float distance, float radius) {
+    const uint32_t base = query * SceneQueryLayout::QUERY_STRIDE;
+    writeUint32(queries, base + SceneQueryLayout::TYPE, static_cast<uint32_t>(type));
+    writeUint32(queries, base + SceneQueryLayout::MASK, ALL_GROUPS);
+    writeUint32(queries, base + SceneQueryLayout::FLAGS, 0);
+    queries[base + SceneQueryLayout::DISTANCE] = distance;
+    queries[base + SceneQueryLayout::ORIGIN + 0] = origin.x;
+    queries[base + SceneQueryLayout::ORIGIN + 1] = origin.y;
+    queries[base + SceneQueryLayout::ORIGIN + 2] = origin.z;
+    queries[base + SceneQueryLayout::DIRECTION + 0] = dir.x;
+    queries[base + SceneQueryLayout::DIRECTION + 1] = dir.y;
+    queries[base + SceneQueryLayout::DIRECTION + 2] = dir.z;
+    queries[base + SceneQueryLayout::RADIUS] = radius;
+}
+
+// compares hit `hit` of query `query` in the packed output against a result of the single query API
+void expectHit(const Float32Array &hits, uint32_t query, uint32_t hit, const RaycastResult &expected) {
+    const uint32_t base = (query * MAX_HITS + hit) * SceneQueryLayout::HIT_STRIDE;
+    EXPECT_EQ(readUint32(hits, base + SceneQueryLayout::HIT_SHAPE), expected.shape);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_DISTANCE], expected.distance);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_POINT + 0], expected.hitPoint.x);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_POINT + 1], expected.hitPoint.y);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_POINT + 2], expected.hitPoint.z);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_NORMAL + 0], expected.hitNormal.x);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_NORMAL + 1], expected.hitNormal.y);
+    EXPECT_FLOAT_EQ(hits[base + SceneQueryLayout::HIT_NORMAL + 2], expected.hitNormal.z);
+}
+
+} // namespace
+
+TEST(physicsPhysXSceneQueryTest, batchMatchesSingleQueries) {
+    auto *world = ccnew World();
+
+    // two static unit boxes on the x axis
+    IntrusivePtr<Node> nearNode = ccnew Node("near");
+    IntrusivePtr<Node> farNode = ccnew Node("far");
+    farNode->setPosition(3.F, 0.F, 0.F);
+    auto *nearBox = ccnew PhysXBox();
+    auto *farBox = ccnew PhysXBox();
+    nearBox->initialize(nearNode);
+    farBox->initialize(farNode);
+    for (auto *box : {nearBox, farBox}) {
+        box->setGroup(1);
+        box->setMask(ALL_GROUPS);
+        box->onEnable();
+    }
+    world->syncSceneToPhysics();
+    world->step(1.F / 60.F);
+
+    const Vec3 origin{-5.F, 0.F, 0.F};
+    const Vec3 dir{1.F, 0.F, 0.F};
+    constexpr uint32_t QUERY_COUNT{5};
+    Float32Array queries(QUERY_COUNT * SceneQueryLayout::QUERY_STRIDE);
+    writeQuery(queries, 0, ESceneQueryType::RAYCAST, origin, dir, 20.F, 0.F);
+    writeQuery(queries, 1, ESceneQueryType::RAYCAST_CLOSEST, origin, dir, 20.F, 0.F);
+    writeQuery(queries, 2, ESceneQueryType::SWEEP_SPHERE_CLOSEST, origin, dir, 20.F, 0.25F);
+    writeQuery(queries, 3, ESceneQueryType::OVERLAP_SPHERE, Vec3{3.F, 0.F, 0.F}, dir, 0.F, 0.1F);
+    // misses: the ray points away from the boxes
+    writeQuery(queries, 4, ESceneQueryType::RAYCAST, origin, -dir, 20.F, 0.F);
+
+    Float32Array hits(QUERY_COUNT * MAX_HITS * SceneQueryLayout::HIT_STRIDE);
+    Uint32Array hitCounts(QUERY_COUNT);
+    EXPECT_EQ(world->sceneQueryBatch(queries, MAX_HITS, hits, hitCounts), 5U);
+
+    RaycastOptions options{origin, 20.F, dir, ALL_GROUPS, false};
+    ASSERT_TRUE(world->raycast(options));
+    const auto expectedHits = world->raycastResult();
+    ASSERT_EQ(expectedHits.size(), 2U);
+    ASSERT_EQ(hitCounts[0], 2U);
+    for (uint32_t i = 0; i < 2; ++i) {
+        // both go through the same touch buffer of PhysX, the order may still differ
+        const uint32_t base = i * SceneQueryLayout::HIT_STRIDE;
+        const auto shape = readUint32(hits, base + SceneQueryLayout::HIT_SHAPE);
+        const auto &expected = expectedHits[0].shape == shape ? expectedHits[0] : expectedHits[1];
+        expectHit(hits, 0, i, expected);
+    }
+
+    ASSERT_TRUE(world->raycastClosest(options));
+    ASSERT_EQ(hitCounts[1], 1U);
+    expectHit(hits, 1, 0, world->raycastClosestResult());
+    EXPECT_EQ(world->raycastClosestResult().shape, nearBox->getObjectID());
+
+    // the sphere touches the near face of the near box a radius earlier than the ray
+    ASSERT_EQ(hitCounts[2], 1U);
+    const uint32_t sweepBase = 2 * MAX_HITS * SceneQueryLayout::HIT_STRIDE;
+    EXPECT_EQ(readUint32(hits, sweepBase + SceneQueryLayout::HIT_SHAPE), nearBox->getObjectID());
+    EXPECT_NEAR(hits[sweepBase + SceneQueryLayout::HIT_DISTANCE], 4.25F, 1e-3F);
+    EXPECT_NEAR(hits[sweepBase + SceneQueryLayout::HIT_NORMAL + 0], -1.F, 1e-3F);
+
+    ASSERT_EQ(hitCounts[3], 1U);
+    const uint32_t overlapBase = 3 * MAX_HITS * SceneQueryLayout::HIT_STRIDE;
+    EXPECT_EQ(readUint32(hits, overlapBase + SceneQueryLayout::HIT_SHAPE), farBox->getObjectID());
+
+    EXPECT_EQ(hitCounts[4], 0U);
+
+    // hit buffers which cannot hold maxHitsPerQuery hits per query are refused
+    Float32Array smallHits(MAX_HITS * SceneQueryLayout::HIT_STRIDE);
+    EXPECT_EQ(world->sceneQueryBatch(queries, MAX_HITS, smallHits, hitCounts), 0U);
+
+    for (auto *box : {nearBox, farBox}) {
+        box->onDisable();
+        box->onDestroy();
+        delete box;
+    }
+    delete world;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#if CC_USE_PHYSICS_PHYSX
+
+    #include "core/scene-graph/Node.h"
+    #include "gtest/gtest.h"
+    #include "physics/physx/PhysXRigidBody.h"
+    #include "physics/physx/PhysXSharedBody.h"
+    #include "physics/physx/PhysXWorld.h"
+    #include "physics/physx/shapes/PhysXBox.h"
+
+using namespace cc;
+using namespace cc::physics;
+
+TEST(physicsPhysXSyncTest, kinematicChildFollowsDynamicParent) {
+    auto *world = ccnew PhysXWorld();
+
+    IntrusivePtr<Node> parent = ccnew Node("parent");
+    IntrusivePtr<Node> child = ccnew Node("child");
+    child->setParent(parent);
+    child->setPosition(0.F, 1.F, 0.F);
+    child->updateWorldTransform();
+
+    auto *parentBody = ccnew PhysXRigidBody();
+    parentBody->initialize(parent, ERigidBodyType::DYNAMIC, 1);
+    parentBody->onEnable();
+    auto *childBody = ccnew PhysXRigidBody();
+    childBody->initialize(child, ERigidBodyType::KINEMATIC, 1);
+    childBody->onEnable();
+
+    world->syncSceneToPhysics();
+    for (uint32_t i = 0; i < 10; ++i) {
+        world->step(1.F / 60.F);
+    }
+
+    // the parent falls, its own write is not echoed back but its kinematic child is marked dirty
+    EXPECT_LT(parent->getWorldPosition().y, 0.F);
+    EXPECT_EQ(parentBody->getSharedBody().getDirtyBits(), 0U);
+    EXPECT_NE(childBody->getSharedBody().getDirtyBits(), 0U);
+
+    world->syncSceneToPhysics();
+    const auto pose = childBody->getSharedBody().getImpl().rigidActor->getGlobalPose();
+    EXPECT_NEAR(pose.p.y, child->getWorldPosition().y, 1e-4F);
+    EXPECT_EQ(childBody->getSharedBody().getDirtyBits(), 0U);
+
+    childBody->onDisable();
+    childBody->onDestroy();
+    parentBody->onDisable();
+    parentBody->onDestroy();
+    delete childBody;
+    delete parentBody;
+    delete world;
+}
+
+TEST(physicsPhysXSyncTest, moveFromContactCallbackReachesPhysX) {
+    auto *world = ccnew PhysXWorld();
+
+    IntrusivePtr<Node> ground = ccnew Node("ground");
+    ground->setScale(10.F, 1.F, 10.F);
+    IntrusivePtr<Node> box = ccnew Node("box");
+    box->setPosition(0.F, 1.5F, 0.F);
+
+    auto *groundShape = ccnew PhysXBox();
+    groundShape->initialize(ground);
+    groundShape->onEnable();
+    auto *body = ccnew PhysXRigidBody();
+    body->initialize(box, ERigidBodyType::DYNAMIC, 1);
+    body->onEnable();
+    auto *boxShape = ccnew PhysXBox();
+    boxShape->initialize(box);
+    boxShape->onEnable();
+
+    // the frame loop of the engine: scene to physics, step, then the collision callbacks
+    bool touched = false;
+    for (uint32_t i = 0; i < 120 && !touched; ++i) {
+        world->syncSceneToPhysics();
+        world->step(1.F / 60.F);
+        world->emitEvents();
+        touched = !world->getContactEventPairs().empty();
+    }
+    ASSERT_TRUE(touched);
+
+    // a callback moves the body the physics sync has just written, before its world transform is updated
+    box->setPosition(5.F, 10.F, 0.F);
+    EXPECT_NE(body->getSharedBody().getDirtyBits(), 0U);
+
+    world->syncSceneToPhysics();
+    const auto pose = body->getSharedBody().getImpl().rigidActor->getGlobalPose();
+    EXPECT_NEAR(pose.p.x, 5.F, 1e-4F);
+    EXPECT_NEAR(pose.p.y, 10.F, 1e-4F);
+    EXPECT_NEAR(pose.p.z, 0.F, 1e-4F);
+
+    boxShape->onDisable();
+    boxShape->onDestroy();
+    body->onDisable();
+    body->onDestroy();
+    groundShape->onDisable();
+    groundShape->onDestroy();
+    delete boxShape;
+    delete body;
+    delete groundShape;
+    delete world;
+}
+
+#endif
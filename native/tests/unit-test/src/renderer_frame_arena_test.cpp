@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "gtest/gtest.h"
+#include "renderer/pipeline/FrameArena.h"
+
+using namespace cc;
+using namespace cc::pipeline;
+
+TEST(FrameArenaTest, allocateAligned) {
+    FrameArena arena(1024);
+    for (size_t alignment : {1U, 4U, 8U, 16U}) {
+        void *ptr = arena.allocate(3, alignment);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0U);
+    }
+    EXPECT_GT(arena.getUsedSize(), 0U);
+}
+
+TEST(FrameArenaTest, resetRecyclesAndCountsGenerations) {
+    FrameArena arena(1024);
+    const auto generation = arena.getGeneration();
+    void *first = arena.allocate(256, 16);
+    arena.allocate(128, 16);
+    const auto used = arena.getUsedSize();
+
+    arena.reset();
+    EXPECT_EQ(arena.getGeneration(), generation + 1);
+    EXPECT_EQ(arena.getUsedSize(), 0U);
+    EXPECT_EQ(arena.getLastFrameUsage(), used);
+    // the same block is handed out again
+    EXPECT_EQ(arena.allocate(256, 16), first);
+}
+
+TEST(FrameArenaTest, mergeBlocksAfterGrowth) {
+    FrameArena arena(1024);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_NE(arena.allocate(512, 16), nullptr);
+    }
+    EXPECT_GT(arena.getCapacity(), 1024U);
+    const auto capacity = arena.getCapacity();
+
+    arena.reset();
+    // one block big enough for the whole last frame
+    EXPECT_GE(arena.getCapacity(), capacity);
+    EXPECT_EQ(arena.getPeakUsage(), arena.getLastFrameUsage());
+    void *first = arena.allocate(512, 16);
+    for (int i = 1; i < 8; ++i) {
+        arena.allocate(512, 16);
+    }
+    EXPECT_EQ(arena.getCapacity(), capacity);
+    arena.reset();
+    EXPECT_EQ(arena.allocate(512, 16), first);
+}
+
+TEST(FrameArenaTest, pmrVector) {
+    FrameArena arena(1024);
+    ccstd::pmr::vector<uint32_t> values(&arena);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        values.emplace_back(i);
+    }
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+    // deallocation is a no-op, all memory comes back at reset
+    const auto used = arena.getUsedSize();
+    values.clear();
+    values.shrink_to_fit();
+    EXPECT_EQ(arena.getUsedSize(), used);
+}
@@ -0,0 +1,208 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/InstancedBuffer.h"
+#include "scene/SubModel.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t STRIDE = 4 * sizeof(float);
+constexpr uint32_t SUB_MODEL_COUNT = 12;
+
+struct Upload {
+    uint32_t offset{0};
+    uint32_t size{0};
+
+    bool operator==(const Upload &rhs) const { return offset == rhs.offset && size == rhs.size; }
+};
+
+// Only records the buffer uploads.
+class RecordingCommandBuffer final : public gfx::CommandBuffer {
+public:
+    ccstd::vector<Upload> uploads;
+
+    void updateBuffer(gfx::Buffer * /*buff*/, const void * /*data*/, uint32_t size) override { uploads.push_back({0, size}); }
+    void updateBufferRange(gfx::Buffer * /*buff*/, const void * /*data*/, uint32_t offset, uint32_t size) override { uploads.push_back({offset, size}); }
+
+    void begin(gfx::RenderPass * /*renderPass*/, uint32_t /*subpass*/, gfx::Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(gfx::RenderPass * /*renderPass*/, gfx::Framebuffer * /*fbo*/, const gfx::Rect & /*renderArea*/, const gfx::Color * /*colors*/, float /*depth*/, uint32_t /*stencil*/, gfx::CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void bindPipelineState(gfx::PipelineState * /*pso*/) override {}
+    void bindDescriptorSet(uint32_t /*set*/, gfx::DescriptorSet * /*descriptorSet*/, uint32_t /*dynamicOffsetCount*/, const uint32_t * /*dynamicOffsets*/) override {}
+    void bindInputAssembler(gfx::InputAssembler * /*ia*/) override {}
+    void setViewport(const gfx::Viewport & /*vp*/) override {}
+    void setScissor(const gfx::Rect & /*rect*/) override {}
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const gfx::Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(gfx::StencilFace /*face*/, uint32_t /*mask*/) override {}
+    void setStencilCompareMask(gfx::StencilFace /*face*/, uint32_t /*ref*/, uint32_t /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const gfx::DrawInfo & /*info*/) override {}
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, gfx::Texture * /*texture*/, const gfx::BufferTextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void blitTexture(gfx::Texture * /*srcTexture*/, gfx::Texture * /*dstTexture*/, const gfx::TextureBlit * /*regions*/, uint32_t /*count*/, gfx::Filter /*filter*/) override {}
+    void execute(gfx::CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const gfx::DispatchInfo & /*info*/) override {}
+    void beginQuery(gfx::QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void endQuery(gfx::QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void resetQueryPool(gfx::QueryPool * /*queryPool*/) override {}
+    void pipelineBarrier(const gfx::GeneralBarrier * /*barrier*/, const gfx::BufferBarrier *const * /*bufferBarriers*/, const gfx::Buffer *const * /*buffers*/, uint32_t /*bufferBarrierCount*/, const gfx::TextureBarrier *const * /*textureBarriers*/, const gfx::Texture *const * /*textures*/, uint32_t /*textureBarrierCount*/) override {}
+
+protected:
+    void doInit(const gfx::CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+class InstancedBufferTest : public testing::Test {
+protected:
+    void SetUp() override {
+        pipeline::InstancedBuffer::setPersistentModeEnabled(true);
+
+        auto *device = gfx::Device::getInstance();
+        _layout = device->createDescriptorSetLayout({});
+        _descriptorSet = device->createDescriptorSet({_layout});
+        _vertexBuffer = device->createBuffer({gfx::BufferUsageBit::VERTEX, gfx::MemoryUsageBit::DEVICE, 3 * sizeof(float), 3 * sizeof(float)});
+        _ia = device->createInputAssembler({{gfx::Attribute{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F}}, {_vertexBuffer}});
+        _shader = device->createShader({});
+
+        for (auto &subModel : _subModels) {
+            subModel = ccnew scene::SubModel();
+            subModel->setInputAssembler(_ia);
+            subModel->setDescriptorSet(_descriptorSet);
+            subModel->getInstancedAttributeBlock().buffer = Uint8Array(STRIDE);
+        }
+        _buffer = ccnew pipeline::InstancedBuffer(nullptr);
+    }
+
+    void TearDown() override {
+        _buffer->destroy();
+        pipeline::InstancedBuffer::setPersistentModeEnabled(false);
+    }
+
+    void setAttribute(uint32_t subModel, float value) {
+        auto *data = reinterpret_cast<float *>(_subModels[subModel]->getInstancedAttributeBlock().buffer.buffer()->getData());
+        data[0] = value;
+    }
+
+    // What a camera does with the buffer: clear, merge its visible sub-models and upload.
+    const ccstd::vector<Upload> &view(std::initializer_list<uint32_t> subModels) {
+        _cmdBuff.uploads.clear();
+        _buffer->clear();
+        for (const auto subModel : subModels) {
+            _buffer->merge(_subModels[subModel], 0, _shader);
+        }
+        _buffer->uploadBuffers(&_cmdBuff);
+        return _cmdBuff.uploads;
+    }
+
+    uint32_t instanceCount() const {
+        uint32_t count = 0;
+        for (const auto &instance : _buffer->getInstances()) {
+            count += instance.count;
+        }
+        return count;
+    }
+
+    IntrusivePtr<gfx::DescriptorSetLayout> _layout;
+    IntrusivePtr<gfx::DescriptorSet> _descriptorSet;
+    IntrusivePtr<gfx::Buffer> _vertexBuffer;
+    IntrusivePtr<gfx::InputAssembler> _ia;
+    IntrusivePtr<gfx::Shader> _shader;
+    IntrusivePtr<scene::SubModel> _subModels[SUB_MODEL_COUNT];
+    IntrusivePtr<pipeline::InstancedBuffer> _buffer;
+    RecordingCommandBuffer _cmdBuff;
+};
+
+} // namespace
+
+TEST_F(InstancedBufferTest, slotsSurviveFrames) {
+    pipeline::InstancedBuffer::beginFrame();
+    EXPECT_EQ(view({0, 1, 2}), (ccstd::vector<Upload>{{0, 3 * STRIDE}}));
+    EXPECT_EQ(instanceCount(), 3U);
+
+    // nothing changed, nothing to upload
+    pipeline::InstancedBuffer::beginFrame();
+    EXPECT_TRUE(view({0, 1, 2}).empty());
+    EXPECT_EQ(instanceCount(), 3U);
+
+    // only the slot of the changed sub-model is uploaded
+    pipeline::InstancedBuffer::beginFrame();
+    setAttribute(1, 2.F);
+    EXPECT_EQ(view({0, 1, 2}), (ccstd::vector<Upload>{{STRIDE, STRIDE}}));
+}
+
+TEST_F(InstancedBufferTest, culledSlotIsReused) {
+    pipeline::InstancedBuffer::beginFrame();
+    view({0, 1, 2});
+
+    // the last slot moves into the one of the culled sub-model
+    pipeline::InstancedBuffer::beginFrame();
+    EXPECT_EQ(view({0, 2}), (ccstd::vector<Upload>{{STRIDE, STRIDE}}));
+    EXPECT_EQ(instanceCount(), 2U);
+
+    // and it comes back at the end
+    pipeline::InstancedBuffer::beginFrame();
+    EXPECT_EQ(view({0, 2, 1}), (ccstd::vector<Upload>{{2 * STRIDE, STRIDE}}));
+    EXPECT_EQ(instanceCount(), 3U);
+}
+
+TEST_F(InstancedBufferTest, camerasKeepTheirSlots) {
+    pipeline::InstancedBuffer::beginFrame();
+    view({0, 1});
+    const auto *firstVB = _buffer->getInstances()[0].vb;
+    view({2});
+    const auto *secondVB = _buffer->getInstances()[0].vb;
+    EXPECT_NE(firstVB, secondVB);
+
+    // both cameras find their slots as they left them
+    for (int frame = 0; frame < 3; ++frame) {
+        pipeline::InstancedBuffer::beginFrame();
+        EXPECT_TRUE(view({0, 1}).empty());
+        EXPECT_EQ(instanceCount(), 2U);
+        EXPECT_EQ(_buffer->getInstances()[0].vb, firstVB);
+        EXPECT_TRUE(view({2}).empty());
+        EXPECT_EQ(instanceCount(), 1U);
+        EXPECT_EQ(_buffer->getInstances()[0].vb, secondVB);
+    }
+}
+
+TEST_F(InstancedBufferTest, dirtySlotsAreCoalesced) {
+    pipeline::InstancedBuffer::beginFrame();
+    view({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+
+    // close dirty slots share an upload, distant ones get their own
+    pipeline::InstancedBuffer::beginFrame();
+    for (const auto subModel : {0U, 1U, 3U, 10U}) {
+        setAttribute(subModel, 3.F);
+    }
+    EXPECT_EQ(view({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}), (ccstd::vector<Upload>{{0, 4 * STRIDE}, {10 * STRIDE, STRIDE}}));
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/geometry/AABB.h"
+#include "gtest/gtest.h"
+#include "math/Mat4.h"
+#include "renderer/pipeline/SoftwareOcclusionCulling.h"
+
+using namespace cc;
+
+namespace {
+
+// a quad in the xy plane covering [-halfSize, halfSize] at depth z
+void rasterizeQuad(pipeline::SoftwareOcclusionCulling &culling, float halfSize, float z) {
+    const ccstd::vector<Vec3> positions{
+        {-halfSize, -halfSize, z},
+        {halfSize, -halfSize, z},
+        {halfSize, halfSize, z},
+        {-halfSize, halfSize, z},
+    };
+    const ccstd::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+    culling.rasterize(Mat4::IDENTITY, positions, indices);
+}
+
+geometry::AABB box(float x, float y, float z, float halfExtent) {
+    return geometry::AABB(x, y, z, halfExtent, halfExtent, halfExtent);
+}
+
+} // namespace
+
+// the identity view projection maps the positions to ndc directly
+TEST(SoftwareOcclusionCullingTest, orthographicQuad) {
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.beginView(Mat4::IDENTITY);
+    rasterizeQuad(culling, 0.5F, 0.F);
+    culling.endView();
+
+    // behind the quad
+    EXPECT_TRUE(culling.isOccluded(box(0.F, 0.F, 0.5F, 0.1F)));
+    EXPECT_TRUE(culling.isOccluded(box(0.2F, -0.2F, 0.8F, 0.2F)));
+    // in front of the quad
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, -0.5F, 0.1F)));
+    // intersecting the quad
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, 0.F, 0.1F)));
+    // beside the quad, or only partially covered
+    EXPECT_FALSE(culling.isOccluded(box(0.8F, 0.F, 0.5F, 0.1F)));
+    EXPECT_FALSE(culling.isOccluded(box(0.5F, 0.F, 0.5F, 0.1F)));
+    // out of the screen
+    EXPECT_FALSE(culling.isOccluded(box(3.F, 0.F, 0.5F, 0.1F)));
+}
+
+TEST(SoftwareOcclusionCullingTest, viewClearsDepth) {
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.beginView(Mat4::IDENTITY);
+    rasterizeQuad(culling, 0.5F, 0.F);
+    culling.endView();
+    EXPECT_TRUE(culling.isOccluded(box(0.F, 0.F, 0.5F, 0.1F)));
+
+    // nothing rasterized in the next view
+    culling.beginView(Mat4::IDENTITY);
+    culling.endView();
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, 0.5F, 0.1F)));
+}
+
+TEST(SoftwareOcclusionCullingTest, nearestOccluderWins) {
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.beginView(Mat4::IDENTITY);
+    rasterizeQuad(culling, 0.5F, 0.6F);
+    rasterizeQuad(culling, 0.5F, -0.2F);
+    culling.endView();
+
+    // between the quads, only the near one counts
+    EXPECT_TRUE(culling.isOccluded(box(0.F, 0.F, 0.2F, 0.1F)));
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, -0.5F, 0.1F)));
+}
+
+TEST(SoftwareOcclusionCullingTest, perspective) {
+    Mat4 proj;
+    Mat4::createPerspective(1.F, 1.F, 1.F, 100.F, &proj);
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.setResolution(64, 64);
+    culling.beginView(proj);
+    // a wall 10 units in front of the camera looking down -z
+    rasterizeQuad(culling, 20.F, -10.F);
+    culling.endView();
+
+    EXPECT_TRUE(culling.isOccluded(box(0.F, 0.F, -30.F, 1.F)));
+    EXPECT_TRUE(culling.isOccluded(box(5.F, 5.F, -50.F, 2.F)));
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, -5.F, 1.F)));
+    // crossing the near plane is never culled
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, 0.F, 5.F)));
+}
+
+TEST(SoftwareOcclusionCullingTest, occluderDoesNotCullItself) {
+    // a wall covering the screen, the bounds of its own quad lie exactly on the rasterized depth
+    Mat4 proj;
+    Mat4::createPerspective(math::PI / 3.F, 2.F, 1.F, 1000.F, &proj);
+    pipeline::SoftwareOcclusionCulling culling;
+    for (uint32_t i = 0; i < 200; ++i) {
+        const auto depth = 1.F + static_cast<float>(i) * 0.995F;
+        const auto halfHeight = depth;
+        const ccstd::vector<Vec3> positions{
+            {-2.F * halfHeight, -halfHeight, -depth},
+            {2.F * halfHeight, -halfHeight, -depth},
+            {2.F * halfHeight, halfHeight, -depth},
+            {-2.F * halfHeight, halfHeight, -depth},
+        };
+        const ccstd::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+        culling.beginView(proj);
+        culling.rasterize(Mat4::IDENTITY, positions, indices);
+        culling.endView();
+
+        EXPECT_FALSE(culling.isOccluded(geometry::AABB(0.F, 0.F, -depth, 2.F * halfHeight, halfHeight, 0.F))) << "depth " << depth;
+        // the tolerance doesn't keep what is clearly behind
+        EXPECT_TRUE(culling.isOccluded(box(0.F, 0.F, -depth * 1.5F, depth * 0.1F))) << "depth " << depth;
+    }
+}
+
+TEST(SoftwareOcclusionCullingTest, worldTransform) {
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.beginView(Mat4::IDENTITY);
+    Mat4 world;
+    Mat4::createTranslation(0.5F, 0.F, 0.F, &world);
+    const ccstd::vector<Vec3> positions{{-0.25F, -0.25F, 0.F}, {0.25F, -0.25F, 0.F}, {0.25F, 0.25F, 0.F}, {-0.25F, 0.25F, 0.F}};
+    const ccstd::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+    culling.rasterize(world, positions, indices);
+    culling.endView();
+
+    EXPECT_TRUE(culling.isOccluded(box(0.5F, 0.F, 0.5F, 0.1F)));
+    EXPECT_FALSE(culling.isOccluded(box(0.F, 0.F, 0.5F, 0.1F)));
+}
+
+TEST(SoftwareOcclusionCullingTest, nothingToPrepare) {
+    pipeline::SoftwareOcclusionCulling culling;
+    culling.setEnabled(true);
+    EXPECT_FALSE(culling.prepare(nullptr));
+    culling.finish();
+    EXPECT_EQ(culling.getOccluderCount(), 0);
+}
@@ -0,0 +1,205 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/custom/RenderInterfaceTypes.h"
+
+using namespace cc;
+
+namespace {
+
+const ccstd::string PROGRAM_NAME{"async-test-program"};
+
+// only the macros and the global set layout are read when a shader is compiled
+class TestPipeline final : public render::PipelineRuntime {
+public:
+    explicit TestPipeline(gfx::Device *device) : _device(device) {
+        _globalLayout = device->createDescriptorSetLayout({});
+    }
+
+    bool activate(gfx::Swapchain * /*swapchain*/) override { return true; }
+    bool destroy() noexcept override { return true; }
+    void render(const ccstd::vector<scene::Camera *> & /*cameras*/) override {}
+    gfx::Device *getDevice() const override { return _device; }
+    const MacroRecord &getMacros() const override { return _macros; }
+    pipeline::GlobalDSManager *getGlobalDSManager() const override { return nullptr; }
+    gfx::DescriptorSetLayout *getDescriptorSetLayout() const override { return _globalLayout; }
+    gfx::DescriptorSet *getDescriptorSet() const override { return nullptr; }
+    const ccstd::vector<gfx::CommandBuffer *> &getCommandBuffers() const override { return _commandBuffers; }
+    pipeline::PipelineSceneData *getPipelineSceneData() const override { return nullptr; }
+    const ccstd::string &getConstantMacros() const override { return _constantMacros; }
+    scene::Model *getProfiler() const override { return nullptr; }
+    void setProfiler(scene::Model * /*profiler*/) override {}
+    pipeline::GeometryRenderer *getGeometryRenderer() const override { return nullptr; }
+    float getShadingScale() const override { return 1.F; }
+    void setShadingScale(float /*scale*/) override {}
+    const ccstd::string &getMacroString(const ccstd::string & /*name*/) const override { return _constantMacros; }
+    int32_t getMacroInt(const ccstd::string & /*name*/) const override { return 0; }
+    bool getMacroBool(const ccstd::string & /*name*/) const override { return false; }
+    void setMacroString(const ccstd::string & /*name*/, const ccstd::string & /*value*/) override {}
+    void setMacroInt(const ccstd::string & /*name*/, int32_t /*value*/) override {}
+    void setMacroBool(const ccstd::string & /*name*/, bool /*value*/) override {}
+    void onGlobalPipelineStateChanged() override {}
+    void setValue(const ccstd::string & /*name*/, int32_t /*value*/) override {}
+    void setValue(const ccstd::string & /*name*/, bool /*value*/) override {}
+    bool isOcclusionQueryEnabled() const override { return false; }
+    void resetRenderQueue(bool /*reset*/) override {}
+    bool isRenderQueueReset() const override { return false; }
+
+private:
+    gfx::Device *_device{nullptr};
+    IntrusivePtr<gfx::DescriptorSetLayout> _globalLayout;
+    MacroRecord _macros;
+    ccstd::string _constantMacros;
+    ccstd::vector<gfx::CommandBuffer *> _commandBuffers;
+};
+
+class RendererProgramLibAsyncTest : public testing::Test {
+protected:
+    void SetUp() override {
+        device = gfx::Device::getInstance();
+        pipeline = std::make_unique<TestPipeline>(device);
+        lib = std::make_unique<ProgramLib>();
+
+        IShaderInfo shader;
+        shader.name = PROGRAM_NAME;
+        shader.hash = 0x1234U;
+        shader.glsl4 = {"void main() {}", "void main() {}"};
+        shader.glsl3 = shader.glsl4;
+        shader.glsl1 = shader.glsl4;
+        shader.defines.push_back({"USE_A", "boolean", {}, {}, {}});
+        shader.defines.push_back({"LEVEL", "number", ccstd::vector<int32_t>{0, 7}, {}, {}});
+        lib->define(shader);
+    }
+
+    void TearDown() override {
+        lib.reset();
+        pipeline.reset();
+    }
+
+    gfx::Shader *requestAsync(int32_t level, const ShaderCompileCallback &callback = nullptr) {
+        MacroRecord defines{{"USE_A", true}, {"LEVEL", level}};
+        return lib->getGFXShaderAsync(device, PROGRAM_NAME, defines, pipeline.get(), callback);
+    }
+
+    gfx::Device *device{nullptr};
+    std::unique_ptr<TestPipeline> pipeline;
+    std::unique_ptr<ProgramLib> lib;
+};
+
+} // namespace
+
+TEST_F(RendererProgramLibAsyncTest, disabledCompilesOnRequest) {
+    EXPECT_FALSE(lib->isAsyncCompileEnabled());
+    auto *shader = requestAsync(0);
+    EXPECT_NE(shader, nullptr);
+    EXPECT_EQ(lib->getCompileStats().queued, 0U);
+    EXPECT_EQ(requestAsync(0), shader);
+}
+
+TEST_F(RendererProgramLibAsyncTest, queueWithoutFallback) {
+    lib->setAsyncCompileEnabled(true);
+
+    gfx::Shader *compiled = nullptr;
+    uint32_t callbackCount = 0;
+    const auto callback = [&](gfx::Shader *shader) {
+        compiled = shader;
+        ++callbackCount;
+    };
+    EXPECT_EQ(requestAsync(1, callback), nullptr);
+    // a second request of the same variant waits for the same compilation
+    EXPECT_EQ(requestAsync(1, callback), nullptr);
+
+    const auto &stats = lib->getCompileStats();
+    EXPECT_EQ(stats.queued, 1U);
+    EXPECT_EQ(stats.drawsSkipped, 2U);
+    EXPECT_EQ(stats.stallsAvoided, 0U);
+    EXPECT_EQ(callbackCount, 0U);
+
+    lib->compileQueuedShaders(device, pipeline.get());
+    EXPECT_EQ(stats.compiled, 1U);
+    EXPECT_EQ(callbackCount, 2U);
+    ASSERT_NE(compiled, nullptr);
+
+    // compiled variants are answered right away
+    EXPECT_EQ(requestAsync(1), compiled);
+    EXPECT_EQ(stats.queued, 1U);
+    EXPECT_EQ(stats.drawsSkipped, 2U);
+}
+
+TEST_F(RendererProgramLibAsyncTest, fallbackSubstitution) {
+    MacroRecord fallbackDefines{{"USE_A", false}};
+    auto *fallback = lib->getGFXShader(device, PROGRAM_NAME, fallbackDefines, pipeline.get());
+    ASSERT_NE(fallback, nullptr);
+    lib->setFallbackShader(PROGRAM_NAME, fallback);
+    lib->setAsyncCompileEnabled(true);
+
+    EXPECT_EQ(requestAsync(2), fallback);
+    const auto &stats = lib->getCompileStats();
+    EXPECT_EQ(stats.stallsAvoided, 1U);
+    EXPECT_EQ(stats.drawsSkipped, 0U);
+
+    lib->compileQueuedShaders(device, pipeline.get());
+    auto *shader = requestAsync(2);
+    EXPECT_NE(shader, nullptr);
+    EXPECT_NE(shader, fallback);
+
+    // removing the fallback skips the draws of variants still compiling
+    lib->setFallbackShader(PROGRAM_NAME, nullptr);
+    EXPECT_EQ(requestAsync(3), nullptr);
+    EXPECT_EQ(stats.stallsAvoided, 1U);
+    EXPECT_EQ(stats.drawsSkipped, 1U);
+}
+
+TEST_F(RendererProgramLibAsyncTest, compileLimit) {
+    lib->setAsyncCompileEnabled(true);
+    lib->setAsyncCompileLimit(2);
+
+    uint32_t callbackCount = 0;
+    for (int32_t level = 0; level < 5; ++level) {
+        requestAsync(level, [&](gfx::Shader * /*shader*/) { ++callbackCount; });
+    }
+    const auto &stats = lib->getCompileStats();
+    EXPECT_EQ(stats.queued, 5U);
+
+    lib->compileQueuedShaders(device, pipeline.get());
+    EXPECT_EQ(stats.compiled, 2U);
+    EXPECT_EQ(callbackCount, 2U);
+    lib->compileQueuedShaders(device, pipeline.get());
+    EXPECT_EQ(stats.compiled, 4U);
+    lib->compileQueuedShaders(device, pipeline.get());
+    EXPECT_EQ(stats.compiled, 5U);
+    EXPECT_EQ(callbackCount, 5U);
+
+    // nothing is left to compile
+    lib->compileQueuedShaders(device, pipeline.get());
+    EXPECT_EQ(stats.compiled, 5U);
+
+    // a limit of zero would never drain the queue
+    lib->setAsyncCompileLimit(0);
+    EXPECT_EQ(lib->getAsyncCompileLimit(), 1U);
+}
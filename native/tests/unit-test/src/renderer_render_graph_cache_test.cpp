@@ -0,0 +1,171 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/NativeRenderGraphCache.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gtest/gtest.h"
+
+using namespace cc::render;
+
+namespace {
+
+struct CompiledGraphFixture {
+    CompiledGraphFixture(const ViewInfo &rasterData, const ResourceInfo &resources, const LayoutInfo &layoutInfo)
+    : resource(boost::container::pmr::get_default_resource()),
+      renderGraph(resource),
+      rescGraph(resource),
+      layoutGraphData(resource) {
+        fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+    }
+
+    std::unique_ptr<CompiledRenderGraph> compile() {
+        auto compiled = std::make_unique<CompiledRenderGraph>(rescGraph, renderGraph, layoutGraphData, resource, resource);
+        compiled->graphHash = hashRenderGraph(renderGraph, rescGraph);
+        compiled->fgd.run();
+        return compiled;
+    }
+
+    bool isCacheHit(const CompiledRenderGraph &compiled) const {
+        return compiled.isValid(renderGraph, rescGraph, hashRenderGraph(renderGraph, rescGraph));
+    }
+
+    RasterView *firstRasterView() {
+        for (const auto vertID : cc::makeRange(vertices(renderGraph))) {
+            if (holds<RasterTag>(vertID, renderGraph)) {
+                auto &pass = get(RasterTag{}, vertID, renderGraph);
+                if (!pass.rasterViews.empty()) {
+                    return &pass.rasterViews.begin()->second;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    boost::container::pmr::memory_resource *resource;
+    RenderGraph renderGraph;
+    ResourceGraph rescGraph;
+    LayoutGraphData layoutGraphData;
+};
+
+} // namespace
+
+TEST(renderGraphCache, unchangedGraphHits) {
+    TEST_CASE_4;
+    CompiledGraphFixture graph(rasterData, resources, layoutInfo);
+    const auto compiled = graph.compile();
+
+    // hashing doesn't depend on anything but the graphs
+    EXPECT_EQ(hashRenderGraph(graph.renderGraph, graph.rescGraph), compiled->graphHash);
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+
+    // an identical graph hashes the same, but the results refer to the old graph object
+    CompiledGraphFixture other(rasterData, resources, layoutInfo);
+    EXPECT_EQ(hashRenderGraph(other.renderGraph, other.rescGraph), compiled->graphHash);
+    EXPECT_FALSE(other.isCacheHit(*compiled));
+}
+
+TEST(renderGraphCache, clearValuesKeepTheCache) {
+    TEST_CASE_4;
+    CompiledGraphFixture graph(rasterData, resources, layoutInfo);
+    const auto compiled = graph.compile();
+
+    auto *view = graph.firstRasterView();
+    ASSERT_NE(view, nullptr);
+    view->clearColor = cc::gfx::Color{0.F, 1.F, 0.F, 1.F};
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+}
+
+TEST(renderGraphCache, resourceChangeInvalidates) {
+    TEST_CASE_4;
+    CompiledGraphFixture graph(rasterData, resources, layoutInfo);
+    const auto compiled = graph.compile();
+
+    // resized
+    auto &desc = graph.rescGraph.descs[0];
+    const auto width = desc.width;
+    desc.width = width * 2;
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+    desc.width = width;
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+
+    // reformatted
+    desc.format = Format::RGBA16F;
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+    desc.format = Format::RGBA8;
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+
+    // added
+    add_vertex(graph.rescGraph, ManagedTag{}, "extra");
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+}
+
+TEST(renderGraphCache, passChangeInvalidates) {
+    TEST_CASE_4;
+    CompiledGraphFixture graph(rasterData, resources, layoutInfo);
+    const auto compiled = graph.compile();
+
+    // a different store op changes the barriers
+    auto *view = graph.firstRasterView();
+    ASSERT_NE(view, nullptr);
+    view->storeOp = cc::gfx::StoreOp::DISCARD;
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+    view->storeOp = cc::gfx::StoreOp::STORE;
+    EXPECT_TRUE(graph.isCacheHit(*compiled));
+
+    view->accessType = view->accessType == AccessType::READ ? AccessType::READ_WRITE : AccessType::READ;
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+
+    // a recompiled graph hits again
+    const auto recompiled = graph.compile();
+    EXPECT_TRUE(graph.isCacheHit(*recompiled));
+
+    // added pass
+    add_vertex(graph.renderGraph, RasterTag{}, "extra");
+    EXPECT_FALSE(graph.isCacheHit(*recompiled));
+}
+
+TEST(renderGraphCache, vertexCountsGuardHashCollisions) {
+    TEST_CASE_4;
+    CompiledGraphFixture graph(rasterData, resources, layoutInfo);
+    auto compiled = graph.compile();
+    EXPECT_EQ(compiled->numPasses, num_vertices(graph.renderGraph));
+    EXPECT_EQ(compiled->numResources, num_vertices(graph.rescGraph));
+
+    // pretend the grown graphs collide with the compiled ones
+    add_vertex(graph.renderGraph, RasterTag{}, "extra");
+    compiled->graphHash = hashRenderGraph(graph.renderGraph, graph.rescGraph);
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+
+    compiled = graph.compile();
+    add_vertex(graph.rescGraph, ManagedTag{}, "extra");
+    compiled->graphHash = hashRenderGraph(graph.renderGraph, graph.rescGraph);
+    EXPECT_FALSE(graph.isCacheHit(*compiled));
+
+    // the results also refer to the resource graph object they were compiled against
+    CompiledGraphFixture other(rasterData, resources, layoutInfo);
+    const auto hash = hashRenderGraph(graph.renderGraph, graph.rescGraph);
+    EXPECT_FALSE(compiled->isValid(graph.renderGraph, other.rescGraph, hash));
+}
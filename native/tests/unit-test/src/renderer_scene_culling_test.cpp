@@ -0,0 +1,200 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/job-system/JobSystem.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/SoftwareOcclusionCulling.h"
+#include "renderer/pipeline/custom/NativeSceneCulling.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+using namespace cc;
+
+namespace {
+
+// models on the x axis, one unit apart, each camera sees a slab of SLAB_SIZE models
+constexpr uint32_t MODEL_COUNT = 128;
+constexpr uint32_t CAMERA_COUNT = 8;
+constexpr uint32_t SLAB_SIZE = MODEL_COUNT / CAMERA_COUNT;
+
+bool isHidden(uint32_t i) {
+    return i % 7 == 3; // on a layer the cameras do not render
+}
+
+bool isDisabled(uint32_t i) {
+    return i % 5 == 2;
+}
+
+// culls with a job system of GetParam() workers, built through its thread count constructor
+class RendererSceneCullingTest : public testing::TestWithParam<uint32_t> {
+protected:
+    void SetUp() override {
+        scene = ccnew scene::RenderScene();
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            auto *node = nodes.emplace_back(ccnew Node()).get();
+            auto *model = models.emplace_back(ccnew scene::Model()).get();
+            const auto x = static_cast<float>(i) + 0.5F;
+            node->setPosition(x, 0.F, 0.F);
+            if (isHidden(i)) {
+                node->setLayer(static_cast<uint32_t>(Layers::LayerList::UI_2D));
+            }
+            model->initialize();
+            model->setNode(node);
+            model->setTransform(node);
+            model->setWorldBounds(ccnew geometry::AABB(x, 0.F, 0.F, 0.25F, 0.25F, 0.25F));
+            model->setEnabled(!isDisabled(i));
+            scene->addModel(model);
+        }
+        // a model without bounds is visible to every camera
+        auto *node = nodes.emplace_back(ccnew Node()).get();
+        pointModel = models.emplace_back(ccnew scene::Model()).get();
+        pointModel->initialize();
+        pointModel->setNode(node);
+        pointModel->setTransform(node);
+        pointModel->setEnabled(true);
+        scene->addModel(pointModel);
+
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            auto *camera = cameras.emplace_back(ccnew scene::Camera(gfx::Device::getInstance())).get();
+            const auto begin = static_cast<float>(c * SLAB_SIZE);
+            geometry::Frustum frustum;
+            geometry::Frustum::createFromAABB(&frustum, geometry::AABB(begin + SLAB_SIZE / 2.F, 0.F, 0.F, SLAB_SIZE / 2.F, 1.F, 1.F));
+            camera->setFrustum(frustum);
+            camera->setPosition(Vec3(begin, 0.F, 0.F));
+            camera->setForward(Vec3(1.F, 0.F, 0.F));
+            camera->setVisibility(static_cast<uint32_t>(Layers::LayerList::DEFAULT));
+        }
+    }
+
+    void TearDown() override {
+        scene->destroy();
+        for (auto &camera : cameras) {
+            camera->destroy();
+        }
+        for (auto &model : models) {
+            model->destroy();
+        }
+    }
+
+    // one task per camera, the queues only draw opaque objects
+    ccstd::pmr::vector<render::CameraCullingTask> makeTasks() {
+        ccstd::pmr::vector<render::CameraCullingTask> tasks(boost::container::pmr::get_default_resource());
+        tasks.resize(CAMERA_COUNT);
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            tasks[c].scene = scene;
+            tasks[c].camera = cameras[c];
+            tasks[c].queue = &queues[c];
+        }
+        return tasks;
+    }
+
+    ccstd::vector<const scene::Model *> expectedVisibleModels(uint32_t c) const {
+        ccstd::vector<const scene::Model *> expected;
+        for (uint32_t i = c * SLAB_SIZE; i < (c + 1) * SLAB_SIZE; ++i) {
+            if (!isHidden(i) && !isDisabled(i)) {
+                expected.emplace_back(models[i]);
+            }
+        }
+        expected.emplace_back(pointModel);
+        return expected;
+    }
+
+    JobSystem workers{GetParam()};
+    pipeline::SoftwareOcclusionCulling occlusionCulling;
+    IntrusivePtr<scene::RenderScene> scene;
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+    ccstd::vector<IntrusivePtr<scene::Camera>> cameras;
+    ccstd::vector<render::NativeRenderQueue> queues{makeQueues()};
+    scene::Model *pointModel{nullptr};
+
+private:
+    static ccstd::vector<render::NativeRenderQueue> makeQueues() {
+        ccstd::vector<render::NativeRenderQueue> result;
+        result.reserve(CAMERA_COUNT);
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            result.emplace_back(render::SceneFlags::OPAQUE_OBJECT, boost::container::pmr::get_default_resource());
+        }
+        return result;
+    }
+};
+
+} // namespace
+
+TEST_P(RendererSceneCullingTest, eachCameraSeesItsOwnModels) {
+    ASSERT_FALSE(occlusionCulling.isEnabled());
+    auto tasks = makeTasks();
+    render::cullCameras(tasks, occlusionCulling, &workers);
+    for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+        // the scene is walked in order, so is the visible list
+        EXPECT_EQ(tasks[c].visibleModels, expectedVisibleModels(c)) << "camera " << c;
+        EXPECT_TRUE(tasks[c].pendingInstances.empty());
+        EXPECT_TRUE(tasks[c].opaqueDraws.instances.empty());
+    }
+}
+
+TEST_P(RendererSceneCullingTest, parallelMatchesSerial) {
+    auto parallel = makeTasks();
+    render::cullCameras(parallel, occlusionCulling, &workers);
+
+    // a single task is culled on the calling thread
+    auto serial = makeTasks();
+    for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+        ccstd::pmr::vector<render::CameraCullingTask> single(boost::container::pmr::get_default_resource());
+        single.resize(1);
+        single[0].scene = serial[c].scene;
+        single[0].camera = serial[c].camera;
+        single[0].queue = serial[c].queue;
+        render::cullCameras(single, occlusionCulling, &workers);
+        EXPECT_EQ(parallel[c].visibleModels, single[0].visibleModels) << "camera " << c;
+    }
+
+    // culling again gives the same result, the LOD caches are cleared after each camera
+    auto again = makeTasks();
+    render::cullCameras(again, occlusionCulling, &workers);
+    for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+        EXPECT_EQ(parallel[c].visibleModels, again[c].visibleModels) << "camera " << c;
+    }
+}
+
+TEST_P(RendererSceneCullingTest, sharedModelsAreSeenByEveryCamera) {
+    // move every camera over the first slab, the cameras cull the same models concurrently
+    for (auto &camera : cameras) {
+        camera->setFrustum(cameras.front()->getFrustum());
+    }
+    auto tasks = makeTasks();
+    render::cullCameras(tasks, occlusionCulling, &workers);
+    const auto expected = expectedVisibleModels(0);
+    for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+        EXPECT_EQ(tasks[c].visibleModels, expected) << "camera " << c;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Workers, RendererSceneCullingTest, testing::Values(1U, 2U, 3U, 8U));
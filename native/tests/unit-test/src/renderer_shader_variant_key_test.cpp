@@ -0,0 +1,64 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "renderer/core/PassUtils.h"
+
+using namespace cc;
+
+TEST(rendererShaderVariantKeyTest, set) {
+    ShaderVariantKey key;
+    key.set(0, 1, 1);
+    key.set(3, 4, 0xA);
+    EXPECT_EQ(key.words[0], 0x51U);
+
+    // replaces the previous value of the field only
+    key.set(3, 4, 0x5);
+    EXPECT_EQ(key.words[0], 0x29U);
+
+    // a field across the first word boundary
+    key.set(62, 4, 0xF);
+    EXPECT_EQ(key.words[0], 0xC000000000000029U);
+    EXPECT_EQ(key.words[1], 0x3U);
+    key.set(62, 4, 0x6);
+    EXPECT_EQ(key.words[0], 0x8000000000000029U);
+    EXPECT_EQ(key.words[1], 0x1U);
+
+    // values wider than the field are masked
+    key.set(200, 2, 0x7);
+    EXPECT_EQ(key.words[3], uint64_t{0x3} << 8);
+}
+
+TEST(rendererShaderVariantKeyTest, compare) {
+    ShaderVariantKey a;
+    ShaderVariantKey b;
+    a.set(130, 3, 5);
+    EXPECT_NE(a, b);
+    b.set(130, 3, 5);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(ShaderVariantKeyHash{}(a), ShaderVariantKeyHash{}(b));
+    b.set(10, 1, 1);
+    EXPECT_NE(a, b);
+}
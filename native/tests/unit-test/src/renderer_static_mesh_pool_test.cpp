@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "3d/assets/Mesh.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "gtest/gtest.h"
+#include "renderer/pipeline/StaticMeshPool.h"
+#include "scene/Model.h"
+
+using namespace cc;
+
+namespace {
+
+IntrusivePtr<Mesh> createTriangleMesh() {
+    constexpr uint32_t vertexBytes = 3 * 3 * sizeof(float);
+    const uint16_t indices[]{0, 1, 2};
+
+    Mesh::ICreateInfo info;
+    Mesh::IVertexBundle bundle;
+    bundle.view = {0, vertexBytes, 3, 3 * sizeof(float)};
+    bundle.attributes.emplace_back(gfx::Attribute{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F});
+    info.structInfo.vertexBundles.emplace_back(bundle);
+
+    Mesh::ISubMesh primitive;
+    primitive.vertexBundelIndices = {0};
+    primitive.primitiveMode = gfx::PrimitiveMode::TRIANGLE_LIST;
+    primitive.indexView = Mesh::IBufferView{vertexBytes, sizeof(indices), 3, sizeof(uint16_t)};
+    info.structInfo.primitives.emplace_back(primitive);
+
+    info.data = Uint8Array(vertexBytes + sizeof(indices));
+    memcpy(info.data.buffer()->getData() + vertexBytes, indices, sizeof(indices));
+
+    IntrusivePtr<Mesh> mesh = ccnew Mesh();
+    mesh->reset(std::move(info));
+    mesh->initialize();
+    return mesh;
+}
+
+} // namespace
+
+TEST(rendererStaticMeshPoolTest, allocateReleaseReuse) {
+    auto *pool = pipeline::StaticMeshPool::getInstance();
+    auto meshA = createTriangleMesh();
+    auto meshB = createTriangleMesh();
+    IntrusivePtr<scene::Model> modelA = ccnew scene::Model();
+    IntrusivePtr<scene::Model> modelB = ccnew scene::Model();
+    IntrusivePtr<scene::Model> modelC = ccnew scene::Model();
+
+    const auto *rangeA = pool->acquire(modelA, meshA->getRenderingSubMeshes()[0]);
+    const auto *rangeB = pool->acquire(modelB, meshB->getRenderingSubMeshes()[0]);
+    ASSERT_NE(rangeA, nullptr);
+    ASSERT_NE(rangeB, nullptr);
+    const auto *arena = rangeB->arena;
+    EXPECT_EQ(rangeA->arena, arena);
+    EXPECT_EQ(rangeB->firstIndex, 3U);
+    EXPECT_EQ(rangeB->vertexOffset, 3);
+
+    // the geometry stays while another model still uses the mesh
+    EXPECT_EQ(pool->acquire(modelC, meshA->getRenderingSubMeshes()[0]), rangeA);
+    pool->release(modelA);
+    EXPECT_EQ(pool->getMeshCount(), 2U);
+    EXPECT_EQ(arena->indices.size(), 6U);
+
+    // the last user is gone, the geometry stays in place for the draws of this frame
+    pool->release(modelC);
+    EXPECT_EQ(pool->getMeshCount(), 1U);
+    EXPECT_TRUE(arena->fragmented);
+    EXPECT_EQ(arena->indices.size(), 6U);
+    EXPECT_EQ(rangeB->firstIndex, 3U);
+    pool->upload();
+    EXPECT_EQ(rangeB->firstIndex, 3U);
+
+    // B moves to the front of the arena on the next flush
+    pool->flush();
+    EXPECT_FALSE(arena->fragmented);
+    EXPECT_EQ(arena->indices.size(), 3U);
+    EXPECT_EQ(arena->vertices.size(), 3 * 3 * sizeof(float));
+    EXPECT_EQ(rangeB->firstIndex, 0U);
+    EXPECT_EQ(rangeB->vertexOffset, 0);
+
+    // the reclaimed space is reused by the next mesh
+    auto meshC = createTriangleMesh();
+    const auto *rangeC = pool->acquire(modelA, meshC->getRenderingSubMeshes()[0]);
+    ASSERT_NE(rangeC, nullptr);
+    EXPECT_EQ(rangeC->arena, arena);
+    EXPECT_EQ(rangeC->firstIndex, 3U);
+    EXPECT_EQ(rangeC->vertexOffset, 3);
+
+    pool->flush();
+    EXPECT_FALSE(arena->dirty);
+    EXPECT_EQ(arena->indexBuffer->getSize(), 6 * sizeof(uint32_t));
+
+    pool->destroy();
+    EXPECT_EQ(pool->getArenaCount(), 0U);
+}
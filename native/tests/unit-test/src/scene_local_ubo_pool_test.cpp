@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/Root.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/LocalUBOPool.h"
+#include "scene/Model.h"
+
+using namespace cc;
+
+namespace {
+
+class LocalUBOPoolTest : public testing::Test {
+protected:
+    void SetUp() override {
+        Root::getInstance()->setLocalUBOPoolEnabled(true);
+    }
+    void TearDown() override {
+        Root::getInstance()->setLocalUBOPoolEnabled(false);
+        pool->destroy();
+    }
+
+    gfx::Device *device{gfx::Device::getInstance()};
+    scene::LocalUBOPool *pool{scene::LocalUBOPool::getInstance()};
+};
+
+} // namespace
+
+TEST_F(LocalUBOPoolTest, switchedByRoot) {
+    EXPECT_TRUE(pool->isEnabled());
+    Root::getInstance()->setLocalUBOPoolEnabled(false);
+    EXPECT_FALSE(pool->isEnabled());
+    EXPECT_FALSE(Root::getInstance()->isLocalUBOPoolEnabled());
+}
+
+TEST_F(LocalUBOPoolTest, modelUsesPooledSlot) {
+    IntrusivePtr<scene::Model> pooled = ccnew scene::Model();
+    pooled->initialize();
+    pooled->initLocalDescriptors(0);
+    EXPECT_TRUE(pooled->hasPooledLocalUBO());
+    EXPECT_NE(pooled->getLocalBuffer(), nullptr);
+
+    // models initialized after the switch is turned off keep their own buffer
+    Root::getInstance()->setLocalUBOPoolEnabled(false);
+    IntrusivePtr<scene::Model> own = ccnew scene::Model();
+    own->initialize();
+    own->initLocalDescriptors(0);
+    EXPECT_FALSE(own->hasPooledLocalUBO());
+    EXPECT_NE(own->getLocalBuffer(), nullptr);
+
+    pooled->destroy();
+    own->destroy();
+    EXPECT_FALSE(pooled->hasPooledLocalUBO());
+}
+
+TEST_F(LocalUBOPoolTest, slotsAreReused) {
+    scene::LocalUBOSlot a;
+    scene::LocalUBOSlot b;
+    IntrusivePtr<gfx::Buffer> viewA = pool->allocate(device, &a);
+    IntrusivePtr<gfx::Buffer> viewB = pool->allocate(device, &b);
+    ASSERT_TRUE(viewA && viewB);
+    EXPECT_EQ(a.chunk, b.chunk);
+    EXPECT_NE(a.index, b.index);
+    EXPECT_EQ(viewA->getSize(), static_cast<uint32_t>(pipeline::UBOLocal::SIZE));
+    EXPECT_EQ(pool->getStride() % 16, 0U);
+    EXPECT_GE(pool->getStride(), static_cast<uint32_t>(pipeline::UBOLocal::SIZE));
+
+    const auto index = a.index;
+    viewA->destroy();
+    pool->free(&a);
+    EXPECT_FALSE(a.isValid());
+
+    scene::LocalUBOSlot c;
+    IntrusivePtr<gfx::Buffer> viewC = pool->allocate(device, &c);
+    EXPECT_EQ(c.chunk, b.chunk);
+    EXPECT_EQ(c.index, index);
+    // reused slots start cleared
+    EXPECT_EQ(pool->getData(c)[0], 0.F);
+
+    viewB->destroy();
+    viewC->destroy();
+    pool->free(&b);
+    pool->free(&c);
+}
+
+TEST_F(LocalUBOPoolTest, fullChunkOpensAnother) {
+    ccstd::vector<scene::LocalUBOSlot> slots(scene::LocalUBOPool::SLOTS_PER_CHUNK + 1);
+    ccstd::vector<IntrusivePtr<gfx::Buffer>> views;
+    for (auto &slot : slots) {
+        views.emplace_back(pool->allocate(device, &slot));
+    }
+    EXPECT_EQ(slots.front().chunk, slots[scene::LocalUBOPool::SLOTS_PER_CHUNK - 1].chunk);
+    EXPECT_NE(slots.front().chunk, slots.back().chunk);
+    EXPECT_EQ(pool->getChunkCount(), 2U);
+
+    for (uint32_t i = 0; i < slots.size(); ++i) {
+        views[i]->destroy();
+        pool->free(&slots[i]);
+    }
+}
+
+TEST_F(LocalUBOPoolTest, dirtyChunksUploadOncePerFrame) {
+    scene::LocalUBOSlot a;
+    scene::LocalUBOSlot b;
+    IntrusivePtr<gfx::Buffer> viewA = pool->allocate(device, &a);
+    IntrusivePtr<gfx::Buffer> viewB = pool->allocate(device, &b);
+    EXPECT_EQ(pool->update(), 0U);
+
+    pool->getData(a)[pipeline::UBOLocal::MAT_WORLD_OFFSET] = 1.F;
+    pool->markDirty(a);
+    pool->getData(b)[pipeline::UBOLocal::MAT_WORLD_OFFSET] = 2.F;
+    pool->markDirty(b);
+    // both slots share one chunk, which is uploaded once
+    EXPECT_EQ(pool->update(), 1U);
+    EXPECT_EQ(pool->update(), 0U);
+    EXPECT_EQ(pool->getData(a)[pipeline::UBOLocal::MAT_WORLD_OFFSET], 1.F);
+    EXPECT_EQ(pool->getData(b)[pipeline::UBOLocal::MAT_WORLD_OFFSET], 2.F);
+
+    viewA->destroy();
+    viewB->destroy();
+    pool->free(&a);
+    pool->free(&b);
+}
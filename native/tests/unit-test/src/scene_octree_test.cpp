@@ -0,0 +1,250 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Ptr.h"
+#include "core/geometry/AABB.h"
+#include "gtest/gtest.h"
+#include "scene/Model.h"
+#include "scene/Octree.h"
+
+using namespace cc;
+
+namespace {
+
+// root bounds are [-16, 16], the leaves at depth 3 are 4 units wide
+constexpr uint32_t TEST_DEPTH = 4;
+constexpr uint32_t LEAF_DEPTH = TEST_DEPTH - 1;
+
+class OctreeTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _info = ccnew scene::OctreeInfo();
+        _info->setEnabled(true);
+        _info->setMinPos({-6.F, -6.F, -6.F});
+        _info->setMaxPos({16.F, 16.F, 16.F});
+        _info->setDepth(TEST_DEPTH);
+    }
+
+    void TearDown() override {
+        for (auto &model : _models) {
+            model->setOctreeNode(nullptr);
+        }
+    }
+
+    void activate(float looseness) {
+        _info->setLooseness(looseness);
+        _info->activate(&_octree);
+    }
+
+    scene::Model *createModel(const Vec3 &center, float halfExtent) {
+        auto *model = _models.emplace_back(ccnew scene::Model()).get();
+        model->setWorldBounds(ccnew geometry::AABB(center.x, center.y, center.z, halfExtent, halfExtent, halfExtent));
+        return model;
+    }
+
+    static void moveModel(scene::Model *model, const Vec3 &center) {
+        model->getWorldBounds()->setCenter(center);
+    }
+
+    static const scene::OctreeNode *getRoot(const scene::Model *model) {
+        const scene::OctreeNode *node = model->getOctreeNode();
+        while (node && node->getParent()) {
+            node = node->getParent();
+        }
+        return node;
+    }
+
+    static uint32_t countChildren(const scene::OctreeNode *node) {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < scene::OCTREE_CHILDREN_NUM; ++i) {
+            count += node->getChild(i) ? 1 : 0;
+        }
+        return count;
+    }
+
+    // every node below the root holds models or leads to a node holding models
+    static bool hasEmptyLeaf(const scene::OctreeNode *node) { // NOLINT(misc-no-recursion)
+        if (node->getParent() && node->getModels().empty() && countChildren(node) == 0) {
+            return true;
+        }
+        for (uint32_t i = 0; i < scene::OCTREE_CHILDREN_NUM; ++i) {
+            if (node->getChild(i) && hasEmptyLeaf(node->getChild(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    scene::Octree _octree;
+    IntrusivePtr<scene::OctreeInfo> _info;
+    ccstd::vector<IntrusivePtr<scene::Model>> _models;
+};
+
+} // namespace
+
+TEST_F(OctreeTest, insertPlacesModelInDeepestContainingNode) {
+    activate(1.F);
+    auto *small = createModel({2.F, 2.F, 2.F}, 0.5F);
+    auto *large = createModel({0.F, 0.F, 0.F}, 1.F);
+    _octree.insert(small);
+    _octree.insert(large);
+
+    const scene::OctreeNode *node = small->getOctreeNode();
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(node->getDepth(), LEAF_DEPTH);
+    EXPECT_TRUE(node->getBox().contain(scene::BBox(*small->getWorldBounds())));
+    EXPECT_EQ(node->getModels(), ccstd::vector<scene::Model *>{small});
+
+    // straddling the center of the root, it stays in the root
+    ASSERT_NE(large->getOctreeNode(), nullptr);
+    EXPECT_EQ(large->getOctreeNode()->getDepth(), 0U);
+    EXPECT_EQ(large->getOctreeNode(), getRoot(small));
+}
+
+TEST_F(OctreeTest, updateKeepsNodeInsideLooseBounds) {
+    activate(2.F);
+    auto *model = createModel({2.F, 2.F, 2.F}, 0.5F);
+    _octree.insert(model);
+    const scene::OctreeNode *node = model->getOctreeNode();
+    ASSERT_NE(node, nullptr);
+    ASSERT_EQ(node->getDepth(), LEAF_DEPTH);
+
+    // leaves [0, 4] on x, still inside the loose bounds [-2, 6]
+    moveModel(model, {4.5F, 2.F, 2.F});
+    EXPECT_FALSE(node->getBox().contain(scene::BBox(*model->getWorldBounds())));
+    _octree.update(model);
+    EXPECT_EQ(model->getOctreeNode(), node);
+
+    // out of the loose bounds as well
+    moveModel(model, {6.5F, 2.F, 2.F});
+    _octree.update(model);
+    EXPECT_NE(model->getOctreeNode(), node);
+    EXPECT_TRUE(model->getOctreeNode()->getLooseBox().contain(scene::BBox(*model->getWorldBounds())));
+}
+
+TEST_F(OctreeTest, updateReinsertsFromAncestor) {
+    activate(1.F);
+    auto *model = createModel({2.F, 2.F, 2.F}, 0.5F);
+    auto *other = createModel({14.F, 14.F, 14.F}, 0.5F);
+    _octree.insert(model);
+    _octree.insert(other);
+    const scene::OctreeNode *leaf = model->getOctreeNode();
+    ASSERT_NE(leaf, nullptr);
+    const scene::OctreeNode *parent = leaf->getParent();
+    ASSERT_NE(parent, nullptr);
+    ASSERT_EQ(countChildren(parent), 1U);
+
+    // into the sibling leaf [4, 8] of the same parent
+    moveModel(model, {6.F, 2.F, 2.F});
+    _octree.update(model);
+    const scene::OctreeNode *moved = model->getOctreeNode();
+    ASSERT_NE(moved, nullptr);
+    EXPECT_EQ(moved->getDepth(), LEAF_DEPTH);
+    EXPECT_EQ(moved->getParent(), parent);
+    EXPECT_TRUE(moved->getBox().contain(scene::BBox(*model->getWorldBounds())));
+    // the emptied leaf is pruned
+    EXPECT_EQ(countChildren(parent), 1U);
+
+    // across the root center, reinserted into another branch
+    moveModel(model, {-2.F, -2.F, -2.F});
+    _octree.update(model);
+    ASSERT_NE(model->getOctreeNode(), nullptr);
+    EXPECT_EQ(model->getOctreeNode()->getDepth(), LEAF_DEPTH);
+    EXPECT_TRUE(model->getOctreeNode()->getBox().contain(scene::BBox(*model->getWorldBounds())));
+    EXPECT_EQ(getRoot(model), getRoot(other));
+    EXPECT_FALSE(hasEmptyLeaf(getRoot(model)));
+}
+
+TEST_F(OctreeTest, batchesPruneEmptyNodes) {
+    activate(1.F);
+    ccstd::vector<scene::Model *> models;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            for (int z = 0; z < 4; ++z) {
+                models.push_back(createModel({-14.F + 8.F * static_cast<float>(x),
+                                              -14.F + 8.F * static_cast<float>(y),
+                                              -14.F + 8.F * static_cast<float>(z)},
+                                             0.5F));
+            }
+        }
+    }
+    _octree.insert(models);
+    const scene::OctreeNode *root = getRoot(models.front());
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(countChildren(root), 8U);
+    for (auto *model : models) {
+        EXPECT_EQ(model->getOctreeNode()->getDepth(), LEAF_DEPTH);
+    }
+
+    // gather everything into one leaf, the emptied branches are pruned at the end of the batch
+    for (auto *model : models) {
+        moveModel(model, {2.F, 2.F, 2.F});
+    }
+    _octree.update(models);
+    const scene::OctreeNode *leaf = models.front()->getOctreeNode();
+    for (auto *model : models) {
+        EXPECT_EQ(model->getOctreeNode(), leaf);
+    }
+    EXPECT_EQ(leaf->getModels().size(), models.size());
+    EXPECT_EQ(countChildren(root), 1U);
+    EXPECT_FALSE(hasEmptyLeaf(root));
+
+    // re-inserting a batch of models already in the tree
+    for (uint32_t i = 0; i < models.size(); i += 2) {
+        moveModel(models[i], {-2.F, -2.F, -2.F});
+    }
+    _octree.insert(models);
+    EXPECT_EQ(countChildren(root), 2U);
+    EXPECT_FALSE(hasEmptyLeaf(root));
+
+    _octree.remove(models);
+    for (auto *model : models) {
+        EXPECT_EQ(model->getOctreeNode(), nullptr);
+    }
+    EXPECT_EQ(countChildren(root), 0U);
+    EXPECT_TRUE(root->getModels().empty());
+}
+
+TEST_F(OctreeTest, infoPassesLooseness) {
+    activate(2.F);
+    EXPECT_FLOAT_EQ(_octree.getLooseness(), 2.F);
+
+    auto *model = createModel({2.F, 2.F, 2.F}, 0.5F);
+    _octree.insert(model);
+    ASSERT_NE(model->getOctreeNode(), nullptr);
+
+    // changing it rebuilds the tree with the models kept
+    _info->setLooseness(1.5F);
+    EXPECT_FLOAT_EQ(_info->getLooseness(), 1.5F);
+    EXPECT_FLOAT_EQ(_octree.getLooseness(), 1.5F);
+    ASSERT_NE(model->getOctreeNode(), nullptr);
+    EXPECT_TRUE(model->getOctreeNode()->getLooseBox().contain(scene::BBox(*model->getWorldBounds())));
+
+    // values below 1 fall back to a regular octree
+    _info->setLooseness(0.5F);
+    EXPECT_FLOAT_EQ(_octree.getLooseness(), 1.F);
+    activate(0.F);
+    EXPECT_FLOAT_EQ(_octree.getLooseness(), 1.F);
+}
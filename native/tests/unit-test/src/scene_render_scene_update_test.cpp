@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "base/job-system/JobSystem.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+using namespace cc;
+
+namespace {
+
+// keeps the last uploaded local UBO
+class RecordingBuffer final : public gfx::Buffer {
+public:
+    void update(const void *buffer, uint32_t size) override {
+        const auto *bytes = static_cast<const uint8_t *>(buffer);
+        uploaded.assign(bytes, bytes + size);
+        ++uploads;
+    }
+
+    Vec3 uploadedTranslation() const {
+        float matWorld[16];
+        memcpy(matWorld, uploaded.data() + sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET, sizeof(matWorld));
+        return {matWorld[12], matWorld[13], matWorld[14]};
+    }
+
+    ccstd::vector<uint8_t> uploaded;
+    uint32_t uploads{0};
+
+protected:
+    void doInit(const gfx::BufferInfo & /*info*/) override {}
+    void doInit(const gfx::BufferViewInfo & /*info*/) override {}
+    void doResize(uint32_t /*size*/, uint32_t /*count*/) override {}
+    void doDestroy() override {}
+};
+
+// updates with a job system of GetParam() workers, built through its thread count constructor
+class RenderSceneUpdateTest : public testing::TestWithParam<uint32_t> {
+protected:
+    JobSystem workers{GetParam()};
+};
+
+} // namespace
+
+TEST_P(RenderSceneUpdateTest, localUBOsAreIndependentOfWorkerCount) {
+    // enough models to be split over every worker
+    constexpr uint32_t MODEL_COUNT = 1000;
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<RecordingBuffer *> buffers;
+    ccstd::vector<scene::Model *> modelList;
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        auto *buffer = ccnew RecordingBuffer();
+        buffer->initialize(gfx::BufferInfo{gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                           gfx::MemoryUsageBit::DEVICE,
+                                           pipeline::UBOLocal::SIZE,
+                                           pipeline::UBOLocal::SIZE,
+                                           gfx::BufferFlagBit::ENABLE_STAGING_WRITE});
+        auto *model = models.emplace_back(ccnew scene::Model()).get();
+        auto *node = nodes.emplace_back(ccnew Node()).get();
+        model->initialize();
+        model->setTransform(node);
+        model->setLocalBuffer(buffer);
+        buffers.emplace_back(buffer);
+        modelList.emplace_back(model);
+    }
+
+    for (uint32_t frame = 1; frame <= 2; ++frame) {
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            nodes[i]->setPosition(static_cast<float>(i), static_cast<float>(frame), 0.F);
+            modelList[i]->setLocalDataUpdated(true);
+        }
+        // the models have no sub-models, forcing the update makes them write their local UBO
+        scene::RenderScene::updateLocalUBOs(modelList, true, false, &workers);
+        for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+            ASSERT_EQ(buffers[i]->uploads, frame);
+            EXPECT_EQ(buffers[i]->uploadedTranslation(), Vec3(static_cast<float>(i), static_cast<float>(frame), 0.F));
+        }
+
+        // nothing changed, nothing uploaded
+        scene::RenderScene::updateLocalUBOs(modelList, true, false, &workers);
+        EXPECT_EQ(buffers.front()->uploads, frame);
+        EXPECT_EQ(buffers.back()->uploads, frame);
+    }
+
+    // only models with plain passes write their local UBO when it is not forced
+    modelList.front()->setLocalDataUpdated(true);
+    scene::RenderScene::updateLocalUBOs(modelList, false, false, &workers);
+    EXPECT_EQ(buffers.front()->uploads, 2U);
+
+    for (auto &model : models) {
+        model->destroy();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Workers, RenderSceneUpdateTest, testing::Values(1U, 2U, 3U, 8U));
@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "base/SlotMap.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+TEST(SlotMapTest, insertAndGet) {
+    SlotMap<int> slotMap;
+    const auto a = slotMap.insert(1);
+    const auto b = slotMap.insert(2);
+    EXPECT_EQ(slotMap.size(), 2);
+    EXPECT_EQ(*slotMap.get(a), 1);
+    EXPECT_EQ(*slotMap.get(b), 2);
+    EXPECT_FALSE(slotMap.get(SlotMapHandle{}));
+}
+
+TEST(SlotMapTest, swapRemove) {
+    SlotMap<int> slotMap;
+    const auto a = slotMap.insert(1);
+    const auto b = slotMap.insert(2);
+    const auto c = slotMap.insert(3);
+    EXPECT_TRUE(slotMap.erase(a));
+    EXPECT_FALSE(slotMap.erase(a));
+    EXPECT_FALSE(slotMap.contains(a));
+
+    // the last value is moved into the hole, handles stay valid
+    ASSERT_EQ(slotMap.values().size(), 2);
+    EXPECT_EQ(slotMap.values()[0], 3);
+    EXPECT_EQ(*slotMap.get(b), 2);
+    EXPECT_EQ(*slotMap.get(c), 3);
+}
+
+TEST(SlotMapTest, staleHandle) {
+    SlotMap<int> slotMap;
+    const auto a = slotMap.insert(1);
+    slotMap.erase(a);
+    const auto b = slotMap.insert(2);
+    // the slot is reused with a new generation
+    EXPECT_EQ(a.index, b.index);
+    EXPECT_NE(a, b);
+    EXPECT_FALSE(slotMap.get(a));
+    EXPECT_EQ(*slotMap.get(b), 2);
+
+    slotMap.clear();
+    EXPECT_TRUE(slotMap.empty());
+    EXPECT_FALSE(slotMap.contains(b));
+    const auto c = slotMap.insert(3);
+    EXPECT_EQ(*slotMap.get(c), 3);
+    EXPECT_EQ(slotMap.size(), 1);
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+// replay on the empty device, see DeviceManager::create
+#undef CC_USE_VULKAN
+#undef CC_USE_METAL
+#undef CC_USE_GLES3
+#undef CC_USE_GLES2
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include "renderer/GFXDeviceManager.h"
+#include "renderer/gfx-capture/CaptureReplayer.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+// Fix linking error of undefined symbol cocos_main
+int cocos_main(int argc, const char **argv) {
+    return 0;
+}
+
+// Loads a trace written by DeviceCapture and replays it on the empty device,
+// checks that a capture decodes and replays without a GPU or window.
+int main(int argc, const char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture file> [repeat count]\n", argv[0]);
+        return 1;
+    }
+    const int repeat = argc > 2 ? std::max(atoi(argv[2]), 1) : 1;
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "failed to open %s\n", argv[1]);
+        return 1;
+    }
+    ccstd::vector<uint8_t> trace{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    auto *device = DeviceManager::create();
+    if (!device) {
+        fprintf(stderr, "failed to create the empty device\n");
+        return 1;
+    }
+
+    int ret = 0;
+    {
+        CaptureReplayer replayer(device);
+        if (!replayer.load(std::move(trace))) {
+            fprintf(stderr, "%s is not a valid capture\n", argv[1]);
+            ret = 1;
+        }
+        for (int i = 0; !ret && i < repeat; ++i) {
+            if (!replayer.replay()) {
+                fprintf(stderr, "replay failed after %u records\n", replayer.getStats().records);
+                ret = 1;
+                break;
+            }
+            const auto &stats = replayer.getStats();
+            printf("replayed %u frames, %u records, %u draw calls\n", stats.frames, stats.records, stats.drawCalls);
+            replayer.reset();
+        }
+    }
+
+    CC_SAFE_DESTROY_AND_DELETE(device);
+    return ret;
+}
@@ -140,6 +140,21 @@ class PhysicsWorld {
         this._impl.setAllowSleep(v);
     }
 
+    /**
+     * Number of job system workers solving a step, 0 runs the whole step on the calling thread.
+     */
+    setSimulationWorkerCount (v) {
+        this._impl.setSimulationWorkerCount(v >>> 0);
+    }
+
+    /**
+     * When enabled, step only kicks off the solve and its results are fetched at the next step,
+     * so that rendering overlaps the simulation at one step of latency.
+     */
+    setSplitSimulation (v) {
+        this._impl.setSplitSimulation(!!v);
+    }
+
     setDefaultMaterial (v) { }
 
     step (f, t, m) {
@@ -180,6 +195,14 @@ class PhysicsWorld {
         return isHit;
     }
 
+    /**
+     * Runs a batch of queries packed with the native SceneQueryLayout in one call,
+     * hits are written to `hits` and the per query hit count to `hitCounts`.
+     */
+    sceneQueryBatch (queries, maxHitsPerQuery, hits, hitCounts) {
+        return this._impl.sceneQueryBatch(queries, maxHitsPerQuery, hits, hitCounts);
+    }
+
     emitEvents () {
         this.emitTriggerEvent();
         this.emitCollisionEvent();